@@ -0,0 +1,88 @@
+#include "BenchFramework.h"
+#include "../../BridgeCore/include/DotNetAdapter.h"
+#include "../../BridgeCore/include/PipeChannel.h"
+#include "../../BridgeCore/include/Types.h"
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <thread>
+
+namespace {
+
+// Worker that answers every tagged line "OK" at once, so the numbers are
+// the pipe round trip and the adapter's own cost.
+class EchoWorker {
+public:
+    explicit EchoWorker(const std::string& path) : m_listen(Bridge::PipeChannel::Listen(path)) {
+        m_thread = std::thread([this] { Run(); });
+    }
+    ~EchoWorker() {
+        m_stop = true;
+        m_thread.join();
+    }
+
+private:
+    void Run() {
+        Bridge::PipeChannel c;
+        while (!m_stop && !c.IsOpen()) c = m_listen.Accept(20);
+        std::string in, out;
+        char chunk[64 * 1024];
+        while (!m_stop) {
+            int n = c.Receive(chunk, sizeof(chunk), 20);
+            if (n < 0) return;
+            in.append(chunk, static_cast<size_t>(n));
+            size_t start = 0, nl;
+            out.clear();
+            while ((nl = in.find('\n', start)) != std::string::npos) {
+                out.append(in, start, in.find(' ', start) - start).append(" OK\n");
+                start = nl + 1;
+            }
+            in.erase(0, start);
+            if (!out.empty()) c.SendAll(out.data(), out.size());
+        }
+    }
+
+    Bridge::PipeChannel m_listen;
+    std::atomic<bool>   m_stop{ false };
+    std::thread         m_thread;
+};
+
+} // namespace
+
+void BenchDotNet() {
+    std::string path = (std::filesystem::temp_directory_path() / "bridge_bench_dotnet.pipe").string();
+    EchoWorker worker(path);
+    Bridge::DotNetSettings s;
+    s.pipeName = path;
+    Bridge::DotNetAdapter adapter(s);
+    for (int i = 0; i < 200 && !adapter.IsConnected(); ++i)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    if (!adapter.IsConnected()) {
+        printf("  pipe connect failed\n");
+        return;
+    }
+
+    Bridge::OrderRequest req;
+    req.command     = Bridge::Command::PLACE;
+    req.account     = "ACC1";
+    req.instrument  = "ES";
+    req.action      = Bridge::Action::BUY;
+    req.quantity    = 5;
+    req.orderType   = Bridge::OrderType::LIMIT;
+    req.limitPrice  = 4200.25;
+    req.timeInForce = Bridge::TimeInForce::DAY;
+
+    RunBench("DotNetAdapter::Execute PLACE (round trip)", 20000, [&](uint64_t) {
+        g_sink = g_sink + static_cast<uint64_t>(adapter.Execute(req) + 100);
+    });
+
+    Bridge::OrderRequest batch[16];
+    for (auto& r : batch) r = req;
+    int results[16];
+    double ns = RunBench("DotNetAdapter::ExecuteBatch x16 (pipelined)", 2000, [&](uint64_t) {
+        adapter.ExecuteBatch(batch, 16, results);
+        g_sink = g_sink + static_cast<uint64_t>(results[15] + 100);
+    });
+    printf("  %-44s %10.2f ns/order\n", "  per order", ns / 16);
+}
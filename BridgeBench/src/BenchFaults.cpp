@@ -0,0 +1,99 @@
+#include "BenchFramework.h"
+#include "../../BridgeCore/include/BridgeEngine.h"
+#include "../../BridgeCore/include/FaultInjectingAdapter.h"
+#include "../../BridgeCore/include/MockAdapter.h"
+#include "../../BridgeCore/include/Config.h"
+#include "../../BridgeCore/include/Types.h"
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr int kAccounts = 16;
+constexpr int kOrders   = 4000;
+
+using Clock = std::chrono::steady_clock;
+
+// Push kOrders async orders through an engine whose adapter misbehaves per
+// 'latency', as fast as the queue takes them, and report how long each took
+// from submission to a result being pollable.
+void RunProfile(const char* latency, double rejectRate, int timeoutMs) {
+    Bridge::BridgeConfig cfg;
+    cfg.adapterType     = "MOCK";
+    cfg.executionLanes  = 4;
+    cfg.asyncQueueDepth = 256;
+    Bridge::FaultProfile profile;
+    Bridge::ParseFaultLatency(latency, profile);
+    profile.rejectRate = rejectRate;
+    profile.timeoutMs  = timeoutMs;
+    profile.seed       = 1;
+    auto faulty = std::make_shared<Bridge::FaultInjectingAdapter>(
+        std::make_shared<Bridge::MockAdapter>(), profile);
+    Bridge::BridgeEngine engine(cfg, faulty);
+
+    std::vector<Bridge::OrderRequest> reqs(kAccounts);
+    for (int a = 0; a < kAccounts; ++a) {
+        Bridge::OrderRequest& r = reqs[a];
+        r.command     = Bridge::Command::PLACE;
+        r.account     = "FAULT" + std::to_string(a);
+        r.instrument  = "ES";
+        r.action      = Bridge::Action::BUY;
+        r.quantity    = 1;
+        r.orderType   = Bridge::OrderType::MARKET;
+        r.timeInForce = Bridge::TimeInForce::DAY;
+    }
+
+    struct Pending { int ticket; Clock::time_point sent; };
+    std::vector<Pending> open;
+    std::vector<double>  latUs;
+    latUs.reserve(kOrders);
+    uint64_t queueFull = 0;
+    int      failed    = 0;
+
+    auto reap = [&] {
+        Clock::time_point now = Clock::now();
+        size_t kept = 0;
+        for (const Pending& p : open) {
+            int rc = engine.PollResult(p.ticket);
+            if (rc == Bridge::RC_PENDING) { open[kept++] = p; continue; }
+            if (rc != Bridge::RC_SUCCESS) ++failed;
+            latUs.push_back(std::chrono::duration<double, std::micro>(now - p.sent).count());
+        }
+        open.resize(kept);
+    };
+
+    auto t0 = Clock::now();
+    for (int i = 0; i < kOrders; ++i) {
+        int t;
+        while ((t = engine.ExecuteAsync(reqs[i % kAccounts])) == Bridge::RC_QUEUE_FULL) {
+            ++queueFull;
+            reap();
+            std::this_thread::yield();
+        }
+        open.push_back(Pending{ t, Clock::now() });
+        if (i % 64 == 63) reap();
+    }
+    while (!open.empty()) { reap(); std::this_thread::yield(); }
+    double secs = std::chrono::duration<double>(Clock::now() - t0).count();
+
+    std::sort(latUs.begin(), latUs.end());
+    auto pct = [&](double q) { return latUs[static_cast<size_t>(q * (latUs.size() - 1))]; };
+    printf("  %-22s %8.0f orders/s  p50 %8.0fus  p99 %8.0fus  max %8.0fus  queue-full %llu  failed %d\n",
+           latency, kOrders / secs, pct(0.50), pct(0.99), latUs.back(),
+           static_cast<unsigned long long>(queueFull), failed);
+    g_sink = g_sink + latUs.size();
+}
+
+} // anonymous namespace
+
+void BenchFaults() {
+    printf("  %d async orders, 4 lanes, queue depth 256, submit-to-result latency\n", kOrders);
+    RunProfile("none", 0.0, 0);
+    RunProfile("fixed:100", 0.0, 0);
+    RunProfile("uniform:50-150", 0.0, 0);
+    RunProfile("lognormal:100,0.8", 0.01, 2);
+}
@@ -0,0 +1,278 @@
+#include "BenchFramework.h"
+#include "../../BridgeCore/include/FixAdapter.h"
+#include "../../BridgeCore/include/FixDecoder.h"
+#include "../../BridgeCore/include/FixMessage.h"
+#include "../../BridgeCore/include/FixSessionStore.h"
+#include "../../BridgeCore/include/FixTemplate.h"
+#include "../../BridgeCore/include/Numeric.h"
+#include "../../BridgeCore/include/Parser.h"
+#include "../../BridgeCore/include/Socket.h"
+#include "../../BridgeCore/include/Types.h"
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Loopback acceptor that accepts the logon and then only drains the socket,
+// so the numbers are the initiator's encode-and-write cost alone.
+class DrainAcceptor {
+public:
+    DrainAcceptor() : m_listen(Bridge::Socket::Listen("127.0.0.1", 0)) {
+        m_thread = std::thread([this] { Run(); });
+    }
+    ~DrainAcceptor() {
+        m_stop = true;
+        m_thread.join();
+    }
+    uint16_t Port() const { return m_listen.LocalPort(); }
+
+private:
+    void Run() {
+        Bridge::Socket c;
+        while (!m_stop && !c.IsOpen()) c = m_listen.Accept(20);
+        std::vector<char> buf(1 << 20);
+        size_t len = 0;
+        while (!m_stop) {
+            int n = c.Receive(buf.data() + len, buf.size() - len, 20);
+            if (n < 0) return;
+            len += static_cast<size_t>(n);
+            if (m_loggedOn) {
+                len = 0;
+                continue;
+            }
+            if (Bridge::FixFrame(std::string_view(buf.data(), len)) <= 0) continue;
+            Bridge::FixWriter w;
+            w.Begin("A");
+            w.Add(Bridge::FixTag::SenderCompID, std::string_view("SERVER"));
+            w.Add(Bridge::FixTag::TargetCompID, std::string_view("CLIENT"));
+            w.Add(Bridge::FixTag::MsgSeqNum, static_cast<int64_t>(1));
+            w.AddTimestamp(Bridge::FixTag::SendingTime);
+            w.Add(Bridge::FixTag::EncryptMethod, '0');
+            w.Add(Bridge::FixTag::HeartBtInt, static_cast<int64_t>(30));
+            std::string_view msg = w.Finish();
+            c.SendAll(msg.data(), msg.size());
+            m_loggedOn = true;
+            len = 0;
+        }
+    }
+
+    Bridge::Socket    m_listen;
+    std::atomic<bool> m_stop{ false };
+    bool              m_loggedOn = false;
+    std::thread       m_thread;
+};
+
+// The order payloads of TestParser.
+const char* const kPayloads[] = {
+    "command=PLACE|account=ACC1|instrument=ES|action=BUY|"
+    "quantity=1|orderType=MARKET|limitPrice=0|stopPrice=0|timeInForce=DAY",
+    "command=PLACE|account=ACC1|instrument=ES|action=BUY|"
+    "quantity=5|orderType=LIMIT|limitPrice=4200.25|stopPrice=0|timeInForce=GTC",
+    "command=PLACE|account=ACC1|instrument=ESH26|action=SELL|"
+    "quantity=3|orderType=STOPLIMIT|limitPrice=4200.25|stopPrice=4199.75|timeInForce=GTC",
+};
+
+const char* const kOrdTypes = "1234";
+
+Bridge::FixOrderFields FieldsOf(const Bridge::OrderRequest& r) {
+    Bridge::FixOrderFields f;
+    f.clOrdId  = "BR093000A-12345";
+    f.account  = r.account;
+    f.symbol   = r.instrument;
+    f.side     = r.action == Bridge::Action::BUY ? '1' : '2';
+    f.quantity = r.quantity;
+    f.ordType  = kOrdTypes[static_cast<int>(r.orderType)];
+    f.tif      = r.timeInForce == Bridge::TimeInForce::GTC ? '1' : '0';
+    f.price    = r.limitPx.IsSet() ? r.limitPx : Bridge::PriceFromDouble(r.limitPrice);
+    f.stopPx   = r.stopPx.IsSet() ? r.stopPx : Bridge::PriceFromDouble(r.stopPrice);
+    return f;
+}
+
+// What a first cut would write: one std::string per message, every field
+// formatted, the checksum summed over the whole message.
+std::string NaiveEncode(uint64_t seq, const Bridge::FixOrderFields& f) {
+    char ts[Bridge::kFixTimestampLen];
+    Bridge::FixTimestamp(ts);
+    std::string time(ts, sizeof(ts));
+    char px[40];
+    std::string body = "35=D\x01" "49=CLIENT\x01" "56=SERVER\x01" "34=" + std::to_string(seq) + "\x01" +
+                       "52=" + time + "\x01" + "11=" + std::string(f.clOrdId) + "\x01" +
+                       "1=" + std::string(f.account) + "\x01" + "21=1\x01" +
+                       "55=" + std::string(f.symbol) + "\x01" + "54=" + f.side + "\x01" +
+                       "60=" + time + "\x01" + "38=" + std::to_string(f.quantity) + "\x01" +
+                       "40=" + f.ordType + "\x01";
+    if (f.ordType == '2' || f.ordType == '4')
+        body += "44=" + std::string(px, Bridge::FormatPrice(f.price, px, sizeof(px))) + "\x01";
+    if (f.ordType == '3' || f.ordType == '4')
+        body += "99=" + std::string(px, Bridge::FormatPrice(f.stopPx, px, sizeof(px))) + "\x01";
+    body += "59=" + std::string(1, f.tif) + "\x01";
+    std::string msg = "8=FIX.4.2\x01" "9=" + std::to_string(body.size()) + "\x01" + body;
+    unsigned sum = 0;
+    for (char c : msg) sum += static_cast<unsigned char>(c);
+    char trailer[8];
+    snprintf(trailer, sizeof(trailer), "10=%03u\x01", sum & 0xFF);
+    return msg + trailer;
+}
+
+// A burst of execution reports as the acceptor would send them: acks,
+// partial fills and fills, with the occasional reject.
+std::string MakeReports(size_t count) {
+    std::string stream;
+    Bridge::FixWriter w;
+    for (size_t i = 0; i < count; ++i) {
+        std::string id = "BR093000A-" + std::to_string(i / 3);
+        char        type = "012"[i % 3];
+        if (i % 64 == 63) type = '8';
+        w.Begin("8");
+        w.Add(Bridge::FixTag::SenderCompID, std::string_view("SERVER"));
+        w.Add(Bridge::FixTag::TargetCompID, std::string_view("CLIENT"));
+        w.Add(Bridge::FixTag::MsgSeqNum, static_cast<int64_t>(i + 2));
+        w.AddTimestamp(Bridge::FixTag::SendingTime);
+        w.Add(Bridge::FixTag::OrderID, std::string_view(id));
+        w.Add(Bridge::FixTag::ClOrdID, std::string_view(id));
+        w.Add(Bridge::FixTag::ExecID, static_cast<int64_t>(i));
+        w.Add(Bridge::FixTag::ExecType, type);
+        w.Add(Bridge::FixTag::OrdStatus, type);
+        w.Add(Bridge::FixTag::Account, std::string_view("BENCH"));
+        w.Add(Bridge::FixTag::Symbol, std::string_view("ES"));
+        w.Add(Bridge::FixTag::Side, '1');
+        w.Add(Bridge::FixTag::OrderQty, static_cast<int64_t>(2));
+        if (type == '1' || type == '2') {
+            w.Add(Bridge::FixTag::LastShares, static_cast<int64_t>(1));
+            w.Add(Bridge::FixTag::LastPx, std::string_view("4900.25"));
+        }
+        w.Add(Bridge::FixTag::LeavesQty, static_cast<int64_t>(type == '2' ? 0 : 2));
+        w.Add(Bridge::FixTag::CumQty, static_cast<int64_t>(type == '0' ? 0 : 1));
+        w.Add(Bridge::FixTag::AvgPx, std::string_view("4900.25"));
+        if (type == '8') w.Add(Bridge::FixTag::Text, std::string_view("outside trading hours"));
+        stream += w.Finish();
+    }
+    return stream;
+}
+
+// Decode every message of 'stream' with 'decode', which returns the length
+// used (<= 0 to stop); prints messages per second on this thread.
+template <typename Decode>
+void BenchDecode(const char* name, const std::string& stream, size_t count, int passes, Decode&& decode) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (int p = 0; p < passes; ++p) {
+        size_t used = 0;
+        while (used < stream.size()) {
+            ptrdiff_t n = decode(std::string_view(stream).substr(used));
+            if (n <= 0) break;
+            used += static_cast<size_t>(n);
+        }
+    }
+    auto   t1  = std::chrono::steady_clock::now();
+    double sec = std::chrono::duration<double>(t1 - t0).count();
+    double n   = static_cast<double>(count) * passes;
+    printf("  %-44s %10.2f ns/msg  (%.1f M msgs/s)\n", name, sec * 1e9 / n, n / sec / 1e6);
+}
+
+} // anonymous namespace
+
+void BenchFix() {
+    Bridge::OrderRequest req;
+    req.command     = Bridge::Command::PLACE;
+    req.account     = "BENCH";
+    req.instrument  = "ES";
+    req.action      = Bridge::Action::BUY;
+    req.quantity    = 2;
+    req.orderType   = Bridge::OrderType::LIMIT;
+    req.limitPx     = Bridge::PriceFromDouble(4900.25);
+    req.timeInForce = Bridge::TimeInForce::DAY;
+
+    // NewOrderSingle encoding of the parser-test orders, three ways.
+    constexpr size_t kOrders = sizeof(kPayloads) / sizeof(kPayloads[0]);
+    Bridge::OrderRequest   parsed[kOrders];
+    Bridge::FixOrderFields fields[kOrders];
+    for (size_t i = 0; i < kOrders; ++i) {
+        if (Bridge::ParsePayload(kPayloads[i], parsed[i]) != Bridge::RC_SUCCESS) {
+            printf("  parser payload %zu rejected\n", i);
+            return;
+        }
+        fields[i] = FieldsOf(parsed[i]);
+    }
+    RunBench("NewOrderSingle naive (std::string)", 1000000, [&](uint64_t i) {
+        g_sink = g_sink + NaiveEncode(i, fields[i % kOrders]).size();
+    });
+    Bridge::FixWriter w;
+    RunBench("NewOrderSingle FixWriter", 2000000, [&](uint64_t i) {
+        g_sink = g_sink + Bridge::EncodeOrder(w, 'D', "CLIENT", "SERVER", i, fields[i % kOrders]).size();
+    });
+    Bridge::FixOrderTemplates templates("CLIENT", "SERVER");
+    RunBench("NewOrderSingle template patch", 2000000, [&](uint64_t i) {
+        g_sink = g_sink + templates.Render('D', i, fields[i % kOrders]).size();
+    });
+
+    // Decoding execution reports on one core.
+    constexpr size_t kReports = 4096;
+    std::string reports = MakeReports(kReports);
+    BenchDecode("ExecutionReport FixFrame + FixFields", reports, kReports, 200, [&](std::string_view buf) {
+        ptrdiff_t n = Bridge::FixFrame(buf);
+        Bridge::FixFields f;
+        if (n <= 0 || !f.Parse(buf.substr(0, static_cast<size_t>(n)))) return ptrdiff_t(-1);
+        g_sink = g_sink + static_cast<uint64_t>(f.GetChar(Bridge::FixTag::ExecType) + f.GetInt(Bridge::FixTag::CumQty) +
+                                                f.Get(Bridge::FixTag::ClOrdID).size() + f.Get(Bridge::FixTag::LeavesQty).size());
+        return n;
+    });
+    Bridge::FixDecoder decoder;
+    BenchDecode("ExecutionReport FixDecoder", reports, kReports, 200, [&](std::string_view buf) {
+        ptrdiff_t n = decoder.Decode(buf);
+        if (n <= 0) return n;
+        g_sink = g_sink + static_cast<uint64_t>(decoder.GetChar(Bridge::FixTag::ExecType) +
+                                                decoder.GetInt(Bridge::FixTag::CumQty) +
+                                                decoder.Get(Bridge::FixTag::ClOrdID).size() +
+                                                decoder.Get(Bridge::FixTag::LeavesQty).size());
+        return n;
+    });
+    RunBench("FixByteSum 4 KB", 200000, [&](uint64_t i) {
+        g_sink = g_sink + Bridge::FixByteSum(reports.data() + (i & 63), 4096);
+    });
+
+    // Keeping a sent order for resend: a copy into the mapped ring, no syscall.
+    {
+        std::filesystem::path path = std::filesystem::temp_directory_path() / "bridge_bench_fix.store";
+        std::filesystem::remove(path);
+        Bridge::FixSessionStore store;
+        if (store.Open(path.string(), "CLIENT", "SERVER")) {
+            std::string_view order = std::string_view(reports).substr(0, 200);
+            uint64_t seq = 0;
+            RunBench("FixSessionStore::Store 200 B + sequence", 2000000, [&](uint64_t) {
+                store.Store(++seq, order);
+                store.SetNextOutgoing(seq + 1);
+            });
+            g_sink = g_sink + store.Find(seq).size();
+            store.Close();
+        }
+        std::filesystem::remove(path);
+    }
+
+    DrainAcceptor acceptor;
+    Bridge::FixSettings s;
+    s.port = acceptor.Port();
+    Bridge::FixAdapter fix(s);
+    for (int i = 0; i < 200 && !fix.IsConnected(); ++i)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    if (!fix.IsConnected()) {
+        printf("  loopback logon failed\n");
+        return;
+    }
+    RunBench("FixAdapter::Execute PLACE (encode + write)", 200000, [&](uint64_t) {
+        g_sink = g_sink + static_cast<uint64_t>(fix.Execute(req) + 100);
+    });
+
+    Bridge::OrderRequest batch[16];
+    for (auto& r : batch) r = req;
+    int results[16];
+    double ns = RunBench("FixAdapter::ExecuteBatch x16 (one write)", 20000, [&](uint64_t) {
+        fix.ExecuteBatch(batch, 16, results);
+        g_sink = g_sink + static_cast<uint64_t>(results[0] + 100);
+    });
+    printf("  %-44s %10.2f ns/order\n", "  per order", ns / 16);
+}
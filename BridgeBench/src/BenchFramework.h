@@ -0,0 +1,20 @@
+// BenchFramework shared declarations (included by bench files, not compiled separately)
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+// Results are folded into this sink so the optimiser cannot drop the work.
+extern volatile uint64_t g_sink;
+
+// Time 'iters' calls of fn(i) after a short warm-up; prints and returns ns/op.
+template <typename Fn>
+double RunBench(const char* name, uint64_t iters, Fn&& fn) {
+    for (uint64_t i = 0; i < iters / 10; ++i) fn(i);
+    auto t0 = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < iters; ++i) fn(i);
+    auto t1 = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / static_cast<double>(iters);
+    printf("  %-44s %10.2f ns/op  (%llu ops)\n", name, ns, static_cast<unsigned long long>(iters));
+    return ns;
+}
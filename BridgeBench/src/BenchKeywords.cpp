@@ -0,0 +1,66 @@
+#include "BenchFramework.h"
+#include "../../BridgeCore/include/Keywords.h"
+#include "../../BridgeCore/include/Validation.h"
+#include <algorithm>
+#include <cctype>
+#include <string>
+
+namespace {
+
+// Baseline: the upper-case-copy + compare-chain parsers this table replaced.
+std::string LegacyToUpper(const std::string& s) {
+    std::string r = s;
+    std::transform(r.begin(), r.end(), r.begin(),
+        [](unsigned char c){ return static_cast<char>(std::toupper(c)); });
+    return r;
+}
+
+int LegacyLookup(const std::string& s) {
+    std::string u = LegacyToUpper(s);
+    if (u == "PLACE")             return 0;
+    if (u == "CANCEL")            return 1;
+    if (u == "CANCELALLORDERS")   return 2;
+    if (u == "CHANGE")            return 3;
+    if (u == "CLOSEPOSITION")     return 4;
+    if (u == "CLOSESTRATEGY")     return 5;
+    if (u == "FLATTENEVERYTHING") return 6;
+    if (u == "REVERSEPOSITION")   return 7;
+    if (u == "BUY")               return 8;
+    if (u == "SELL")              return 9;
+    if (u == "MARKET")            return 10;
+    if (u == "LIMIT")             return 11;
+    if (u == "STOPMARKET")        return 12;
+    if (u == "STOPLIMIT")         return 13;
+    if (u == "DAY")               return 14;
+    if (u == "GTC")               return 15;
+    return -1;
+}
+
+// Tokens in the proportions a PLACE payload produces them, plus misses.
+const std::string kTokens[] = {
+    "PLACE", "buy", "LIMIT", "DAY", "CANCEL", "Sell", "STOPLIMIT", "GTC",
+    "REVERSEPOSITION", "MARKET", "accountId", "FLATTENEVERYTHING",
+    "timeInForce", "quantity", "limitPrice", "stopPrice",
+};
+constexpr size_t kTokenCount = sizeof(kTokens) / sizeof(kTokens[0]);
+
+} // anonymous namespace
+
+void BenchKeywords() {
+    const uint64_t iters = 4000000;
+
+    double before = RunBench("legacy ToUpper + compare chain", iters, [](uint64_t i) {
+        g_sink = g_sink + static_cast<uint64_t>(LegacyLookup(kTokens[i % kTokenCount]));
+    });
+
+    double after = RunBench("perfect-hash LookupKeyword", iters, [](uint64_t i) {
+        const Bridge::Keyword* k = Bridge::LookupKeyword(kTokens[i % kTokenCount]);
+        g_sink = g_sink + (k ? k->value : 0xFFu);
+    });
+
+    RunBench("ParseCommand (string_view)", iters, [](uint64_t i) {
+        g_sink = g_sink + static_cast<uint64_t>(Bridge::ParseCommand(kTokens[i % kTokenCount]));
+    });
+
+    printf("  speed-up: %.1fx per token\n", before / after);
+}
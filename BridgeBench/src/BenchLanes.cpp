@@ -0,0 +1,68 @@
+#include "BenchFramework.h"
+#include "../../BridgeCore/include/BridgeEngine.h"
+#include "../../BridgeCore/include/MockAdapter.h"
+#include "../../BridgeCore/include/Config.h"
+#include "../../BridgeCore/include/Types.h"
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr int kAccounts = 16;
+constexpr int kOrders   = 4000;
+
+// Push kOrders async orders spread over kAccounts through an engine with
+// 'lanes' execution lanes and wait for the last one. Returns orders/sec.
+double Throughput(int lanes, std::chrono::microseconds latency) {
+    Bridge::BridgeConfig cfg;
+    cfg.adapterType     = "MOCK";
+    cfg.executionLanes  = lanes;
+    cfg.asyncQueueDepth = 4096;
+    auto mock = std::make_shared<Bridge::MockAdapter>();
+    mock->SetLatency(latency);
+    Bridge::BridgeEngine engine(cfg, mock);
+
+    std::vector<Bridge::OrderRequest> reqs(kAccounts);
+    for (int a = 0; a < kAccounts; ++a) {
+        Bridge::OrderRequest& r = reqs[a];
+        r.command     = Bridge::Command::PLACE;
+        r.account     = "BENCH" + std::to_string(a);
+        r.instrument  = "ES";
+        r.action      = Bridge::Action::BUY;
+        r.quantity    = 1;
+        r.orderType   = Bridge::OrderType::MARKET;
+        r.timeInForce = Bridge::TimeInForce::DAY;
+    }
+
+    std::vector<int> tickets;
+    tickets.reserve(kOrders);
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < kOrders; ++i) {
+        int t;
+        while ((t = engine.ExecuteAsync(reqs[i % kAccounts])) == Bridge::RC_QUEUE_FULL)
+            std::this_thread::yield();
+        tickets.push_back(t);
+    }
+    for (int t : tickets)
+        while (engine.PollResult(t) == Bridge::RC_PENDING) std::this_thread::yield();
+    auto t1 = std::chrono::steady_clock::now();
+    return kOrders / std::chrono::duration<double>(t1 - t0).count();
+}
+
+} // anonymous namespace
+
+void BenchLanes() {
+    for (long long us : { 0LL, 50LL }) {
+        printf("  mock latency %lldus, %d orders over %d accounts\n", us, kOrders, kAccounts);
+        double base = 0.0;
+        for (int lanes : { 1, 2, 4, 8 }) {
+            double ops = Throughput(lanes, std::chrono::microseconds(us));
+            if (lanes == 1) base = ops;
+            printf("    %d lane(s): %12.0f orders/s  (%.2fx)\n", lanes, ops, ops / base);
+            g_sink = g_sink + static_cast<uint64_t>(ops);
+        }
+    }
+}
@@ -0,0 +1,43 @@
+#include "BenchFramework.h"
+#include "../../BridgeCore/include/LatencyStats.h"
+#include "../../BridgeCore/include/SharedStats.h"
+#include "../../BridgeCore/include/Types.h"
+
+namespace {
+
+constexpr uint64_t kIters = 2000000;
+
+// The instrumentation one DLL export adds: a scope, the command and adapter
+// tags and five stage marks.
+void Instrumented(uint64_t i, uint8_t adapter) {
+    Bridge::LatencyScope scope;
+    Bridge::LatencyScope::Mark(Bridge::Stage::Convert);
+    Bridge::LatencyScope::Mark(Bridge::Stage::Parse);
+    Bridge::LatencyScope::SetCommand(Bridge::Command::PLACE);
+    Bridge::LatencyScope::Mark(Bridge::Stage::Validate);
+    Bridge::LatencyScope::SetAdapter(adapter);
+    Bridge::LatencyScope::Mark(Bridge::Stage::Dispatch);
+    g_sink = g_sink + i;
+    Bridge::LatencyScope::Mark(Bridge::Stage::Adapter);
+}
+
+} // namespace
+
+void BenchLatency() {
+    uint8_t adapter = Bridge::LatencyAdapterId("BENCH");
+
+    RunBench("no instrumentation", kIters, [](uint64_t i) { g_sink = g_sink + i; });
+
+    Bridge::LatencySetEnabled(true);
+    RunBench("scope + 5 marks (enabled)", kIters, [&](uint64_t i) { Instrumented(i, adapter); });
+
+    Bridge::LatencySetEnabled(false);
+    RunBench("scope + 5 marks (latencyStats=false)", kIters, [&](uint64_t i) { Instrumented(i, adapter); });
+    Bridge::LatencySetEnabled(true);
+
+    RunBench("CountRequest (shared stats)", kIters, [](uint64_t i) {
+        Bridge::CountRequest(Bridge::Command::PLACE, static_cast<int>(i & 1));
+    });
+
+    RunBench("LatencyReport()", 200, [](uint64_t) { g_sink = g_sink + Bridge::LatencyReport().size(); });
+}
@@ -0,0 +1,156 @@
+#include "BenchFramework.h"
+#include "../../BridgeCore/include/LogEvent.h"
+#include "../../BridgeCore/include/Logger.h"
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr int kLines   = 200000;
+constexpr int kThreads = 4;
+
+using Clock = std::chrono::steady_clock;
+
+// The logger as it was: timestamp, concatenate, lock, write and flush on the
+// calling thread.
+class SyncLogger {
+public:
+    explicit SyncLogger(const std::string& path) : m_file(path, std::ios::app) {}
+
+    void Log(const std::string& message) {
+        auto now = std::chrono::system_clock::now();
+        std::time_t t = std::chrono::system_clock::to_time_t(now);
+        char buf[32] = {};
+        struct tm tm_info;
+#ifdef _WIN32
+        localtime_s(&tm_info, &t);
+#else
+        localtime_r(&t, &tm_info);
+#endif
+        std::strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S", &tm_info);
+        std::string line = std::string("[") + buf + "] [INFO ] " + message + "\n";
+        std::lock_guard<std::mutex> lk(m_mutex);
+        m_file << line << std::flush;
+    }
+
+private:
+    std::mutex    m_mutex;
+    std::ofstream m_file;
+};
+
+// Time each of kLines calls of log(i) on 'threads' threads and print the
+// per-call latency the calling (strategy) threads see.
+template <typename Fn>
+void Measure(const char* name, int threads, Fn&& log) {
+    std::vector<std::vector<int64_t>> perThread(threads);
+    Clock::time_point start = Clock::now();
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; ++t) {
+        pool.emplace_back([&, t] {
+            std::vector<int64_t>& ns = perThread[t];
+            ns.reserve(kLines / threads);
+            for (int i = 0; i < kLines / threads; ++i) {
+                Clock::time_point t0 = Clock::now();
+                log(i);
+                ns.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t0).count());
+            }
+        });
+    }
+    for (std::thread& th : pool) th.join();
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::vector<int64_t> all;
+    for (const auto& v : perThread) all.insert(all.end(), v.begin(), v.end());
+    std::sort(all.begin(), all.end());
+    auto pct = [&](double q) { return static_cast<double>(all[static_cast<size_t>(q * (all.size() - 1))]); };
+    printf("  %-34s %dT %9.0f lines/s  p50 %7.0f  p99 %8.0f  p99.9 %9.0f  max %9.0f ns\n", name, threads,
+           all.size() / seconds, pct(0.50), pct(0.99), pct(0.999), static_cast<double>(all.back()));
+    g_sink = g_sink + all.size();
+}
+
+std::string Message(int i) {
+    return "[PLACE_ORDER] #" + std::to_string(i) + " Execute returned rc=0 account=SIM1 instrument=ESZ26";
+}
+
+constexpr Bridge::LogFormat kPlaceOrder("[REQ-{:04}] PLACE_ORDER called command={} account={} instrument={}"
+                                        " action={} quantity={} orderType={} limitPrice={} stopPrice={} tif={}");
+
+// BridgeTS's PLACE_ORDER line, built the way it was before LogEvent.
+void LogPlaceOrderConcat(int i) {
+    char tag[32];
+    snprintf(tag, sizeof(tag), "[REQ-%04u]", static_cast<unsigned>(i));
+    Bridge::LogInfo(std::string(tag) + " PLACE_ORDER called"
+        " command=" + std::string("PLACE") +
+        " account=" + std::string("SIM1") +
+        " instrument=" + std::string("ESZ26") +
+        " action=" + std::string("BUY") +
+        " quantity=" + std::to_string(2) +
+        " orderType=" + std::string("LIMIT") +
+        " limitPrice=" + std::to_string(4500.25 + i % 8) +
+        " stopPrice=" + std::to_string(0.0) +
+        " tif=" + std::string("DAY"));
+}
+
+void LogPlaceOrderEvent(int i) {
+    Bridge::LogEvent(Bridge::LogLevel::INFO, kPlaceOrder, static_cast<unsigned>(i), "PLACE", "SIM1", "ESZ26",
+                     "BUY", 2, "LIMIT", 4500.25 + i % 8, 0.0, "DAY");
+}
+
+} // namespace
+
+void BenchLogging() {
+    namespace fs = std::filesystem;
+    fs::path dir = fs::temp_directory_path() / "bridge_bench_logging";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+
+    printf("  %d lines per run, per-call latency on the logging threads\n", kLines);
+    for (int threads : { 1, kThreads }) {
+        SyncLogger sync((dir / ("sync" + std::to_string(threads) + ".log")).string());
+        Measure("sync: lock + flush per line", threads, [&](int i) { sync.Log(Message(i)); });
+
+        Bridge::LogOptions o;
+        o.filePath      = (dir / ("async" + std::to_string(threads) + ".log")).string();
+        o.blockWhenFull = true;
+        Bridge::LogInit(o);
+        Measure("async, block when full", threads, [](int i) { Bridge::LogInfo(Message(i)); });
+        Bridge::LogFlush();
+
+        o.filePath      = (dir / ("drop" + std::to_string(threads) + ".log")).string();
+        o.blockWhenFull = false;
+        Bridge::LogInit(o);
+        uint64_t dropped = Bridge::LogDropped();
+        Measure("async, drop when full", threads, [](int i) { Bridge::LogInfo(Message(i)); });
+        Bridge::LogFlush();
+        printf("  %-34s %llu line(s) dropped\n", "", static_cast<unsigned long long>(Bridge::LogDropped() - dropped));
+    }
+
+    printf("  PLACE_ORDER line, %d per run, blocking when full\n", kLines);
+    Bridge::LogOptions o;
+    o.blockWhenFull = true;
+    o.filePath      = (dir / "concat.log").string();
+    Bridge::LogInit(o);
+    Measure("concat + to_string, text log", 1, LogPlaceOrderConcat);
+    Bridge::LogFlush();
+    o.filePath = (dir / "event.log").string();
+    Bridge::LogInit(o);
+    Measure("LogEvent, text log", 1, LogPlaceOrderEvent);
+    Bridge::LogFlush();
+    o.binary = true;
+    Bridge::LogInit(o);
+    Measure("LogEvent, binary log", 1, LogPlaceOrderEvent);
+    Bridge::LogFlush();
+    printf("  %-34s text %llu bytes, binary %llu bytes\n", "",
+           static_cast<unsigned long long>(fs::file_size(dir / "event.log")),
+           static_cast<unsigned long long>(fs::file_size(dir / "event.blog")));
+
+    Bridge::LogInit("", false);
+    fs::remove_all(dir);
+}
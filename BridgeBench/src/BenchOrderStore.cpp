@@ -0,0 +1,86 @@
+#include "BenchFramework.h"
+#include "../../BridgeCore/include/OrderStore.h"
+#include "../../BridgeCore/include/Types.h"
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Baseline: the MockAdapter layout before OrderStore - one vector of every
+// order ever placed, scanned on each cancel, ids built with a stream.
+struct LegacyOrder {
+    std::string       orderId;
+    Bridge::SymbolId  account;
+    Bridge::SymbolId  instrument;
+    int               quantity;
+    bool              working;
+};
+
+struct LegacyStore {
+    std::vector<LegacyOrder> orders;
+    int nextId = 1;
+
+    void Add(Bridge::SymbolId account, Bridge::SymbolId instrument, int qty) {
+        std::ostringstream oss;
+        oss << "MOCK-" << nextId++;
+        orders.push_back(LegacyOrder{ oss.str(), account, instrument, qty, true });
+    }
+    void Cancel(Bridge::SymbolId account, Bridge::SymbolId instrument) {
+        for (auto& o : orders)
+            if (o.account == account && o.instrument == instrument && o.working)
+                o.working = false;
+    }
+};
+
+constexpr int              kHistory    = 1000000;
+constexpr Bridge::SymbolId kAccounts   = 8;
+constexpr Bridge::SymbolId kContracts  = 64;
+
+Bridge::OrderRequest MakeReq() {
+    Bridge::OrderRequest r;
+    r.command     = Bridge::Command::PLACE;
+    r.action      = Bridge::Action::BUY;
+    r.quantity    = 1;
+    r.orderType   = Bridge::OrderType::LIMIT;
+    r.timeInForce = Bridge::TimeInForce::DAY;
+    return r;
+}
+
+} // anonymous namespace
+
+void BenchOrderStore() {
+    printf("  %d historical (cancelled) orders, then place + cancel one order\n", kHistory);
+    Bridge::OrderRequest req = MakeReq();
+
+    LegacyStore legacy;
+    legacy.orders.reserve(kHistory + 1000);
+    for (int i = 0; i < kHistory; ++i) {
+        Bridge::SymbolId a = 1 + i % kAccounts, c = 100 + i % kContracts;
+        legacy.Add(a, c, 1);
+        legacy.orders.back().working = false;
+    }
+    Bridge::OrderStore store;
+    for (int i = 0; i < kHistory; ++i) {
+        Bridge::SymbolId a = 1 + i % kAccounts, c = 100 + i % kContracts;
+        store.Add(req, a, c);
+        store.CancelWorking(a, c);
+    }
+    // A few resting orders on other keys, as a live strategy would have.
+    for (Bridge::SymbolId c = 100; c < 100 + kContracts; c += 2) {
+        legacy.Add(2, c, 1);
+        store.Add(req, 2, c);
+    }
+
+    double before = RunBench("legacy vector scan", 200, [&](uint64_t) {
+        legacy.Add(1, 101, 1);
+        legacy.Cancel(1, 101);
+        g_sink = g_sink + legacy.orders.size();
+    });
+    double after = RunBench("OrderStore (indexed)", 200000, [&](uint64_t) {
+        store.Add(req, 1, 101);
+        g_sink = g_sink + store.CancelWorking(1, 101);
+    });
+    printf("  working slots in use: %zu, archived: %zu\n", store.SlotCount(), store.ArchivedCount());
+    printf("  speed-up: %.0fx\n", before / after);
+}
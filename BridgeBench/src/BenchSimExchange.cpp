@@ -0,0 +1,103 @@
+#include "BenchFramework.h"
+#include "../../BridgeCore/include/SimExchangeAdapter.h"
+#include "../../BridgeCore/include/MarketDataFeed.h"
+#include "../../BridgeCore/include/Types.h"
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+namespace {
+
+constexpr int kEvents = 2000000;     // roughly a day of top-of-book ES updates
+constexpr int kChunk  = 256;         // events replayed between strategy actions
+
+// Synthetic ES session: a quarter-point random walk, three quotes per trade.
+std::string MakeSession() {
+    std::string text;
+    text.reserve(static_cast<size_t>(kEvents) * 40);
+    uint64_t rng  = 0x9E3779B97F4A7C15ull;
+    long     bidQ = 5000 * 4;          // price in quarter points
+    uint64_t t    = 34200000000ull;    // 09:30 in microseconds
+    char line[96];
+    for (int i = 0; i < kEvents; ++i) {
+        rng ^= rng << 13; rng ^= rng >> 7; rng ^= rng << 17;
+        t += 1 + rng % 20000;
+        int n;
+        if (i % 4 == 3) {
+            long px = (rng & 1) ? bidQ + 1 : bidQ;
+            n = snprintf(line, sizeof(line), "%llu,T,ES,%ld.%02ld,%d\n",
+                         static_cast<unsigned long long>(t), px / 4, (px % 4) * 25,
+                         1 + static_cast<int>((rng >> 8) % 20));
+        } else {
+            if ((rng >> 16) % 3 == 0) bidQ += ((rng >> 20) & 1) ? 1 : -1;
+            long askQ = bidQ + 1;
+            n = snprintf(line, sizeof(line), "%llu,Q,ES,%ld.%02ld,%d,%ld.%02ld,%d\n",
+                         static_cast<unsigned long long>(t), bidQ / 4, (bidQ % 4) * 25,
+                         5 + static_cast<int>((rng >> 24) % 60), askQ / 4, (askQ % 4) * 25,
+                         5 + static_cast<int>((rng >> 32) % 60));
+        }
+        text.append(line, static_cast<size_t>(n));
+    }
+    return text;
+}
+
+} // anonymous namespace
+
+void BenchSimExchange() {
+    std::string text = MakeSession();
+    Bridge::MarketDataFeed feed;
+
+    auto t0 = std::chrono::steady_clock::now();
+    int rc = feed.Parse(text);
+    auto t1 = std::chrono::steady_clock::now();
+    double parseSec = std::chrono::duration<double>(t1 - t0).count();
+    if (rc != Bridge::RC_SUCCESS) {
+        printf("  feed parse failed at line %zu\n", feed.ErrorLine());
+        return;
+    }
+    printf("  parse   %d events (%.1f MB): %8.3f s  (%.1f M events/s)\n",
+           kEvents, text.size() / 1e6, parseSec, kEvents / parseSec / 1e6);
+
+    // Replay with a strategy quoting around the touch: a limit order each
+    // side every chunk, a market order every 8th, everything cancelled
+    // every 64th.
+    Bridge::SimExchangeAdapter sim;
+    uint64_t reports = 0;
+    sim.SetExecutionSink([&](const Bridge::ExecutionReport&) { ++reports; });
+
+    Bridge::OrderRequest buy, sell, flat;
+    for (Bridge::OrderRequest* r : { &buy, &sell, &flat }) {
+        r->command     = Bridge::Command::PLACE;
+        r->account     = "BENCH";
+        r->instrument  = "ES";
+        r->quantity    = 2;
+        r->orderType   = Bridge::OrderType::LIMIT;
+        r->timeInForce = Bridge::TimeInForce::DAY;
+    }
+    buy.action  = Bridge::Action::BUY;
+    sell.action = Bridge::Action::SELL;
+    flat.command = Bridge::Command::CLOSEPOSITION;
+
+    t0 = std::chrono::steady_clock::now();
+    size_t orders = 0;
+    for (size_t i = 0, c = 0; i < feed.Size(); i += kChunk, ++c) {
+        sim.Replay(feed, i, kChunk);
+        const Bridge::MarketEvent& ev = feed.Events()[i];
+        double mid = static_cast<double>(ev.price) / 1e6;
+        buy.limitPrice  = mid - 0.50;
+        sell.limitPrice = mid + 0.75;
+        buy.orderType   = (c % 8 == 7) ? Bridge::OrderType::MARKET : Bridge::OrderType::LIMIT;
+        sim.Execute(buy);
+        sim.Execute(sell);
+        orders += 2;
+        if (c % 64 == 63) { sim.Execute(flat); ++orders; }
+    }
+    t1 = std::chrono::steady_clock::now();
+    double replaySec = std::chrono::duration<double>(t1 - t0).count();
+    printf("  replay  %d events, %zu requests:    %8.3f s  (%.1f M events/s)\n",
+           kEvents, orders, replaySec, kEvents / replaySec / 1e6);
+    printf("  fills %llu, execution reports %llu, still working %zu\n",
+           static_cast<unsigned long long>(sim.FillCount()),
+           static_cast<unsigned long long>(reports), sim.WorkingCount());
+    g_sink = g_sink + reports;
+}
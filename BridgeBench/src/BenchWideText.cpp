@@ -0,0 +1,48 @@
+#include "BenchFramework.h"
+#include "../../BridgeCore/include/WideText.h"
+#include <string>
+
+namespace {
+
+// Baseline: the per-character append BuildRequest used before NarrowWide.
+std::string LegacyNarrow(const wchar_t* w) {
+    std::string s;
+    while (*w) { s += static_cast<char>(*w++); }
+    return s;
+}
+
+const wchar_t* kField   = L"ESH26";
+const wchar_t* kPayload =
+    L"command=PLACE|account=ACC001|instrument=ESH26|action=BUY|quantity=1|"
+    L"orderType=LIMIT|limitPrice=4900.25|stopPrice=0|timeInForce=DAY";
+const wchar_t* kAccented =
+    L"command=PLACE|account=Soci\u00e9t\u00e9G\u00e9n\u00e9rale|instrument=FESX|action=BUY";
+
+} // anonymous namespace
+
+void BenchWideText() {
+    const uint64_t iters = 2000000;
+    printf("  NarrowWide compiled for %s\n", Bridge::NarrowWideIsa());
+
+    RunBench("legacy append, 5-char field", iters, [](uint64_t) {
+        g_sink = g_sink + LegacyNarrow(kField).size();
+    });
+    RunBench("NarrowWide, 5-char field", iters, [](uint64_t) {
+        char buf[64];
+        g_sink = g_sink + Bridge::NarrowWide(kField, buf, sizeof(buf));
+    });
+
+    double before = RunBench("legacy append, 133-char payload", iters, [](uint64_t) {
+        g_sink = g_sink + LegacyNarrow(kPayload).size();
+    });
+    double after = RunBench("NarrowWide, 133-char payload", iters, [](uint64_t) {
+        char buf[1024];
+        g_sink = g_sink + Bridge::NarrowWide(kPayload, buf, sizeof(buf));
+    });
+    RunBench("NarrowWide, non-ASCII payload (UTF-8 path)", iters, [](uint64_t) {
+        char buf[1024];
+        g_sink = g_sink + Bridge::NarrowWide(kAccented, buf, sizeof(buf));
+    });
+
+    printf("  speed-up on payload: %.1fx\n", before / after);
+}
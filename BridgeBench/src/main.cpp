@@ -0,0 +1,48 @@
+#include "BenchFramework.h"
+#include <cstring>
+
+volatile uint64_t g_sink = 0;
+
+// Forward declarations for benchmark groups
+void BenchKeywords();
+void BenchWideText();
+void BenchLanes();
+void BenchOrderStore();
+void BenchSimExchange();
+void BenchFaults();
+void BenchLogging();
+void BenchLatency();
+void BenchFix();
+void BenchDotNet();
+
+struct BenchGroup {
+    const char* name;
+    void      (*fn)();
+};
+
+static const BenchGroup kGroups[] = {
+    { "keywords", BenchKeywords },
+    { "widetext", BenchWideText },
+    { "lanes",    BenchLanes    },
+    { "orders",   BenchOrderStore },
+    { "sim",      BenchSimExchange },
+    { "faults",   BenchFaults   },
+    { "logging",  BenchLogging  },
+    { "latency",  BenchLatency  },
+    { "fix",      BenchFix      },
+    { "dotnet",   BenchDotNet   },
+};
+
+// Usage: BridgeBench [group ...]   (no arguments runs every group)
+int main(int argc, char** argv) {
+    printf("=== BridgeBench ===\n");
+    for (const BenchGroup& g : kGroups) {
+        bool selected = (argc < 2);
+        for (int i = 1; i < argc; ++i)
+            if (std::strcmp(argv[i], g.name) == 0) selected = true;
+        if (!selected) continue;
+        printf("\n-- %s --\n", g.name);
+        g.fn();
+    }
+    return 0;
+}
@@ -0,0 +1,22 @@
+#pragma once
+#include "IBrokerAdapter.h"
+#include "Config.h"
+#include <memory>
+#include <string>
+
+namespace Bridge {
+
+// Create the adapter named by BridgeConfig::adapterType ("MOCK", "SIM", "FIX",
+// "DOTNET"). Unknown names fall back to MOCK, as the engine always has. FIX
+// and DOTNET get their default settings; CreateAdapter(cfg) uses the fix*
+// keys and pipeName/dotnetTimeoutMs.
+std::shared_ptr<IBrokerAdapter> CreateAdapter(const std::string& adapterType);
+
+// Adapter for a whole configuration: the adapterType adapter, wrapped in a
+// FaultInjectingAdapter when any fault* setting is active.
+std::shared_ptr<IBrokerAdapter> CreateAdapter(const BridgeConfig& cfg);
+
+// True if a and b would build different adapters.
+bool AdapterSettingsDiffer(const BridgeConfig& a, const BridgeConfig& b) noexcept;
+
+} // namespace Bridge
@@ -0,0 +1,104 @@
+#pragma once
+#include "Logger.h"
+#include "MappedFile.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace Bridge {
+
+// The binary log written when logFormat is BINARY, decoded by BridgeLogcat.
+//
+// Layout: an 8-byte file header ("BRLOG001"), then records, each a type
+// byte followed by its fields in native byte order:
+//   Anchor  wallNs:i64 steadyNs:i64          maps steady-clock stamps to wall time
+//   Format  id:u16 len:u16 text              numbers a format before its first event
+//   Event   steadyNs:i64 level:u8 id:u16 size:u8 args   (args as in LogArgs)
+//   Text    steadyNs:i64 level:u8 len:u32 text          a plain Log() line
+// An Anchor also retires every format sent before it, so a process that
+// appends to an existing file starts a fresh dictionary.
+namespace BinaryLog {
+
+constexpr char    kMagic[8]  = { 'B', 'R', 'L', 'O', 'G', '0', '0', '1' };
+constexpr uint8_t kAnchor    = 'A';
+constexpr uint8_t kFormat    = 'F';
+constexpr uint8_t kEvent     = 'E';
+constexpr uint8_t kText      = 'T';
+
+template <typename T>
+inline void Put(std::string& out, T v) {
+    char raw[sizeof(T)];
+    std::memcpy(raw, &v, sizeof(T));
+    out.append(raw, sizeof(T));
+}
+
+inline void AppendAnchor(std::string& out, int64_t wallNs, int64_t steadyNs) {
+    Put(out, kAnchor);
+    Put(out, wallNs);
+    Put(out, steadyNs);
+}
+
+inline void AppendFormat(std::string& out, uint16_t id, std::string_view text) {
+    if (text.size() > UINT16_MAX) text = text.substr(0, UINT16_MAX);
+    Put(out, kFormat);
+    Put(out, id);
+    Put(out, static_cast<uint16_t>(text.size()));
+    out.append(text);
+}
+
+inline void AppendEvent(std::string& out, int64_t steadyNs, LogLevel level, uint16_t id,
+                        const unsigned char* args, uint8_t size) {
+    Put(out, kEvent);
+    Put(out, steadyNs);
+    Put(out, static_cast<uint8_t>(level));
+    Put(out, id);
+    Put(out, size);
+    out.append(reinterpret_cast<const char*>(args), size);
+}
+
+inline void AppendText(std::string& out, int64_t steadyNs, LogLevel level, std::string_view text) {
+    Put(out, kText);
+    Put(out, steadyNs);
+    Put(out, static_cast<uint8_t>(level));
+    Put(out, static_cast<uint32_t>(text.size()));
+    out.append(text);
+}
+
+// Length of the well-formed prefix of a binary log: header and complete
+// records, stopping at a zero tail (preallocated space) or a torn record.
+// 0 if 'data' does not start with the header.
+size_t ValidLength(const char* data, size_t size) noexcept;
+
+} // namespace BinaryLog
+
+// One decoded log line.
+struct BinaryLogLine {
+    int64_t     wallNs = 0;   // ns since the Unix epoch
+    LogLevel    level  = LogLevel::INFO;
+    std::string text;
+};
+
+// Sequential reader over a binary log (which may still be being written).
+class BinaryLogReader {
+public:
+    // False if the file cannot be mapped or is not a binary log.
+    bool Open(const std::string& path) noexcept;
+
+    // Decode the next line; false at the end of the log or at a record that
+    // is cut short or damaged.
+    bool Next(BinaryLogLine& out);
+
+    size_t Offset() const noexcept { return m_offset; }
+
+private:
+    MappedFile m_file;
+    size_t     m_offset   = 0;
+    int64_t    m_wallNs   = 0;   // last anchor
+    int64_t    m_steadyNs = 0;
+    std::unordered_map<uint16_t, std::string> m_formats;
+};
+
+} // namespace Bridge
@@ -0,0 +1,111 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace Bridge {
+
+// Bounded lock-free multi-producer / multi-consumer ring (Vyukov's design).
+// Each cell carries a sequence number that tells producers and consumers
+// whether it is free or full for the lap they are on, so a push or pop is one
+// CAS on the shared position plus one release store on the cell. Capacity is
+// rounded up to a power of two. TryPush fails rather than blocks when full.
+template <typename T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(size_t capacity)
+        : m_mask(RoundUp(capacity) - 1),
+          m_cells(new Cell[m_mask + 1])
+    {
+        for (size_t i = 0; i <= m_mask; ++i)
+            m_cells[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    size_t Capacity() const noexcept { return m_mask + 1; }
+
+    // Elements queued at some recent moment. For monitoring only: it can be
+    // stale by the time it returns.
+    size_t SizeApprox() const noexcept {
+        size_t tail = m_dequeuePos.load(std::memory_order_relaxed);
+        size_t head = m_enqueuePos.load(std::memory_order_relaxed);
+        return head > tail ? std::min(head - tail, Capacity()) : 0;
+    }
+
+    bool TryPush(T&& value) {
+        return TryPush(std::move(value), [](T&) noexcept {});
+    }
+
+    // As TryPush, but calls onClaimed(element) once a cell is secured and
+    // before consumers can see it; nothing runs if the queue is full. Lets a
+    // producer hand out an id only for pushes that succeed. Must not throw.
+    template <typename F>
+    bool TryPush(T&& value, F&& onClaimed) {
+        size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &m_cells[pos & m_mask];
+            size_t seq = cell->seq.load(std::memory_order_acquire);
+            intptr_t dif = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (dif == 0) {
+                if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            } else if (dif < 0) {
+                return false;                               // full
+            } else {
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+        cell->value = std::move(value);
+        onClaimed(cell->value);
+        cell->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool TryPop(T& out) {
+        size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &m_cells[pos & m_mask];
+            size_t seq = cell->seq.load(std::memory_order_acquire);
+            intptr_t dif = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if (dif == 0) {
+                if (m_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            } else if (dif < 0) {
+                return false;                               // empty
+            } else {
+                pos = m_dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+        out = std::move(cell->value);
+        cell->seq.store(pos + m_mask + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> seq;
+        T                   value;
+    };
+
+    static size_t RoundUp(size_t n) noexcept {
+        size_t p = 2;
+        while (p < n) p <<= 1;
+        return p;
+    }
+
+    // Producers and consumers each hammer their own position; keep them on
+    // separate cache lines.
+    alignas(64) std::atomic<size_t> m_enqueuePos{ 0 };
+    alignas(64) std::atomic<size_t> m_dequeuePos{ 0 };
+    alignas(64) const size_t        m_mask;
+    std::unique_ptr<Cell[]>         m_cells;
+};
+
+} // namespace Bridge
@@ -2,26 +2,197 @@
 #include "IBrokerAdapter.h"
 #include "Config.h"
 #include "Types.h"
+#include "BoundedQueue.h"
+#include "ConfigStore.h"
+#include "ConfigWatcher.h"
+#include "DedupCache.h"
+#include "RequestJournal.h"
+#include "SharedStats.h"
+#include "TicketTable.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
 
 namespace Bridge {
 
 class BridgeEngine {
 public:
     explicit BridgeEngine(const BridgeConfig& cfg);
-    ~BridgeEngine() = default;
 
-    // Execute a fully-populated request.
+    // Use 'adapter' instead of the one cfg.adapterType names (tests, tools).
+    BridgeEngine(const BridgeConfig& cfg, std::shared_ptr<IBrokerAdapter> adapter);
+    ~BridgeEngine();
+
+    // Execute a fully-populated request. With journalPath set, every request
+    // that reaches Execute, ExecuteBatch or an async worker is appended to
+    // the request journal along with its return code.
     int Execute(const OrderRequest& req) noexcept;
 
+    // Submit already-validated requests through the adapter's batch path,
+    // writing one return code per request to 'results'.
+    void ExecuteBatch(const OrderRequest* reqs, size_t count, int* results) noexcept;
+
+    // Parse, validate and submit newline-separated pipe payloads in one pass.
+    // Blank lines are skipped. Writes one return code per payload to
+    // 'results' and returns the number of payloads, or RC_INVALID_PARAM
+    // (nothing submitted) if there are more than 'capacity'.
+    int ExecuteBatch(std::string_view payloads, int* results, int capacity) noexcept;
+
+    // Queue a validated request for the async workers and return its ticket
+    // (> 0) straight away, or RC_QUEUE_FULL. The workers are started on the
+    // first call. With asyncWorkers == 0 the request runs inline and the
+    // ticket is already complete.
+    //
+    // With executionLanes > 0 each account is pinned to one of that many
+    // lanes, each drained by a single thread: orders for one account run
+    // strictly in submission order while different accounts run in
+    // parallel. Adapters that are not IsShardSafe() get a single lane.
+    int ExecuteAsync(const OrderRequest& req) noexcept;
+
+    // Result for a ticket from ExecuteAsync: RC_PENDING while queued or
+    // executing, then the adapter's return code. RC_UNKNOWN_TICKET if the
+    // ticket was never issued or has been recycled. Lock-free.
+    int PollResult(int ticket) const noexcept;
+
     bool IsConnected() const noexcept;
 
+    // Number of async lanes in use; 0 until the first async submission.
+    size_t ExecutionLanes() const noexcept;
+
+    // Current configuration snapshot (one atomic load). The reference stays
+    // valid for the engine's lifetime, even after a reload replaces it.
+    const BridgeConfig& Config() const noexcept { return *m_config.Current(); }
+    uint64_t            ConfigVersion() const noexcept { return m_config.Version(); }
+
+    // Publish a new configuration. Log settings and dedupWindowMs apply
+    // immediately; a different adapterType or fault* setting swaps the
+    // adapter (see SwapAdapter) before anything is published, and if the new
+    // adapter cannot be created the whole reload is dropped. asyncWorkers, asyncQueueDepth and
+    // executionLanes are fixed at startup and keep their original values.
+    void ApplyConfig(const BridgeConfig& next);
+
+    // Replace the adapter. New requests go to 'adapter' at once; the call
+    // returns after every request already inside the old adapter has
+    // finished, and the old adapter is then released.
+    void SwapAdapter(std::shared_ptr<IBrokerAdapter> adapter);
+
+    // Reload 'path' with LoadConfig and ApplyConfig whenever it changes.
+    // Returns false if the file's directory cannot be watched.
+    bool WatchConfigFile(const std::string& path);
+
+    // Duplicate-suppression counters (see DedupCache).
+    uint64_t DedupHits()   const noexcept { return m_dedup.Hits(); }
+    uint64_t DedupMisses() const noexcept { return m_dedup.Misses(); }
+
+    // Requests written to the journal so far; 0 when journalPath is empty.
+    uint64_t JournaledRequests() const noexcept { return m_journal ? m_journal->Records() : 0; }
+
+    // Write LatencyReport() to the log, one line per row. No-op if empty.
+    static void LogLatencyReport(const char* title);
+
+    // Refresh the shared-memory stats segment now (the stats thread does it
+    // every statsPublishMs). No-op when statsSharedMemory is off.
+    void PublishStats() noexcept;
+
+    // Stop the config watcher, the stats thread and the async workers, log
+    // the totals and release the adapter along with its threads. Afterwards
+    // requests return RC_NOT_CONNECTED. Idempotent; the destructor calls it.
+    void Shutdown() noexcept;
+
 private:
-    std::shared_ptr<IBrokerAdapter> m_adapter;
-    BridgeConfig                    m_config;
+    struct AdapterSlot;
+    class  AdapterLease;
+
+    struct AsyncJob {
+        int          ticket     = 0;
+        int64_t      receivedNs = 0;   // journal timestamp; 0 when not journaling
+        OrderRequest req;
+    };
+
+    // One submission ring and the thread(s) draining it. Lanes mode has one
+    // thread per lane; the plain async pool is one lane with asyncWorkers.
+    struct Lane {
+        explicit Lane(size_t depth) : queue(depth) {}
+        BoundedQueue<AsyncJob>   queue;
+        std::atomic<uint32_t>    wake{ 0 };   // bumped on every push; workers wait on it
+        std::vector<std::thread> threads;
+    };
+
+    // SwapAdapter, with the latency stats under 'name' rather than the
+    // current config's adapterType.
+    void InstallAdapter(std::shared_ptr<IBrokerAdapter> adapter, const std::string& name);
+
+    void StartWorkers();
+    void StopWorkers() noexcept;
+    void WorkerLoop(Lane& lane) noexcept;
+
+    // Execute and ExecuteBatch without the journal. 'queued': run by an
+    // async worker (latency stats keep those apart).
+    int  ExecuteNow(const OrderRequest& req, bool queued = false) noexcept;
+    void ExecuteBatchNow(const OrderRequest* reqs, size_t count, int* results) noexcept;
+
+    // Journal timestamp for a request arriving now, and the record written
+    // once it completes. Both are no-ops without a journal.
+    int64_t JournalClock() const noexcept { return m_journal ? RequestJournal::NowNs() : 0; }
+    void    Journal(const OrderRequest& req, int64_t receivedNs, int rc, uint8_t flags) noexcept;
+
+    // Window a request is deduplicated over: bar-keyed requests until
+    // evicted, others per dedupWindowMs. 0 = not deduplicated.
+    int64_t DedupWindow(const OrderRequest& req) const noexcept;
+    bool    FindDuplicate(const OrderRequest& req, uint64_t key, int64_t nowMs, int& rc) noexcept;
+
+    // Publishes the stats segment every statsPublishMs and logs the latency
+    // report every statsDumpSeconds while it changes. Started only when
+    // 'cfg' gives it one of those to do; a reload may start it later.
+    void StartStatsThread(const BridgeConfig& cfg);
+    void StatsLoop() noexcept;
+
+    // The adapter is published like the config: readers lease the current
+    // slot with a counter, and a swap waits for the old slot's count to
+    // drain. Slots are retired, never freed, until the engine goes away.
+    std::atomic<AdapterSlot*>                 m_adapter{ nullptr };
+    std::vector<std::unique_ptr<AdapterSlot>> m_adapterSlots;   // guarded by m_swapMutex
+    std::mutex                                m_swapMutex;
+
+    ConfigStore   m_config;
+    const int     m_startupAsyncWorkers;
+    const int     m_startupQueueDepth;
+    const int     m_startupLanes;
+    std::mutex    m_reloadMutex;
+    ConfigWatcher m_watcher;
+
+    TicketTable                        m_tickets;
+    std::vector<std::unique_ptr<Lane>> m_lanes;           // fixed once m_workersStarted
+    std::atomic<size_t>                m_laneCount{ 0 };
+    std::once_flag                     m_workersStarted;
+    std::atomic<bool>                  m_stop{ false };
+
+    DedupCache                      m_dedup;
+    std::unique_ptr<RequestJournal> m_journal;   // fixed at startup from journalPath
+
+    std::mutex                          m_statsMutex;
+    std::condition_variable             m_statsWake;
+    bool                                m_statsStop = false;   // guarded by m_statsMutex
+    std::unique_ptr<SharedStatsSegment> m_statsSegment;        // fixed at startup from statsSharedMemory
+    std::unique_ptr<StatsSnapshot>      m_statsSnapshot;       // guarded by m_statsMutex
+    std::thread                         m_statsThread;         // guarded by m_statsMutex until joined
+    std::atomic<bool>                   m_shutDown{ false };
 };
 
 // Singleton accessor; initialised once on first call.
 BridgeEngine& GetEngine() noexcept;
 
+// Shut the GetEngine() engine down (if it was ever created) and stop the
+// log writer. For DLL hosts: call before unloading, so no thread is joined
+// from a static destructor under the loader lock. No other bridge call may
+// be in progress or follow.
+void ShutdownEngine() noexcept;
+
 } // namespace Bridge
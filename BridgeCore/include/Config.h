@@ -1,12 +1,54 @@
 #pragma once
+#include "Logger.h"
 #include <string>
 
 namespace Bridge {
 
 struct BridgeConfig {
-    std::string adapterType;   // "MOCK", "FIX", "DOTNET"
+    std::string adapterType;   // "MOCK", "SIM", "FIX", "DOTNET"
     std::string logFilePath;   // path to log file; default "logs/bridge.log"
     bool        logToConsole = false;
+    int         logFlushMs      = 200;   // longest a log line waits to be flushed; ERROR lines flush at once
+    int         logQueueDepth   = 8192;  // log lines that can wait for the writer thread; fixed at startup
+    bool        logBlockOnFull  = false; // logWhenFull "BLOCK": wait for room; "DROP" (default): count and drop
+    bool        logBinary       = false; // logFormat "BINARY": binary log for BridgeLogcat; "TEXT" (default)
+    LogLevel    logLevel        = LogLevel::INFO;   // lines below this level are discarded
+    int         logMaxSizeMb    = 0;     // start a new log segment at this size; 0 = no limit
+    int         logRotateMinutes = 0;    // start a new log segment after this long; 0 = never
+    int         logKeepSegments = 10;    // older log segments are deleted; 0 = keep all
+    int         asyncWorkers    = 1;     // threads draining the async queue; 0 = run async orders inline
+    int         asyncQueueDepth = 1024;  // async submission ring size (rounded up to a power of two)
+    int         executionLanes  = 0;     // >0: shard async orders by account onto this many ordered lanes
+    int         dedupWindowMs   = 0;     // suppress identical orders within this window; 0 = only by BARKEY
+    std::string journalPath;             // binary request journal (see RequestJournal.h); empty = off
+    bool        latencyStats    = true;  // per-stage latency histograms (see LatencyStats.h)
+    int         statsDumpSeconds = 60;   // log the latency report this often; 0 = never
+    std::string statsSharedMemory;       // shared-memory stats segment (see SharedStats.h); empty = off
+    int         statsPublishMs  = 1000;  // refresh the segment this often; 0 = never
+
+    // FIX 4.2 session for adapterType "FIX" (see FixAdapter.h).
+    std::string fixHost             = "127.0.0.1";
+    int         fixPort             = 9876;
+    std::string fixSenderCompId     = "CLIENT";
+    std::string fixTargetCompId     = "SERVER";
+    int         fixHeartbeatSeconds = 30;
+    int         fixAckTimeoutMs     = 0;      // > 0: Execute waits for the broker's answer
+    std::string fixStorePath;                 // session store (see FixSessionStore.h); empty = reset at each logon
+
+    // Market data for adapterType "SIM" (see SimExchangeAdapter.h).
+    std::string simFeedPath;                  // replayed at its recorded pace; empty = orders never fill
+
+    // BridgeDotNetWorker pipe for adapterType "DOTNET" (see DotNetAdapter.h).
+    std::string pipeName        = "BridgeT4Pipe";
+    int         dotnetTimeoutMs = 5000;      // Execute waits this long for the worker's answer
+
+    // Fault injection around the adapter, for load testing (see FaultInjectingAdapter.h).
+    std::string faultLatency;                 // "fixed:<us>", "uniform:<min>-<max>", "lognormal:<median>,<sigma>", "histogram:<path>"
+    double      faultRejectRate        = 0.0; // 0..1
+    int         faultTimeoutMs         = 0;
+    int         faultDisconnectEveryMs = 0;
+    int         faultDisconnectForMs   = 0;
+    int         faultSeed              = 0;   // 0 = random
 };
 
 // Load config from the given JSON file path.
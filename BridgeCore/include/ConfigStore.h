@@ -0,0 +1,43 @@
+#pragma once
+#include "Config.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Bridge {
+
+// Publishes BridgeConfig as immutable snapshots, RCU style. Readers take the
+// current snapshot with one atomic load and may keep using it for as long as
+// the store lives; Publish swaps in a new snapshot without blocking them.
+//
+// Superseded snapshots are retired, not freed: they stay allocated until
+// the store is destroyed, which is what lets readers skip any reference
+// counting. Reloads are rare (a human editing a file), so the retire list
+// stays tiny.
+class ConfigStore {
+public:
+    explicit ConfigStore(const BridgeConfig& initial);
+
+    ConfigStore(const ConfigStore&) = delete;
+    ConfigStore& operator=(const ConfigStore&) = delete;
+
+    const BridgeConfig* Current() const noexcept {
+        return m_current.load(std::memory_order_acquire);
+    }
+
+    // Publish 'next' and return the snapshot it replaced.
+    const BridgeConfig* Publish(const BridgeConfig& next);
+
+    // Number of snapshots published so far, starting at 1.
+    uint64_t Version() const noexcept { return m_version.load(std::memory_order_acquire); }
+
+private:
+    std::atomic<const BridgeConfig*>                m_current;
+    std::atomic<uint64_t>                           m_version{ 0 };
+    std::mutex                                      m_publishMutex;
+    std::vector<std::unique_ptr<const BridgeConfig>> m_snapshots;   // current + retired
+};
+
+} // namespace Bridge
@@ -0,0 +1,47 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+
+namespace Bridge {
+
+// Watches one file and calls 'onChange' on a background thread after it is
+// written, created or replaced (editors often save via rename). Bursts of
+// events are coalesced: the callback fires once the file has been quiet for
+// a short debounce interval.
+//
+// Uses inotify on Linux and ReadDirectoryChangesW on Windows, watching the
+// file's directory; elsewhere it polls the modification time.
+class ConfigWatcher {
+public:
+    ConfigWatcher() = default;
+    ~ConfigWatcher();
+
+    ConfigWatcher(const ConfigWatcher&) = delete;
+    ConfigWatcher& operator=(const ConfigWatcher&) = delete;
+
+    // Start watching 'path'. Returns false if its directory cannot be
+    // watched (e.g. does not exist) or a watch is already running.
+    bool Start(const std::string& path, std::function<void()> onChange);
+
+    // Stop watching; waits for the watcher thread. Safe to call repeatedly.
+    void Stop() noexcept;
+
+    bool IsRunning() const noexcept { return m_thread.joinable(); }
+
+private:
+    void Run();
+
+    std::string           m_dir;
+    std::string           m_name;
+    std::function<void()> m_onChange;
+    std::thread           m_thread;
+    std::atomic<bool>     m_stop{ false };
+    intptr_t              m_watchHandle = -1;   // inotify fd / directory HANDLE
+    intptr_t              m_stopHandle  = -1;   // pipe write end / stop event HANDLE
+    intptr_t              m_stopRead    = -1;   // pipe read end (Linux)
+};
+
+} // namespace Bridge
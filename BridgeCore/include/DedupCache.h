@@ -0,0 +1,54 @@
+#pragma once
+#include "Types.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace Bridge {
+
+// Hash of a caller-supplied bar key ("BARKEY=" in a payload). Never 0, so
+// 0 can mean "no bar key".
+uint64_t BarKeyOf(std::string_view key) noexcept;
+
+// Fixed-size, lock-free idempotency cache for order requests. A request is
+// reduced to a 64-bit key over its normalized fields (interned ids, exact
+// prices, bar key), and the cache remembers the return code it produced and
+// when. Lookups and inserts touch at most kProbe adjacent slots; a full
+// neighbourhood evicts its oldest entry.
+//
+// Best effort by design: two identical requests racing on different threads
+// may both miss. That is fine for the case it exists for, a strategy
+// re-sending the same order on every tick from one thread.
+class DedupCache {
+public:
+    static constexpr size_t kSlots = 4096;   // power of two
+    static constexpr size_t kProbe = 8;
+
+    // Normalized key for 'req'. Never 0.
+    static uint64_t KeyOf(const OrderRequest& req) noexcept;
+
+    // True (and 'rc' set) if 'key' was recorded within the last 'windowMs'.
+    // Counts a hit or a miss.
+    bool Lookup(uint64_t key, int64_t nowMs, int64_t windowMs, int& rc) noexcept;
+
+    // Remember that 'key' produced 'rc' at 'nowMs'.
+    void Record(uint64_t key, int64_t nowMs, int rc) noexcept;
+
+    uint64_t Hits()   const noexcept { return m_hits.load(std::memory_order_relaxed); }
+    uint64_t Misses() const noexcept { return m_misses.load(std::memory_order_relaxed); }
+
+private:
+    // 'key' is cleared while 'value' is rewritten, so a reader that sees the
+    // same key before and after reading 'value' has a matching pair.
+    struct Slot {
+        std::atomic<uint64_t> key{ 0 };
+        std::atomic<uint64_t> value{ 0 };    // (stampMs << 8) | uint8(rc)
+    };
+
+    Slot                  m_slots[kSlots];
+    std::atomic<uint64_t> m_hits{ 0 };
+    std::atomic<uint64_t> m_misses{ 0 };
+};
+
+} // namespace Bridge
@@ -0,0 +1,105 @@
+#pragma once
+#include "IBrokerAdapter.h"
+#include "Config.h"
+#include "PipeChannel.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Bridge {
+
+// Connection settings, from pipeName and the dotnet* keys of bridge.json.
+struct DotNetSettings {
+    std::string pipeName    = "BridgeT4Pipe";
+    int         timeoutMs   = 5000;   // Execute waits this long for the worker's answer
+    int         reconnectMs = 1000;   // first retry delay; doubles up to 30 s
+};
+
+DotNetSettings DotNetSettingsOf(const BridgeConfig& cfg);
+
+// Client of BridgeDotNetWorker (dotnet/BridgeDotNetWorker) over one
+// persistent pipe. A session thread connects, sends CONNECT so the worker
+// logs on to T4, reads the worker's replies and reconnects with backoff
+// when the pipe drops. Until CONNECT is answered OK, Execute returns
+// RC_NOT_CONNECTED at once; it never waits on a reconnect.
+//
+// Requests are pipelined: each line carries a correlation tag,
+//   #<id> PLACE <instrument> BUY|SELL <qty> <price> <type>
+// and the worker answers "#<id> OK ..." or "#<id> ERROR ..." once it has
+// run it. The worker reads ahead but runs the requests in the order they
+// were written, one at a time, so any number of callers (and a whole batch
+// in one write) can be in flight on the one connection without reordering. OK is RC_SUCCESS,
+// ERROR RC_REJECTED; no answer within timeoutMs is RC_TIMEOUT (the order may
+// still be placed). Only PLACE is forwarded - the worker has no cancel or
+// position commands - so other commands return RC_INVALID_CMD.
+class DotNetAdapter : public IBrokerAdapter {
+public:
+    explicit DotNetAdapter(DotNetSettings settings);
+    ~DotNetAdapter() override;
+
+    DotNetAdapter(const DotNetAdapter&) = delete;
+    DotNetAdapter& operator=(const DotNetAdapter&) = delete;
+
+    bool IsConnected() const noexcept override { return m_connected.load(std::memory_order_acquire); }
+    // Requests of different accounts only share the pipe, which is locked
+    // per write; the worker runs them in that write order.
+    bool IsShardSafe() const noexcept override { return true; }
+    int  Execute(const OrderRequest& req) override;
+    void ExecuteBatch(const OrderRequest* reqs, size_t count, int* results) override;
+
+    // Requests written and not yet answered.
+    size_t InFlight() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    // A request waiting for the worker's answer.
+    struct Pending {
+        int  rc     = RC_PENDING;
+        bool waited = true;   // false once its caller gave up; the answer is dropped
+    };
+
+    // Session thread.
+    void Run() noexcept;
+    bool Open();
+    void Serve();
+    bool OnLine(std::string_view line);   // false: drop the connection
+    void Disconnected();
+
+    // With m_mutex held.
+    void AppendPlace(uint64_t id, const OrderRequest& req);
+    bool Send();
+    void Await(std::unique_lock<std::mutex>& lk, const std::vector<std::pair<size_t, uint64_t>>& sent,
+               int* results);
+
+    const DotNetSettings m_settings;
+
+    mutable std::mutex      m_mutex;
+    std::condition_variable m_answered;   // Pending::rc set, or the pipe dropped
+    std::condition_variable m_wake;       // m_stop set
+    std::atomic<bool>       m_connected{ false };
+    bool                    m_stop = false;
+
+    // Guarded by m_mutex. m_pipe is replaced only by the session thread,
+    // which alone reads from it.
+    PipeChannel                           m_pipe;
+    uint64_t                              m_nextId    = 1;
+    uint64_t                              m_connectId = 0;   // the handshake, until answered
+    Clock::time_point                     m_connectSent;
+    std::string                           m_sendBuf;
+    std::unordered_map<uint64_t, Pending> m_pending;
+    std::vector<char>                     m_recvBuf;          // session thread only
+
+    std::thread m_thread;
+};
+
+} // namespace Bridge
@@ -0,0 +1,102 @@
+#pragma once
+#include "IBrokerAdapter.h"
+#include "Config.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Bridge {
+
+// How a FaultInjectingAdapter misbehaves. Built from the fault* settings in
+// bridge.json by MakeFaultProfile.
+struct FaultProfile {
+    enum class Latency : uint8_t { None, Fixed, Uniform, LogNormal, Histogram };
+
+    // One histogram bucket: 'count' samples in (previous upperUs, upperUs].
+    struct Bucket {
+        double   upperUs;
+        uint64_t count;
+    };
+
+    Latency             latency  = Latency::None;
+    double              fixedUs  = 0.0;    // Fixed
+    double              minUs    = 0.0;    // Uniform
+    double              maxUs    = 0.0;
+    double              medianUs = 0.0;    // LogNormal: exp(mu)
+    double              sigma    = 0.0;    //            shape
+    std::vector<Bucket> histogram;         // Histogram, ascending upperUs
+
+    double   rejectRate        = 0.0;  // fraction of requests answered RC_REJECTED
+    int      timeoutMs         = 0;    // answers slower than this become RC_TIMEOUT; 0 = never
+    int      disconnectEveryMs = 0;    // period of the disconnect cycle; 0 = always up
+    int      disconnectForMs   = 0;    // down for the last this-many ms of each period
+    uint64_t seed              = 0;    // 0 = different every run
+
+    bool Active() const noexcept {
+        return latency != Latency::None || rejectRate > 0.0 || timeoutMs > 0 ||
+               (disconnectEveryMs > 0 && disconnectForMs > 0);
+    }
+};
+
+// Parse a faultLatency spec into 'out':
+//   "none" | "fixed:<us>" | "uniform:<minUs>-<maxUs>" |
+//   "lognormal:<medianUs>,<sigma>" | "histogram:<path>"
+// A histogram file has one "<upperUs> <count>" bucket per line ('#'
+// comments allowed). Returns RC_SUCCESS or RC_CONFIG_ERR.
+int ParseFaultLatency(std::string_view spec, FaultProfile& out) noexcept;
+
+// Profile described by cfg's fault* settings. A malformed faultLatency is
+// logged and treated as "none".
+FaultProfile MakeFaultProfile(const BridgeConfig& cfg);
+
+// Decorator that makes any adapter slow, jittery or unreliable on purpose,
+// to load-test the engine and the DLL exports without a broker. Each call
+// waits a latency drawn from the profile, is rejected at the reject rate,
+// and fails with RC_NOT_CONNECTED inside disconnect windows (IsConnected()
+// goes false too). A latency beyond timeoutMs waits timeoutMs and returns
+// RC_TIMEOUT; the request is still passed on, as when a broker's
+// acknowledgement is lost rather than the order.
+class FaultInjectingAdapter : public IBrokerAdapter {
+public:
+    FaultInjectingAdapter(std::shared_ptr<IBrokerAdapter> inner, FaultProfile profile);
+
+    bool IsConnected() const noexcept override;
+    bool IsShardSafe() const noexcept override { return m_inner->IsShardSafe(); }
+    int  Execute(const OrderRequest& req) override;
+    // One latency draw, reject roll and timeout check covers the whole batch.
+    void ExecuteBatch(const OrderRequest* reqs, size_t count, int* results) override;
+
+    IBrokerAdapter&     Inner() const noexcept { return *m_inner; }
+    const FaultProfile& Profile() const noexcept { return m_profile; }
+
+    // Latency the next call would wait, in microseconds (exposed for tests).
+    double SampleLatencyUs() noexcept;
+
+    uint64_t Rejects()     const noexcept { return m_rejects.load(std::memory_order_relaxed); }
+    uint64_t Timeouts()    const noexcept { return m_timeouts.load(std::memory_order_relaxed); }
+    uint64_t Disconnects() const noexcept { return m_disconnects.load(std::memory_order_relaxed); }
+
+private:
+    enum class Outcome { Forward, Reject, Timeout, Down };
+
+    double  NextUniform() noexcept;         // (0, 1)
+    bool    InDisconnectWindow() const noexcept;
+    Outcome Delay() noexcept;               // sleeps, then says what to do
+
+    std::shared_ptr<IBrokerAdapter>       m_inner;
+    FaultProfile                          m_profile;
+    std::vector<uint64_t>                 m_cumulative;   // running histogram counts
+    std::chrono::steady_clock::time_point m_start;
+    uint64_t                              m_seed;
+    std::atomic<uint64_t>                 m_draws{ 0 };
+    std::atomic<uint64_t>                 m_rejects{ 0 };
+    std::atomic<uint64_t>                 m_timeouts{ 0 };
+    std::atomic<uint64_t>                 m_disconnects{ 0 };
+};
+
+} // namespace Bridge
@@ -0,0 +1,236 @@
+#pragma once
+#include "IBrokerAdapter.h"
+#include "Config.h"
+#include "FixDecoder.h"
+#include "FixMessage.h"
+#include "FixSessionStore.h"
+#include "FixTemplate.h"
+#include "OrderStore.h"
+#include "Socket.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Bridge {
+
+// Connection settings, from the fix* keys of bridge.json.
+struct FixSettings {
+    std::string host             = "127.0.0.1";
+    int         port             = 9876;
+    std::string senderCompId     = "CLIENT";
+    std::string targetCompId     = "SERVER";
+    int         heartbeatSeconds = 30;
+    int         ackTimeoutMs     = 0;      // > 0: Execute waits this long for the broker's answer
+    int         reconnectMs      = 1000;   // first retry delay; doubles up to 30 s
+    std::string storePath;                 // session store file; empty = reset sequence numbers at each logon
+};
+
+FixSettings FixSettingsOf(const BridgeConfig& cfg);
+
+// One ExecutionReport as received. The views point into the receive
+// buffer and are only valid during the ExecutionSink call.
+struct FixExecution {
+    std::string_view clOrdId;
+    std::string_view origClOrdId;
+    std::string_view orderId;
+    std::string_view execId;
+    std::string_view account;
+    std::string_view symbol;
+    std::string_view text;
+    char             execType  = 0;     // 150, or 39 when 150 is absent
+    char             ordStatus = 0;     // 39
+    Action           side      = Action::UNKNOWN;
+    int              lastQty   = 0;     // 32 LastShares
+    int              cumQty    = 0;
+    int              leavesQty = 0;
+    FixedPrice       lastPx;
+    FixedPrice       avgPx;
+};
+
+// FIX 4.2 initiator over plain TCP. A session thread connects, logs on
+// (see the session store below), answers heartbeats and test requests,
+// reconnects with backoff and applies incoming execution reports.
+//
+// Commands map onto NewOrderSingle (D), OrderCancelRequest (F) and
+// OrderCancelReplaceRequest (G) against the orders this session has open,
+// with the MockAdapter/SimExchangeAdapter semantics:
+//   PLACE             D
+//   CANCEL            F for each open order of the account and instrument
+//   CANCELALLORDERS   F for each open order of the account
+//   CHANGE            G for the newest open order, F for the others; D if none
+//   CLOSEPOSITION     CANCEL, then a market D offsetting the filled position
+//   FLATTENEVERYTHING F for every open order, market D for every position
+//   REVERSEPOSITION   CANCEL, then a market D for twice the position
+//                     (flat: the opposite of the request)
+// CANCEL and CANCELALLORDERS without an account (or CANCEL without an
+// instrument) return RC_INVALID_PARAM rather than reaching other accounts.
+// Fills for orders of another session are counted only under account and
+// instrument names already known.
+//
+// Execute patches a pre-rendered message template (FixOrderTemplates) and
+// writes to the socket under one lock. With ackTimeoutMs = 0 it returns as soon as the bytes are
+// written; otherwise it waits for the ExecutionReport (RC_REJECTED,
+// RC_TIMEOUT). RC_NOT_CONNECTED until the logon is accepted.
+//
+// With a session store (storePath) sequence numbers survive reconnects and
+// restarts, and a ResendRequest re-sends the stored orders with
+// PossDupFlag=Y; session messages are gap-filled. Without one every logon
+// resets sequence numbers (141=Y) and a ResendRequest gets a gap fill.
+class FixAdapter : public IBrokerAdapter {
+public:
+    using ExecutionSink = std::function<void(const FixExecution&)>;
+
+    explicit FixAdapter(FixSettings settings);
+    ~FixAdapter() override;   // logs out (waiting up to 2 s for the reply)
+
+    FixAdapter(const FixAdapter&) = delete;
+    FixAdapter& operator=(const FixAdapter&) = delete;
+
+    bool IsConnected() const noexcept override { return m_loggedOn.load(std::memory_order_acquire); }
+    int  Execute(const OrderRequest& req) override;
+    void ExecuteBatch(const OrderRequest* reqs, size_t count, int* results) override;
+
+    // Receives every ExecutionReport after the adapter has applied it.
+    // Called on the session thread with the adapter locked: the sink must
+    // not call back into the adapter.
+    void SetExecutionSink(ExecutionSink sink);
+
+    // Orders sent and not yet filled, cancelled or rejected.
+    size_t  OpenOrderCount() const;
+    // Net filled position (long > 0), from execution reports.
+    int64_t Position(SymbolId account, SymbolId instrument) const;
+    // MsgSeqNum of the next message sent / expected.
+    uint64_t NextOutgoingSeq() const;
+    uint64_t NextIncomingSeq() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    enum class OrderState : uint8_t {
+        PendingNew,       // D sent, no answer yet
+        Working,
+        PendingCancel,    // F sent; for a PendingReplace order, its Replacement entry too
+        PendingReplace,   // G sent; replaced by the Replacement entry on success
+        Replacement       // the G's own ClOrdID until it is confirmed
+    };
+
+    struct FixOrder {
+        SymbolId    account    = kNoSymbol;
+        SymbolId    instrument = kNoSymbol;
+        Action      side       = Action::UNKNOWN;
+        int         quantity   = 0;
+        OrderType   type       = OrderType::MARKET;
+        FixedPrice  limit;
+        FixedPrice  stop;
+        TimeInForce tif        = TimeInForce::DAY;
+        int         cumQty     = 0;
+        OrderState  state      = OrderState::PendingNew;
+        uint64_t    placed     = 0;   // send order, to find the newest
+        std::string replacement;      // the unconfirmed G's ClOrdID, while one is out
+    };
+
+    // A D, F or G waiting for the broker's answer.
+    struct Pending {
+        std::string origClOrdId;      // F and G
+        uint64_t    seq    = 0;       // MsgSeqNum it went out with, for session Rejects
+        int         rc     = RC_PENDING;
+        bool        waited = false;   // an Execute call is waiting for rc
+    };
+
+    // Lets the maps be searched with the string_views of a received message.
+    struct ViewHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view s) const noexcept { return std::hash<std::string_view>{}(s); }
+    };
+    template <class T>
+    using ClOrdIdMap = std::unordered_map<std::string, T, ViewHash, std::equal_to<>>;
+
+    // Session thread.
+    void Run() noexcept;
+    bool Logon();
+    void Serve();
+    bool OnTimer(Clock::time_point now);
+    bool OnMessage(const FixDecoder& f);
+    void OnExecution(const FixDecoder& f);
+    void OnCancelReject(const FixDecoder& f);
+    void OnSessionReject(const FixDecoder& f);
+    void Disconnected();
+    void Restore(std::string_view origClOrdId, std::string_view requestId);   // F/G refused
+
+    // Outbound; all with m_mutex held.
+    FixWriter& Start(std::string_view msgType, uint64_t seq = 0);
+    bool       Queue();                      // the message in m_writer
+    bool       QueueOrder(char msgType, const FixOrderFields& f);
+    bool       Append(std::string_view msg);
+    bool       Flush();
+    bool       SendNow() { return Queue() && Flush(); }
+    bool       Resend(uint64_t begin, uint64_t end);   // answer a ResendRequest from the store
+    void       SetInSeq(uint64_t seq);
+
+    int  Dispatch(const OrderRequest& req, size_t index);
+    int  SendNew(const FixOrder& order, size_t index);
+    void SendCancel(const std::string& clOrdId, FixOrder& order, size_t index);
+    void SendReplace(const std::string& clOrdId, FixOrder& order, const FixOrder& next, size_t index);
+    void CancelWhere(std::optional<SymbolId> account, std::optional<SymbolId> instrument,
+                     size_t index);   // nullopt = any
+    int  Flatten(uint64_t key, size_t index);
+    void Await(std::unique_lock<std::mutex>& lk, int* results);
+    void Answer(std::string_view clOrdId, int rc);
+    std::string NextClOrdId();
+
+    static FixOrder       OrderOf(const OrderRequest& req);
+    static FixOrderFields FieldsOf(const FixOrder& order, std::string_view clOrdId);
+    static uint64_t KeyOf(SymbolId account, SymbolId instrument) noexcept {
+        return (static_cast<uint64_t>(account) << 32) | instrument;
+    }
+
+    const FixSettings m_settings;
+
+    mutable std::mutex      m_mutex;
+    std::condition_variable m_answered;   // Pending::rc set, or the session dropped
+    std::condition_variable m_wake;       // m_stop set
+    std::atomic<bool>       m_loggedOn{ false };
+    bool                    m_stop       = false;
+    bool                    m_logoutSent = false;
+
+    // Session state, guarded by m_mutex. m_socket is replaced only by the
+    // session thread, which alone reads from it.
+    Socket           m_socket;
+    uint64_t         m_outSeq = 1;
+    uint64_t         m_inSeq  = 1;
+    bool             m_resetSent       = false;   // this logon asked for 141=Y
+    bool             m_resendRequested = false;
+    bool             m_testRequestSent = false;
+    Clock::time_point m_lastSent, m_lastReceived;
+    FixWriter        m_writer;       // session messages, and orders a template cannot hold
+    FixOrderTemplates m_templates;
+    bool             m_seqOverride = false;   // message being built reuses an old MsgSeqNum
+    std::string      m_sendBuf;      // queued messages, written by Flush
+    std::vector<char> m_recvBuf;     // session thread only
+    FixDecoder       m_decoder;      // session thread only
+    FixSessionStore  m_store;        // sequence numbers and sent orders; may be closed
+
+    // Orders, guarded by m_mutex.
+    OrderIdCounter                               m_ids;
+    uint64_t                                     m_placed = 0;
+    ClOrdIdMap<FixOrder>                         m_orders;     // by current ClOrdID
+    ClOrdIdMap<Pending>                          m_pending;    // by the request's ClOrdID
+    std::unordered_map<uint64_t, int64_t>        m_positions;  // KeyOf(account, instrument)
+    std::vector<std::pair<size_t, std::string>>  m_sent;       // this call's (request index, ClOrdID)
+    ExecutionSink                                m_sink;
+
+    std::thread m_thread;
+};
+
+} // namespace Bridge
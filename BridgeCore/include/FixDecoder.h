@@ -0,0 +1,51 @@
+#pragma once
+#include "FixMessage.h"
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace Bridge {
+
+// Decodes FIX messages in place, straight out of a receive buffer: frames
+// the first message, checks BodyLength and CheckSum (FixFrame) and walks
+// its fields once, recording where the fields FixAdapter reads on every
+// message start in a fixed-size index. Values are string_views into the
+// buffer, valid until it is overwritten. Never allocates.
+//
+// Indexed: 35 MsgType, 11 ClOrdID, 37 OrderID, 39 OrdStatus, 150 ExecType,
+// 14 CumQty, 151 LeavesQty, 31 LastPx, 32 LastShares, 58 Text, plus the
+// header and order fields 34, 43, 49, 56, 1, 6, 17, 41, 54, 55. Other tags
+// are found by scanning the message. The first occurrence of a tag wins.
+class FixDecoder {
+public:
+    static constexpr size_t kIndexed = 20;   // tags with an index slot
+
+    // Decode the first message in 'buf'. Returns its length (> 0), 0 if it
+    // is not complete yet, or -1 if 'buf' is garbled (bad header,
+    // BodyLength, CheckSum or field); after -1 nothing is decoded.
+    ptrdiff_t Decode(std::string_view buf) noexcept;
+
+    std::string_view Get(int tag) const noexcept;   // empty if absent
+    bool             Has(int tag) const noexcept;
+    int64_t          GetInt(int tag, int64_t fallback = 0) const noexcept;
+    char             GetChar(int tag, char fallback = '\0') const noexcept;
+
+    std::string_view MsgType() const noexcept { return Get(FixTag::MsgType); }
+    std::string_view Message() const noexcept { return m_msg; }
+
+    static bool IsIndexed(int tag) noexcept;
+
+private:
+    // A value never starts at offset 0, so 0 marks an absent field.
+    struct Span {
+        uint32_t offset;
+        uint32_t length;
+    };
+
+    std::string_view Scan(int tag, bool& found) const noexcept;
+
+    std::string_view m_msg;
+    Span             m_index[kIndexed] = {};
+};
+
+} // namespace Bridge
@@ -0,0 +1,103 @@
+#pragma once
+#include "Types.h"
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// FIX 4.2 tag=value building blocks for FixAdapter: a message writer, a
+// framer for a receive buffer and a field view over one framed message.
+
+namespace Bridge {
+
+constexpr char kFixSoh = '\x01';
+
+namespace FixTag {
+constexpr int Account = 1, AvgPx = 6, BeginSeqNo = 7, BeginString = 8, BodyLength = 9,
+              CheckSum = 10, ClOrdID = 11, CumQty = 14, EndSeqNo = 16, ExecID = 17, HandlInst = 21,
+              LastPx = 31, LastShares = 32, MsgSeqNum = 34, MsgType = 35, NewSeqNo = 36, OrderID = 37,
+              OrderQty = 38, OrdStatus = 39, OrdType = 40, OrigClOrdID = 41, PossDupFlag = 43,
+              Price = 44, RefSeqNum = 45, SenderCompID = 49, SendingTime = 52, Side = 54, Symbol = 55,
+              TargetCompID = 56, Text = 58, TimeInForce = 59, TransactTime = 60, EncryptMethod = 98,
+              StopPx = 99, HeartBtInt = 108, TestReqID = 112, OrigSendingTime = 122, GapFillFlag = 123,
+              ResetSeqNumFlag = 141, ExecType = 150, LeavesQty = 151;
+} // namespace FixTag
+
+// Sum of the bytes p[0..n), unsigned; the CheckSum is its low byte.
+// Vectorised (sum of absolute differences against zero) with SSE2/AVX2.
+unsigned FixByteSum(const char* p, size_t n) noexcept;
+
+// "YYYYMMDD-HH:MM:SS.sss" (UTC), the SendingTime/TransactTime format.
+constexpr size_t kFixTimestampLen = 21;
+
+// Write the current UTC time into 'out' (kFixTimestampLen chars, not
+// NUL-terminated). The date part is cached per second and per thread.
+void FixTimestamp(char* out) noexcept;
+
+// Builds one message in a fixed buffer: Begin, the fields in order, then
+// Finish, which puts BeginString and BodyLength in front and the CheckSum
+// after. Never allocates; fields that do not fit set Overflow().
+class FixWriter {
+public:
+    static constexpr size_t kCapacity = 1024;
+
+    void Begin(std::string_view msgType) noexcept;
+    void Add(int tag, std::string_view value) noexcept;
+    void Add(int tag, int64_t value) noexcept;
+    void Add(int tag, char value) noexcept;
+    // 'px' when set, else 'fallback' formatted with up to 9 decimals.
+    void AddPrice(int tag, const FixedPrice& px, double fallback) noexcept;
+    void AddTimestamp(int tag) noexcept;
+
+    // The complete message; valid until the next Begin. Empty on overflow.
+    std::string_view Finish() noexcept;
+
+    bool Overflow() const noexcept { return m_overflow; }
+
+private:
+    static constexpr size_t kHeaderRoom = 32;   // "8=FIX.4.2|9=nnnnn|" goes in front of the body
+
+    char*  Reserve(size_t n) noexcept;
+    void   AddTag(int tag) noexcept;
+
+    char   m_buf[kCapacity];
+    size_t m_pos      = kHeaderRoom;
+    bool   m_overflow = false;
+};
+
+// Length of the first complete message at the start of 'buf': > 0 when a
+// whole message is there, 0 if more bytes are needed, -1 if 'buf' does not
+// start with a well-formed header or its CheckSum is wrong (the caller
+// should drop the connection: FIX has no resynchronisation).
+ptrdiff_t FixFrame(std::string_view buf) noexcept;
+
+// The fields of one framed message, in order. Lookups scan linearly, which
+// beats hashing at a few dozen fields. Views point into the message text.
+class FixFields {
+public:
+    static constexpr size_t kMaxFields = 64;
+
+    // False if a field is malformed or there are more than kMaxFields.
+    bool Parse(std::string_view msg) noexcept;
+
+    std::string_view Get(int tag) const noexcept;   // empty if absent
+    bool             Has(int tag) const noexcept;
+    int64_t          GetInt(int tag, int64_t fallback = 0) const noexcept;
+    char             GetChar(int tag, char fallback = '\0') const noexcept;
+
+    std::string_view MsgType() const noexcept { return Get(FixTag::MsgType); }
+    size_t           Count() const noexcept { return m_count; }
+
+    // The i-th field in message order, i < Count().
+    int              TagAt(size_t i) const noexcept { return m_fields[i].tag; }
+    std::string_view ValueAt(size_t i) const noexcept { return m_fields[i].value; }
+
+private:
+    struct Field {
+        int              tag;
+        std::string_view value;
+    };
+    Field  m_fields[kMaxFields];
+    size_t m_count = 0;
+};
+
+} // namespace Bridge
@@ -0,0 +1,76 @@
+#pragma once
+#include "MappedFile.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace Bridge {
+
+// Persistent state of one FIX session in a memory-mapped file: the next
+// outgoing and incoming MsgSeqNum and the application messages sent, so a
+// ResendRequest can be answered and a restart resumes the session where it
+// stopped. Every update is a store into the mapping - no write() or fsync
+// on the order path; the OS writes the pages back (and they survive a crash
+// of the process, though not of the machine).
+//
+// Layout: a 4 KB header page (magic "BRFIXS01", CompIDs, sizes, sequence
+// numbers, ring position), an index of 'indexSlots' entries addressed by
+// MsgSeqNum % indexSlots, then a ring of 'ringBytes' holding the messages
+// end to end. A message is kept until the ring wraps over it or a message
+// indexSlots numbers later takes its index entry; Find is O(1) either way.
+// Opening an existing store only validates the header page.
+//
+// Not thread-safe: FixAdapter calls it under its session lock.
+class FixSessionStore {
+public:
+    static constexpr size_t kDefaultRingBytes  = size_t(8) << 20;
+    static constexpr size_t kDefaultIndexSlots = 65536;
+
+    FixSessionStore() = default;
+    ~FixSessionStore() { Close(); }
+
+    FixSessionStore(const FixSessionStore&) = delete;
+    FixSessionStore& operator=(const FixSessionStore&) = delete;
+
+    // Create 'path', or reopen the store of the same session. Returns false
+    // on I/O errors, if the file is not a session store, or if it belongs to
+    // other CompIDs or was created with other sizes.
+    bool Open(const std::string& path, std::string_view senderCompId, std::string_view targetCompId,
+              size_t ringBytes = kDefaultRingBytes, size_t indexSlots = kDefaultIndexSlots) noexcept;
+    void Close() noexcept;
+    bool IsOpen() const noexcept { return m_file.IsOpen(); }
+
+    uint64_t NextOutgoing() const noexcept;
+    uint64_t NextIncoming() const noexcept;
+    void     SetNextOutgoing(uint64_t seq) noexcept;
+    void     SetNextIncoming(uint64_t seq) noexcept;
+
+    // Keep the message sent with MsgSeqNum 'seq'. Sequence numbers must
+    // rise; a message larger than a quarter of the ring is not kept.
+    bool Store(uint64_t seq, std::string_view msg) noexcept;
+
+    // The message sent with 'seq', or empty if it was never stored or has
+    // been overwritten. Valid until the next Store or Reset.
+    std::string_view Find(uint64_t seq) const noexcept;
+
+    // Oldest MsgSeqNum that may still be found.
+    uint64_t FirstKept() const noexcept;
+
+    // Start the session over: both sequence numbers back to 1, nothing kept.
+    void Reset() noexcept;
+
+private:
+    struct Header;
+    struct Slot;
+
+    Header* Head() const noexcept { return reinterpret_cast<Header*>(m_file.Data()); }
+    Slot*   Slots() const noexcept;
+    char*   Ring() const noexcept;
+
+    MappedFile m_file;
+    size_t     m_ringBytes  = 0;
+    size_t     m_indexSlots = 0;
+};
+
+} // namespace Bridge
@@ -0,0 +1,82 @@
+#pragma once
+#include "FixMessage.h"
+#include "Types.h"
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace Bridge {
+
+// The values of one NewOrderSingle (D), OrderCancelRequest (F) or
+// OrderCancelReplaceRequest (G).
+struct FixOrderFields {
+    std::string_view clOrdId;
+    std::string_view origClOrdId;   // F and G
+    std::string_view account;       // 1; left out when empty
+    std::string_view symbol;
+    char             side     = '1';
+    int64_t          quantity = 0;
+    char             ordType  = '1';   // D and G: 1 market, 2 limit, 3 stop, 4 stop limit
+    char             tif      = '0';   // D and G
+    FixedPrice       price;            // ordType 2 and 4
+    FixedPrice       stopPx;           // ordType 3 and 4
+};
+
+// Builds the message field by field with FixWriter: the reference encoding,
+// and the fallback when a value does not fit a template slot.
+std::string_view EncodeOrder(FixWriter& w, char msgType, std::string_view senderCompId,
+                             std::string_view targetCompId, uint64_t seq, const FixOrderFields& f) noexcept;
+
+// Order messages pre-rendered once per session. Every field that does not
+// change between orders (BeginString, MsgType, CompIDs, HandlInst, OrdType)
+// is written at construction together with fixed-width slots for
+// MsgSeqNum, SendingTime/TransactTime, Side, OrderQty, Price, StopPx and
+// TimeInForce; Render patches the slots in place, appends the
+// variable-length strings (ClOrdID, OrigClOrdID, Account, Symbol) and
+// finishes BodyLength and CheckSum from the precomputed sum of the
+// constant bytes. Numbers are zero-padded to their slot width, which FIX
+// allows ("00023" = "23"). Never allocates.
+class FixOrderTemplates {
+public:
+    static constexpr size_t kCapacity = 512;
+
+    FixOrderTemplates(std::string_view senderCompId, std::string_view targetCompId) noexcept;
+
+    // 'D', 'F' or 'G'. The message is valid until the next Render. Empty
+    // if a value does not fit its slot (MsgSeqNum or OrderQty over 9
+    // digits, a price over 18 chars, strings over the buffer) or a price
+    // the OrdType needs is unset: build that one with EncodeOrder.
+    std::string_view Render(char msgType, uint64_t seq, const FixOrderFields& f) noexcept;
+
+    // False if the CompIDs were too long to pre-render; Render then always
+    // returns empty.
+    bool Valid() const noexcept { return m_valid; }
+
+private:
+    static constexpr size_t kHeaderRoom = 24;       // "8=FIX.4.2|9=nnn|" goes in front of the body
+    static constexpr size_t kNoSlot     = SIZE_MAX;
+
+    struct Template {
+        char     buf[kCapacity];
+        size_t   fixedEnd  = kHeaderRoom;   // end of the pre-rendered part; the strings follow
+        unsigned constSum  = 0;             // byte sum of the pre-rendered part outside the slots
+        size_t   seq       = kNoSlot;       // slot offsets into buf
+        size_t   sendTime  = kNoSlot;
+        size_t   xactTime  = kNoSlot;
+        size_t   side      = kNoSlot;
+        size_t   qty       = kNoSlot;
+        size_t   price     = kNoSlot;
+        size_t   stopPx    = kNoSlot;
+        size_t   tif       = kNoSlot;
+    };
+
+    void Build(Template& t, char msgType, char ordType, std::string_view sender, std::string_view target) noexcept;
+
+    // 4 NewOrderSingle and 4 CancelReplace variants by OrdType, one Cancel.
+    Template m_new[4];
+    Template m_replace[4];
+    Template m_cancel;
+    bool     m_valid = true;
+};
+
+} // namespace Bridge
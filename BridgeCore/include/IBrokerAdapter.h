@@ -1,5 +1,6 @@
 #pragma once
 #include "Types.h"
+#include <cstddef>
 #include <string>
 
 namespace Bridge {
@@ -10,8 +11,21 @@ public:
 
     virtual bool IsConnected() const noexcept = 0;
 
+    // True if Execute may be called concurrently for different accounts,
+    // with each account's calls still arriving in order. The engine only
+    // spreads accounts across execution lanes for shard-safe adapters.
+    virtual bool IsShardSafe() const noexcept { return false; }
+
     // Execute an order request; returns a Bridge return code.
     virtual int Execute(const OrderRequest& req) = 0;
+
+    // Execute 'count' requests in order, writing one return code per request
+    // to 'results'. The default submits them one at a time through Execute;
+    // adapters that can amortise locking or I/O across a batch override it.
+    virtual void ExecuteBatch(const OrderRequest* reqs, size_t count, int* results) {
+        for (size_t i = 0; i < count; ++i)
+            results[i] = Execute(reqs[i]);
+    }
 };
 
 } // namespace Bridge
@@ -0,0 +1,175 @@
+#pragma once
+#include "Types.h"
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace Bridge {
+
+// Field names accepted in a pipe-delimited payload.
+enum class PayloadField : uint8_t {
+    COMMAND,
+    ACCOUNT,
+    INSTRUMENT,
+    ACTION,
+    QUANTITY,
+    ORDERTYPE,
+    LIMITPRICE,
+    STOPPRICE,
+    TIMEINFORCE,
+    BARKEY
+};
+
+enum class KeywordKind : uint8_t {
+    Command,
+    Action,
+    OrderType,
+    TimeInForce,
+    Field
+};
+
+struct Keyword {
+    std::string_view text;   // canonical uppercase spelling
+    KeywordKind      kind;   // which enum 'value' belongs to
+    uint8_t          value;  // underlying value of that enum
+};
+
+namespace Keywords {
+
+template <typename E>
+constexpr Keyword Make(std::string_view text, KeywordKind kind, E value) {
+    return Keyword{ text, kind, static_cast<uint8_t>(value) };
+}
+
+// Every token the bridge recognises: enum spellings and payload keys.
+inline constexpr Keyword kAll[] = {
+    Make("PLACE",             KeywordKind::Command,     Command::PLACE),
+    Make("CANCEL",            KeywordKind::Command,     Command::CANCEL),
+    Make("CANCELALLORDERS",   KeywordKind::Command,     Command::CANCELALLORDERS),
+    Make("CHANGE",            KeywordKind::Command,     Command::CHANGE),
+    Make("CLOSEPOSITION",     KeywordKind::Command,     Command::CLOSEPOSITION),
+    Make("CLOSESTRATEGY",     KeywordKind::Command,     Command::CLOSESTRATEGY),
+    Make("FLATTENEVERYTHING", KeywordKind::Command,     Command::FLATTENEVERYTHING),
+    Make("REVERSEPOSITION",   KeywordKind::Command,     Command::REVERSEPOSITION),
+    Make("BUY",               KeywordKind::Action,      Action::BUY),
+    Make("SELL",              KeywordKind::Action,      Action::SELL),
+    Make("MARKET",            KeywordKind::OrderType,   OrderType::MARKET),
+    Make("LIMIT",             KeywordKind::OrderType,   OrderType::LIMIT),
+    Make("STOPMARKET",        KeywordKind::OrderType,   OrderType::STOPMARKET),
+    Make("STOPLIMIT",         KeywordKind::OrderType,   OrderType::STOPLIMIT),
+    Make("DAY",               KeywordKind::TimeInForce, TimeInForce::DAY),
+    Make("GTC",               KeywordKind::TimeInForce, TimeInForce::GTC),
+    Make("COMMAND",           KeywordKind::Field,       PayloadField::COMMAND),
+    Make("ACCOUNT",           KeywordKind::Field,       PayloadField::ACCOUNT),
+    Make("INSTRUMENT",        KeywordKind::Field,       PayloadField::INSTRUMENT),
+    Make("ACTION",            KeywordKind::Field,       PayloadField::ACTION),
+    Make("QUANTITY",          KeywordKind::Field,       PayloadField::QUANTITY),
+    Make("ORDERTYPE",         KeywordKind::Field,       PayloadField::ORDERTYPE),
+    Make("LIMITPRICE",        KeywordKind::Field,       PayloadField::LIMITPRICE),
+    Make("STOPPRICE",         KeywordKind::Field,       PayloadField::STOPPRICE),
+    Make("TIMEINFORCE",       KeywordKind::Field,       PayloadField::TIMEINFORCE),
+    Make("BARKEY",            KeywordKind::Field,       PayloadField::BARKEY),
+};
+
+constexpr size_t  kCount     = sizeof(kAll) / sizeof(kAll[0]);
+constexpr size_t  kSlots     = 64;     // power of two, > kCount
+constexpr uint8_t kEmptySlot = 0xFF;
+
+// Clearing bit 5 maps 'a'-'z' onto 'A'-'Z'. Only letters land in that range,
+// so comparing folded input against an uppercase keyword is exact.
+constexpr uint8_t Fold(char c) noexcept {
+    return static_cast<uint8_t>(static_cast<uint8_t>(c) & 0xDF);
+}
+
+constexpr uint32_t Hash(std::string_view s, uint32_t seed) noexcept {
+    uint32_t h = seed ^ static_cast<uint32_t>(s.size());
+    for (char c : s)
+        h = (h ^ Fold(c)) * 16777619u;   // FNV-1a step over folded bytes
+    return h ^ (h >> 15);
+}
+
+constexpr size_t MinLength() {
+    size_t n = kAll[0].text.size();
+    for (const Keyword& k : kAll) n = k.text.size() < n ? k.text.size() : n;
+    return n;
+}
+
+constexpr size_t MaxLength() {
+    size_t n = 0;
+    for (const Keyword& k : kAll) n = k.text.size() > n ? k.text.size() : n;
+    return n;
+}
+
+constexpr bool IsPerfect(uint32_t seed) {
+    bool used[kSlots] = {};
+    for (const Keyword& k : kAll) {
+        size_t slot = Hash(k.text, seed) & (kSlots - 1);
+        if (used[slot]) return false;
+        used[slot] = true;
+    }
+    return true;
+}
+
+// Search for the first seed under which no two keywords share a slot.
+constexpr uint32_t FindSeed() {
+    for (uint32_t seed = 2166136261u; seed != 2166136261u + 4096; ++seed)
+        if (IsPerfect(seed)) return seed;
+    return 0;
+}
+
+constexpr uint32_t kSeed = FindSeed();
+static_assert(kSeed != 0, "no collision-free seed for the keyword table; grow kSlots");
+
+struct SlotTable {
+    uint8_t index[kSlots];
+};
+
+constexpr SlotTable BuildSlots() {
+    SlotTable t{};
+    for (size_t i = 0; i < kSlots; ++i) t.index[i] = kEmptySlot;
+    for (size_t i = 0; i < kCount; ++i)
+        t.index[Hash(kAll[i].text, kSeed) & (kSlots - 1)] = static_cast<uint8_t>(i);
+    return t;
+}
+
+inline constexpr SlotTable kTable     = BuildSlots();
+inline constexpr size_t    kMinLength = MinLength();
+inline constexpr size_t    kMaxLength = MaxLength();
+
+// Index into kAll of the keyword matching 's' case-insensitively, or
+// kEmptySlot: one hash, one probe, one compare.
+constexpr uint8_t FindIndex(std::string_view s) noexcept {
+    if (s.size() < kMinLength || s.size() > kMaxLength)
+        return kEmptySlot;
+    uint8_t i = kTable.index[Hash(s, kSeed) & (kSlots - 1)];
+    if (i == kEmptySlot) return kEmptySlot;
+    const Keyword& k = kAll[i];
+    if (k.text.size() != s.size()) return kEmptySlot;
+    for (size_t j = 0; j < s.size(); ++j)
+        if (Fold(s[j]) != static_cast<uint8_t>(k.text[j])) return kEmptySlot;
+    return i;
+}
+
+} // namespace Keywords
+
+// Case-insensitive keyword lookup. Returns nullptr for anything that is not
+// a keyword. Never allocates.
+inline const Keyword* LookupKeyword(std::string_view s) noexcept {
+    uint8_t i = Keywords::FindIndex(s);
+    return i == Keywords::kEmptySlot ? nullptr : &Keywords::kAll[i];
+}
+
+// Look up 's' and convert to enum E if it is a keyword of the given kind.
+template <typename E>
+constexpr E LookupKeywordAs(std::string_view s, KeywordKind kind, E unknown) noexcept {
+    uint8_t i = Keywords::FindIndex(s);
+    if (i == Keywords::kEmptySlot || Keywords::kAll[i].kind != kind) return unknown;
+    return static_cast<E>(Keywords::kAll[i].value);
+}
+
+static_assert(LookupKeywordAs("flattenEverything", KeywordKind::Command, Command::UNKNOWN)
+              == Command::FLATTENEVERYTHING);
+static_assert(LookupKeywordAs("Sell", KeywordKind::Action, Action::UNKNOWN) == Action::SELL);
+static_assert(Keywords::FindIndex("LIMIT ") == Keywords::kEmptySlot);
+
+} // namespace Bridge
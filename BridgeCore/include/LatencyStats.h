@@ -0,0 +1,205 @@
+#pragma once
+#include "Types.h"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Per-stage request latency. An entry point opens a LatencyScope; code along
+// the request path marks the end of each stage, and the time since the
+// previous mark is charged to that stage. When the outermost scope closes,
+// the stage times and the total go into histograms keyed by stage, command
+// and adapter, which LatencyReport summarises (p50/p99/p99.9/max).
+//
+//   BRIDGE_LATENCY_SCOPE();
+//   NarrowPayload(...);             BRIDGE_LATENCY_MARK(Convert);
+//   ParsePayload(...);              BRIDGE_LATENCY_MARK(Validate);
+//
+// Marks with no open scope on the thread do nothing, so core code can mark
+// stages whether or not its caller is timing. Histograms are per thread and
+// written without atomic read-modify-writes; a request costs one clock read
+// per mark (the TSC on x86). Build with BRIDGE_LATENCY_STATS=0 to compile it
+// all out.
+#ifndef BRIDGE_LATENCY_STATS
+#define BRIDGE_LATENCY_STATS 1
+#endif
+
+namespace Bridge {
+
+enum class Stage : uint8_t {
+    Convert,     // wide-to-narrow string conversion
+    Parse,       // BuildRequest / ParsePayload field parsing
+    Validate,    // ValidateRequest
+    GetEngine,   // engine lookup (first call: construction)
+    Dispatch,    // engine bookkeeping before the adapter: lease, dedup, queueing
+    Adapter,     // the adapter's Execute / ExecuteBatch
+    Log,         // log statements on the request path
+    Total,       // whole request, scope open to close
+    Count
+};
+
+const char* StageName(Stage s) noexcept;
+
+// Command slot used for batches (one scope per batch, any mix of commands).
+constexpr uint8_t kLatencyBatch    = static_cast<uint8_t>(Command::UNKNOWN) + 1;
+constexpr uint8_t kLatencyCommands = kLatencyBatch + 1;
+constexpr uint8_t kLatencyAdapters = 16;  // adapter id 0 = none reached
+
+// Log-linear histogram of tick counts: exact below 32, then 32 buckets per
+// power of two (about 3% resolution). One thread records; any thread may
+// read, seeing each counter atomically.
+class LatencyHistogram {
+public:
+    static constexpr int      kSubBits  = 5;
+    static constexpr int      kMaxBits  = 42;   // larger values are clamped
+    static constexpr size_t   kBuckets  = ((kMaxBits - kSubBits - 1) << kSubBits) + (2 << kSubBits);
+
+    static size_t   BucketOf(uint64_t v) noexcept;
+    static uint64_t BucketHigh(size_t bucket) noexcept;   // largest value in the bucket
+
+    // Single writer.
+    void Record(uint64_t v) noexcept {
+        size_t b = BucketOf(v);
+        Bump(m_counts[b], 1);
+        Bump(m_count, 1);
+        Bump(m_sum, v);
+        if (v > m_max.load(std::memory_order_relaxed)) m_max.store(v, std::memory_order_relaxed);
+    }
+
+    uint64_t Count() const noexcept { return m_count.load(std::memory_order_relaxed); }
+    uint64_t Sum()   const noexcept { return m_sum.load(std::memory_order_relaxed); }
+    uint64_t Max()   const noexcept { return m_max.load(std::memory_order_relaxed); }
+    uint64_t CountAt(size_t bucket) const noexcept { return m_counts[bucket].load(std::memory_order_relaxed); }
+
+    // Add 'other' into this one. Not for a histogram another thread records into.
+    void Merge(const LatencyHistogram& other) noexcept;
+
+    // Upper bound of the bucket holding quantile q (0..1), capped at Max().
+    uint64_t Percentile(double q) const noexcept;
+
+private:
+    static void Bump(std::atomic<uint64_t>& a, uint64_t n) noexcept {
+        a.store(a.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+    std::array<std::atomic<uint64_t>, kBuckets> m_counts{};
+    std::atomic<uint64_t> m_count{ 0 };
+    std::atomic<uint64_t> m_sum{ 0 };
+    std::atomic<uint64_t> m_max{ 0 };
+};
+
+namespace detail {
+
+// The request being timed on a thread. Constant-initialised, so the inline
+// checks below compile to a plain thread-local load.
+struct LatencyRequest {
+    bool     active  = false;
+    uint8_t  command = 0;
+    uint8_t  adapter = 0;
+    uint8_t  marked  = 0;   // bit per stage
+    uint64_t start   = 0;
+    uint64_t last    = 0;
+    uint64_t ticks[static_cast<size_t>(Stage::Count)] = {};
+    void*    shard   = nullptr;   // this thread's histograms, once it has recorded
+};
+extern constinit thread_local LatencyRequest t_latency;
+extern std::atomic<bool> g_latencyEnabled;
+
+void LatencyBegin(LatencyRequest& r) noexcept;
+void LatencyEnd(LatencyRequest& r) noexcept;
+void LatencyMark(LatencyRequest& r, Stage s) noexcept;
+
+} // namespace detail
+
+// Times one request on the calling thread. Only the outermost scope on a
+// thread records; nested ones (e.g. BridgeEngine::Execute under a DLL
+// export) leave the marks to it. Outside a timed request every call here is
+// one thread-local load and a branch.
+class LatencyScope {
+public:
+    LatencyScope() noexcept {
+        detail::LatencyRequest& r = detail::t_latency;
+        m_owner = !r.active && detail::g_latencyEnabled.load(std::memory_order_relaxed);
+        if (m_owner) detail::LatencyBegin(r);
+    }
+    ~LatencyScope() {
+        if (m_owner) detail::LatencyEnd(detail::t_latency);
+    }
+
+    LatencyScope(const LatencyScope&) = delete;
+    LatencyScope& operator=(const LatencyScope&) = delete;
+
+    // Charge the time since the previous mark to 's'.
+    static void Mark(Stage s) noexcept {
+        detail::LatencyRequest& r = detail::t_latency;
+        if (r.active) detail::LatencyMark(r, s);
+    }
+
+    // Row the request is reported under. A scope tagged kLatencyBatch keeps
+    // that tag when the requests inside it are parsed.
+    static void SetCommand(uint8_t command) noexcept {
+        detail::LatencyRequest& r = detail::t_latency;
+        if (r.active && command < kLatencyCommands && r.command != kLatencyBatch) r.command = command;
+    }
+    static void SetCommand(Command c) noexcept { SetCommand(static_cast<uint8_t>(c)); }
+    static void SetAdapter(uint8_t adapter) noexcept {
+        detail::LatencyRequest& r = detail::t_latency;
+        if (r.active && adapter < kLatencyAdapters) r.adapter = adapter;
+    }
+
+private:
+    bool m_owner;
+};
+
+// Runtime switch (config "latencyStats"); scopes opened while off record nothing.
+void LatencySetEnabled(bool enabled) noexcept;
+bool LatencyEnabled() noexcept;
+
+// Small id for an adapter name, for LatencyScope::SetAdapter. The first
+// kLatencyAdapters - 1 distinct names get their own id; later ones share
+// the last.
+uint8_t LatencyAdapterId(std::string_view name) noexcept;
+
+// Everything recorded so far, merged across threads, in nanoseconds.
+struct LatencySummary {
+    uint64_t count = 0;
+    uint64_t p50 = 0, p99 = 0, p999 = 0, max = 0;
+    uint64_t mean = 0;
+};
+LatencySummary LatencyQuery(Stage s, uint8_t command, std::string_view adapter);
+
+// A table with one row per (command, adapter, stage) that has samples:
+//   command   adapter  stage        count   p50_ns   p99_ns  p999_ns   max_ns
+// Empty if nothing was recorded.
+std::string LatencyReport();
+
+// Every sample of stage 's' so far, over all commands and adapters, added
+// into 'buckets' (LatencyHistogram::kBuckets tick counts). Returns the
+// number of samples and adds their sum and raises 'maxTicks'. For the
+// shared stats segment (SharedStats.h).
+uint64_t LatencyStageBuckets(Stage s, uint64_t* buckets, uint64_t& sumTicks, uint64_t& maxTicks) noexcept;
+
+// Clock ticks per nanosecond for the values above. Waits until the clock has
+// been measured against steady_clock for 20 ms after startup.
+double LatencyTicksPerNs() noexcept;
+
+// LatencyReport into a caller's buffer, cut to capacity - 1 characters and
+// NUL-terminated. Returns the full report length, so a caller can size the
+// buffer by passing capacity 0. For the GET_STATS exports.
+int LatencyReport(char* buffer, int capacity) noexcept;
+
+} // namespace Bridge
+
+#if BRIDGE_LATENCY_STATS
+#define BRIDGE_LATENCY_SCOPE()           ::Bridge::LatencyScope bridgeLatencyScope_
+#define BRIDGE_LATENCY_MARK(stage)       ::Bridge::LatencyScope::Mark(::Bridge::Stage::stage)
+#define BRIDGE_LATENCY_COMMAND(command)  ::Bridge::LatencyScope::SetCommand(command)
+#define BRIDGE_LATENCY_ADAPTER(adapter)  ::Bridge::LatencyScope::SetAdapter(adapter)
+#else
+#define BRIDGE_LATENCY_SCOPE()           ((void)0)
+#define BRIDGE_LATENCY_MARK(stage)       ((void)0)
+#define BRIDGE_LATENCY_COMMAND(command)  ((void)sizeof(command))
+#define BRIDGE_LATENCY_ADAPTER(adapter)  ((void)sizeof(adapter))
+#endif
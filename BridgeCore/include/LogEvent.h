@@ -0,0 +1,124 @@
+#pragma once
+#include "Logger.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace Bridge {
+
+// Structured logging: a log statement records a static format and its raw
+// arguments; the text is only built by the writer thread (text logs) or by
+// BridgeLogcat (binary logs). The calling thread pays for packing a few
+// dozen bytes instead of string concatenation and number formatting.
+//
+//   static constexpr LogFormat kFill("[REQ-{:04}] filled qty={} px={}");
+//   LogEvent(LogLevel::INFO, kFill, id, qty, px);
+//
+// {} takes the next argument; {:0N} zero-pads an integer to N digits.
+
+// A format string. Give formats static storage duration: queued records
+// refer to them by pointer, and a binary log numbers them by address.
+class LogFormat {
+public:
+    constexpr explicit LogFormat(const char* text) noexcept : m_text(text) {}
+
+    LogFormat(const LogFormat&) = delete;
+    LogFormat& operator=(const LogFormat&) = delete;
+
+    constexpr const char* Text() const noexcept { return m_text; }
+
+private:
+    const char* m_text;
+};
+
+constexpr size_t kLogArgBytes    = 192;   // packed argument bytes per statement
+constexpr size_t kLogMaxStrBytes = 64;    // longer string arguments are cut
+
+// Argument encoding: a tag byte, then 8 raw bytes for numbers, or a length
+// byte and the characters for strings.
+enum class LogArgType : uint8_t { Int = 'i', UInt = 'u', Double = 'd', Str = 's' };
+
+// Packed arguments of one statement. Arguments that no longer fit are left
+// out and print as "?".
+struct LogArgs {
+    uint8_t       size = 0;
+    unsigned char bytes[kLogArgBytes];   // not zeroed: only 'size' bytes are ever read
+
+    template <typename T, std::enable_if_t<std::is_integral_v<T>, int> = 0>
+    void Put(T v) noexcept {
+        if constexpr (std::is_signed_v<T> || std::is_same_v<T, bool>)
+            PutRaw(LogArgType::Int, static_cast<int64_t>(v));
+        else
+            PutRaw(LogArgType::UInt, static_cast<uint64_t>(v));
+    }
+    void Put(double v) noexcept { PutRaw(LogArgType::Double, v); }
+    void Put(const char* s) noexcept { Put(std::string_view(s ? s : "<null>")); }
+    void Put(const std::string& s) noexcept { Put(std::string_view(s)); }
+    void Put(std::string_view s) noexcept {
+        size_t room = kLogArgBytes - size;
+        if (room < 2) return;
+        size_t n = s.size();
+        if (n > kLogMaxStrBytes) n = kLogMaxStrBytes;
+        if (n > room - 2)        n = room - 2;
+        bytes[size]     = static_cast<unsigned char>(LogArgType::Str);
+        bytes[size + 1] = static_cast<unsigned char>(n);
+        std::memcpy(bytes + size + 2, s.data(), n);
+        size = static_cast<uint8_t>(size + 2 + n);
+    }
+
+private:
+    template <typename V>
+    void PutRaw(LogArgType type, V v) noexcept {
+        static_assert(sizeof(V) == 8);
+        if (kLogArgBytes - size < 9) return;
+        bytes[size] = static_cast<unsigned char>(type);
+        std::memcpy(bytes + size + 1, &v, 8);
+        size = static_cast<uint8_t>(size + 9);
+    }
+};
+
+static_assert(kLogArgBytes <= 255, "LogArgs::size is one byte");
+
+// Queue a packed statement. Same ring, flush and drop policy as Log().
+void LogPacked(LogLevel level, const LogFormat& format, const LogArgs& args) noexcept;
+
+template <typename... A>
+inline void LogEvent(LogLevel level, const LogFormat& format, const A&... args) noexcept {
+    LogArgs packed;
+    (packed.Put(args), ...);
+    LogPacked(level, format, packed);
+}
+
+// Append the text of a statement to 'out'.
+void FormatLogEvent(std::string& out, const char* format, const unsigned char* args, size_t size);
+
+} // namespace Bridge
+
+// Level-gated LogEvent, like BRIDGE_LOG_* in Logger.h: arguments are not
+// evaluated unless the level is enabled.
+//
+//   BRIDGE_EVENT_DEBUG(kExecuted, id, rc);
+#define BRIDGE_EVENT_AT(level, ...)                                              \
+    do {                                                                         \
+        if (::Bridge::LogEnabled(level)) ::Bridge::LogEvent(level, __VA_ARGS__); \
+    } while (0)
+
+#if BRIDGE_LOG_COMPILE_MIN_LEVEL <= 0
+#define BRIDGE_EVENT_DEBUG(...) BRIDGE_EVENT_AT(::Bridge::LogLevel::DEBUG_, __VA_ARGS__)
+#else
+#define BRIDGE_EVENT_DEBUG(...) ((void)0)
+#endif
+#if BRIDGE_LOG_COMPILE_MIN_LEVEL <= 1
+#define BRIDGE_EVENT_INFO(...) BRIDGE_EVENT_AT(::Bridge::LogLevel::INFO, __VA_ARGS__)
+#else
+#define BRIDGE_EVENT_INFO(...) ((void)0)
+#endif
+#if BRIDGE_LOG_COMPILE_MIN_LEVEL <= 2
+#define BRIDGE_EVENT_WARN(...) BRIDGE_EVENT_AT(::Bridge::LogLevel::WARNING_, __VA_ARGS__)
+#else
+#define BRIDGE_EVENT_WARN(...) ((void)0)
+#endif
+#define BRIDGE_EVENT_ERROR(...) BRIDGE_EVENT_AT(::Bridge::LogLevel::ERROR_, __VA_ARGS__)
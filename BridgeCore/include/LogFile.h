@@ -0,0 +1,81 @@
+#pragma once
+#include "MappedFile.h"
+#include <chrono>
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace Bridge {
+
+// The file the log writer thread appends to. Not thread-safe: only the
+// writer touches it.
+//
+// Without rotation it is a plain append-mode stream. With rotation the live
+// file is preallocated (fallocate / SetFileInformationByHandle) and written
+// through a memory mapping, so an append is a memcpy. Rotate() cuts the live
+// file to its used length and renames it to <stem>.<yyyymmdd-hhmmss><ext>;
+// the next segment, preallocated ahead of time as <stem>.next<ext>, takes
+// its place, and archived segments beyond keepSegments are deleted.
+//
+// After a crash the live file ends in zeros (unused preallocated space);
+// the next Open continues after the last line or binary record.
+class LogFile {
+public:
+    struct Options {
+        std::string path;
+        size_t      segmentBytes  = 0;    // rotate before a segment grows past this; 0 = no limit
+        int         rotateMinutes = 0;    // rotate segments open this long; 0 = never by age
+        int         keepSegments  = 10;   // archived segments kept; 0 = keep all
+        bool        binary        = false;   // BinaryLog content (find its end by parsing it)
+    };
+
+    LogFile() = default;
+    ~LogFile() { Close(); }
+
+    LogFile(const LogFile&) = delete;
+    LogFile& operator=(const LogFile&) = delete;
+
+    // Open 'options.path' for appending. A live segment already over
+    // segmentBytes is archived first.
+    bool Open(const Options& options) noexcept;
+    void Close() noexcept;
+    bool IsOpen() const noexcept { return m_mapped ? m_map.IsOpen() : m_stream.is_open(); }
+    bool Rotating() const noexcept { return m_mapped; }
+
+    void Write(const char* data, size_t size);
+    void Flush() noexcept;
+
+    // Bytes in the live segment.
+    size_t Used() const noexcept { return m_used; }
+
+    // True if writing 'pending' more bytes would take the live segment past
+    // segmentBytes, or if it has been open for rotateMinutes.
+    bool SizeDue(size_t pending) const noexcept;
+    bool AgeDue() const noexcept;
+
+    // Archive the live segment and continue in an empty one. False if the
+    // live file could not be renamed; writing then continues where it was
+    // and rotation is not due again for a while.
+    bool Rotate() noexcept;
+
+    // Archived segments of 'path', oldest first.
+    static std::vector<std::string> ArchivedSegments(const std::string& path);
+
+private:
+    bool MapLive() noexcept;
+    void PrepareNext() noexcept;
+    void Prune() noexcept;
+    size_t Reserve() const noexcept;
+
+    Options       m_opts;
+    bool          m_mapped = false;
+    std::ofstream m_stream;
+    MappedFile    m_map;
+    size_t        m_used = 0;
+    std::string   m_next;   // preallocated next segment; empty if that failed
+    std::chrono::steady_clock::time_point m_opened{};
+    std::chrono::steady_clock::time_point m_retryAt{};   // no rotation before this
+};
+
+} // namespace Bridge
@@ -1,16 +1,105 @@
 #pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <utility>
 
 namespace Bridge {
 
 enum class LogLevel { DEBUG_, INFO, WARNING_, ERROR_ };
 
+// Lowest level compiled in by the BRIDGE_LOG_* / BRIDGE_EVENT_* macros
+// (0 = DEBUG ... 3 = ERROR). Release builds drop DEBUG statements entirely.
+#ifndef BRIDGE_LOG_COMPILE_MIN_LEVEL
+#ifdef NDEBUG
+#define BRIDGE_LOG_COMPILE_MIN_LEVEL 1
+#else
+#define BRIDGE_LOG_COMPILE_MIN_LEVEL 0
+#endif
+#endif
+
+// Log calls only timestamp the message and queue it; a background thread
+// formats and writes queued lines in batches.
+struct LogOptions {
+    std::string filePath;                 // empty = no file
+    bool        toConsole       = false;
+    int         flushIntervalMs = 200;    // longest a line waits to reach disk; ERROR lines flush at once
+    size_t      queueDepth      = 8192;   // lines that can wait for the writer; fixed by the first LogInit
+    bool        blockWhenFull   = false;  // wait for room instead of dropping the line
+    LogLevel    minLevel        = LogLevel::INFO;   // lower levels are discarded
+    bool        binary          = false;  // write BinaryLog records to filePath with a .blog
+                                          // extension, for BridgeLogcat; no console output
+    // Rolling segments (see LogFile.h); both 0 = one ever-growing file.
+    size_t      segmentBytes    = 0;      // start a new segment before the file passes this size
+    int         rotateMinutes   = 0;      // start a new segment after this long
+    int         keepSegments    = 10;     // older segments are deleted; 0 = keep all
+};
+
+// (Re)configure logging. Lines already queued are written to the previous
+// file first. Until the first call, log lines are discarded.
+void LogInit(const LogOptions& options) noexcept;
 void LogInit(const std::string& filePath, bool logToConsole = false) noexcept;
-void Log(LogLevel level, const std::string& message) noexcept;
 
-inline void LogInfo   (const std::string& msg) noexcept { Log(LogLevel::INFO,     msg); }
-inline void LogWarning(const std::string& msg) noexcept { Log(LogLevel::WARNING_, msg); }
-inline void LogError  (const std::string& msg) noexcept { Log(LogLevel::ERROR_,   msg); }
-inline void LogDebug  (const std::string& msg) noexcept { Log(LogLevel::DEBUG_,   msg); }
+// Write what is queued and stop the writer thread; later lines are discarded
+// until the next LogInit. Nothing else may be logging at the time.
+void LogShutdown() noexcept;
+
+// Lines below 'level' are discarded (LogInit sets it from LogOptions).
+void LogSetLevel(LogLevel level) noexcept;
+
+namespace detail {
+extern std::atomic<int> g_logMinLevel;
+}
+
+// True if a line at 'level' would be written: one relaxed load.
+inline bool LogEnabled(LogLevel level) noexcept {
+    return static_cast<int>(level) >= detail::g_logMinLevel.load(std::memory_order_relaxed);
+}
+
+void Log(LogLevel level, std::string message) noexcept;
+
+// "DEBUG", "INFO ", "WARN ", "ERROR": the level column of a log line.
+const char* LogLevelName(LogLevel level) noexcept;
+
+// Write and flush every line logged before the call.
+void LogFlush() noexcept;
+
+// Lines discarded because the queue was full (never with blockWhenFull).
+uint64_t LogDropped() noexcept;
+
+// Lines waiting for the writer thread right now (approximate).
+size_t LogQueued() noexcept;
+
+inline void LogInfo   (std::string msg) noexcept { Log(LogLevel::INFO,     std::move(msg)); }
+inline void LogWarning(std::string msg) noexcept { Log(LogLevel::WARNING_, std::move(msg)); }
+inline void LogError  (std::string msg) noexcept { Log(LogLevel::ERROR_,   std::move(msg)); }
+inline void LogDebug  (std::string msg) noexcept { Log(LogLevel::DEBUG_,   std::move(msg)); }
 
 } // namespace Bridge
+
+// Level-gated logging: the message expression is evaluated only if the level
+// is enabled, and not compiled at all below BRIDGE_LOG_COMPILE_MIN_LEVEL.
+//
+//   BRIDGE_LOG_DEBUG("queue depth=" + std::to_string(depth));
+#define BRIDGE_LOG_AT(level, ...)                                           \
+    do {                                                                    \
+        if (::Bridge::LogEnabled(level)) ::Bridge::Log(level, __VA_ARGS__); \
+    } while (0)
+
+#if BRIDGE_LOG_COMPILE_MIN_LEVEL <= 0
+#define BRIDGE_LOG_DEBUG(...) BRIDGE_LOG_AT(::Bridge::LogLevel::DEBUG_, __VA_ARGS__)
+#else
+#define BRIDGE_LOG_DEBUG(...) ((void)0)
+#endif
+#if BRIDGE_LOG_COMPILE_MIN_LEVEL <= 1
+#define BRIDGE_LOG_INFO(...) BRIDGE_LOG_AT(::Bridge::LogLevel::INFO, __VA_ARGS__)
+#else
+#define BRIDGE_LOG_INFO(...) ((void)0)
+#endif
+#if BRIDGE_LOG_COMPILE_MIN_LEVEL <= 2
+#define BRIDGE_LOG_WARN(...) BRIDGE_LOG_AT(::Bridge::LogLevel::WARNING_, __VA_ARGS__)
+#else
+#define BRIDGE_LOG_WARN(...) ((void)0)
+#endif
+#define BRIDGE_LOG_ERROR(...) BRIDGE_LOG_AT(::Bridge::LogLevel::ERROR_, __VA_ARGS__)
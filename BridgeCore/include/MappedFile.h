@@ -0,0 +1,59 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+namespace Bridge {
+
+// A file mapped into memory, read-only or read-write. Read-write files can
+// be grown or shrunk in place with Resize, which remaps them: pointers into
+// the old mapping are invalid afterwards.
+class MappedFile {
+public:
+    enum class Mode { ReadOnly, ReadWrite };
+
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Map 'path'. ReadWrite creates the file if needed and extends it to at
+    // least 'minSize' bytes (new bytes read as zero). Returns false on any
+    // I/O error, or if the mapping would be empty.
+    bool Open(const std::string& path, Mode mode, size_t minSize = 0) noexcept;
+
+    // Create 'path' if needed and reserve disk space for 'size' bytes, so
+    // later writes through a mapping do not allocate blocks one page at a
+    // time. The file's length becomes at least 'size'.
+    static bool Preallocate(const std::string& path, size_t size) noexcept;
+
+    // Change the file's length and remap it. ReadWrite only.
+    bool Resize(size_t size) noexcept;
+
+    // Ask the OS to write dirty pages back (asynchronously).
+    void Flush() noexcept;
+
+    // Unmap and close; a ReadWrite file is first cut to 'finalSize' bytes
+    // if that is smaller than its mapped size.
+    void Close(size_t finalSize = static_cast<size_t>(-1)) noexcept;
+
+    bool   IsOpen() const noexcept { return m_data != nullptr; }
+    char*  Data()   const noexcept { return m_data; }
+    size_t Size()   const noexcept { return m_size; }
+
+private:
+    bool Map() noexcept;
+    void Unmap() noexcept;
+
+    char*  m_data = nullptr;
+    size_t m_size = 0;
+    Mode   m_mode = Mode::ReadOnly;
+#ifdef _WIN32
+    void*  m_file    = nullptr;   // HANDLE
+    void*  m_mapping = nullptr;   // HANDLE
+#else
+    int    m_fd = -1;
+#endif
+};
+
+} // namespace Bridge
@@ -0,0 +1,53 @@
+#pragma once
+#include "PriceLevelBook.h"
+#include "Types.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Bridge {
+
+struct MarketEvent {
+    enum class Kind : uint8_t { Trade, Quote };
+
+    uint64_t   timeUs     = 0;
+    SymbolId   instrument = kNoSymbol;
+    Kind       kind       = Kind::Trade;
+    PriceTicks price      = 0;   // trade price, or best bid
+    int        size       = 0;   // trade size, or bid size
+    PriceTicks ask        = 0;   // quotes only
+    int        askSize    = 0;   // quotes only
+};
+
+// A recorded market data session, parsed up front so replay is a walk over
+// a flat array. One event per line, comma separated:
+//   <timeUs>,T,<instrument>,<price>,<size>
+//   <timeUs>,Q,<instrument>,<bid>,<bidSize>,<ask>,<askSize>
+// Blank lines and lines starting with '#' are skipped. Instruments are
+// interned, so events carry the same SymbolIds as parsed orders.
+class MarketDataFeed {
+public:
+    // Append the events in a file. Returns RC_SUCCESS, RC_CONFIG_ERR if the
+    // file cannot be read, or RC_INVALID_PARAM if a line is malformed (see
+    // ErrorLine); events before the bad line are kept.
+    int Load(const std::string& path) noexcept;
+
+    // Same, from text already in memory.
+    int Parse(std::string_view text) noexcept;
+
+    const std::vector<MarketEvent>& Events() const noexcept { return m_events; }
+    size_t Size() const noexcept { return m_events.size(); }
+    void   Add(const MarketEvent& ev) { m_events.push_back(ev); }
+    void   Clear() noexcept { m_events.clear(); m_errorLine = 0; }
+
+    // 1-based line of the last parse failure, or 0.
+    size_t ErrorLine() const noexcept { return m_errorLine; }
+
+private:
+    std::vector<MarketEvent> m_events;
+    size_t                   m_errorLine = 0;
+};
+
+} // namespace Bridge
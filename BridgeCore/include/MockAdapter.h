@@ -1,41 +1,43 @@
 #pragma once
 #include "IBrokerAdapter.h"
+#include "OrderStore.h"
 #include <string>
-#include <unordered_map>
 #include <vector>
+#include <atomic>
+#include <chrono>
 #include <mutex>
 
 namespace Bridge {
 
-struct MockOrder {
-    std::string orderId;
-    std::string account;
-    std::string instrument;
-    Action      action;
-    int         quantity;
-    OrderType   orderType;
-    double      limitPrice;
-    double      stopPrice;
-    TimeInForce timeInForce;
-    bool        working; // true = open/working, false = cancelled/filled
-};
-
 class MockAdapter : public IBrokerAdapter {
 public:
     MockAdapter() = default;
 
     bool IsConnected() const noexcept override { return true; }
+    // State is guarded by one mutex and simulated latency is spent outside
+    // it, so concurrent accounts overlap the way a real broker would allow.
+    bool IsShardSafe() const noexcept override { return true; }
     int  Execute(const OrderRequest& req) override;
+    void ExecuteBatch(const OrderRequest* reqs, size_t count, int* results) override;
 
     // Test helpers
-    const std::vector<MockOrder>& GetOrders() const noexcept { return m_orders; }
-    void Clear() noexcept { std::lock_guard<std::mutex> lk(m_mutex); m_orders.clear(); m_nextId = 1; }
+    // Every order placed since the last Clear(), in placement order. A copy:
+    // the store keeps working and archived orders apart.
+    std::vector<MockOrder> GetOrders() const { std::lock_guard<std::mutex> lk(m_mutex); return m_store.Snapshot(); }
+    size_t WorkingCount() const { std::lock_guard<std::mutex> lk(m_mutex); return m_store.WorkingCount(); }
+    void Clear() { std::lock_guard<std::mutex> lk(m_mutex); m_store.Clear(); }
+
+    // Simulated broker round trip added to every Execute/ExecuteBatch call.
+    void SetLatency(std::chrono::microseconds latency) noexcept { m_latencyUs.store(latency.count()); }
 
 private:
-    std::vector<MockOrder> m_orders;
-    std::mutex             m_mutex;
-    int                    m_nextId = 1;
+    OrderStore             m_store;
+    mutable std::mutex     m_mutex;
+    std::atomic<long long> m_latencyUs{ 0 };
+
+    void simulateLatency() const;
 
+    int dispatch(const OrderRequest& req);
     int doPlace(const OrderRequest& req);
     int doCancel(const OrderRequest& req);
     int doCancelAll(const OrderRequest& req);
@@ -0,0 +1,40 @@
+#pragma once
+#include "Types.h"
+#include <cstddef>
+#include <string_view>
+#include <system_error>
+
+namespace Bridge {
+
+// Locale-independent, exception-free number parsing built on std::from_chars.
+// The whole of 's' must be consumed (one leading '+' is accepted).
+// Returns std::errc{} on success, std::errc::invalid_argument for empty or
+// malformed text, std::errc::result_out_of_range if the value does not fit.
+std::errc ParseInt   (std::string_view s, int& out)    noexcept;
+std::errc ParseDouble(std::string_view s, double& out) noexcept;
+
+// Parse a decimal price exactly, without going through binary floating point:
+// "4200.25" -> { ticks = 420025, scale = 2 }. Exponent forms ("4.2e3") are
+// accepted via ParseDouble + PriceFromDouble.
+std::errc ParsePrice(std::string_view s, FixedPrice& out) noexcept;
+
+// Convert a double, rounded to kMaxScale decimals with trailing zeros dropped.
+// Non-finite or out-of-range input yields an unset price.
+FixedPrice PriceFromDouble(double v) noexcept;
+
+// Correctly rounded while |ticks| < 2^53. Unset prices convert to 0.0.
+double PriceToDouble(const FixedPrice& p) noexcept;
+
+// Re-express 'p' at an instrument's scale. Fails with
+// std::errc::invalid_argument if precision would be lost or p is unset, and
+// std::errc::result_out_of_range on overflow.
+std::errc RescalePrice(const FixedPrice& p, uint8_t scale, FixedPrice& out) noexcept;
+
+// Three-way compare of two set prices (<0, 0, >0); scales may differ.
+int ComparePrice(const FixedPrice& a, const FixedPrice& b) noexcept;
+
+// Write 'p' as decimal text (not NUL-terminated). Returns the number of
+// chars written, or 0 if 'p' is unset or 'cap' is too small.
+size_t FormatPrice(const FixedPrice& p, char* buf, size_t cap) noexcept;
+
+} // namespace Bridge
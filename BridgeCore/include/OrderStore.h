@@ -0,0 +1,122 @@
+#pragma once
+#include "Types.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace Bridge {
+
+struct MockOrder {
+    std::string orderId;
+    SymbolId    account;
+    SymbolId    instrument;
+    Action      action;
+    int         quantity;
+    OrderType   orderType;
+    double      limitPrice;
+    double      stopPrice;
+    FixedPrice  limitPx;
+    FixedPrice  stopPx;
+    TimeInForce timeInForce;
+    bool        working; // true = open/working, false = cancelled/filled
+    uint64_t    sequence; // placement order, from 1
+};
+
+// Order ids of the form "<prefix><n>", kept as text and incremented in
+// place, so issuing one is a few byte compares rather than a format call.
+class OrderIdCounter {
+public:
+    explicit OrderIdCounter(std::string_view prefix);
+
+    // Next id ("MOCK-1", "MOCK-2", ...). The view is valid until the next call.
+    std::string_view Next() noexcept;
+    void             Reset() noexcept;
+
+private:
+    static constexpr size_t kCap = 48;
+    char   m_buf[kCap];
+    size_t m_prefixLen;
+    size_t m_len;
+};
+
+// Working orders indexed for O(matches) cancels, plus an archive of
+// terminal ones.
+//
+// Working orders live in slots of a structure-of-arrays table, so a cancel
+// walks only the columns it needs. Each slot is on two intrusive lists:
+// one per (account, instrument) and one per account, whose heads are
+// found through hash maps. Cancelling unlinks the slot, moves the order to
+// the cold archive and puts the slot on a free list for reuse, so the
+// working table stays as small as the set of open orders.
+class OrderStore {
+public:
+    OrderStore();
+
+    // Add a working order; returns its id.
+    std::string_view Add(const OrderRequest& req, SymbolId account, SymbolId instrument);
+
+    // Cancel working orders; each returns how many were cancelled.
+    size_t CancelWorking(SymbolId account, SymbolId instrument);
+    size_t CancelAccount(SymbolId account);
+    size_t CancelAll();
+
+    size_t WorkingCount() const noexcept { return m_workingCount; }
+    size_t WorkingCount(SymbolId account, SymbolId instrument) const;
+    size_t ArchivedCount() const noexcept { return m_archive.size(); }
+    size_t SlotCount() const noexcept { return m_sequence.size(); }   // high-water mark of working orders
+
+    // Every order ever added, working and archived, in placement order.
+    std::vector<MockOrder> Snapshot() const;
+
+    void Clear();
+
+private:
+    using Slot = uint32_t;
+    static constexpr Slot kNil = UINT32_MAX;
+
+    struct OrderIdText {
+        char    text[24];
+        uint8_t len;
+    };
+
+    static uint64_t KeyOf(SymbolId account, SymbolId instrument) noexcept {
+        return (static_cast<uint64_t>(account) << 32) | instrument;
+    }
+
+    Slot AllocSlot();
+    void LinkKey(Slot s, uint64_t key);
+    void UnlinkKey(Slot s);
+    void LinkAccount(Slot s, SymbolId account);
+    void UnlinkAccount(Slot s);
+    void Retire(Slot s);                  // archive, unlink, free
+    MockOrder Materialize(Slot s, bool working) const;
+
+    // Hot columns, indexed by slot.
+    std::vector<uint64_t>    m_sequence;    // 0 = free slot
+    std::vector<SymbolId>    m_account;
+    std::vector<SymbolId>    m_instrument;
+    std::vector<Slot>        m_keyPrev, m_keyNext;
+    std::vector<Slot>        m_acctPrev, m_acctNext;
+    // Cold columns, only read when an order is archived or snapshotted.
+    std::vector<Action>      m_action;
+    std::vector<int>         m_quantity;
+    std::vector<OrderType>   m_orderType;
+    std::vector<TimeInForce> m_timeInForce;
+    std::vector<double>      m_limitPrice, m_stopPrice;
+    std::vector<FixedPrice>  m_limitPx, m_stopPx;
+    std::vector<OrderIdText> m_orderId;
+
+    std::vector<Slot>                  m_free;
+    std::unordered_map<uint64_t, Slot> m_keyHead;     // (account, instrument) -> first slot
+    std::unordered_map<SymbolId, Slot> m_acctHead;    // account -> first slot
+    size_t                             m_workingCount = 0;
+    uint64_t                           m_nextSequence = 1;
+    OrderIdCounter                     m_ids;
+
+    std::vector<MockOrder>             m_archive;     // terminal orders, in retirement order
+};
+
+} // namespace Bridge
@@ -1,14 +1,17 @@
 #pragma once
 #include "Types.h"
 #include <string>
+#include <string_view>
 
 namespace Bridge {
 
 // Parse pipe-delimited payload of the form:
 //   command=PLACE|account=ACC1|instrument=ES|action=BUY|quantity=1|
 //   orderType=MARKET|limitPrice=0|stopPrice=0|timeInForce=DAY
+// The payload is walked once in place; no heap allocation is made unless
+// account/instrument outgrow the strings' small-buffer storage.
 // Returns RC_SUCCESS or a negative error code.
-int ParsePayload(const std::string& payload, OrderRequest& out) noexcept;
+int ParsePayload(std::string_view payload, OrderRequest& out) noexcept;
 
 // Build an OrderRequest from individual wide-string parameters.
 int BuildRequest(const wchar_t* command,
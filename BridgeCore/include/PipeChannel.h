@@ -0,0 +1,70 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+namespace Bridge {
+
+// A local byte stream to the .NET worker: a named pipe on Windows, a Unix
+// domain socket elsewhere - which is what .NET's NamedPipeServerStream uses
+// on Linux and macOS, so the same pipe name reaches the same worker. Listen
+// and Accept serve the other end, for local stand-ins in tests.
+//
+// Same contract as Socket: one thread may Receive while others Send; Close
+// must not race either. Shutdown is safe from any thread and makes a pending
+// or later Receive return -1.
+class PipeChannel {
+public:
+    PipeChannel() = default;
+    ~PipeChannel();
+
+    PipeChannel(PipeChannel&& other) noexcept;
+    PipeChannel& operator=(PipeChannel&& other) noexcept;
+    PipeChannel(const PipeChannel&) = delete;
+    PipeChannel& operator=(const PipeChannel&) = delete;
+
+    // Where pipe 'name' lives: \\.\pipe\<name> on Windows, <tmp>/CoreFxPipe_<name>
+    // elsewhere (as .NET names it). A name that already is a path is kept.
+    static std::string PathOf(const std::string& name);
+
+    // Connect to pipe 'name', waiting up to timeoutMs while the server is
+    // busy. Not open on failure.
+    static PipeChannel Connect(const std::string& name, int timeoutMs) noexcept;
+
+    // Serve pipe 'name'. Elsewhere than on Windows a stale socket file left
+    // by a previous server is replaced.
+    static PipeChannel Listen(const std::string& name) noexcept;
+
+    // Wait up to timeoutMs for a client on a listening channel. On Windows
+    // the listening instance becomes the connection and a new instance
+    // takes its place.
+    PipeChannel Accept(int timeoutMs) noexcept;
+
+    bool IsOpen() const noexcept { return m_handle != kInvalid; }
+
+    // Write all of 'data'. False if the connection failed.
+    bool SendAll(const char* data, size_t len) noexcept;
+
+    // Wait up to timeoutMs for data and read what is there. Returns the
+    // byte count, 0 on timeout, or -1 once the peer has closed, the
+    // connection failed or Shutdown was called.
+    int Receive(char* buf, size_t cap, int timeoutMs) noexcept;
+
+    void Shutdown() noexcept;
+    void Close() noexcept;
+
+private:
+    static constexpr intptr_t kInvalid = -1;
+
+    PipeChannel(intptr_t handle, std::string path, bool listening) noexcept
+        : m_handle(handle), m_path(std::move(path)), m_listening(listening) {}
+
+    intptr_t          m_handle = kInvalid;   // HANDLE on Windows, fd elsewhere
+    std::string       m_path;
+    bool              m_listening = false;
+    std::atomic<bool> m_shut{ false };
+};
+
+} // namespace Bridge
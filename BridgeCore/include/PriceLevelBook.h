@@ -0,0 +1,117 @@
+#pragma once
+#include "Types.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Bridge {
+
+// Book prices are integer ticks at a fixed kBookScale decimals, so levels
+// compare as plain integers whatever scale the feed or caller quoted.
+using PriceTicks = int64_t;
+constexpr uint8_t kBookScale = 6;
+
+// Exact conversion; fails (returns false) if 'p' is unset, finer than
+// kBookScale or out of range.
+bool       ToBookPrice(const FixedPrice& p, PriceTicks& out) noexcept;
+FixedPrice FromBookPrice(PriceTicks ticks) noexcept;
+
+enum class BookSide : uint8_t { Bid, Ask };
+
+// Resting orders of one instrument in price-time priority.
+//
+// Each side is a flat array of price levels sorted with the best level at
+// the back (bids ascending, asks descending). Activity clusters at the
+// touch, so adding a level, emptying one and matching all work on the tail
+// of one contiguous array instead of walking tree nodes. Orders within a
+// level form a FIFO threaded through a shared node pool whose slots are
+// recycled.
+class PriceLevelBook {
+public:
+    using Handle = uint32_t;
+    static constexpr Handle kNoHandle = UINT32_MAX;
+
+    // Prices for orders that take any price (market orders waiting for
+    // liquidity); they sort ahead of every limit price.
+    static constexpr PriceTicks kMarketBid = INT64_MAX;
+    static constexpr PriceTicks kMarketAsk = INT64_MIN;
+
+    // Rest 'qty' at 'price' behind orders already there. 'tag' is handed
+    // back on fills.
+    Handle Add(BookSide side, PriceTicks price, int qty, uint64_t tag);
+
+    // Remove a resting order; returns its unfilled quantity, or 0 if the
+    // handle is not resting.
+    int Cancel(Handle h);
+
+    // Best price on a side; false if the side is empty.
+    bool   Best(BookSide side, PriceTicks& price) const noexcept;
+    int    QtyAt(BookSide side, PriceTicks price) const noexcept;
+    size_t LevelCount(BookSide side) const noexcept { return m_levels[Index(side)].size(); }
+    size_t OrderCount() const noexcept { return m_orders; }
+
+    // Fill up to 'qty' from orders on 'side' that trade at 'price': bids at
+    // or above it, asks at or below it. Better levels go first, older orders
+    // first within a level. For each fill, onFill(tag, fillQty, levelPrice,
+    // leavesQty) is called after a completed order has left the book; it
+    // must not modify the book. Returns the quantity filled.
+    template <typename F>
+    int Match(BookSide side, PriceTicks price, int qty, F&& onFill);
+
+    void Clear();
+
+private:
+    struct Level {
+        PriceTicks price;
+        int        qty;
+        Handle     head, tail;
+    };
+    struct Node {
+        uint64_t   tag;
+        PriceTicks price;
+        int        qty;      // 0 = free slot
+        Handle     prev, next;
+        BookSide   side;
+    };
+
+    static constexpr size_t Index(BookSide s) noexcept { return s == BookSide::Bid ? 0 : 1; }
+    // True if price 'a' is at least as aggressive as 'b' on 'side'.
+    static constexpr bool AtOrBetter(BookSide s, PriceTicks a, PriceTicks b) noexcept {
+        return s == BookSide::Bid ? a >= b : a <= b;
+    }
+
+    Level* FindLevel(BookSide side, PriceTicks price) noexcept;
+    const Level* FindLevel(BookSide side, PriceTicks price) const noexcept;
+    void   ReleaseFront(Level& level);
+
+    std::vector<Level>  m_levels[2];
+    std::vector<Node>   m_nodes;
+    std::vector<Handle> m_free;
+    size_t              m_orders = 0;
+};
+
+template <typename F>
+int PriceLevelBook::Match(BookSide side, PriceTicks price, int qty, F&& onFill) {
+    std::vector<Level>& levels = m_levels[Index(side)];
+    int filled = 0;
+    while (qty > 0 && !levels.empty()) {
+        Level& top = levels.back();
+        if (!AtOrBetter(side, top.price, price)) break;
+        while (qty > 0 && top.head != kNoHandle) {
+            Node& n = m_nodes[top.head];
+            int take = n.qty < qty ? n.qty : qty;
+            n.qty   -= take;
+            top.qty -= take;
+            qty     -= take;
+            filled  += take;
+            uint64_t tag    = n.tag;
+            int      leaves = n.qty;
+            if (leaves == 0) ReleaseFront(top);
+            onFill(tag, take, top.price, leaves);
+        }
+        if (top.head == kNoHandle) levels.pop_back();
+    }
+    return filled;
+}
+
+} // namespace Bridge
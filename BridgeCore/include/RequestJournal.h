@@ -0,0 +1,87 @@
+#pragma once
+#include "MappedFile.h"
+#include "Types.h"
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+namespace Bridge {
+
+// One journaled request and what became of it.
+struct JournalEntry {
+    OrderRequest req;
+    int64_t      timeNs     = 0;   // when the engine received it, ns since the Unix epoch
+    int64_t      durationNs = 0;   // from receipt to the return code
+    int          rc         = 0;
+    uint8_t      flags      = 0;   // RequestJournal::kAsync / kBatch
+};
+
+// Append-only binary record of every OrderRequest the engine executes,
+// written through a memory-mapped file so an append is a memcpy, not a
+// write() call.
+//
+// Layout: a 64-byte file header ("BRJRNL01", version) followed by records
+// aligned to 8 bytes. Each record is a fixed header holding the request's
+// fields, timestamp, duration and return code, then the account and
+// instrument text. A record's size field is stored last, with release
+// ordering, so a reader - or a restart after a crash - stops cleanly at
+// the first record that was never completed. The file grows in chunks and
+// is trimmed to its used length on Close.
+class RequestJournal {
+public:
+    static constexpr uint8_t kAsync = 0x01;   // came through ExecuteAsync
+    static constexpr uint8_t kBatch = 0x02;   // came through ExecuteBatch
+
+    RequestJournal() = default;
+    ~RequestJournal() { Close(); }
+
+    RequestJournal(const RequestJournal&) = delete;
+    RequestJournal& operator=(const RequestJournal&) = delete;
+
+    // Create 'path', or reopen an existing journal and append after its last
+    // complete record. Returns false on I/O errors or if the file is not a
+    // journal.
+    bool Open(const std::string& path) noexcept;
+    void Close() noexcept;
+    bool IsOpen() const noexcept { return m_file.IsOpen(); }
+
+    // Append one record. Thread-safe. Never throws; a record that cannot be
+    // written (disk full) is counted in Dropped().
+    void Append(const OrderRequest& req, int64_t timeNs, int64_t durationNs, int rc,
+                uint8_t flags = 0) noexcept;
+
+    uint64_t Records() const noexcept;
+    uint64_t Dropped() const noexcept;
+
+    // Wall-clock nanoseconds since the Unix epoch, as stored in timeNs.
+    static int64_t NowNs() noexcept;
+
+private:
+    bool Reserve(size_t bytes) noexcept;
+
+    mutable std::mutex m_mutex;
+    MappedFile         m_file;
+    size_t             m_used    = 0;
+    uint64_t           m_records = 0;
+    uint64_t           m_dropped = 0;
+};
+
+// Sequential reader over a journal file (which may still be being written).
+class JournalReader {
+public:
+    bool Open(const std::string& path) noexcept;
+
+    // Read the next complete record; false at the end of the journal or at
+    // a record that is damaged or still being written.
+    bool Next(JournalEntry& out);
+
+    void   Rewind() noexcept;
+    size_t Offset() const noexcept { return m_offset; }
+
+private:
+    MappedFile m_file;
+    size_t     m_offset = 0;
+};
+
+} // namespace Bridge
@@ -0,0 +1,139 @@
+#pragma once
+#include "LatencyStats.h"
+#include "Types.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Live counters published in a named shared-memory segment for monitors
+// such as BridgeTop. The order path only bumps per-thread counters
+// (CountRequest); the engine's stats thread sums them, together with queue
+// depths, adapter state and the latency histograms, into a StatsSnapshot
+// and copies that into the segment under a seqlock. Readers map the segment
+// read-only and never block the publisher.
+//
+// Segment names: "/<name>" (POSIX shm) on Linux, "Local\<name>" on Windows.
+
+namespace Bridge {
+
+// Return codes are counted in slots RC_TIMEOUT..RC_PENDING, plus one slot
+// for anything else.
+constexpr int     kStatsResults  = RC_PENDING - RC_TIMEOUT + 2;
+constexpr uint8_t kStatsCommands = static_cast<uint8_t>(Command::UNKNOWN) + 1;
+constexpr size_t  kStatsStages   = static_cast<size_t>(Stage::Count);
+
+constexpr int StatsResultSlot(int rc) noexcept {
+    return rc >= RC_TIMEOUT && rc <= RC_PENDING ? rc - RC_TIMEOUT : kStatsResults - 1;
+}
+
+// "OK", "REJECTED", ... for a StatsResultSlot; "OTHER" for the last slot.
+const char* StatsResultName(int slot) noexcept;
+
+// "PLACE", "CANCEL", ... for a StatsSnapshot::requests row.
+const char* StatsCommandName(size_t command) noexcept;
+
+namespace detail {
+
+struct RequestCounters {
+    std::atomic<uint64_t> n[kStatsCommands][kStatsResults] = {};
+};
+extern constinit thread_local RequestCounters* t_requestCounters;
+
+RequestCounters* AcquireRequestCounters() noexcept;
+
+} // namespace detail
+
+// Count one finished request. Per-thread counter, plain relaxed store: no
+// lock, no atomic read-modify-write, nothing shared with other threads.
+inline void CountRequest(Command command, int rc) noexcept {
+    detail::RequestCounters* c = detail::t_requestCounters;
+    if (!c && !(c = detail::AcquireRequestCounters())) return;
+    size_t cmd = static_cast<size_t>(command) < kStatsCommands ? static_cast<size_t>(command)
+                                                              : static_cast<size_t>(Command::UNKNOWN);
+    std::atomic<uint64_t>& n = c->n[cmd][StatsResultSlot(rc)];
+    n.store(n.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+// What a monitor sees. Plain data: the segment carries it word for word.
+struct StatsSnapshot {
+    uint64_t publishedNs = 0;         // publisher's steady clock; 0 = nothing published yet
+    char     adapter[32] = {};        // adapterType, NUL-terminated
+    uint64_t connected      = 0;
+    uint64_t lanes          = 0;      // async lanes started (0 until the first async order)
+    uint64_t asyncQueued    = 0;      // async orders waiting, all lanes
+    uint64_t asyncCapacity  = 0;
+    uint64_t logQueued      = 0;
+    uint64_t logDropped     = 0;
+    uint64_t dedupHits      = 0;
+    uint64_t dedupMisses    = 0;
+    uint64_t journaled      = 0;
+    uint64_t requests[kStatsCommands][kStatsResults] = {};   // by command and StatsResultSlot
+
+    // Latency per stage over all commands and adapters, in clock ticks
+    // (ticksPerNs converts), as LatencyHistogram buckets.
+    double   ticksPerNs = 1.0;
+    uint64_t latencyCount[kStatsStages]    = {};
+    uint64_t latencySum[kStatsStages]      = {};
+    uint64_t latencyMax[kStatsStages]      = {};
+    uint64_t latencyBuckets[kStatsStages][LatencyHistogram::kBuckets] = {};
+};
+
+// Add every thread's CountRequest counters and the latency histograms into
+// 'out' (requests, ticksPerNs and latency*). The caller fills in the rest.
+void CollectStats(StatsSnapshot& out) noexcept;
+
+// Upper bound, in ticks, of the bucket holding quantile q of 'buckets'
+// (LatencyHistogram::kBuckets counts). 0 if there are no samples.
+uint64_t StatsPercentile(const uint64_t* buckets, double q) noexcept;
+
+// The named segment: one publisher creates it, any number of readers open
+// it read-only.
+class SharedStatsSegment {
+public:
+    SharedStatsSegment() = default;
+    ~SharedStatsSegment();
+
+    SharedStatsSegment(const SharedStatsSegment&) = delete;
+    SharedStatsSegment& operator=(const SharedStatsSegment&) = delete;
+
+    // Become the publisher for 'name'. Fails if another live process, or
+    // another segment in this one, already publishes under it; a segment
+    // left by a process that has exited is taken over.
+    bool Create(const std::string& name) noexcept;
+
+    // Attach read-only. Fails if there is no segment or its layout differs.
+    bool Open(const std::string& name) noexcept;
+
+    // Publisher: mark the segment as abandoned and remove the name.
+    void Close() noexcept;
+
+    bool IsOpen() const noexcept { return m_layout != nullptr; }
+
+    // Publisher only. Readers never see a half-written snapshot.
+    void Publish(const StatsSnapshot& s) noexcept;
+
+    // Copy the latest snapshot; false if the publisher kept it busy for every
+    // attempt or the segment is gone.
+    bool Read(StatsSnapshot& out) const noexcept;
+
+    // Publisher's process id and start time (Unix ms); pid 0 once the
+    // publisher has closed the segment.
+    uint64_t PublisherPid() const noexcept;
+    uint64_t StartedUnixMs() const noexcept;
+
+private:
+    struct Layout;
+
+    bool Map(const std::string& name, bool create) noexcept;
+    void Unmap() noexcept;
+
+    Layout*     m_layout = nullptr;
+    bool        m_owner  = false;
+    std::string m_name;
+#ifdef _WIN32
+    void*       m_mapping = nullptr;   // HANDLE
+#endif
+};
+
+} // namespace Bridge
@@ -0,0 +1,161 @@
+#pragma once
+#include "IBrokerAdapter.h"
+#include "Config.h"
+#include "MarketDataFeed.h"
+#include "OrderStore.h"
+#include "PriceLevelBook.h"
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace Bridge {
+
+// Settings from the sim* keys of bridge.json.
+struct SimSettings {
+    std::string feedPath;   // market data file replayed in the background; empty = none
+};
+
+SimSettings SimSettingsOf(const BridgeConfig& cfg);
+
+struct ExecutionReport {
+    enum class Type : uint8_t { New, PartialFill, Fill, Canceled };
+
+    Type        type       = Type::New;
+    std::string orderId;
+    SymbolId    account    = kNoSymbol;
+    SymbolId    instrument = kNoSymbol;
+    Action      action     = Action::UNKNOWN;
+    int         lastQty    = 0;     // this fill; 0 for New/Canceled
+    FixedPrice  lastPx;             // this fill's price; unset for New/Canceled
+    int         cumQty     = 0;
+    int         leavesQty  = 0;
+    uint64_t    timeUs     = 0;     // feed time of the event that caused it
+};
+
+// Simulated exchange: the MockAdapter command set, but orders actually
+// trade. Each instrument has a PriceLevelBook of resting orders, matched in
+// price-time priority against a replayed market data feed:
+//   - quotes offer their displayed size to orders priced through them;
+//   - trades fill orders at or through the print, up to the print size
+//     across both sides (bids first), and trigger stop orders;
+//   - market orders take the displayed quote on arrival and wait in the
+//     book for the rest.
+// Passive orders fill at their own limit price, market orders at the
+// event's price. Fills move per-account positions, so CLOSEPOSITION,
+// REVERSEPOSITION and FLATTENEVERYTHING send the offsetting market orders.
+//
+// Market data comes from Replay/OnMarketEvent, or with a feedPath from a
+// thread that replays the file once, at its recorded pace, from
+// construction on. Without either, orders rest and nothing fills.
+class SimExchangeAdapter : public IBrokerAdapter {
+public:
+    using ExecutionSink = std::function<void(const ExecutionReport&)>;
+
+    SimExchangeAdapter();
+    explicit SimExchangeAdapter(const SimSettings& settings);
+    ~SimExchangeAdapter() override;
+
+    SimExchangeAdapter(const SimExchangeAdapter&) = delete;
+    SimExchangeAdapter& operator=(const SimExchangeAdapter&) = delete;
+
+    bool IsConnected() const noexcept override { return true; }
+    bool IsShardSafe() const noexcept override { return true; }
+    int  Execute(const OrderRequest& req) override;
+    void ExecuteBatch(const OrderRequest* reqs, size_t count, int* results) override;
+
+    // Receives every execution report. Called with the adapter locked: the
+    // sink must not call back into the adapter.
+    void SetExecutionSink(ExecutionSink sink);
+
+    // Apply one market data event, or feed.Events()[first, first + count).
+    // A Replay range is applied under one lock, so step through a long
+    // session in chunks if orders should interleave with it.
+    void   OnMarketEvent(const MarketEvent& ev);
+    size_t Replay(const MarketDataFeed& feed, size_t first = 0, size_t count = SIZE_MAX);
+
+    // Net filled position (long > 0).
+    int64_t  Position(SymbolId account, SymbolId instrument) const;
+    size_t   WorkingCount() const;
+    uint64_t FillCount() const;
+    void     Clear();
+
+private:
+    enum class State : uint8_t { Free, Resting, StopPending };
+
+    struct SimOrder {
+        std::string           orderId;
+        SymbolId              account    = kNoSymbol;
+        SymbolId              instrument = kNoSymbol;
+        Action                action     = Action::UNKNOWN;
+        OrderType             orderType  = OrderType::UNKNOWN;
+        int                   quantity   = 0;
+        int                   cumQty     = 0;
+        PriceTicks            limit      = 0;
+        PriceTicks            stop       = 0;
+        State                 state      = State::Free;
+        PriceLevelBook::Handle handle    = PriceLevelBook::kNoHandle;
+    };
+
+    struct Market {
+        PriceLevelBook        book;
+        std::vector<uint32_t> stops;          // StopPending orders, in arrival order
+        PriceTicks            bid = 0, ask = 0;
+        int                   bidSize = 0, askSize = 0;
+        bool                  hasQuote = false;
+        PriceTicks            last = 0;
+        bool                  hasTrade = false;
+        uint64_t              timeUs = 0;
+    };
+
+    static uint64_t KeyOf(SymbolId account, SymbolId instrument) noexcept {
+        return (static_cast<uint64_t>(account) << 32) | instrument;
+    }
+
+    int  dispatch(const OrderRequest& req);
+    int  doPlace(const OrderRequest& req);
+    void placeMarket(SymbolId account, SymbolId instrument, Action action, int qty);
+    uint32_t newOrder(SymbolId account, SymbolId instrument, Action action, OrderType type, int qty);
+    void enter(uint32_t idx);                    // route to book/quote, or arm a stop
+    void trigger(uint32_t idx);                  // stop elected: becomes market/limit
+    void cancelKey(uint64_t key);
+    void cancelAccount(SymbolId account);
+    void cancelAll();
+    void flattenKey(uint64_t key);
+    void cancelOrder(uint32_t idx);
+    void fill(uint32_t idx, int qty, PriceTicks px);
+    void retire(uint32_t idx);
+    void report(const SimOrder& o, ExecutionReport::Type type, int lastQty, PriceTicks px);
+    void apply(const MarketEvent& ev);
+    void onTrade(Market& m, PriceTicks px, int size);
+    void onQuote(Market& m);
+    Market& market(SymbolId instrument);
+    void RunFeed() noexcept;
+
+    mutable std::mutex                           m_mutex;
+    std::vector<SimOrder>                        m_orders;      // indexed by book tag
+    std::vector<uint32_t>                        m_freeOrders;
+    std::vector<Market>                          m_markets;     // indexed by instrument SymbolId
+    std::unordered_map<uint64_t, std::vector<uint32_t>> m_live; // (account, instrument) -> open orders
+    std::unordered_map<uint64_t, int64_t>        m_positions;
+    OrderIdCounter                               m_ids;
+    ExecutionSink                                m_sink;
+    ExecutionReport                              m_scratch;     // reused so reports do not allocate
+    std::vector<uint32_t>                        m_elected;     // stops triggered by the current trade
+    size_t                                       m_working = 0;
+    uint64_t                                     m_fills   = 0;
+
+    // Background replay of SimSettings::feedPath.
+    MarketDataFeed          m_feed;
+    std::mutex              m_feedMutex;
+    std::condition_variable m_feedWake;
+    bool                    m_feedStop = false;   // guarded by m_feedMutex
+    std::thread             m_feedThread;
+};
+
+} // namespace Bridge
@@ -0,0 +1,56 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Bridge {
+
+// A blocking TCP socket over Winsock or BSD sockets: just what the FIX
+// adapter needs (connect, write everything, read with a timeout) plus
+// listen/accept for local test acceptors. Nagle is off on every connection.
+//
+// One thread may Receive while others Send; Close must not race either.
+// Shutdown is safe from any thread and makes a pending Receive return.
+class Socket {
+public:
+    Socket() = default;
+    ~Socket();
+
+    Socket(Socket&& other) noexcept;
+    Socket& operator=(Socket&& other) noexcept;
+    Socket(const Socket&) = delete;
+    Socket& operator=(const Socket&) = delete;
+
+    // Connect to host:port, giving up after timeoutMs. Not open on failure.
+    static Socket Connect(const std::string& host, uint16_t port, int timeoutMs) noexcept;
+
+    // Listen on host:port; port 0 picks a free one (see LocalPort).
+    static Socket Listen(const std::string& host, uint16_t port) noexcept;
+
+    // Wait up to timeoutMs for a connection on a listening socket.
+    Socket Accept(int timeoutMs) noexcept;
+
+    bool     IsOpen() const noexcept { return m_fd != kInvalid; }
+    uint16_t LocalPort() const noexcept;
+
+    // Write all of 'data'. False if the connection failed.
+    bool SendAll(const char* data, size_t len) noexcept;
+
+    // Wait up to timeoutMs for data and read what is there. Returns the
+    // byte count, 0 on timeout, or -1 once the peer has closed or the
+    // connection failed.
+    int Receive(char* buf, size_t cap, int timeoutMs) noexcept;
+
+    // Stop both directions without releasing the handle.
+    void Shutdown() noexcept;
+    void Close() noexcept;
+
+private:
+    static constexpr intptr_t kInvalid = -1;
+
+    explicit Socket(intptr_t fd) noexcept : m_fd(fd) {}
+
+    intptr_t m_fd = kInvalid;   // SOCKET on Windows
+};
+
+} // namespace Bridge
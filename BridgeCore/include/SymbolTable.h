@@ -0,0 +1,47 @@
+#pragma once
+#include "Types.h"
+#include <string_view>
+
+namespace Bridge {
+
+// Process-wide intern table mapping account/instrument strings to SymbolIds.
+// Ids are dense, start at 1 and are never reused. Looking up a symbol that
+// already exists is lock-free (one hash, usually one probe); only the first
+// sighting of a new string takes a lock and allocates.
+
+// Return the id for 's', interning it if needed. Returns kNoSymbol for an
+// empty string or when the table is full (logged once): callers must not let
+// such a name fall through as kNoSymbol - see SymbolsResolved.
+SymbolId InternSymbol(std::string_view s) noexcept;
+
+// Return the id for 's' if it has been interned, else kNoSymbol. Never inserts.
+SymbolId FindSymbol(std::string_view s) noexcept;
+
+// Text of an interned symbol; empty for kNoSymbol or an unknown id.
+std::string_view SymbolName(SymbolId id) noexcept;
+
+// Ids for a request, interning its strings if the builder did not resolve them.
+inline SymbolId AccountIdOf(const OrderRequest& req) noexcept {
+    return req.accountId != kNoSymbol ? req.accountId : InternSymbol(req.account);
+}
+
+inline SymbolId InstrumentIdOf(const OrderRequest& req) noexcept {
+    return req.instrumentId != kNoSymbol ? req.instrumentId : InternSymbol(req.instrument);
+}
+
+// AccountIdOf and InstrumentIdOf, or false if a non-empty name got no id
+// because the table is full. Such a request must be refused
+// (RC_INVALID_PARAM): as kNoSymbol it would share an id with every other
+// refused name in cancel filters, dedup keys and lane routing.
+inline bool SymbolsResolved(const OrderRequest& req, SymbolId& account, SymbolId& instrument) noexcept {
+    account    = AccountIdOf(req);
+    instrument = InstrumentIdOf(req);
+    return (account != kNoSymbol || req.account.empty()) && (instrument != kNoSymbol || req.instrument.empty());
+}
+
+inline bool SymbolsResolved(const OrderRequest& req) noexcept {
+    SymbolId account, instrument;
+    return SymbolsResolved(req, account, instrument);
+}
+
+} // namespace Bridge
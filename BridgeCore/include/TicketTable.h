@@ -0,0 +1,34 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace Bridge {
+
+// Lock-free table of async order results, keyed by ticket. Each slot packs
+// (ticket << 32 | uint32 rc) into one 64-bit atomic, so a reader sees a
+// ticket and its code together or not at all. Slots are reused round-robin:
+// once more than Capacity() newer tickets have been issued, an old ticket
+// reads back as RC_UNKNOWN_TICKET.
+class TicketTable {
+public:
+    explicit TicketTable(size_t capacity);
+
+    // Next ticket: positive, wraps after INT32_MAX.
+    int  NewTicket() noexcept;
+    void Store(int ticket, int rc) noexcept;
+
+    // Code stored for 'ticket', or RC_UNKNOWN_TICKET if it was never issued
+    // or its slot has since been reused.
+    int  Load(int ticket) const noexcept;
+
+    size_t Capacity() const noexcept { return m_mask + 1; }
+
+private:
+    alignas(64) std::atomic<uint32_t>            m_next{ 0 };
+    size_t                                       m_mask;
+    std::unique_ptr<std::atomic<uint64_t>[]>     m_slots;
+};
+
+} // namespace Bridge
@@ -1,4 +1,5 @@
 #pragma once
+#include <cstdint>
 #include <string>
 
 namespace Bridge {
@@ -10,6 +11,11 @@ constexpr int RC_INVALID_PARAM  = -2;
 constexpr int RC_NOT_CONNECTED  = -3;
 constexpr int RC_INTERNAL_ERR   = -4;
 constexpr int RC_CONFIG_ERR     = -6;
+constexpr int RC_QUEUE_FULL     = -7;   // async submission queue is full
+constexpr int RC_UNKNOWN_TICKET = -8;   // ticket never issued or already recycled
+constexpr int RC_REJECTED       = -9;   // broker refused the order
+constexpr int RC_TIMEOUT        = -10;  // no answer in time; the order may still have been placed
+constexpr int RC_PENDING        =  1;   // async order not yet executed
 
 enum class Command {
     PLACE,
@@ -43,16 +49,39 @@ enum class TimeInForce {
     UNKNOWN
 };
 
+// Compact id for an interned account or instrument string (see SymbolTable.h).
+using SymbolId = uint32_t;
+constexpr SymbolId kNoSymbol = 0;
+
+// Fixed-point price: value = ticks / 10^scale, where scale is the number of
+// decimal places the instrument is quoted in (0..kMaxScale). Lets prices be
+// compared and encoded exactly, without float-to-string round trips.
+// kNoScale marks a price that was never set.
+struct FixedPrice {
+    static constexpr uint8_t kNoScale  = 0xFF;
+    static constexpr uint8_t kMaxScale = 9;
+
+    int64_t ticks = 0;
+    uint8_t scale = kNoScale;
+
+    constexpr bool IsSet() const noexcept { return scale != kNoScale; }
+};
+
 struct OrderRequest {
     Command     command     = Command::UNKNOWN;
     std::string account;
     std::string instrument;
+    SymbolId    accountId    = kNoSymbol;  // interned 'account', when resolved
+    SymbolId    instrumentId = kNoSymbol;  // interned 'instrument', when resolved
     Action      action      = Action::UNKNOWN;
     int         quantity    = 0;
     OrderType   orderType   = OrderType::UNKNOWN;
     double      limitPrice  = 0.0;
     double      stopPrice   = 0.0;
     TimeInForce timeInForce = TimeInForce::UNKNOWN;
+    FixedPrice  limitPx;    // exact form of limitPrice, when known
+    FixedPrice  stopPx;     // exact form of stopPrice, when known
+    uint64_t    barKey      = 0;  // BarKeyOf(caller's bar key) for dedup; 0 = none
 };
 
 } // namespace Bridge
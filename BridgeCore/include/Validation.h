@@ -1,14 +1,15 @@
 #pragma once
 #include "Types.h"
-#include <string>
+#include <string_view>
 
 namespace Bridge {
 
-// Parse a single uppercase token into the corresponding Command enum.
-Command    ParseCommand    (const std::string& s) noexcept;
-Action     ParseAction     (const std::string& s) noexcept;
-OrderType  ParseOrderType  (const std::string& s) noexcept;
-TimeInForce ParseTimeInForce(const std::string& s) noexcept;
+// Parse a single token (matched case-insensitively, without copying) into the
+// corresponding enum. Unrecognised tokens map to UNKNOWN.
+Command    ParseCommand    (std::string_view s) noexcept;
+Action     ParseAction     (std::string_view s) noexcept;
+OrderType  ParseOrderType  (std::string_view s) noexcept;
+TimeInForce ParseTimeInForce(std::string_view s) noexcept;
 
 // Validate a fully-populated OrderRequest.
 // Returns RC_SUCCESS (0) or a negative error code.
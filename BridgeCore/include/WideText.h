@@ -0,0 +1,46 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace Bridge {
+
+// Narrow the NUL-terminated wide string 'w' to UTF-8 in 'buf' ('cap' bytes,
+// NUL terminator included). Pure-ASCII input - everything TradeStation sends
+// in practice - is narrowed in place with SSE2/AVX2 (scalar elsewhere); the
+// first non-ASCII code unit switches the remainder to full UTF-8 conversion.
+// A null 'w' narrows to "". Like snprintf, returns the full narrowed length;
+// if that is >= cap the contents of 'buf' are unspecified.
+size_t NarrowWide(const wchar_t* w, char* buf, size_t cap) noexcept;
+
+// Instruction set NarrowWide was compiled for: "AVX2", "SSE2" or "scalar".
+const char* NarrowWideIsa() noexcept;
+
+// One narrowed argument with inline storage; only input longer than N-1
+// bytes after narrowing spills to the heap.
+template <size_t N>
+class NarrowArg {
+public:
+    explicit NarrowArg(const wchar_t* w) {
+        size_t len = NarrowWide(w, m_inline, N);
+        if (len < N) {
+            m_view = std::string_view(m_inline, len);
+        } else {
+            m_heap.resize(len + 1);
+            len = NarrowWide(w, m_heap.data(), m_heap.size());
+            m_heap.resize(len);
+            m_view = m_heap;
+        }
+    }
+    NarrowArg(const NarrowArg&)            = delete;
+    NarrowArg& operator=(const NarrowArg&) = delete;
+
+    std::string_view view() const noexcept { return m_view; }
+
+private:
+    char             m_inline[N];
+    std::string      m_heap;
+    std::string_view m_view;
+};
+
+} // namespace Bridge
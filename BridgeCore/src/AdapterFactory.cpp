@@ -0,0 +1,58 @@
+#include "AdapterFactory.h"
+#include "FaultInjectingAdapter.h"
+#include "MockAdapter.h"
+#include "SimExchangeAdapter.h"
+#include "FixAdapter.h"
+#include "DotNetAdapter.h"
+
+namespace Bridge {
+
+std::shared_ptr<IBrokerAdapter> CreateAdapter(const std::string& adapterType) {
+    if (adapterType == "FIX")
+        return std::make_shared<FixAdapter>(FixSettings{});
+    if (adapterType == "SIM")
+        return std::make_shared<SimExchangeAdapter>();
+    if (adapterType == "DOTNET")
+        return std::make_shared<DotNetAdapter>(DotNetSettings{});
+    // Default: MOCK
+    return std::make_shared<MockAdapter>();
+}
+
+std::shared_ptr<IBrokerAdapter> CreateAdapter(const BridgeConfig& cfg) {
+    std::shared_ptr<IBrokerAdapter> adapter;
+    if (cfg.adapterType == "FIX")
+        adapter = std::make_shared<FixAdapter>(FixSettingsOf(cfg));
+    else if (cfg.adapterType == "DOTNET")
+        adapter = std::make_shared<DotNetAdapter>(DotNetSettingsOf(cfg));
+    else if (cfg.adapterType == "SIM")
+        adapter = std::make_shared<SimExchangeAdapter>(SimSettingsOf(cfg));
+    else
+        adapter = CreateAdapter(cfg.adapterType);
+    FaultProfile profile = MakeFaultProfile(cfg);
+    if (!profile.Active()) return adapter;
+    return std::make_shared<FaultInjectingAdapter>(std::move(adapter), std::move(profile));
+}
+
+bool AdapterSettingsDiffer(const BridgeConfig& a, const BridgeConfig& b) noexcept {
+    return a.adapterType            != b.adapterType            ||
+           a.faultLatency           != b.faultLatency           ||
+           a.faultRejectRate        != b.faultRejectRate        ||
+           a.faultTimeoutMs         != b.faultTimeoutMs         ||
+           a.faultDisconnectEveryMs != b.faultDisconnectEveryMs ||
+           a.faultDisconnectForMs   != b.faultDisconnectForMs   ||
+           a.faultSeed              != b.faultSeed              ||
+           (a.adapterType == "FIX" &&
+            (a.fixHost             != b.fixHost             ||
+             a.fixPort             != b.fixPort             ||
+             a.fixSenderCompId     != b.fixSenderCompId     ||
+             a.fixTargetCompId     != b.fixTargetCompId     ||
+             a.fixHeartbeatSeconds != b.fixHeartbeatSeconds ||
+             a.fixAckTimeoutMs     != b.fixAckTimeoutMs     ||
+             a.fixStorePath        != b.fixStorePath))       ||
+           (a.adapterType == "SIM" && a.simFeedPath != b.simFeedPath) ||
+           (a.adapterType == "DOTNET" &&
+            (a.pipeName        != b.pipeName ||
+             a.dotnetTimeoutMs != b.dotnetTimeoutMs));
+}
+
+} // namespace Bridge
@@ -0,0 +1,121 @@
+#include "BinaryLog.h"
+#include "LogEvent.h"
+#include <cstring>
+#include <string>
+
+namespace Bridge {
+
+namespace {
+
+// Bounds-checked cursor over the mapped bytes.
+struct Cursor {
+    const char* p;
+    size_t      left;
+
+    template <typename T>
+    bool Get(T& v) noexcept {
+        if (left < sizeof(T)) return false;
+        std::memcpy(&v, p, sizeof(T));
+        p += sizeof(T);
+        left -= sizeof(T);
+        return true;
+    }
+    bool Bytes(size_t n, const char*& out) noexcept {
+        if (left < n) return false;
+        out = p;
+        p += n;
+        left -= n;
+        return true;
+    }
+};
+
+} // anonymous namespace
+
+size_t BinaryLog::ValidLength(const char* data, size_t size) noexcept {
+    if (size < sizeof(kMagic) || std::memcmp(data, kMagic, sizeof(kMagic)) != 0) return 0;
+    Cursor c{ data + sizeof(kMagic), size - sizeof(kMagic) };
+    for (;;) {
+        size_t      end  = size - c.left;
+        uint8_t     type = 0;
+        const char* skip = nullptr;
+        if (!c.Get(type)) return end;
+        bool ok;
+        if (type == kAnchor) {
+            int64_t a, b;
+            ok = c.Get(a) && c.Get(b);
+        } else if (type == kFormat) {
+            uint16_t id, len;
+            ok = c.Get(id) && c.Get(len) && c.Bytes(len, skip);
+        } else if (type == kEvent) {
+            int64_t ns; uint8_t level; uint16_t id; uint8_t n;
+            ok = c.Get(ns) && c.Get(level) && c.Get(id) && c.Get(n) && c.Bytes(n, skip);
+        } else if (type == kText) {
+            int64_t ns; uint8_t level; uint32_t len;
+            ok = c.Get(ns) && c.Get(level) && c.Get(len) && c.Bytes(len, skip);
+        } else {
+            ok = false;
+        }
+        if (!ok) return end;
+    }
+}
+
+bool BinaryLogReader::Open(const std::string& path) noexcept {
+    m_offset = 0;
+    m_wallNs = m_steadyNs = 0;
+    m_formats.clear();
+    if (!m_file.Open(path, MappedFile::Mode::ReadOnly)) return false;
+    if (m_file.Size() < sizeof(BinaryLog::kMagic) ||
+        std::memcmp(m_file.Data(), BinaryLog::kMagic, sizeof(BinaryLog::kMagic)) != 0) {
+        m_file.Close();
+        return false;
+    }
+    m_offset = sizeof(BinaryLog::kMagic);
+    return true;
+}
+
+bool BinaryLogReader::Next(BinaryLogLine& out) {
+    if (!m_file.IsOpen()) return false;
+    for (;;) {
+        Cursor c{ m_file.Data() + m_offset, m_file.Size() - m_offset };
+        uint8_t type = 0;
+        if (!c.Get(type)) return false;
+
+        if (type == BinaryLog::kAnchor) {
+            if (!c.Get(m_wallNs) || !c.Get(m_steadyNs)) return false;
+            m_formats.clear();
+        } else if (type == BinaryLog::kFormat) {
+            uint16_t    id = 0, len = 0;
+            const char* text = nullptr;
+            if (!c.Get(id) || !c.Get(len) || !c.Bytes(len, text)) return false;
+            m_formats[id].assign(text, len);
+        } else if (type == BinaryLog::kEvent || type == BinaryLog::kText) {
+            int64_t     steadyNs = 0;
+            uint8_t     level    = 0;
+            const char* body     = nullptr;
+            if (!c.Get(steadyNs) || !c.Get(level)) return false;
+            out.wallNs = m_wallNs + (steadyNs - m_steadyNs);
+            out.level  = static_cast<LogLevel>(level);
+            out.text.clear();
+            if (type == BinaryLog::kEvent) {
+                uint16_t id = 0;
+                uint8_t  size = 0;
+                if (!c.Get(id) || !c.Get(size) || !c.Bytes(size, body)) return false;
+                auto it = m_formats.find(id);
+                if (it == m_formats.end()) return false;
+                FormatLogEvent(out.text, it->second.c_str(),
+                               reinterpret_cast<const unsigned char*>(body), size);
+            } else {
+                uint32_t len = 0;
+                if (!c.Get(len) || !c.Bytes(len, body)) return false;
+                out.text.assign(body, len);
+            }
+            m_offset = m_file.Size() - c.left;
+            return true;
+        } else {
+            return false;
+        }
+        m_offset = m_file.Size() - c.left;
+    }
+}
+
+} // namespace Bridge
@@ -1,58 +1,703 @@
 #include "BridgeEngine.h"
 #include "Validation.h"
+#include "Parser.h"
 #include "Logger.h"
+#include "LogEvent.h"
 #include "Config.h"
-#include "MockAdapter.h"
-#include "FixAdapterStub.h"
-#include "DotNetAdapterStub.h"
+#include "AdapterFactory.h"
+#include "LatencyStats.h"
+#include "SymbolTable.h"
+#include <chrono>
+#include <limits>
 #include <stdexcept>
 #include <filesystem>
+#include <string_view>
+#include <vector>
 
 namespace Bridge {
 
+// Keep results around long enough for a strategy polling once per bar.
+static size_t TicketCapacity(const BridgeConfig& cfg) noexcept {
+    size_t depth = cfg.asyncQueueDepth > 0 ? static_cast<size_t>(cfg.asyncQueueDepth) : 1;
+    return depth * 4 > 4096 ? depth * 4 : 4096;
+}
+
+// Per-order log lines, formatted off the calling thread (see LogEvent.h).
+static constexpr LogFormat kLogDuplicate("Duplicate order suppressed: command={} cached rc={} (dedup hits={} misses={})");
+static constexpr LogFormat kLogExecuteOk("Execute succeeded: command={}");
+static constexpr LogFormat kLogExecuteRc("Execute returned code={}");
+static constexpr LogFormat kLogBatch("ExecuteBatch: {}/{} succeeded");
+static constexpr LogFormat kLogSymbolsFull("Symbol table full: refusing request for account '{}' instrument '{}'");
+
+static LogOptions LogOptionsOf(const BridgeConfig& cfg) {
+    LogOptions o;
+    o.filePath        = cfg.logFilePath;
+    o.toConsole       = cfg.logToConsole;
+    o.flushIntervalMs = cfg.logFlushMs;
+    o.queueDepth      = cfg.logQueueDepth > 0 ? static_cast<size_t>(cfg.logQueueDepth) : 1;
+    o.blockWhenFull   = cfg.logBlockOnFull;
+    o.binary          = cfg.logBinary;
+    o.minLevel        = cfg.logLevel;
+    o.segmentBytes    = static_cast<size_t>(cfg.logMaxSizeMb) * 1024 * 1024;
+    o.rotateMinutes   = cfg.logRotateMinutes;
+    o.keepSegments    = cfg.logKeepSegments;
+    return o;
+}
+
+static int64_t NowMs() noexcept {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// A request naming an account or instrument the full symbol table could not
+// take; refused rather than sharing kNoSymbol with other such names.
+static bool RefuseUnresolved(const OrderRequest& req) noexcept {
+    if (SymbolsResolved(req)) return false;
+    BRIDGE_EVENT_WARN(kLogSymbolsFull, req.account, req.instrument);
+    return true;
+}
+
+// Transient failures are not remembered, so a retry reaches the adapter.
+static bool IsCacheable(int rc) noexcept {
+    return rc != RC_NOT_CONNECTED && rc != RC_INTERNAL_ERR;
+}
+
 BridgeEngine::BridgeEngine(const BridgeConfig& cfg)
-    : m_config(cfg)
+    : BridgeEngine(cfg, nullptr)
 {
-    LogInit(cfg.logFilePath, cfg.logToConsole);
-    LogInfo("BridgeEngine initialising with adapter=" + cfg.adapterType);
+}
 
-    if (cfg.adapterType == "FIX") {
-        m_adapter = std::make_shared<FixAdapterStub>();
-    } else if (cfg.adapterType == "DOTNET") {
-        m_adapter = std::make_shared<DotNetAdapterStub>();
-    } else {
-        // Default: MOCK
-        m_adapter = std::make_shared<MockAdapter>();
+struct BridgeEngine::AdapterSlot {
+    AdapterSlot(std::shared_ptr<IBrokerAdapter> a, const std::string& name)
+        : adapter(std::move(a)), shardSafe(adapter && adapter->IsShardSafe()),
+          statsId(LatencyAdapterId(name)), statsQueuedId(LatencyAdapterId(name + ":async")) {}
+
+    std::shared_ptr<IBrokerAdapter> adapter;
+    const bool                      shardSafe;
+    const uint8_t                   statsId;         // latency stats column for this adapter
+    const uint8_t                   statsQueuedId;   // ...and for orders run by async workers
+    std::atomic<int>                inFlight{ 0 };
+    std::mutex                      serial;   // used when !shardSafe but lanes > 1
+};
+
+// Pins the current adapter slot for the duration of one call. Increment,
+// then re-check the slot is still current: with sequentially consistent
+// ordering, either SwapAdapter sees the count or we see the new slot.
+class BridgeEngine::AdapterLease {
+public:
+    explicit AdapterLease(const std::atomic<AdapterSlot*>& current) noexcept {
+        for (;;) {
+            m_slot = current.load();
+            m_slot->inFlight.fetch_add(1);
+            if (current.load() == m_slot) break;
+            m_slot->inFlight.fetch_sub(1);
+        }
+    }
+    ~AdapterLease() { m_slot->inFlight.fetch_sub(1); }
+
+    AdapterLease(const AdapterLease&) = delete;
+    AdapterLease& operator=(const AdapterLease&) = delete;
+
+    AdapterSlot&    Slot() const noexcept { return *m_slot; }
+    IBrokerAdapter* operator->() const noexcept { return m_slot->adapter.get(); }
+    bool            Usable() const noexcept { return m_slot->adapter && m_slot->adapter->IsConnected(); }
+
+private:
+    AdapterSlot* m_slot;
+};
+
+BridgeEngine::BridgeEngine(const BridgeConfig& cfg, std::shared_ptr<IBrokerAdapter> adapter)
+    : m_config(cfg),
+      m_startupAsyncWorkers(cfg.asyncWorkers),
+      m_startupQueueDepth(cfg.asyncQueueDepth),
+      m_startupLanes(cfg.executionLanes),
+      m_tickets(TicketCapacity(cfg))
+{
+    LogInit(LogOptionsOf(cfg));
+    BRIDGE_LOG_INFO("BridgeEngine initialising with adapter=" + cfg.adapterType);
+
+    if (!adapter) adapter = CreateAdapter(cfg);
+    m_adapterSlots.push_back(std::make_unique<AdapterSlot>(std::move(adapter), cfg.adapterType));
+    m_adapter.store(m_adapterSlots.back().get());
+    LatencySetEnabled(cfg.latencyStats);
+
+    if (!cfg.journalPath.empty()) {
+        m_journal = std::make_unique<RequestJournal>();
+        if (m_journal->Open(cfg.journalPath)) {
+            BRIDGE_LOG_INFO("Journaling requests to " + cfg.journalPath + " (" +
+                            std::to_string(m_journal->Records()) + " existing record(s))");
+        } else {
+            BRIDGE_LOG_ERROR("Cannot open request journal " + cfg.journalPath + "; journaling disabled");
+            m_journal.reset();
+        }
+    }
+    if (!cfg.statsSharedMemory.empty()) {
+        m_statsSegment = std::make_unique<SharedStatsSegment>();
+        if (m_statsSegment->Create(cfg.statsSharedMemory)) {
+            m_statsSnapshot = std::make_unique<StatsSnapshot>();
+            BRIDGE_LOG_INFO("Publishing live stats in shared memory \"" + cfg.statsSharedMemory + "\"");
+            PublishStats();
+        } else {
+            BRIDGE_LOG_WARN("Cannot publish stats in shared memory \"" + cfg.statsSharedMemory +
+                            "\" (in use by another process?); BridgeTop will not see this one");
+            m_statsSegment.reset();
+        }
     }
+    StartStatsThread(cfg);
+}
+
+BridgeEngine::~BridgeEngine() {
+    Shutdown();
+}
+
+void BridgeEngine::Shutdown() noexcept {
+    if (m_shutDown.exchange(true)) return;
+    m_watcher.Stop();
+    {
+        std::lock_guard<std::mutex> lk(m_statsMutex);
+        m_statsStop = true;
+    }
+    m_statsWake.notify_all();
+    if (m_statsThread.joinable()) m_statsThread.join();
+    StopWorkers();
+    PublishStats();
+    try {
+        if (m_dedup.Hits() + m_dedup.Misses() > 0)
+            BRIDGE_LOG_INFO("Dedup totals: hits=" + std::to_string(m_dedup.Hits()) +
+                            " misses=" + std::to_string(m_dedup.Misses()));
+        if (m_journal)
+            BRIDGE_LOG_INFO("Journal totals: records=" + std::to_string(m_journal->Records()) +
+                            " dropped=" + std::to_string(m_journal->Dropped()));
+        if (Config().latencyStats && Config().statsDumpSeconds > 0) LogLatencyReport("Latency totals");
+        // An empty slot: waits for calls still inside the adapter, then destroys it.
+        InstallAdapter(nullptr, Config().adapterType);
+    }
+    catch (...) {}
+    LogFlush();
+}
+
+void BridgeEngine::StartStatsThread(const BridgeConfig& cfg) {
+    bool dump = cfg.latencyStats && cfg.statsDumpSeconds > 0;
+    if (!dump && !m_statsSegment) return;
+    std::lock_guard<std::mutex> lk(m_statsMutex);
+    if (!m_statsStop && !m_statsThread.joinable()) m_statsThread = std::thread([this] { StatsLoop(); });
+}
+
+void BridgeEngine::LogLatencyReport(const char* title) {
+    if (!LogEnabled(LogLevel::INFO)) return;
+    std::string report = LatencyReport();
+    if (report.empty()) return;
+    LogInfo(std::string(title) + " (since startup):");
+    size_t pos = 0;
+    while (pos < report.size()) {
+        size_t nl = report.find('\n', pos);
+        if (nl == std::string::npos) nl = report.size();
+        LogInfo("  " + report.substr(pos, nl - pos));
+        pos = nl + 1;
+    }
+}
+
+void BridgeEngine::PublishStats() noexcept {
+    if (!m_statsSegment) return;
+    std::lock_guard<std::mutex> lk(m_statsMutex);
+    StatsSnapshot& s = *m_statsSnapshot;
+    s = StatsSnapshot{};
+    CollectStats(s);
+    {
+        AdapterLease adapter(m_adapter);
+        s.connected = adapter.Usable() ? 1 : 0;
+    }
+    const BridgeConfig& cfg = Config();
+    cfg.adapterType.copy(s.adapter, sizeof(s.adapter) - 1);
+    // m_lanes is complete once m_laneCount is set.
+    size_t lanes = m_laneCount.load();
+    for (size_t i = 0; i < lanes; ++i) {
+        s.asyncQueued   += m_lanes[i]->queue.SizeApprox();
+        s.asyncCapacity += m_lanes[i]->queue.Capacity();
+    }
+    s.lanes       = lanes;
+    s.logQueued   = LogQueued();
+    s.logDropped  = LogDropped();
+    s.dedupHits   = m_dedup.Hits();
+    s.dedupMisses = m_dedup.Misses();
+    s.journaled   = JournaledRequests();
+    s.publishedNs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+    m_statsSegment->Publish(s);
+}
+
+void BridgeEngine::StatsLoop() noexcept {
+    std::string last;
+    auto lastDump = std::chrono::steady_clock::now();
+    std::unique_lock<std::mutex> lk(m_statsMutex);
+    for (;;) {
+        // Re-read each round so a reload can change the intervals (or turn them on).
+        int publishMs = m_statsSegment ? Config().statsPublishMs : 0;
+        auto wait = publishMs > 0 ? std::chrono::milliseconds(publishMs) : std::chrono::milliseconds(1000);
+        if (m_statsWake.wait_for(lk, wait, [this] { return m_statsStop; }))
+            break;
+        lk.unlock();
+        try {
+            if (publishMs > 0) PublishStats();
+            int  secs = Config().statsDumpSeconds;
+            auto now  = std::chrono::steady_clock::now();
+            if (secs <= 0 || !Config().latencyStats) {
+                lastDump = now;
+            } else if (now - lastDump >= std::chrono::seconds(secs)) {
+                lastDump = now;
+                std::string report = LatencyReport();
+                if (report != last) {   // skip idle periods
+                    LogLatencyReport("Latency");
+                    last.swap(report);
+                }
+            }
+        }
+        catch (...) {}
+        lk.lock();
+    }
+}
+
+void BridgeEngine::Journal(const OrderRequest& req, int64_t receivedNs, int rc, uint8_t flags) noexcept {
+    if (m_journal)
+        m_journal->Append(req, receivedNs, RequestJournal::NowNs() - receivedNs, rc, flags);
+}
+
+int64_t BridgeEngine::DedupWindow(const OrderRequest& req) const noexcept {
+    if (req.barKey != 0) return std::numeric_limits<int64_t>::max();
+    return m_config.Current()->dedupWindowMs;
+}
+
+bool BridgeEngine::FindDuplicate(const OrderRequest& req, uint64_t key, int64_t nowMs, int& rc) noexcept {
+    if (!m_dedup.Lookup(key, nowMs, DedupWindow(req), rc)) return false;
+    BRIDGE_EVENT_INFO(kLogDuplicate, static_cast<int>(req.command), rc, m_dedup.Hits(), m_dedup.Misses());
+    return true;
 }
 
 int BridgeEngine::Execute(const OrderRequest& req) noexcept {
+    BRIDGE_LATENCY_SCOPE();
+    int64_t received = JournalClock();
+    int     rc       = ExecuteNow(req);
+    CountRequest(req.command, rc);
+    Journal(req, received, rc, 0);
+    return rc;
+}
+
+int BridgeEngine::ExecuteNow(const OrderRequest& req, bool queued) noexcept {
     try {
-        if (!m_adapter || !m_adapter->IsConnected()) {
-            LogError("Adapter not connected");
+        BRIDGE_LATENCY_COMMAND(req.command);
+        AdapterLease adapter(m_adapter);
+        BRIDGE_LATENCY_ADAPTER(queued ? adapter.Slot().statsQueuedId : adapter.Slot().statsId);
+        if (!adapter.Usable()) {
+            BRIDGE_LOG_ERROR("Adapter not connected");
             return RC_NOT_CONNECTED;
         }
-        int rc = m_adapter->Execute(req);
+        if (RefuseUnresolved(req)) return RC_INVALID_PARAM;
+        int64_t  now = 0;
+        uint64_t key = 0;
+        if (DedupWindow(req) > 0) {
+            now = NowMs();
+            key = DedupCache::KeyOf(req);
+            int cached = 0;
+            if (FindDuplicate(req, key, now, cached)) return cached;
+        }
+        BRIDGE_LATENCY_MARK(Dispatch);
+        int rc;
+        if (!adapter.Slot().shardSafe && m_laneCount.load(std::memory_order_relaxed) > 1) {
+            // Lanes were sized for a shard-safe adapter that has since been swapped out.
+            std::lock_guard<std::mutex> lk(adapter.Slot().serial);
+            rc = adapter->Execute(req);
+        } else {
+            rc = adapter->Execute(req);
+        }
+        BRIDGE_LATENCY_MARK(Adapter);
+        if (key != 0 && IsCacheable(rc))
+            m_dedup.Record(key, now, rc);
         if (rc == RC_SUCCESS)
-            LogInfo("Execute succeeded: command=" + std::to_string(static_cast<int>(req.command)));
+            BRIDGE_EVENT_INFO(kLogExecuteOk, static_cast<int>(req.command));
         else
-            LogWarning("Execute returned code=" + std::to_string(rc));
+            BRIDGE_EVENT_WARN(kLogExecuteRc, rc);
+        BRIDGE_LATENCY_MARK(Log);
         return rc;
     }
     catch (const std::exception& ex) {
-        LogError(std::string("Exception in Execute: ") + ex.what());
+        BRIDGE_LOG_ERROR(std::string("Exception in Execute: ") + ex.what());
+        return RC_INTERNAL_ERR;
+    }
+    catch (...) {
+        BRIDGE_LOG_ERROR("Unknown exception in Execute");
+        return RC_INTERNAL_ERR;
+    }
+}
+
+void BridgeEngine::ExecuteBatch(const OrderRequest* reqs, size_t count, int* results) noexcept {
+    BRIDGE_LATENCY_SCOPE();
+    int64_t received = JournalClock();
+    ExecuteBatchNow(reqs, count, results);
+    for (size_t i = 0; i < count; ++i) CountRequest(reqs[i].command, results[i]);
+    for (size_t i = 0; m_journal && i < count; ++i)
+        Journal(reqs[i], received, results[i], RequestJournal::kBatch);
+}
+
+void BridgeEngine::ExecuteBatchNow(const OrderRequest* reqs, size_t count, int* results) noexcept {
+    // Anything the adapter does not get to (e.g. it throws) reports an error.
+    for (size_t i = 0; i < count; ++i) results[i] = RC_INTERNAL_ERR;
+    try {
+        BRIDGE_LATENCY_COMMAND(kLatencyBatch);
+        AdapterLease adapter(m_adapter);
+        BRIDGE_LATENCY_ADAPTER(adapter.Slot().statsId);
+        if (!adapter.Usable()) {
+            BRIDGE_LOG_ERROR("Adapter not connected");
+            for (size_t i = 0; i < count; ++i) results[i] = RC_NOT_CONNECTED;
+            return;
+        }
+        // Answer repeats of earlier orders from the dedup cache and pass the
+        // rest on. Identical orders within one batch are all submitted: a
+        // batch is an explicit list, not a re-fired tick.
+        int64_t now = NowMs();
+        thread_local std::vector<uint64_t>     keys;
+        thread_local std::vector<size_t>       fresh;
+        thread_local std::vector<OrderRequest> freshReqs;
+        thread_local std::vector<int>          freshRc;
+        keys.assign(count, 0);
+        fresh.clear();
+        for (size_t i = 0; i < count; ++i) {
+            if (RefuseUnresolved(reqs[i])) {
+                results[i] = RC_INVALID_PARAM;
+                continue;
+            }
+            if (DedupWindow(reqs[i]) > 0) {
+                keys[i] = DedupCache::KeyOf(reqs[i]);
+                if (FindDuplicate(reqs[i], keys[i], now, results[i])) continue;
+            }
+            fresh.push_back(i);
+        }
+        BRIDGE_LATENCY_MARK(Dispatch);
+        // As in ExecuteNow: the lanes may be running this adapter too.
+        std::unique_lock<std::mutex> serial;
+        if (!adapter.Slot().shardSafe && m_laneCount.load(std::memory_order_relaxed) > 1)
+            serial = std::unique_lock<std::mutex>(adapter.Slot().serial);
+        if (fresh.size() == count) {
+            adapter->ExecuteBatch(reqs, count, results);
+        } else if (!fresh.empty()) {
+            freshReqs.resize(fresh.size());
+            freshRc.resize(fresh.size());
+            for (size_t j = 0; j < fresh.size(); ++j) freshReqs[j] = reqs[fresh[j]];
+            adapter->ExecuteBatch(freshReqs.data(), fresh.size(), freshRc.data());
+            for (size_t j = 0; j < fresh.size(); ++j) results[fresh[j]] = freshRc[j];
+        }
+        if (serial) serial.unlock();
+        BRIDGE_LATENCY_MARK(Adapter);
+        for (size_t i : fresh) {
+            if (keys[i] != 0 && IsCacheable(results[i]))
+                m_dedup.Record(keys[i], now, results[i]);
+        }
+
+        size_t ok = 0;
+        for (size_t i = 0; i < count; ++i) ok += (results[i] == RC_SUCCESS);
+        BRIDGE_EVENT_INFO(kLogBatch, ok, count);
+        BRIDGE_LATENCY_MARK(Log);
+    }
+    catch (const std::exception& ex) {
+        BRIDGE_LOG_ERROR(std::string("Exception in ExecuteBatch: ") + ex.what());
+    }
+    catch (...) {
+        BRIDGE_LOG_ERROR("Unknown exception in ExecuteBatch");
+    }
+}
+
+// Split 'payloads' into trimmed, non-blank lines, calling fn(line) for each.
+template <typename Fn>
+static void ForEachPayloadLine(std::string_view payloads, Fn&& fn) {
+    size_t pos = 0;
+    while (pos < payloads.size()) {
+        size_t nl = payloads.find('\n', pos);
+        if (nl == std::string_view::npos) nl = payloads.size();
+        std::string_view line = payloads.substr(pos, nl - pos);
+        pos = nl + 1;
+        while (!line.empty() && (line.back() == '\r' || line.back() == ' ' || line.back() == '\t'))
+            line.remove_suffix(1);
+        while (!line.empty() && (line.front() == ' ' || line.front() == '\t'))
+            line.remove_prefix(1);
+        if (!line.empty()) fn(line);
+    }
+}
+
+int BridgeEngine::ExecuteBatch(std::string_view payloads, int* results, int capacity) noexcept {
+    BRIDGE_LATENCY_SCOPE();
+    BRIDGE_LATENCY_COMMAND(kLatencyBatch);
+    try {
+        if (!results || capacity < 0) return RC_INVALID_PARAM;
+
+        size_t count = 0;
+        ForEachPayloadLine(payloads, [&](std::string_view) { ++count; });
+        if (count > static_cast<size_t>(capacity)) {
+            BRIDGE_LOG_WARN("ExecuteBatch: " + std::to_string(count) +
+                            " payloads exceed result capacity " + std::to_string(capacity));
+            return RC_INVALID_PARAM;
+        }
+
+        // Scratch reused across calls on the same thread, so a steady stream
+        // of batches stops allocating once the vectors have grown.
+        thread_local std::vector<OrderRequest> valid;
+        thread_local std::vector<size_t>       slot;
+        thread_local std::vector<int>          validRc;
+        valid.resize(count);
+        slot.clear();
+
+        size_t line = 0;
+        ForEachPayloadLine(payloads, [&](std::string_view payload) {
+            OrderRequest& req = valid[slot.size()];
+            req = OrderRequest{};
+            results[line] = ParsePayload(payload, req);
+            BRIDGE_LATENCY_MARK(Validate);
+            if (results[line] == RC_SUCCESS) slot.push_back(line);
+            else CountRequest(req.command, results[line]);
+            ++line;
+        });
+
+        validRc.resize(slot.size());
+        if (!slot.empty())
+            ExecuteBatch(valid.data(), slot.size(), validRc.data());
+        for (size_t i = 0; i < slot.size(); ++i)
+            results[slot[i]] = validRc[i];
+        return static_cast<int>(count);
+    }
+    catch (...) {
+        BRIDGE_LOG_ERROR("Unknown exception in ExecuteBatch");
+        return RC_INTERNAL_ERR;
+    }
+}
+
+int BridgeEngine::ExecuteAsync(const OrderRequest& req) noexcept {
+    BRIDGE_LATENCY_SCOPE();
+    BRIDGE_LATENCY_COMMAND(req.command);
+    try {
+        int64_t received = JournalClock();
+        if (m_startupAsyncWorkers <= 0 && m_startupLanes <= 0) {
+            int ticket = m_tickets.NewTicket();
+            int rc     = ExecuteNow(req);
+            CountRequest(req.command, rc);
+            Journal(req, received, rc, RequestJournal::kAsync);
+            m_tickets.Store(ticket, rc);
+            return ticket;
+        }
+        if (RefuseUnresolved(req)) {
+            CountRequest(req.command, RC_INVALID_PARAM);
+            return RC_INVALID_PARAM;
+        }
+        if (m_stop.load(std::memory_order_acquire)) {   // shut down: no worker would run it
+            CountRequest(req.command, RC_NOT_CONNECTED);
+            return RC_NOT_CONNECTED;
+        }
+        std::call_once(m_workersStarted, [this] { StartWorkers(); });
+
+        // Issue the ticket only once the job has a queue cell, and publish it
+        // as pending before a worker can complete it. A rejected push must
+        // not take a ticket: under sustained backpressure the burnt tickets
+        // would recycle table slots that live tickets still occupy.
+        Lane& lane = *m_lanes[m_lanes.size() == 1 ? 0 : AccountIdOf(req) % m_lanes.size()];
+        int ticket = 0;
+        bool queued = lane.queue.TryPush(AsyncJob{ 0, received, req }, [&](AsyncJob& job) noexcept {
+            ticket = m_tickets.NewTicket();
+            m_tickets.Store(ticket, RC_PENDING);
+            job.ticket = ticket;
+        });
+        if (!queued) {
+            CountRequest(req.command, RC_QUEUE_FULL);
+            BRIDGE_LOG_WARN("ExecuteAsync: queue full (depth=" + std::to_string(lane.queue.Capacity()) + ")");
+            return RC_QUEUE_FULL;
+        }
+        lane.wake.fetch_add(1, std::memory_order_release);
+        lane.wake.notify_one();
+        BRIDGE_LATENCY_MARK(Dispatch);
+        return ticket;
+    }
+    catch (const std::exception& ex) {
+        BRIDGE_LOG_ERROR(std::string("Exception in ExecuteAsync: ") + ex.what());
         return RC_INTERNAL_ERR;
     }
     catch (...) {
-        LogError("Unknown exception in Execute");
+        BRIDGE_LOG_ERROR("Unknown exception in ExecuteAsync");
         return RC_INTERNAL_ERR;
     }
 }
 
+int BridgeEngine::PollResult(int ticket) const noexcept {
+    return m_tickets.Load(ticket);
+}
+
+void BridgeEngine::StartWorkers() {
+    size_t depth = m_startupQueueDepth > 0 ? static_cast<size_t>(m_startupQueueDepth) : 1;
+    if (m_startupLanes > 0) {
+        size_t lanes = static_cast<size_t>(m_startupLanes);
+        bool shardSafe;
+        {
+            AdapterLease adapter(m_adapter);
+            shardSafe = adapter.Slot().shardSafe;
+        }
+        if (!shardSafe) {
+            BRIDGE_LOG_WARN("Adapter is not shard-safe; using 1 execution lane instead of " +
+                            std::to_string(lanes));
+            lanes = 1;
+        }
+        for (size_t i = 0; i < lanes; ++i)
+            m_lanes.push_back(std::make_unique<Lane>(depth));
+        for (auto& lane : m_lanes) {
+            Lane* l = lane.get();
+            l->threads.emplace_back([this, l] { WorkerLoop(*l); });
+        }
+        BRIDGE_LOG_INFO("Started " + std::to_string(lanes) + " execution lane(s), queue depth=" +
+                        std::to_string(m_lanes[0]->queue.Capacity()) + " each");
+    } else {
+        m_lanes.push_back(std::make_unique<Lane>(depth));
+        Lane* l = m_lanes[0].get();
+        for (int i = 0; i < m_startupAsyncWorkers; ++i)
+            l->threads.emplace_back([this, l] { WorkerLoop(*l); });
+        BRIDGE_LOG_INFO("Started " + std::to_string(m_startupAsyncWorkers) + " async worker(s), queue depth=" +
+                        std::to_string(l->queue.Capacity()));
+    }
+    m_laneCount.store(m_lanes.size());
+}
+
+void BridgeEngine::StopWorkers() noexcept {
+    m_stop.store(true, std::memory_order_release);
+    for (auto& lane : m_lanes) {
+        lane->wake.fetch_add(1, std::memory_order_release);
+        lane->wake.notify_all();
+    }
+    for (auto& lane : m_lanes) {
+        for (std::thread& t : lane->threads) {
+            if (t.joinable()) t.join();
+        }
+    }
+}
+
+void BridgeEngine::WorkerLoop(Lane& lane) noexcept {
+    AsyncJob job;
+    for (;;) {
+        // Read the wake counter before checking the queue, so a push that
+        // lands in between changes it and the wait below returns at once.
+        uint32_t seen = lane.wake.load(std::memory_order_acquire);
+        while (lane.queue.TryPop(job)) {
+            BRIDGE_LATENCY_SCOPE();
+            int rc = ExecuteNow(job.req, true);
+            CountRequest(job.req.command, rc);
+            Journal(job.req, job.receivedNs, rc, RequestJournal::kAsync);
+            m_tickets.Store(job.ticket, rc);
+        }
+        if (m_stop.load(std::memory_order_acquire)) break;   // drained; shutting down
+        lane.wake.wait(seen, std::memory_order_acquire);
+    }
+}
+
+size_t BridgeEngine::ExecutionLanes() const noexcept {
+    return m_laneCount.load();
+}
+
+void BridgeEngine::SwapAdapter(std::shared_ptr<IBrokerAdapter> adapter) {
+    InstallAdapter(std::move(adapter), Config().adapterType);
+}
+
+void BridgeEngine::InstallAdapter(std::shared_ptr<IBrokerAdapter> adapter, const std::string& name) {
+    std::lock_guard<std::mutex> lk(m_swapMutex);
+    m_adapterSlots.push_back(std::make_unique<AdapterSlot>(std::move(adapter), name));
+    AdapterSlot* old = m_adapter.exchange(m_adapterSlots.back().get());
+
+    // Drain: wait for calls that leased the old slot before the exchange.
+    auto start = std::chrono::steady_clock::now();
+    auto nextLog = start + std::chrono::seconds(1);
+    while (old->inFlight.load() != 0) {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+        if (std::chrono::steady_clock::now() >= nextLog) {
+            BRIDGE_LOG_WARN("SwapAdapter: waiting for " + std::to_string(old->inFlight.load()) +
+                            " in-flight request(s) on the old adapter");
+            nextLog += std::chrono::seconds(1);
+        }
+    }
+    old->adapter.reset();
+    BRIDGE_LOG_INFO("Adapter swapped after draining in " +
+                    std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(
+                        std::chrono::steady_clock::now() - start).count()) + " ms");
+}
+
+void BridgeEngine::ApplyConfig(const BridgeConfig& requested) {
+    std::lock_guard<std::mutex> lk(m_reloadMutex);
+    const BridgeConfig& prev = *m_config.Current();
+    BridgeConfig next = requested;
+
+    if (next.asyncWorkers != m_startupAsyncWorkers || next.asyncQueueDepth != m_startupQueueDepth ||
+        next.executionLanes != m_startupLanes) {
+        BRIDGE_LOG_WARN("Config reload: asyncWorkers/asyncQueueDepth/executionLanes take effect only after a restart");
+        next.asyncWorkers    = m_startupAsyncWorkers;
+        next.asyncQueueDepth = m_startupQueueDepth;
+        next.executionLanes  = m_startupLanes;
+    }
+    // The adapter first: if it cannot be created, nothing of this reload applies.
+    if (AdapterSettingsDiffer(next, prev)) {
+        std::shared_ptr<IBrokerAdapter> adapter;
+        try {
+            adapter = CreateAdapter(next);
+        }
+        catch (const std::exception& ex) {
+            BRIDGE_LOG_ERROR("Config reload: cannot create adapter " + next.adapterType + " (" + ex.what() +
+                             "); keeping current settings");
+            return;
+        }
+        BRIDGE_LOG_INFO("Config reload: switching adapter " + prev.adapterType + " -> " + next.adapterType);
+        InstallAdapter(std::move(adapter), next.adapterType);
+    }
+    if (next.journalPath != prev.journalPath) {
+        BRIDGE_LOG_WARN("Config reload: journalPath takes effect only after a restart");
+        next.journalPath = prev.journalPath;
+    }
+    if (next.statsSharedMemory != prev.statsSharedMemory) {
+        BRIDGE_LOG_WARN("Config reload: statsSharedMemory takes effect only after a restart");
+        next.statsSharedMemory = prev.statsSharedMemory;
+    }
+    if (next.logQueueDepth != prev.logQueueDepth) {
+        BRIDGE_LOG_WARN("Config reload: logQueueDepth takes effect only after a restart");
+        next.logQueueDepth = prev.logQueueDepth;
+    }
+    if (next.logFilePath != prev.logFilePath || next.logToConsole != prev.logToConsole ||
+        next.logFlushMs != prev.logFlushMs || next.logBlockOnFull != prev.logBlockOnFull ||
+        next.logBinary != prev.logBinary || next.logLevel != prev.logLevel ||
+        next.logMaxSizeMb != prev.logMaxSizeMb || next.logRotateMinutes != prev.logRotateMinutes ||
+        next.logKeepSegments != prev.logKeepSegments)
+        LogInit(LogOptionsOf(next));
+    LatencySetEnabled(next.latencyStats);
+
+    m_config.Publish(next);
+    StartStatsThread(next);
+    BRIDGE_LOG_INFO("Config applied (version " + std::to_string(m_config.Version()) + ")");
+}
+
+bool BridgeEngine::WatchConfigFile(const std::string& path) {
+    // Runs on the watcher thread, where an escaping exception would end the process.
+    return m_watcher.Start(path, [this, path] {
+        try {
+            BridgeConfig next;
+            if (LoadConfig(path, next) != RC_SUCCESS) {
+                BRIDGE_LOG_WARN("Config reload: cannot read " + path + "; keeping current settings");
+                return;
+            }
+            ApplyConfig(next);
+        }
+        catch (const std::exception& ex) {
+            BRIDGE_LOG_ERROR(std::string("Exception in config reload: ") + ex.what());
+        }
+        catch (...) {
+            BRIDGE_LOG_ERROR("Unknown exception in config reload");
+        }
+    });
+}
+
 bool BridgeEngine::IsConnected() const noexcept {
-    return m_adapter && m_adapter->IsConnected();
+    AdapterLease adapter(m_adapter);
+    return adapter.Usable();
 }
 
+static std::atomic<BridgeEngine*> g_engine{ nullptr };   // set once GetEngine has built it
+
 BridgeEngine& GetEngine() noexcept {
     // Load config once from file (or use defaults)
     static BridgeConfig cfg = []() -> BridgeConfig {
@@ -63,7 +708,17 @@ BridgeEngine& GetEngine() noexcept {
         return c;
     }();
     static BridgeEngine engine(cfg);
+    static bool watching = [] {
+        g_engine.store(&engine);
+        return engine.WatchConfigFile("config/bridge.json");
+    }();
+    (void)watching;
     return engine;
 }
 
+void ShutdownEngine() noexcept {
+    if (BridgeEngine* engine = g_engine.load()) engine->Shutdown();
+    LogShutdown();
+}
+
 } // namespace Bridge
@@ -1,5 +1,6 @@
 #include "Config.h"
 #include "Types.h"
+#include "Numeric.h"
 #include <fstream>
 #include <string>
 #include <algorithm>
@@ -11,9 +12,29 @@ static std::string Trim(const std::string& s) {
     size_t b = s.find_first_not_of(" \t\r\n\"");
     if (b == std::string::npos) return {};
     size_t e = s.find_last_not_of(" \t\r\n\",");
+    if (e == std::string::npos || e < b) return {};   // "": nothing but quotes and a comma
     return s.substr(b, e - b + 1);
 }
 
+// Parse a non-negative integer setting; leaves 'out' untouched if malformed.
+static void ParseCount(const std::string& val, int& out) {
+    int v = 0;
+    if (ParseInt(val, v) == std::errc{} && v >= 0) out = v;
+}
+
+static void ParseRate(const std::string& val, double& out) {
+    double v = 0.0;
+    if (ParseDouble(val, v) == std::errc{} && v >= 0.0 && v <= 1.0) out = v;
+}
+
+// "DEBUG", "INFO", "WARN" or "ERROR"; leaves 'out' untouched otherwise.
+static void ParseLevel(const std::string& val, LogLevel& out) {
+    if      (val == "DEBUG") out = LogLevel::DEBUG_;
+    else if (val == "INFO")  out = LogLevel::INFO;
+    else if (val == "WARN" || val == "WARNING") out = LogLevel::WARNING_;
+    else if (val == "ERROR") out = LogLevel::ERROR_;
+}
+
 static std::string ToUpper(const std::string& s) {
     std::string r = s;
     std::transform(r.begin(), r.end(), r.begin(),
@@ -39,6 +60,39 @@ int LoadConfig(const std::string& path, BridgeConfig& out) noexcept {
             if      (ku == "ADAPTERTYPE")  out.adapterType   = ToUpper(val);
             else if (ku == "LOGFILEPATH")  out.logFilePath   = val;
             else if (ku == "LOGTOCONSOLE") out.logToConsole  = (ToUpper(val) == "TRUE");
+            else if (ku == "LOGFLUSHMS")      ParseCount(val, out.logFlushMs);
+            else if (ku == "LOGQUEUEDEPTH")   ParseCount(val, out.logQueueDepth);
+            else if (ku == "LOGWHENFULL")     out.logBlockOnFull = (ToUpper(val) == "BLOCK");
+            else if (ku == "LOGFORMAT")       out.logBinary      = (ToUpper(val) == "BINARY");
+            else if (ku == "LOGLEVEL")        ParseLevel(ToUpper(val), out.logLevel);
+            else if (ku == "LOGMAXSIZEMB")    ParseCount(val, out.logMaxSizeMb);
+            else if (ku == "LOGROTATEMINUTES") ParseCount(val, out.logRotateMinutes);
+            else if (ku == "LOGKEEPSEGMENTS") ParseCount(val, out.logKeepSegments);
+            else if (ku == "ASYNCWORKERS")    ParseCount(val, out.asyncWorkers);
+            else if (ku == "ASYNCQUEUEDEPTH") ParseCount(val, out.asyncQueueDepth);
+            else if (ku == "EXECUTIONLANES")  ParseCount(val, out.executionLanes);
+            else if (ku == "DEDUPWINDOWMS")   ParseCount(val, out.dedupWindowMs);
+            else if (ku == "JOURNALPATH")     out.journalPath = val;
+            else if (ku == "LATENCYSTATS")    out.latencyStats = (ToUpper(val) == "TRUE");
+            else if (ku == "STATSDUMPSECONDS") ParseCount(val, out.statsDumpSeconds);
+            else if (ku == "STATSSHAREDMEMORY") out.statsSharedMemory = val;
+            else if (ku == "STATSPUBLISHMS")  ParseCount(val, out.statsPublishMs);
+            else if (ku == "FIXHOST")         out.fixHost = val;
+            else if (ku == "FIXPORT")         ParseCount(val, out.fixPort);
+            else if (ku == "FIXSENDERCOMPID") out.fixSenderCompId = val;
+            else if (ku == "FIXTARGETCOMPID") out.fixTargetCompId = val;
+            else if (ku == "FIXHEARTBEATSECONDS") ParseCount(val, out.fixHeartbeatSeconds);
+            else if (ku == "FIXACKTIMEOUTMS") ParseCount(val, out.fixAckTimeoutMs);
+            else if (ku == "FIXSTOREPATH")    out.fixStorePath = val;
+            else if (ku == "SIMFEEDPATH")     out.simFeedPath = val;
+            else if (ku == "PIPENAME")        out.pipeName = val;
+            else if (ku == "DOTNETTIMEOUTMS") ParseCount(val, out.dotnetTimeoutMs);
+            else if (ku == "FAULTLATENCY")    out.faultLatency = val;
+            else if (ku == "FAULTREJECTRATE") ParseRate(val, out.faultRejectRate);
+            else if (ku == "FAULTTIMEOUTMS")  ParseCount(val, out.faultTimeoutMs);
+            else if (ku == "FAULTDISCONNECTEVERYMS") ParseCount(val, out.faultDisconnectEveryMs);
+            else if (ku == "FAULTDISCONNECTFORMS")   ParseCount(val, out.faultDisconnectForMs);
+            else if (ku == "FAULTSEED")       ParseCount(val, out.faultSeed);
         }
         return RC_SUCCESS;
     }
@@ -0,0 +1,19 @@
+#include "ConfigStore.h"
+
+namespace Bridge {
+
+ConfigStore::ConfigStore(const BridgeConfig& initial)
+    : m_current(nullptr)
+{
+    Publish(initial);
+}
+
+const BridgeConfig* ConfigStore::Publish(const BridgeConfig& next) {
+    std::lock_guard<std::mutex> lk(m_publishMutex);
+    m_snapshots.push_back(std::make_unique<const BridgeConfig>(next));
+    const BridgeConfig* prev = m_current.exchange(m_snapshots.back().get(), std::memory_order_acq_rel);
+    m_version.fetch_add(1, std::memory_order_release);
+    return prev;
+}
+
+} // namespace Bridge
@@ -0,0 +1,233 @@
+#include "ConfigWatcher.h"
+#include "Logger.h"
+#include <chrono>
+#include <filesystem>
+#include <system_error>
+
+#if defined(_WIN32)
+#  define WIN32_LEAN_AND_MEAN
+#  include <windows.h>
+#elif defined(__linux__)
+#  include <sys/inotify.h>
+#  include <poll.h>
+#  include <unistd.h>
+#  include <fcntl.h>
+#endif
+
+namespace Bridge {
+
+// Editors save in several steps (truncate, write, rename); wait for quiet.
+static constexpr int kDebounceMs = 150;
+
+ConfigWatcher::~ConfigWatcher() {
+    Stop();
+}
+
+#if defined(_WIN32)
+
+static std::wstring Widen(const std::string& s) {
+    if (s.empty()) return {};
+    int n = MultiByteToWideChar(CP_UTF8, 0, s.data(), static_cast<int>(s.size()), nullptr, 0);
+    std::wstring w(static_cast<size_t>(n), L'\0');
+    MultiByteToWideChar(CP_UTF8, 0, s.data(), static_cast<int>(s.size()), w.data(), n);
+    return w;
+}
+
+bool ConfigWatcher::Start(const std::string& path, std::function<void()> onChange) {
+    if (IsRunning()) return false;
+    std::filesystem::path p(path);
+    m_dir      = p.has_parent_path() ? p.parent_path().string() : ".";
+    m_name     = p.filename().string();
+    m_onChange = std::move(onChange);
+
+    HANDLE dir = CreateFileW(Widen(m_dir).c_str(), FILE_LIST_DIRECTORY,
+                             FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+                             OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+    if (dir == INVALID_HANDLE_VALUE) {
+        BRIDGE_LOG_WARN("ConfigWatcher: cannot watch directory " + m_dir);
+        return false;
+    }
+    HANDLE stop = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+    if (!stop) {
+        CloseHandle(dir);
+        return false;
+    }
+    m_watchHandle = reinterpret_cast<intptr_t>(dir);
+    m_stopHandle  = reinterpret_cast<intptr_t>(stop);
+    m_stop.store(false);
+    m_thread = std::thread([this] { Run(); });
+    return true;
+}
+
+void ConfigWatcher::Stop() noexcept {
+    if (!m_thread.joinable()) return;
+    m_stop.store(true);
+    SetEvent(reinterpret_cast<HANDLE>(m_stopHandle));
+    m_thread.join();
+    CloseHandle(reinterpret_cast<HANDLE>(m_watchHandle));
+    CloseHandle(reinterpret_cast<HANDLE>(m_stopHandle));
+    m_watchHandle = m_stopHandle = -1;
+}
+
+void ConfigWatcher::Run() {
+    HANDLE dir  = reinterpret_cast<HANDLE>(m_watchHandle);
+    HANDLE stop = reinterpret_cast<HANDLE>(m_stopHandle);
+    HANDLE done = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+    if (!done) return;
+    std::wstring name = Widen(m_name);
+    alignas(DWORD) char buf[16 * 1024];
+    const DWORD filter = FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME |
+                         FILE_NOTIFY_CHANGE_SIZE;
+    bool pending = false;
+
+    while (!m_stop.load()) {
+        OVERLAPPED ov{};
+        ov.hEvent = done;
+        ResetEvent(done);
+        if (!ReadDirectoryChangesW(dir, buf, sizeof(buf), FALSE, filter, nullptr, &ov, nullptr)) {
+            BRIDGE_LOG_WARN("ConfigWatcher: ReadDirectoryChangesW failed, error=" +
+                            std::to_string(GetLastError()));
+            break;
+        }
+        HANDLE waits[2] = { done, stop };
+        DWORD wr = WaitForMultipleObjects(2, waits, FALSE, pending ? kDebounceMs : INFINITE);
+        if (wr == WAIT_OBJECT_0 + 1) {
+            CancelIoEx(dir, &ov);
+            WaitForSingleObject(done, INFINITE);
+            break;
+        }
+        if (wr == WAIT_TIMEOUT) {
+            // Quiet for the debounce interval: fire, then keep listening.
+            CancelIoEx(dir, &ov);
+            WaitForSingleObject(done, INFINITE);
+            pending = false;
+            m_onChange();
+            continue;
+        }
+        DWORD bytes = 0;
+        if (!GetOverlappedResult(dir, &ov, &bytes, FALSE) || bytes == 0) {
+            pending = true;   // overflow: something changed, re-read to be safe
+            continue;
+        }
+        for (const char* p = buf;;) {
+            auto* info = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(p);
+            std::wstring changed(info->FileName, info->FileNameLength / sizeof(WCHAR));
+            if (CompareStringOrdinal(changed.c_str(), -1, name.c_str(), -1, TRUE) == CSTR_EQUAL)
+                pending = true;
+            if (info->NextEntryOffset == 0) break;
+            p += info->NextEntryOffset;
+        }
+    }
+    CloseHandle(done);
+}
+
+#elif defined(__linux__)
+
+bool ConfigWatcher::Start(const std::string& path, std::function<void()> onChange) {
+    if (IsRunning()) return false;
+    std::filesystem::path p(path);
+    m_dir      = p.has_parent_path() ? p.parent_path().string() : ".";
+    m_name     = p.filename().string();
+    m_onChange = std::move(onChange);
+
+    int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd < 0) return false;
+    if (inotify_add_watch(fd, m_dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_MODIFY) < 0) {
+        BRIDGE_LOG_WARN("ConfigWatcher: cannot watch directory " + m_dir);
+        close(fd);
+        return false;
+    }
+    int pipeFds[2];
+    if (pipe2(pipeFds, O_CLOEXEC) != 0) {
+        close(fd);
+        return false;
+    }
+    m_watchHandle = fd;
+    m_stopRead    = pipeFds[0];
+    m_stopHandle  = pipeFds[1];
+    m_stop.store(false);
+    m_thread = std::thread([this] { Run(); });
+    return true;
+}
+
+void ConfigWatcher::Stop() noexcept {
+    if (!m_thread.joinable()) return;
+    m_stop.store(true);
+    char b = 1;
+    ssize_t ignored = write(static_cast<int>(m_stopHandle), &b, 1);
+    (void)ignored;
+    m_thread.join();
+    close(static_cast<int>(m_watchHandle));
+    close(static_cast<int>(m_stopRead));
+    close(static_cast<int>(m_stopHandle));
+    m_watchHandle = m_stopRead = m_stopHandle = -1;
+}
+
+void ConfigWatcher::Run() {
+    int fd = static_cast<int>(m_watchHandle);
+    alignas(inotify_event) char buf[4096];
+    bool pending = false;
+
+    while (!m_stop.load()) {
+        pollfd fds[2] = {
+            { fd, POLLIN, 0 },
+            { static_cast<int>(m_stopRead), POLLIN, 0 },
+        };
+        int n = poll(fds, 2, pending ? kDebounceMs : -1);
+        if (n < 0) continue;                           // EINTR
+        if (fds[1].revents) break;
+        if (n == 0) {
+            pending = false;
+            m_onChange();
+            continue;
+        }
+        ssize_t len;
+        while ((len = read(fd, buf, sizeof(buf))) > 0) {
+            for (char* p = buf; p < buf + len; ) {
+                auto* ev = reinterpret_cast<inotify_event*>(p);
+                if ((ev->mask & IN_Q_OVERFLOW) || (ev->len > 0 && m_name == ev->name))
+                    pending = true;
+                p += sizeof(inotify_event) + ev->len;
+            }
+        }
+    }
+}
+
+#else
+
+// Portable fallback: poll the modification time.
+bool ConfigWatcher::Start(const std::string& path, std::function<void()> onChange) {
+    if (IsRunning()) return false;
+    std::error_code ec;
+    std::filesystem::path p(path);
+    m_dir      = p.has_parent_path() ? p.parent_path().string() : ".";
+    m_name     = path;
+    m_onChange = std::move(onChange);
+    if (!std::filesystem::is_directory(m_dir, ec)) return false;
+    m_stop.store(false);
+    m_thread = std::thread([this] { Run(); });
+    return true;
+}
+
+void ConfigWatcher::Stop() noexcept {
+    if (!m_thread.joinable()) return;
+    m_stop.store(true);
+    m_thread.join();
+}
+
+void ConfigWatcher::Run() {
+    std::error_code ec;
+    auto last = std::filesystem::last_write_time(m_name, ec);
+    while (!m_stop.load()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(kDebounceMs));
+        auto now = std::filesystem::last_write_time(m_name, ec);
+        if (!ec && now != last) {
+            last = now;
+            m_onChange();
+        }
+    }
+}
+
+#endif
+
+} // namespace Bridge
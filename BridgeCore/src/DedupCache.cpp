@@ -0,0 +1,104 @@
+#include "DedupCache.h"
+#include "Numeric.h"
+#include "SymbolTable.h"
+
+namespace Bridge {
+
+static constexpr uint64_t kFnvOffset = 14695981039346656037ull;
+static constexpr uint64_t kFnvPrime  = 1099511628211ull;
+
+static uint64_t Mix(uint64_t h, uint64_t v) noexcept {
+    for (int i = 0; i < 8; ++i) {
+        h = (h ^ (v & 0xFF)) * kFnvPrime;
+        v >>= 8;
+    }
+    return h;
+}
+
+// Strip trailing zero decimals so "5000.50" and 5000.5 hash alike.
+static uint64_t MixPrice(uint64_t h, FixedPrice p) noexcept {
+    if (!p.IsSet()) return Mix(h, 0xFF);
+    while (p.scale > 0 && p.ticks % 10 == 0) {
+        p.ticks /= 10;
+        --p.scale;
+    }
+    return Mix(Mix(h, p.scale), static_cast<uint64_t>(p.ticks));
+}
+
+static FixedPrice ExactPrice(const FixedPrice& px, double value) noexcept {
+    return px.IsSet() ? px : PriceFromDouble(value);
+}
+
+static uint64_t Unpack(uint64_t value, int& rc) noexcept {
+    rc = static_cast<int8_t>(static_cast<uint8_t>(value));
+    return value >> 8;
+}
+
+uint64_t BarKeyOf(std::string_view key) noexcept {
+    uint64_t h = kFnvOffset;
+    for (char c : key)
+        h = (h ^ static_cast<uint8_t>(c)) * kFnvPrime;
+    return h ? h : 1;
+}
+
+// The interned id, or a hash of the name if the symbol table is full, so
+// names that got no id still key apart.
+static uint64_t NameKey(SymbolId id, std::string_view name) noexcept {
+    return id != kNoSymbol || name.empty() ? id : BarKeyOf(name) | (uint64_t(1) << 63);
+}
+
+uint64_t DedupCache::KeyOf(const OrderRequest& req) noexcept {
+    uint64_t h = kFnvOffset;
+    h = Mix(h, static_cast<uint64_t>(req.command));
+    h = Mix(h, NameKey(AccountIdOf(req), req.account));
+    h = Mix(h, NameKey(InstrumentIdOf(req), req.instrument));
+    h = Mix(h, static_cast<uint64_t>(req.action));
+    h = Mix(h, static_cast<uint64_t>(static_cast<uint32_t>(req.quantity)));
+    h = Mix(h, static_cast<uint64_t>(req.orderType));
+    h = MixPrice(h, ExactPrice(req.limitPx, req.limitPrice));
+    h = MixPrice(h, ExactPrice(req.stopPx, req.stopPrice));
+    h = Mix(h, static_cast<uint64_t>(req.timeInForce));
+    h = Mix(h, req.barKey);
+    h ^= h >> 29;                       // spread high bits into the slot index
+    return h ? h : 1;
+}
+
+bool DedupCache::Lookup(uint64_t key, int64_t nowMs, int64_t windowMs, int& rc) noexcept {
+    size_t base = static_cast<size_t>(key) & (kSlots - 1);
+    for (size_t i = 0; i < kProbe; ++i) {
+        Slot& s = m_slots[(base + i) & (kSlots - 1)];
+        if (s.key.load(std::memory_order_acquire) != key) continue;
+        uint64_t value = s.value.load(std::memory_order_acquire);
+        if (s.key.load(std::memory_order_acquire) != key) continue;   // rewritten meanwhile
+        int cached = 0;
+        int64_t stamp = static_cast<int64_t>(Unpack(value, cached));
+        if (nowMs - stamp < windowMs) {
+            rc = cached;
+            m_hits.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        break;   // expired
+    }
+    m_misses.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void DedupCache::Record(uint64_t key, int64_t nowMs, int rc) noexcept {
+    size_t base   = static_cast<size_t>(key) & (kSlots - 1);
+    Slot*  target = nullptr;
+    uint64_t oldest = UINT64_MAX;
+    for (size_t i = 0; i < kProbe; ++i) {
+        Slot& s = m_slots[(base + i) & (kSlots - 1)];
+        uint64_t k = s.key.load(std::memory_order_acquire);
+        if (k == key || k == 0) { target = &s; break; }
+        uint64_t stamp = s.value.load(std::memory_order_relaxed) >> 8;
+        if (stamp < oldest) { oldest = stamp; target = &s; }
+    }
+    uint64_t value = (static_cast<uint64_t>(nowMs) << 8) |
+                     static_cast<uint8_t>(static_cast<int8_t>(rc));
+    target->key.store(0, std::memory_order_release);
+    target->value.store(value, std::memory_order_release);
+    target->key.store(key, std::memory_order_release);
+}
+
+} // namespace Bridge
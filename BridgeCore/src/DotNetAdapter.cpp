@@ -0,0 +1,320 @@
+#include "DotNetAdapter.h"
+#include "Logger.h"
+#include "Numeric.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+
+namespace Bridge {
+
+namespace {
+
+constexpr int    kConnectTimeoutMs   = 5000;
+constexpr int    kHandshakeTimeoutMs = 30000;   // the worker logs on to T4 before answering CONNECT
+constexpr int    kMaxReconnectMs     = 30000;
+constexpr int    kPollMs             = 50;
+constexpr size_t kRecvCapacity       = 64 * 1024;
+
+const char* TypeName(OrderType t) noexcept {
+    switch (t) {
+        case OrderType::LIMIT:      return "LIMIT";
+        case OrderType::STOPMARKET: return "STOPMARKET";
+        case OrderType::STOPLIMIT:  return "STOPLIMIT";
+        default:                    return "MARKET";
+    }
+}
+
+// The worker's PLACE takes one price: the limit, or the stop of a stop-market order.
+FixedPrice PriceOf(const OrderRequest& req) noexcept {
+    if (req.orderType == OrderType::LIMIT || req.orderType == OrderType::STOPLIMIT)
+        return req.limitPx.IsSet() ? req.limitPx : PriceFromDouble(req.limitPrice);
+    if (req.orderType == OrderType::STOPMARKET)
+        return req.stopPx.IsSet() ? req.stopPx : PriceFromDouble(req.stopPrice);
+    return FixedPrice{ 0, 0 };
+}
+
+// Fields are separated by spaces and requests by newlines.
+bool IsToken(std::string_view s) noexcept {
+    return !s.empty() && std::none_of(s.begin(), s.end(), [](char c) {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    });
+}
+
+void AppendInt(std::string& out, uint64_t v) {
+    char buf[24];
+    auto r = std::to_chars(buf, buf + sizeof(buf), v);
+    out.append(buf, r.ptr);
+}
+
+} // anonymous namespace
+
+DotNetSettings DotNetSettingsOf(const BridgeConfig& cfg) {
+    DotNetSettings s;
+    s.pipeName  = cfg.pipeName;
+    s.timeoutMs = cfg.dotnetTimeoutMs;
+    return s;
+}
+
+DotNetAdapter::DotNetAdapter(DotNetSettings settings)
+    : m_settings(std::move(settings))
+{
+    m_sendBuf.reserve(4096);
+    m_recvBuf.resize(kRecvCapacity);
+    m_thread = std::thread([this] { Run(); });
+}
+
+DotNetAdapter::~DotNetAdapter() {
+    {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        m_stop = true;
+        m_pipe.Shutdown();
+    }
+    m_wake.notify_all();
+    if (m_thread.joinable()) m_thread.join();
+}
+
+size_t DotNetAdapter::InFlight() const {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    return m_pending.size();
+}
+
+// ---- Orders -----------------------------------------------------------------
+
+int DotNetAdapter::Execute(const OrderRequest& req) {
+    int rc = RC_SUCCESS;
+    ExecuteBatch(&req, 1, &rc);
+    return rc;
+}
+
+void DotNetAdapter::ExecuteBatch(const OrderRequest* reqs, size_t count, int* results) {
+    std::vector<std::pair<size_t, uint64_t>> sent;   // (request index, id)
+    sent.reserve(count);
+    std::unique_lock<std::mutex> lk(m_mutex);
+    if (!m_connected.load(std::memory_order_relaxed)) {
+        std::fill(results, results + count, RC_NOT_CONNECTED);
+        return;
+    }
+    m_sendBuf.clear();
+    for (size_t i = 0; i < count; ++i) {
+        const OrderRequest& req = reqs[i];
+        if (req.command != Command::PLACE) {
+            results[i] = RC_INVALID_CMD;
+            continue;
+        }
+        if (!IsToken(req.instrument) || req.quantity <= 0 ||
+            (req.action != Action::BUY && req.action != Action::SELL) || !PriceOf(req).IsSet()) {
+            results[i] = RC_INVALID_PARAM;
+            continue;
+        }
+        uint64_t id = m_nextId++;
+        AppendPlace(id, req);
+        m_pending.emplace(id, Pending{});
+        sent.emplace_back(i, id);
+        results[i] = RC_SUCCESS;
+    }
+    if (sent.empty()) return;
+    // One write for the whole batch; the answers come back as they are ready.
+    if (!Send()) {
+        for (const auto& s : sent) {
+            m_pending.erase(s.second);
+            results[s.first] = RC_NOT_CONNECTED;
+        }
+        return;
+    }
+    Await(lk, sent, results);
+}
+
+void DotNetAdapter::AppendPlace(uint64_t id, const OrderRequest& req) {
+    char price[32];
+    size_t priceLen = FormatPrice(PriceOf(req), price, sizeof(price));
+    m_sendBuf += '#';
+    AppendInt(m_sendBuf, id);
+    m_sendBuf += " PLACE ";
+    m_sendBuf += req.instrument;
+    m_sendBuf += req.action == Action::BUY ? " BUY " : " SELL ";
+    AppendInt(m_sendBuf, static_cast<uint64_t>(req.quantity));
+    m_sendBuf += ' ';
+    m_sendBuf.append(price, priceLen);
+    m_sendBuf += ' ';
+    m_sendBuf += TypeName(req.orderType);
+    m_sendBuf += '\n';
+}
+
+bool DotNetAdapter::Send() {
+    if (m_pipe.SendAll(m_sendBuf.data(), m_sendBuf.size())) return true;
+    // Let the session thread notice and reconnect.
+    m_connected.store(false, std::memory_order_release);
+    m_pipe.Shutdown();
+    return false;
+}
+
+void DotNetAdapter::Await(std::unique_lock<std::mutex>& lk, const std::vector<std::pair<size_t, uint64_t>>& sent,
+                          int* results) {
+    auto answered = [&] {
+        for (const auto& s : sent) {
+            auto it = m_pending.find(s.second);
+            if (it != m_pending.end() && it->second.rc == RC_PENDING) return false;
+        }
+        return true;
+    };
+    m_answered.wait_for(lk, std::chrono::milliseconds(std::max(m_settings.timeoutMs, 1)), answered);
+    for (const auto& s : sent) {
+        auto it = m_pending.find(s.second);
+        if (it == m_pending.end()) {
+            results[s.first] = RC_NOT_CONNECTED;
+            continue;
+        }
+        int rc = it->second.rc;
+        if (rc == RC_PENDING) {
+            it->second.waited = false;   // the session thread drops it when the answer comes
+            rc = RC_TIMEOUT;
+        } else {
+            m_pending.erase(it);
+        }
+        results[s.first] = rc;
+    }
+}
+
+// ---- Session thread -------------------------------------------------------------
+
+void DotNetAdapter::Run() noexcept {
+    int  delay  = std::max(m_settings.reconnectMs, 1);
+    bool warned = false;
+    for (;;) {
+        bool served = false;
+        try {
+            if (Open()) {
+                warned = false;
+                served = true;
+                Serve();
+            } else if (!warned) {
+                BRIDGE_LOG_WARN("DOTNET: cannot connect to pipe " + PipeChannel::PathOf(m_settings.pipeName) +
+                                "; retrying in the background");
+                warned = true;
+            }
+        }
+        catch (...) {
+            BRIDGE_LOG_ERROR("DOTNET: unexpected exception in the session thread");
+        }
+        Disconnected();
+        if (served) delay = std::max(m_settings.reconnectMs, 1);
+
+        std::unique_lock<std::mutex> lk(m_mutex);
+        if (m_wake.wait_for(lk, std::chrono::milliseconds(delay), [this] { return m_stop; })) return;
+        if (!served) delay = std::min(delay * 2, kMaxReconnectMs);
+    }
+}
+
+bool DotNetAdapter::Open() {
+    {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        if (m_stop) return false;
+    }
+    // Connecting happens without the lock, so callers are never held up by it.
+    PipeChannel p = PipeChannel::Connect(m_settings.pipeName, kConnectTimeoutMs);
+    if (!p.IsOpen()) return false;
+
+    std::lock_guard<std::mutex> lk(m_mutex);
+    if (m_stop) return false;
+    m_pipe        = std::move(p);
+    m_connectId   = m_nextId++;
+    m_connectSent = Clock::now();
+    m_sendBuf.clear();
+    m_sendBuf += '#';
+    AppendInt(m_sendBuf, m_connectId);
+    m_sendBuf += " CONNECT\n";
+    if (!m_pipe.SendAll(m_sendBuf.data(), m_sendBuf.size())) return false;
+    BRIDGE_LOG_INFO("DOTNET: connected to pipe " + PipeChannel::PathOf(m_settings.pipeName) + ", CONNECT sent");
+    return true;
+}
+
+void DotNetAdapter::Serve() {
+    size_t len = 0;
+    for (;;) {
+        if (len == m_recvBuf.size()) {
+            BRIDGE_LOG_ERROR("DOTNET: reply longer than " + std::to_string(m_recvBuf.size()) + " bytes");
+            return;
+        }
+        int n = m_pipe.Receive(m_recvBuf.data() + len, m_recvBuf.size() - len, kPollMs);
+        if (n < 0) return;
+        len += static_cast<size_t>(n);
+
+        size_t used = 0;
+        for (;;) {
+            const char* start = m_recvBuf.data() + used;
+            const char* nl    = static_cast<const char*>(std::memchr(start, '\n', len - used));
+            if (!nl) break;
+            std::string_view line(start, static_cast<size_t>(nl - start));
+            if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+            used = static_cast<size_t>(nl - m_recvBuf.data()) + 1;
+            if (!OnLine(line)) return;
+        }
+        if (used > 0) {
+            std::memmove(m_recvBuf.data(), m_recvBuf.data() + used, len - used);
+            len -= used;
+        }
+
+        std::lock_guard<std::mutex> lk(m_mutex);
+        if (m_stop) return;
+        if (m_connectId != 0 && Clock::now() - m_connectSent > std::chrono::milliseconds(kHandshakeTimeoutMs)) {
+            BRIDGE_LOG_ERROR("DOTNET: no answer to CONNECT in " + std::to_string(kHandshakeTimeoutMs / 1000) + " s");
+            return;
+        }
+    }
+}
+
+bool DotNetAdapter::OnLine(std::string_view line) {
+    // "#<id> OK ..." or "#<id> ERROR ..."
+    uint64_t id = 0;
+    const char* end = line.data() + line.size();
+    auto r = line.size() > 1 && line[0] == '#' ? std::from_chars(line.data() + 1, end, id)
+                                               : std::from_chars_result{ line.data(), std::errc::invalid_argument };
+    if (r.ec != std::errc{} || r.ptr == end || *r.ptr != ' ') {
+        BRIDGE_LOG_WARN("DOTNET: ignoring untagged reply '" + std::string(line) + "'");
+        return true;
+    }
+    std::string_view reply(r.ptr + 1, static_cast<size_t>(end - r.ptr - 1));
+    bool ok = reply == "OK" || reply.rfind("OK ", 0) == 0;
+
+    std::lock_guard<std::mutex> lk(m_mutex);
+    if (id == m_connectId) {
+        m_connectId = 0;
+        if (!ok) {
+            BRIDGE_LOG_ERROR("DOTNET: worker refused CONNECT: " + std::string(reply));
+            return false;
+        }
+        m_connected.store(true, std::memory_order_release);
+        BRIDGE_LOG_INFO("DOTNET: worker connected: " + std::string(reply));
+        return true;
+    }
+    auto it = m_pending.find(id);
+    if (it == m_pending.end()) return true;
+    if (!ok) BRIDGE_LOG_WARN("DOTNET: request #" + std::to_string(id) + " refused: " + std::string(reply));
+    if (!it->second.waited) {
+        m_pending.erase(it);
+        return true;
+    }
+    it->second.rc = ok ? RC_SUCCESS : RC_REJECTED;
+    m_answered.notify_all();
+    return true;
+}
+
+void DotNetAdapter::Disconnected() {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    bool was = m_connected.exchange(false);
+    m_pipe.Close();
+    m_connectId = 0;
+    // Nobody will answer these now; waiting callers get RC_NOT_CONNECTED.
+    for (auto it = m_pending.begin(); it != m_pending.end();) {
+        if (!it->second.waited) {
+            it = m_pending.erase(it);
+            continue;
+        }
+        if (it->second.rc == RC_PENDING) it->second.rc = RC_NOT_CONNECTED;
+        ++it;
+    }
+    m_answered.notify_all();
+    if (was && !m_stop) BRIDGE_LOG_WARN("DOTNET: pipe lost; reconnecting");
+}
+
+} // namespace Bridge
@@ -0,0 +1,210 @@
+#include "FaultInjectingAdapter.h"
+#include "Logger.h"
+#include "Numeric.h"
+#include "Types.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <random>
+#include <thread>
+
+namespace Bridge {
+
+static std::string_view TrimSpaces(std::string_view s) noexcept {
+    while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) s.remove_prefix(1);
+    while (!s.empty() && (s.back() == ' ' || s.back() == '\t' || s.back() == '\r')) s.remove_suffix(1);
+    return s;
+}
+
+// Parse "<a><sep><b>" as two non-negative doubles.
+static bool ParsePair(std::string_view s, char sep, double& a, double& b) noexcept {
+    size_t at = s.find(sep);
+    if (at == std::string_view::npos) return false;
+    return ParseDouble(TrimSpaces(s.substr(0, at)), a) == std::errc{} &&
+           ParseDouble(TrimSpaces(s.substr(at + 1)), b) == std::errc{} &&
+           a >= 0.0 && b >= 0.0;
+}
+
+static int LoadHistogram(const std::string& path, std::vector<FaultProfile::Bucket>& out) {
+    std::ifstream f(path);
+    if (!f.is_open()) return RC_CONFIG_ERR;
+    out.clear();
+    std::string line;
+    while (std::getline(f, line)) {
+        std::string_view s = TrimSpaces(line);
+        if (s.empty() || s[0] == '#') continue;
+        size_t gap = s.find_first_of(" \t,");
+        if (gap == std::string_view::npos) return RC_CONFIG_ERR;
+        double upper = 0.0;
+        int    count = 0;
+        if (ParseDouble(s.substr(0, gap), upper) != std::errc{} ||
+            ParseInt(TrimSpaces(s.substr(gap + 1)), count) != std::errc{} ||
+            upper < 0.0 || count < 0)
+            return RC_CONFIG_ERR;
+        if (!out.empty() && upper <= out.back().upperUs) return RC_CONFIG_ERR;
+        out.push_back(FaultProfile::Bucket{ upper, static_cast<uint64_t>(count) });
+    }
+    for (const FaultProfile::Bucket& b : out)
+        if (b.count > 0) return RC_SUCCESS;
+    return RC_CONFIG_ERR;
+}
+
+int ParseFaultLatency(std::string_view spec, FaultProfile& out) noexcept {
+    try {
+        spec = TrimSpaces(spec);
+        size_t colon = spec.find(':');
+        std::string kind(spec.substr(0, colon));
+        std::transform(kind.begin(), kind.end(), kind.begin(),
+            [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        std::string_view arg = colon == std::string_view::npos ? std::string_view{}
+                                                               : TrimSpaces(spec.substr(colon + 1));
+
+        if (kind.empty() || kind == "none") {
+            out.latency = FaultProfile::Latency::None;
+            return RC_SUCCESS;
+        }
+        if (kind == "fixed") {
+            if (ParseDouble(arg, out.fixedUs) != std::errc{} || out.fixedUs < 0.0) return RC_CONFIG_ERR;
+            out.latency = FaultProfile::Latency::Fixed;
+            return RC_SUCCESS;
+        }
+        if (kind == "uniform") {
+            if (!ParsePair(arg, '-', out.minUs, out.maxUs) || out.maxUs < out.minUs) return RC_CONFIG_ERR;
+            out.latency = FaultProfile::Latency::Uniform;
+            return RC_SUCCESS;
+        }
+        if (kind == "lognormal") {
+            if (!ParsePair(arg, ',', out.medianUs, out.sigma)) return RC_CONFIG_ERR;
+            out.latency = FaultProfile::Latency::LogNormal;
+            return RC_SUCCESS;
+        }
+        if (kind == "histogram") {
+            if (LoadHistogram(std::string(arg), out.histogram) != RC_SUCCESS) return RC_CONFIG_ERR;
+            out.latency = FaultProfile::Latency::Histogram;
+            return RC_SUCCESS;
+        }
+        return RC_CONFIG_ERR;
+    }
+    catch (...) {
+        return RC_CONFIG_ERR;
+    }
+}
+
+FaultProfile MakeFaultProfile(const BridgeConfig& cfg) {
+    FaultProfile p;
+    if (ParseFaultLatency(cfg.faultLatency, p) != RC_SUCCESS) {
+        BRIDGE_LOG_WARN("faultLatency '" + cfg.faultLatency + "' is not valid; injecting no latency");
+        p = FaultProfile{};
+    }
+    p.rejectRate        = std::clamp(cfg.faultRejectRate, 0.0, 1.0);
+    p.timeoutMs         = cfg.faultTimeoutMs;
+    p.disconnectEveryMs = cfg.faultDisconnectEveryMs;
+    p.disconnectForMs   = std::min(cfg.faultDisconnectForMs, cfg.faultDisconnectEveryMs);
+    p.seed              = static_cast<uint64_t>(cfg.faultSeed);
+    return p;
+}
+
+FaultInjectingAdapter::FaultInjectingAdapter(std::shared_ptr<IBrokerAdapter> inner, FaultProfile profile)
+    : m_inner(std::move(inner)),
+      m_profile(std::move(profile)),
+      m_start(std::chrono::steady_clock::now()),
+      m_seed(m_profile.seed ? m_profile.seed : std::random_device{}())
+{
+    uint64_t total = 0;
+    for (const FaultProfile::Bucket& b : m_profile.histogram) {
+        total += b.count;
+        m_cumulative.push_back(total);
+    }
+}
+
+// splitmix64 over a shared draw counter: lock-free across lanes, and one
+// seed replays the same sequence of draws.
+double FaultInjectingAdapter::NextUniform() noexcept {
+    uint64_t z = m_seed + (m_draws.fetch_add(1, std::memory_order_relaxed) + 1) * 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    z ^= z >> 31;
+    return (static_cast<double>(z >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+}
+
+double FaultInjectingAdapter::SampleLatencyUs() noexcept {
+    const FaultProfile& p = m_profile;
+    switch (p.latency) {
+        case FaultProfile::Latency::Fixed:
+            return p.fixedUs;
+        case FaultProfile::Latency::Uniform:
+            return p.minUs + NextUniform() * (p.maxUs - p.minUs);
+        case FaultProfile::Latency::LogNormal: {
+            // Box-Muller: one standard normal from two uniforms.
+            double z = std::sqrt(-2.0 * std::log(NextUniform())) *
+                       std::cos(6.283185307179586 * NextUniform());
+            return p.medianUs * std::exp(p.sigma * z);
+        }
+        case FaultProfile::Latency::Histogram: {
+            if (m_cumulative.empty() || m_cumulative.back() == 0) return 0.0;
+            double   u      = NextUniform();
+            uint64_t target = static_cast<uint64_t>(u * static_cast<double>(m_cumulative.back()));
+            size_t   i      = std::upper_bound(m_cumulative.begin(), m_cumulative.end(), target) -
+                              m_cumulative.begin();
+            i = std::min(i, m_cumulative.size() - 1);
+            double lo = i ? p.histogram[i - 1].upperUs : 0.0;
+            return lo + NextUniform() * (p.histogram[i].upperUs - lo);
+        }
+        default:
+            return 0.0;
+    }
+}
+
+bool FaultInjectingAdapter::InDisconnectWindow() const noexcept {
+    const FaultProfile& p = m_profile;
+    if (p.disconnectEveryMs <= 0 || p.disconnectForMs <= 0) return false;
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - m_start).count();
+    return ms % p.disconnectEveryMs >= p.disconnectEveryMs - p.disconnectForMs;
+}
+
+bool FaultInjectingAdapter::IsConnected() const noexcept {
+    return !InDisconnectWindow() && m_inner->IsConnected();
+}
+
+FaultInjectingAdapter::Outcome FaultInjectingAdapter::Delay() noexcept {
+    if (InDisconnectWindow()) {
+        m_disconnects.fetch_add(1, std::memory_order_relaxed);
+        return Outcome::Down;
+    }
+    double us = SampleLatencyUs();
+    if (m_profile.timeoutMs > 0 && us > m_profile.timeoutMs * 1000.0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(m_profile.timeoutMs));
+        m_timeouts.fetch_add(1, std::memory_order_relaxed);
+        return Outcome::Timeout;
+    }
+    if (us >= 1.0) std::this_thread::sleep_for(std::chrono::microseconds(static_cast<long long>(us)));
+    if (m_profile.rejectRate > 0.0 && NextUniform() < m_profile.rejectRate) {
+        m_rejects.fetch_add(1, std::memory_order_relaxed);
+        return Outcome::Reject;
+    }
+    return Outcome::Forward;
+}
+
+int FaultInjectingAdapter::Execute(const OrderRequest& req) {
+    switch (Delay()) {
+        case Outcome::Down:    return RC_NOT_CONNECTED;
+        case Outcome::Reject:  return RC_REJECTED;
+        case Outcome::Timeout: m_inner->Execute(req); return RC_TIMEOUT;
+        default:               return m_inner->Execute(req);
+    }
+}
+
+void FaultInjectingAdapter::ExecuteBatch(const OrderRequest* reqs, size_t count, int* results) {
+    Outcome outcome = Delay();
+    if (outcome == Outcome::Forward || outcome == Outcome::Timeout)
+        m_inner->ExecuteBatch(reqs, count, results);
+    int rc = outcome == Outcome::Down    ? RC_NOT_CONNECTED
+           : outcome == Outcome::Reject  ? RC_REJECTED
+           : outcome == Outcome::Timeout ? RC_TIMEOUT
+           :                               RC_SUCCESS;
+    if (outcome != Outcome::Forward)
+        std::fill(results, results + count, rc);
+}
+
+} // namespace Bridge
@@ -0,0 +1,932 @@
+#include "FixAdapter.h"
+#include "Logger.h"
+#include "Numeric.h"
+#include "SymbolTable.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace Bridge {
+
+namespace {
+
+constexpr int    kConnectTimeoutMs = 5000;
+constexpr int    kLogonTimeoutMs   = 10000;
+constexpr int    kLogoutWaitMs     = 2000;
+constexpr int    kMaxReconnectMs   = 30000;
+constexpr int    kPollMs           = 50;
+constexpr size_t kRecvCapacity     = 64 * 1024;
+
+char SideCode(Action a) noexcept { return a == Action::BUY ? '1' : '2'; }
+
+Action SideOf(char c) noexcept {
+    switch (c) {
+        case '1': return Action::BUY;
+        case '2': case '5': case '6': return Action::SELL;   // sell, sell short, sell short exempt
+        default:  return Action::UNKNOWN;
+    }
+}
+
+char OrdTypeCode(OrderType t) noexcept {
+    switch (t) {
+        case OrderType::LIMIT:      return '2';
+        case OrderType::STOPMARKET: return '3';
+        case OrderType::STOPLIMIT:  return '4';
+        default:                    return '1';
+    }
+}
+
+bool HasLimit(OrderType t) noexcept { return t == OrderType::LIMIT || t == OrderType::STOPLIMIT; }
+bool HasStop(OrderType t) noexcept  { return t == OrderType::STOPMARKET || t == OrderType::STOPLIMIT; }
+
+int ClampInt(int64_t v) noexcept {
+    return static_cast<int>(std::clamp<int64_t>(v, std::numeric_limits<int>::min(), std::numeric_limits<int>::max()));
+}
+
+// "BR<HHMMSS><letter>-": ClOrdIDs must stay unique for the trading day
+// across restarts and across adapters started in the same second.
+std::string ClOrdIdPrefix() {
+    static std::atomic<unsigned> instances{ 0 };
+    char ts[kFixTimestampLen];
+    FixTimestamp(ts);
+    std::string p = "BR";
+    p.append(ts + 9, 2).append(ts + 12, 2).append(ts + 15, 2);
+    p += static_cast<char>('A' + instances.fetch_add(1) % 26);
+    p += '-';
+    return p;
+}
+
+} // anonymous namespace
+
+FixSettings FixSettingsOf(const BridgeConfig& cfg) {
+    FixSettings s;
+    s.host             = cfg.fixHost;
+    s.port             = cfg.fixPort;
+    s.senderCompId     = cfg.fixSenderCompId;
+    s.targetCompId     = cfg.fixTargetCompId;
+    s.heartbeatSeconds = cfg.fixHeartbeatSeconds;
+    s.ackTimeoutMs     = cfg.fixAckTimeoutMs;
+    s.storePath        = cfg.fixStorePath;
+    return s;
+}
+
+FixAdapter::FixAdapter(FixSettings settings)
+    : m_settings(std::move(settings)),
+      m_templates(m_settings.senderCompId, m_settings.targetCompId),
+      m_ids(ClOrdIdPrefix())
+{
+    m_sendBuf.reserve(16 * 1024);
+    m_recvBuf.resize(kRecvCapacity);
+    if (!m_settings.storePath.empty()) {
+        if (m_store.Open(m_settings.storePath, m_settings.senderCompId, m_settings.targetCompId)) {
+            m_outSeq = m_store.NextOutgoing();
+            m_inSeq  = m_store.NextIncoming();
+            BRIDGE_LOG_INFO("FIX: session store " + m_settings.storePath + " resumes at MsgSeqNum " +
+                            std::to_string(m_store.NextOutgoing()) + " out, " +
+                            std::to_string(m_store.NextIncoming()) + " in");
+        } else {
+            BRIDGE_LOG_ERROR("FIX: cannot open session store " + m_settings.storePath +
+                             " (unreadable, or another session's); resetting sequence numbers at each logon");
+        }
+    }
+    m_thread = std::thread([this] { Run(); });
+}
+
+FixAdapter::~FixAdapter() {
+    {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        m_stop = true;
+        if (m_loggedOn.load(std::memory_order_relaxed)) {
+            Start("5");
+            m_logoutSent = SendNow();
+        }
+    }
+    m_wake.notify_all();
+    if (m_thread.joinable()) m_thread.join();
+}
+
+void FixAdapter::SetExecutionSink(ExecutionSink sink) {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    m_sink = std::move(sink);
+}
+
+size_t FixAdapter::OpenOrderCount() const {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    size_t n = 0;
+    for (const auto& [id, o] : m_orders) {
+        if (o.state == OrderState::Replacement) continue;
+        // An order cancelled mid-replace is one order under two ClOrdIDs.
+        auto rep = o.replacement.empty() ? m_orders.end() : m_orders.find(o.replacement);
+        if (rep == m_orders.end() || rep->second.state != OrderState::PendingCancel) ++n;
+    }
+    return n;
+}
+
+int64_t FixAdapter::Position(SymbolId account, SymbolId instrument) const {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    auto it = m_positions.find(KeyOf(account, instrument));
+    return it == m_positions.end() ? 0 : it->second;
+}
+
+uint64_t FixAdapter::NextOutgoingSeq() const {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    return m_outSeq;
+}
+
+uint64_t FixAdapter::NextIncomingSeq() const {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    return m_inSeq;
+}
+
+// ---- Orders -----------------------------------------------------------------
+
+int FixAdapter::Execute(const OrderRequest& req) {
+    int rc = RC_SUCCESS;
+    ExecuteBatch(&req, 1, &rc);
+    return rc;
+}
+
+void FixAdapter::ExecuteBatch(const OrderRequest* reqs, size_t count, int* results) {
+    std::unique_lock<std::mutex> lk(m_mutex);
+    if (!m_loggedOn.load(std::memory_order_relaxed)) {
+        std::fill(results, results + count, RC_NOT_CONNECTED);
+        return;
+    }
+    m_sent.clear();
+    for (size_t i = 0; i < count; ++i)
+        results[i] = Dispatch(reqs[i], i);
+    // One write for everything the batch produced.
+    if (!Flush()) {
+        for (const auto& sent : m_sent) results[sent.first] = RC_NOT_CONNECTED;
+        return;
+    }
+    Await(lk, results);
+}
+
+void FixAdapter::Await(std::unique_lock<std::mutex>& lk, int* results) {
+    if (m_settings.ackTimeoutMs <= 0 || m_sent.empty()) return;
+    // Other callers reuse m_sent while this one waits.
+    std::vector<std::pair<size_t, std::string>> sent;
+    sent.swap(m_sent);
+    for (const auto& s : sent) {
+        auto it = m_pending.find(s.second);
+        if (it != m_pending.end()) it->second.waited = true;
+    }
+    auto answered = [&] {
+        for (const auto& s : sent) {
+            auto it = m_pending.find(s.second);
+            if (it != m_pending.end() && it->second.rc == RC_PENDING) return false;
+        }
+        return true;
+    };
+    m_answered.wait_for(lk, std::chrono::milliseconds(m_settings.ackTimeoutMs), answered);
+    for (const auto& s : sent) {
+        auto it = m_pending.find(s.second);
+        if (it == m_pending.end()) continue;
+        int rc = it->second.rc;
+        if (rc == RC_PENDING) {
+            it->second.waited = false;   // the session thread drops it when the answer comes
+            rc = RC_TIMEOUT;
+        } else {
+            m_pending.erase(it);
+        }
+        // A request that sent several messages reports its first failure.
+        if (results[s.first] == RC_SUCCESS) results[s.first] = rc;
+    }
+}
+
+void FixAdapter::Answer(std::string_view clOrdId, int rc) {
+    auto it = m_pending.find(clOrdId);
+    if (it == m_pending.end()) return;
+    if (!it->second.waited) {
+        m_pending.erase(it);
+        return;
+    }
+    it->second.rc = rc;
+    m_answered.notify_all();
+}
+
+std::string FixAdapter::NextClOrdId() {
+    return std::string(m_ids.Next());
+}
+
+FixAdapter::FixOrder FixAdapter::OrderOf(const OrderRequest& req) {
+    FixOrder o;
+    o.account    = AccountIdOf(req);
+    o.instrument = InstrumentIdOf(req);
+    o.side       = req.action;
+    o.quantity   = req.quantity;
+    o.type       = req.orderType;
+    o.limit      = req.limitPx.IsSet() ? req.limitPx : PriceFromDouble(req.limitPrice);
+    o.stop       = req.stopPx.IsSet()  ? req.stopPx  : PriceFromDouble(req.stopPrice);
+    o.tif        = req.timeInForce == TimeInForce::GTC ? TimeInForce::GTC : TimeInForce::DAY;
+    return o;
+}
+
+int FixAdapter::Dispatch(const OrderRequest& req, size_t index) {
+    SymbolId account, instrument;
+    if (!SymbolsResolved(req, account, instrument)) return RC_INVALID_PARAM;   // symbol table full
+    uint64_t key = KeyOf(account, instrument);
+
+    switch (req.command) {
+        case Command::PLACE:
+            return SendNew(OrderOf(req), index);
+        case Command::CANCEL:
+            if (account == kNoSymbol || instrument == kNoSymbol) return RC_INVALID_PARAM;
+            CancelWhere(account, instrument, index);
+            return RC_SUCCESS;
+        case Command::CANCELALLORDERS:
+            if (account == kNoSymbol) return RC_INVALID_PARAM;
+            CancelWhere(account, std::nullopt, index);
+            return RC_SUCCESS;
+        case Command::CHANGE: {
+            const std::string* newestId = nullptr;
+            FixOrder*          newest   = nullptr;
+            for (auto& [id, o] : m_orders) {
+                if (o.account != account || o.instrument != instrument) continue;
+                if (o.state != OrderState::PendingNew && o.state != OrderState::Working) continue;
+                if (!newest || o.placed > newest->placed) {
+                    newestId = &id;
+                    newest   = &o;
+                }
+            }
+            if (!newest) return SendNew(OrderOf(req), index);
+            for (auto& [id, o] : m_orders) {
+                if (&o != newest && o.account == account && o.instrument == instrument &&
+                    (o.state == OrderState::PendingNew || o.state == OrderState::Working))
+                    SendCancel(id, o, index);
+            }
+            // FIX cannot change the side; anything the request leaves out stays.
+            FixOrder next = OrderOf(req);
+            next.side = newest->side;
+            if (next.type == OrderType::UNKNOWN) next.type = newest->type;
+            if (next.quantity <= 0) next.quantity = newest->quantity;
+            if (HasLimit(next.type) && !req.limitPx.IsSet() && req.limitPrice == 0.0) next.limit = newest->limit;
+            if (HasStop(next.type) && !req.stopPx.IsSet() && req.stopPrice == 0.0)    next.stop  = newest->stop;
+            SendReplace(*newestId, *newest, next, index);
+            return RC_SUCCESS;
+        }
+        case Command::CLOSEPOSITION:
+            CancelWhere(account, instrument, index);
+            return Flatten(key, index);
+        case Command::CLOSESTRATEGY:    // alias
+        case Command::FLATTENEVERYTHING: {
+            CancelWhere(std::nullopt, std::nullopt, index);
+            int rc = RC_SUCCESS;
+            for (const auto& [k, qty] : m_positions) {
+                if (qty == 0) continue;
+                int r = Flatten(k, index);
+                if (rc == RC_SUCCESS) rc = r;
+            }
+            return rc;
+        }
+        case Command::REVERSEPOSITION: {
+            CancelWhere(account, instrument, index);
+            auto    it  = m_positions.find(key);
+            int64_t pos = it == m_positions.end() ? 0 : it->second;
+            FixOrder o  = OrderOf(req);
+            if (pos != 0) {
+                o.side     = pos > 0 ? Action::SELL : Action::BUY;
+                o.quantity = ClampInt(2 * (pos < 0 ? -pos : pos));
+                o.type     = OrderType::MARKET;
+                o.tif      = TimeInForce::DAY;
+            } else {
+                // Flat: as MockAdapter, place the opposite of the request.
+                o.side = req.action == Action::BUY ? Action::SELL : Action::BUY;
+            }
+            return SendNew(o, index);
+        }
+        default:
+            return RC_INVALID_CMD;
+    }
+}
+
+int FixAdapter::Flatten(uint64_t key, size_t index) {
+    auto it = m_positions.find(key);
+    if (it == m_positions.end() || it->second == 0) return RC_SUCCESS;
+    FixOrder o;
+    o.account    = static_cast<SymbolId>(key >> 32);
+    o.instrument = static_cast<SymbolId>(key);
+    o.side       = it->second > 0 ? Action::SELL : Action::BUY;
+    o.quantity   = ClampInt(it->second < 0 ? -it->second : it->second);
+    o.type       = OrderType::MARKET;
+    return SendNew(o, index);
+}
+
+void FixAdapter::CancelWhere(std::optional<SymbolId> account, std::optional<SymbolId> instrument, size_t index) {
+    // SendCancel does not add orders, so iterating while it runs is safe.
+    // An order with a G out is cancelled under its last accepted ClOrdID,
+    // which FIX 4.2 allows while the replace is pending.
+    for (auto& [id, o] : m_orders) {
+        if (account && o.account != *account) continue;
+        if (instrument && o.instrument != *instrument) continue;
+        if (o.state == OrderState::PendingNew || o.state == OrderState::Working ||
+            o.state == OrderState::PendingReplace)
+            SendCancel(id, o, index);
+    }
+}
+
+FixOrderFields FixAdapter::FieldsOf(const FixOrder& order, std::string_view clOrdId) {
+    FixOrderFields f;
+    f.clOrdId  = clOrdId;
+    f.account  = SymbolName(order.account);
+    f.symbol   = SymbolName(order.instrument);
+    f.side     = SideCode(order.side);
+    f.quantity = order.quantity;
+    f.ordType  = OrdTypeCode(order.type);
+    f.tif      = order.tif == TimeInForce::GTC ? '1' : '0';
+    f.price    = order.limit;
+    f.stopPx   = order.stop;
+    return f;
+}
+
+int FixAdapter::SendNew(const FixOrder& order, size_t index) {
+    if (order.side == Action::UNKNOWN || order.quantity <= 0 || order.type == OrderType::UNKNOWN)
+        return RC_INVALID_PARAM;
+    std::string id  = NextClOrdId();
+    uint64_t    seq = m_outSeq;
+    if (!QueueOrder('D', FieldsOf(order, id))) return RC_INVALID_PARAM;
+
+    FixOrder& o = m_orders[id];
+    o        = order;
+    o.state  = OrderState::PendingNew;
+    o.placed = ++m_placed;
+    m_pending[id].seq = seq;
+    m_sent.emplace_back(index, std::move(id));
+    return RC_SUCCESS;
+}
+
+void FixAdapter::SendCancel(const std::string& clOrdId, FixOrder& order, size_t index) {
+    std::string    id  = NextClOrdId();
+    uint64_t       seq = m_outSeq;
+    FixOrderFields f   = FieldsOf(order, id);
+    f.origClOrdId = clOrdId;
+    if (!QueueOrder('F', f)) return;
+
+    if (order.state == OrderState::PendingReplace) {
+        auto rep = m_orders.find(order.replacement);
+        if (rep != m_orders.end()) rep->second.state = OrderState::PendingCancel;
+    }
+    order.state = OrderState::PendingCancel;
+    Pending& p  = m_pending[id];
+    p.origClOrdId = clOrdId;
+    p.seq         = seq;
+    m_sent.emplace_back(index, std::move(id));
+}
+
+void FixAdapter::SendReplace(const std::string& clOrdId, FixOrder& order, const FixOrder& next, size_t index) {
+    std::string    id  = NextClOrdId();
+    uint64_t       seq = m_outSeq;
+    FixOrderFields f   = FieldsOf(next, id);
+    f.origClOrdId = clOrdId;
+    f.side        = SideCode(order.side);
+    if (!QueueOrder('G', f)) return;
+
+    order.state       = OrderState::PendingReplace;
+    order.replacement = id;
+    // Element references survive the insert: unordered_map never moves nodes.
+    FixOrder& r = m_orders[id];
+    r        = next;
+    r.cumQty = order.cumQty;
+    r.state  = OrderState::Replacement;
+    r.placed = ++m_placed;
+    Pending& p  = m_pending[id];
+    p.origClOrdId = clOrdId;
+    p.seq         = seq;
+    m_sent.emplace_back(index, std::move(id));
+}
+
+// ---- Outbound -----------------------------------------------------------------
+
+FixWriter& FixAdapter::Start(std::string_view msgType, uint64_t seq) {
+    m_seqOverride = seq != 0;
+    m_writer.Begin(msgType);
+    m_writer.Add(FixTag::SenderCompID, m_settings.senderCompId);
+    m_writer.Add(FixTag::TargetCompID, m_settings.targetCompId);
+    m_writer.Add(FixTag::MsgSeqNum, static_cast<int64_t>(m_seqOverride ? seq : m_outSeq));
+    if (m_seqOverride) m_writer.Add(FixTag::PossDupFlag, 'Y');
+    m_writer.AddTimestamp(FixTag::SendingTime);
+    return m_writer;
+}
+
+bool FixAdapter::Queue() {
+    return Append(m_writer.Finish());
+}
+
+bool FixAdapter::QueueOrder(char msgType, const FixOrderFields& f) {
+    m_seqOverride = false;
+    uint64_t         seq = m_outSeq;
+    std::string_view msg = m_templates.Render(msgType, seq, f);
+    if (msg.empty())   // a value too wide for its slot
+        msg = EncodeOrder(m_writer, msgType, m_settings.senderCompId, m_settings.targetCompId, seq, f);
+    if (!Append(msg)) return false;
+    m_store.Store(seq, msg);   // kept for a ResendRequest
+    return true;
+}
+
+bool FixAdapter::Append(std::string_view msg) {
+    if (msg.empty()) {
+        BRIDGE_LOG_ERROR("FIX: message does not fit in " + std::to_string(FixWriter::kCapacity) +
+                         " bytes or lacks a price; not sent");
+        return false;
+    }
+    m_sendBuf.append(msg.data(), msg.size());
+    if (!m_seqOverride) m_store.SetNextOutgoing(++m_outSeq);
+    m_lastSent = Clock::now();
+    return true;
+}
+
+void FixAdapter::SetInSeq(uint64_t seq) {
+    m_inSeq = seq;
+    m_store.SetNextIncoming(seq);
+}
+
+bool FixAdapter::Resend(uint64_t begin, uint64_t end) {
+    // Stored orders go out again with PossDupFlag and their original
+    // SendingTime; runs of anything else (session messages, or orders the
+    // store no longer holds) become one gap fill each.
+    uint64_t gap = 0;
+    auto fillGap = [&](uint64_t next) {
+        if (gap == 0) return true;
+        FixWriter& w = Start("4", gap);
+        w.Add(FixTag::GapFillFlag, 'Y');
+        w.Add(FixTag::NewSeqNo, static_cast<int64_t>(next));
+        gap = 0;
+        return Queue();
+    };
+    size_t resent = 0;
+    for (uint64_t seq = begin; seq <= end; ++seq) {
+        FixFields        f;
+        std::string_view stored = m_store.Find(seq);
+        if (stored.empty() || !f.Parse(stored)) {
+            if (gap == 0) gap = seq;
+            continue;
+        }
+        if (!fillGap(seq)) return false;
+        m_seqOverride = true;
+        m_writer.Begin(f.MsgType());
+        for (size_t i = 0; i < f.Count(); ++i) {
+            int tag = f.TagAt(i);
+            if (tag == FixTag::BeginString || tag == FixTag::BodyLength || tag == FixTag::MsgType ||
+                tag == FixTag::CheckSum || tag == FixTag::PossDupFlag || tag == FixTag::OrigSendingTime)
+                continue;
+            if (tag == FixTag::SendingTime) {
+                m_writer.AddTimestamp(FixTag::SendingTime);
+                m_writer.Add(FixTag::OrigSendingTime, f.ValueAt(i));
+                continue;
+            }
+            m_writer.Add(tag, f.ValueAt(i));
+            if (tag == FixTag::MsgSeqNum) m_writer.Add(FixTag::PossDupFlag, 'Y');
+        }
+        if (!Queue()) return false;
+        ++resent;
+    }
+    if (!fillGap(end + 1)) return false;
+    BRIDGE_LOG_WARN("FIX: resent " + std::to_string(resent) + " order(s) of MsgSeqNum " + std::to_string(begin) +
+                    "-" + std::to_string(end) + ", gap-filled the rest");
+    return Flush();
+}
+
+bool FixAdapter::Flush() {
+    if (m_sendBuf.empty()) return true;
+    bool ok = m_socket.SendAll(m_sendBuf.data(), m_sendBuf.size());
+    m_sendBuf.clear();
+    if (!ok) {
+        // The session thread sees the shutdown, closes and reconnects.
+        m_socket.Shutdown();
+        m_loggedOn.store(false, std::memory_order_release);
+    }
+    return ok;
+}
+
+// ---- Session thread -------------------------------------------------------------
+
+void FixAdapter::Run() noexcept {
+    int  delay  = std::max(m_settings.reconnectMs, 1);
+    bool warned = false;
+    for (;;) {
+        bool served = false;
+        try {
+            if (Logon()) {
+                warned = false;
+                served = true;
+                Serve();
+            } else if (!warned) {
+                BRIDGE_LOG_WARN("FIX: cannot connect to " + m_settings.host + ":" +
+                                std::to_string(m_settings.port) + "; retrying in the background");
+                warned = true;
+            }
+        }
+        catch (...) {
+            BRIDGE_LOG_ERROR("FIX: unexpected exception in the session thread");
+        }
+        Disconnected();
+        if (served) delay = std::max(m_settings.reconnectMs, 1);
+
+        std::unique_lock<std::mutex> lk(m_mutex);
+        if (m_wake.wait_for(lk, std::chrono::milliseconds(delay), [this] { return m_stop; })) return;
+        if (!served) delay = std::min(delay * 2, kMaxReconnectMs);
+    }
+}
+
+bool FixAdapter::Logon() {
+    {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        if (m_stop) return false;
+    }
+    if (m_settings.port <= 0 || m_settings.port > 65535) return false;
+    Socket s = Socket::Connect(m_settings.host, static_cast<uint16_t>(m_settings.port), kConnectTimeoutMs);
+    if (!s.IsOpen()) return false;
+
+    std::lock_guard<std::mutex> lk(m_mutex);
+    if (m_stop) return false;
+    m_socket          = std::move(s);
+    // With a store the session carries on; without one it starts over.
+    m_outSeq          = m_store.NextOutgoing();
+    m_inSeq           = m_store.NextIncoming();
+    m_resetSent       = m_outSeq == 1 && m_inSeq == 1;
+    m_resendRequested = false;
+    m_testRequestSent = false;
+    m_lastReceived    = Clock::now();
+    m_sendBuf.clear();
+
+    FixWriter& w = Start("A");
+    w.Add(FixTag::EncryptMethod, '0');
+    w.Add(FixTag::HeartBtInt, static_cast<int64_t>(m_settings.heartbeatSeconds));
+    if (m_resetSent) w.Add(FixTag::ResetSeqNumFlag, 'Y');
+    if (!SendNow()) return false;
+    BRIDGE_LOG_INFO("FIX: connected to " + m_settings.host + ":" + std::to_string(m_settings.port) + ", logon sent");
+    return true;
+}
+
+void FixAdapter::Serve() {
+    const Clock::time_point started = Clock::now();
+    Clock::time_point       stopSeen{};
+    size_t                  len = 0;
+    for (;;) {
+        if (len == m_recvBuf.size()) {
+            BRIDGE_LOG_ERROR("FIX: incoming message larger than " + std::to_string(m_recvBuf.size()) + " bytes");
+            return;
+        }
+        int n = m_socket.Receive(m_recvBuf.data() + len, m_recvBuf.size() - len, kPollMs);
+        if (n < 0) return;
+        len += static_cast<size_t>(n);
+
+        // Decoded in place; fields are views into m_recvBuf.
+        size_t used = 0;
+        while (used < len) {
+            ptrdiff_t size = m_decoder.Decode(std::string_view(m_recvBuf.data() + used, len - used));
+            if (size == 0) break;
+            if (size < 0) {
+                BRIDGE_LOG_ERROR("FIX: garbled message or bad CheckSum; dropping the connection");
+                return;
+            }
+            if (!OnMessage(m_decoder)) return;
+            used += static_cast<size_t>(size);
+        }
+        if (used > 0) {
+            std::memmove(m_recvBuf.data(), m_recvBuf.data() + used, len - used);
+            len -= used;
+        }
+
+        Clock::time_point now = Clock::now();
+        std::lock_guard<std::mutex> lk(m_mutex);
+        if (m_stop) {
+            if (!m_logoutSent) return;
+            if (stopSeen == Clock::time_point{}) stopSeen = now;
+            else if (now - stopSeen > std::chrono::milliseconds(kLogoutWaitMs)) return;
+        }
+        if (!m_loggedOn.load(std::memory_order_relaxed) &&
+            now - started > std::chrono::milliseconds(kLogonTimeoutMs)) {
+            BRIDGE_LOG_WARN("FIX: no answer to logon; reconnecting");
+            return;
+        }
+        if (!OnTimer(now)) return;
+    }
+}
+
+bool FixAdapter::OnTimer(Clock::time_point now) {
+    if (!m_loggedOn.load(std::memory_order_relaxed) || m_settings.heartbeatSeconds <= 0) return true;
+    const auto interval = std::chrono::seconds(m_settings.heartbeatSeconds);
+    if (now - m_lastSent >= interval) {
+        Start("0");
+        if (!SendNow()) return false;
+    }
+    auto quiet = now - m_lastReceived;
+    if (quiet >= 2 * interval) {
+        BRIDGE_LOG_WARN("FIX: nothing received for two heartbeat intervals; reconnecting");
+        return false;
+    }
+    if (quiet >= interval + interval / 5 && !m_testRequestSent) {
+        Start("1").Add(FixTag::TestReqID, std::string_view("TEST"));
+        if (!SendNow()) return false;
+        m_testRequestSent = true;
+    }
+    return true;
+}
+
+bool FixAdapter::OnMessage(const FixDecoder& f) {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    m_lastReceived    = Clock::now();
+    m_testRequestSent = false;
+
+    if (f.Get(FixTag::SenderCompID) != m_settings.targetCompId ||
+        f.Get(FixTag::TargetCompID) != m_settings.senderCompId) {
+        BRIDGE_LOG_ERROR("FIX: message for another session (CompIDs do not match); dropping the connection");
+        return false;
+    }
+    std::string_view type = f.MsgType();
+    uint64_t         seq  = static_cast<uint64_t>(f.GetInt(FixTag::MsgSeqNum));
+
+    if (!m_loggedOn.load(std::memory_order_relaxed)) {
+        if (type == "A") {
+            bool theirReset = !m_resetSent && f.GetChar(FixTag::ResetSeqNumFlag) == 'Y';
+            bool reset      = m_resetSent || theirReset;
+            if (!reset && seq < m_inSeq) {
+                BRIDGE_LOG_ERROR("FIX: logon MsgSeqNum " + std::to_string(seq) + " is below the expected " +
+                                 std::to_string(m_inSeq) + "; logging out");
+                Start("5").Add(FixTag::Text, std::string_view("MsgSeqNum too low"));
+                SendNow();
+                return false;
+            }
+            if (theirReset) {
+                // The counterparty started the session over: our logon is 1
+                // in the new one, and nothing stored can be resent under the
+                // numbers it was sent with.
+                BRIDGE_LOG_WARN("FIX: counterparty reset sequence numbers at logon");
+                m_store.Reset();
+                m_outSeq = 2;
+                m_store.SetNextOutgoing(m_outSeq);
+            }
+            m_loggedOn.store(true, std::memory_order_release);
+            BRIDGE_LOG_INFO("FIX: logged on as " + m_settings.senderCompId + " to " + m_settings.targetCompId);
+            if (reset || seq == m_inSeq) {
+                SetInSeq(seq + 1);
+                return true;
+            }
+            // Missed messages while away: the resend brings them, then a gap
+            // fill moves past this logon.
+            BRIDGE_LOG_WARN("FIX: expected MsgSeqNum " + std::to_string(m_inSeq) + " at logon, got " +
+                            std::to_string(seq) + "; requesting a resend");
+            FixWriter& w = Start("2");
+            w.Add(FixTag::BeginSeqNo, static_cast<int64_t>(m_inSeq));
+            w.Add(FixTag::EndSeqNo, static_cast<int64_t>(0));
+            m_resendRequested = true;
+            return SendNow();
+        }
+        if (type == "5") BRIDGE_LOG_WARN("FIX: logon refused: " + std::string(f.Get(FixTag::Text)));
+        else             BRIDGE_LOG_WARN("FIX: expected a Logon, got 35=" + std::string(type));
+        return false;
+    }
+
+    if (type == "4") {   // SequenceReset: gap fill or reset, either way jump ahead
+        uint64_t next = static_cast<uint64_t>(f.GetInt(FixTag::NewSeqNo));
+        if (next > m_inSeq) SetInSeq(next);
+        m_resendRequested = false;
+        return true;
+    }
+    if (seq > m_inSeq) {
+        if (type == "5") return false;
+        if (!m_resendRequested) {
+            BRIDGE_LOG_WARN("FIX: expected MsgSeqNum " + std::to_string(m_inSeq) + ", got " +
+                            std::to_string(seq) + "; requesting a resend");
+            FixWriter& w = Start("2");
+            w.Add(FixTag::BeginSeqNo, static_cast<int64_t>(m_inSeq));
+            w.Add(FixTag::EndSeqNo, static_cast<int64_t>(0));
+            if (!SendNow()) return false;
+            m_resendRequested = true;
+        }
+        return true;   // dropped; it comes again with the resend
+    }
+    if (seq < m_inSeq) {
+        if (f.GetChar(FixTag::PossDupFlag) == 'Y') return true;   // seen it already
+        BRIDGE_LOG_ERROR("FIX: MsgSeqNum " + std::to_string(seq) + " is below the expected " +
+                         std::to_string(m_inSeq) + "; logging out");
+        Start("5").Add(FixTag::Text, std::string_view("MsgSeqNum too low"));
+        SendNow();
+        return false;
+    }
+    SetInSeq(seq + 1);
+    m_resendRequested = false;
+
+    if (type.size() != 1) return true;
+    switch (type[0]) {
+        case '0':   // Heartbeat
+            return true;
+        case '1':   // TestRequest
+            Start("0").Add(FixTag::TestReqID, f.Get(FixTag::TestReqID));
+            return SendNow();
+        case '2': { // ResendRequest
+            uint64_t begin = static_cast<uint64_t>(f.GetInt(FixTag::BeginSeqNo));
+            uint64_t end   = static_cast<uint64_t>(f.GetInt(FixTag::EndSeqNo));
+            if (begin == 0 || begin >= m_outSeq) return true;
+            if (end == 0 || end >= m_outSeq) end = m_outSeq - 1;
+            if (m_store.IsOpen()) return Resend(begin, end);
+            BRIDGE_LOG_WARN("FIX: resend from " + std::to_string(begin) + " requested; sending a gap fill");
+            FixWriter& w = Start("4", begin);
+            w.Add(FixTag::GapFillFlag, 'Y');
+            w.Add(FixTag::NewSeqNo, static_cast<int64_t>(m_outSeq));
+            return SendNow();
+        }
+        case '3':   // Reject
+        case 'j':   // BusinessMessageReject
+            OnSessionReject(f);
+            return true;
+        case '5':   // Logout
+            if (!m_logoutSent) {
+                BRIDGE_LOG_WARN("FIX: logged out by the counterparty: " + std::string(f.Get(FixTag::Text)));
+                Start("5");
+                SendNow();
+            }
+            return false;
+        case '8':
+            OnExecution(f);
+            return true;
+        case '9':
+            OnCancelReject(f);
+            return true;
+        default:
+            return true;
+    }
+}
+
+void FixAdapter::OnExecution(const FixDecoder& f) {
+    FixExecution e;
+    e.clOrdId     = f.Get(FixTag::ClOrdID);
+    e.origClOrdId = f.Get(FixTag::OrigClOrdID);
+    e.orderId     = f.Get(FixTag::OrderID);
+    e.execId      = f.Get(FixTag::ExecID);
+    e.account     = f.Get(FixTag::Account);
+    e.symbol      = f.Get(FixTag::Symbol);
+    e.text        = f.Get(FixTag::Text);
+    e.ordStatus   = f.GetChar(FixTag::OrdStatus);
+    e.execType    = f.GetChar(FixTag::ExecType, e.ordStatus);
+    e.side        = SideOf(f.GetChar(FixTag::Side));
+    e.lastQty     = ClampInt(f.GetInt(FixTag::LastShares));
+    e.cumQty      = ClampInt(f.GetInt(FixTag::CumQty));
+    e.leavesQty   = ClampInt(f.GetInt(FixTag::LeavesQty));
+    if (f.Has(FixTag::LastPx)) ParsePrice(f.Get(FixTag::LastPx), e.lastPx);
+    if (f.Has(FixTag::AvgPx))  ParsePrice(f.Get(FixTag::AvgPx), e.avgPx);
+
+    auto it = m_orders.find(e.clOrdId);
+    if (it == m_orders.end() && !e.origClOrdId.empty()) it = m_orders.find(e.origClOrdId);
+    if (it == m_orders.end()) {
+        // Answering our F: the order it was retargeted to after a replace.
+        auto p = m_pending.find(e.clOrdId);
+        if (p != m_pending.end() && !p->second.origClOrdId.empty()) it = m_orders.find(p->second.origClOrdId);
+    }
+
+    switch (e.execType) {
+        case '0':   // New
+            if (it != m_orders.end() && it->second.state == OrderState::PendingNew)
+                it->second.state = OrderState::Working;
+            Answer(e.clOrdId, RC_SUCCESS);
+            break;
+        case '1':   // PartialFill
+        case '2': { // Fill
+            Action side = e.side;
+            SymbolId account = kNoSymbol, instrument = kNoSymbol;
+            if (it != m_orders.end()) {
+                if (side == Action::UNKNOWN) side = it->second.side;
+                account    = it->second.account;
+                instrument = it->second.instrument;
+            } else {
+                // Not ours: count it only under names already known, never
+                // letting the broker fill the symbol table.
+                account    = FindSymbol(e.account);
+                instrument = FindSymbol(e.symbol);
+                if (instrument == kNoSymbol || (account == kNoSymbol && !e.account.empty())) {
+                    BRIDGE_LOG_WARN("FIX: fill for unknown account '" + std::string(e.account) + "' instrument '" +
+                                    std::string(e.symbol) + "' not tracked");
+                    side = Action::UNKNOWN;
+                }
+            }
+            if (e.lastQty > 0 && side != Action::UNKNOWN)
+                m_positions[KeyOf(account, instrument)] += side == Action::BUY ? e.lastQty : -e.lastQty;
+            if (it != m_orders.end()) {
+                it->second.cumQty = e.cumQty;
+                if (it->second.state == OrderState::PendingNew) it->second.state = OrderState::Working;
+                if (e.execType == '2' || e.ordStatus == '2') m_orders.erase(it);
+            }
+            Answer(e.clOrdId, RC_SUCCESS);
+            break;
+        }
+        case '3':   // DoneForDay
+        case '4':   // Canceled
+        case 'C':   // Expired
+            if (it != m_orders.end()) {
+                // An unconfirmed replacement goes with the order it would replace.
+                if (!it->second.replacement.empty()) m_orders.erase(it->second.replacement);
+                m_orders.erase(it);
+            }
+            Answer(e.clOrdId, RC_SUCCESS);
+            break;
+        case '5': { // Replaced: 11 is the replacement, 41 the order it replaced
+            auto orig = m_orders.find(e.origClOrdId);
+            if (orig != m_orders.end()) m_orders.erase(orig);
+            auto rep = m_orders.find(e.clOrdId);
+            if (rep != m_orders.end() && rep->second.state == OrderState::Replacement)
+                rep->second.state = OrderState::Working;
+            // An F sent while the replace was out now cancels the replacement.
+            for (auto& [id, p] : m_pending) {
+                if (id != e.clOrdId && p.origClOrdId == e.origClOrdId) p.origClOrdId = std::string(e.clOrdId);
+            }
+            Answer(e.clOrdId, RC_SUCCESS);
+            break;
+        }
+        case '8': { // Rejected
+            BRIDGE_LOG_WARN("FIX: order " + std::string(e.clOrdId) + " rejected: " + std::string(e.text));
+            auto p = m_pending.find(e.clOrdId);
+            if (p != m_pending.end() && !p->second.origClOrdId.empty()) {
+                Restore(p->second.origClOrdId, e.clOrdId);
+            } else {
+                auto own = m_orders.find(e.clOrdId);
+                if (own != m_orders.end()) m_orders.erase(own);
+            }
+            Answer(e.clOrdId, RC_REJECTED);
+            break;
+        }
+        default:    // pending states, restatements
+            break;
+    }
+    if (m_sink) m_sink(e);
+}
+
+void FixAdapter::OnCancelReject(const FixDecoder& f) {
+    std::string_view id = f.Get(FixTag::ClOrdID);
+    // Our own record first: a replace may have moved the F onto the replacement.
+    std::string orig;
+    auto p = m_pending.find(id);
+    if (p != m_pending.end()) orig = p->second.origClOrdId;
+    if (orig.empty()) orig = std::string(f.Get(FixTag::OrigClOrdID));
+    BRIDGE_LOG_WARN("FIX: cancel/replace of " + orig + " rejected: " + std::string(f.Get(FixTag::Text)));
+    Restore(orig, id);
+    char status = f.GetChar(FixTag::OrdStatus);
+    if (status == '2' || status == '4' || status == '8' || status == 'C') {   // the order is already done
+        auto it = m_orders.find(orig);
+        if (it != m_orders.end()) m_orders.erase(it);
+    }
+    Answer(id, RC_REJECTED);
+}
+
+void FixAdapter::OnSessionReject(const FixDecoder& f) {
+    uint64_t ref = static_cast<uint64_t>(f.GetInt(FixTag::RefSeqNum));
+    BRIDGE_LOG_WARN("FIX: message " + std::to_string(ref) + " rejected: " + std::string(f.Get(FixTag::Text)));
+    for (auto& [id, p] : m_pending) {
+        if (p.seq != ref || p.rc != RC_PENDING) continue;
+        std::string key = id;   // Answer may erase the entry
+        if (p.origClOrdId.empty()) {
+            auto it = m_orders.find(key);
+            if (it != m_orders.end()) m_orders.erase(it);
+        } else {
+            Restore(p.origClOrdId, key);
+        }
+        Answer(key, RC_REJECTED);
+        return;
+    }
+}
+
+void FixAdapter::Restore(std::string_view origClOrdId, std::string_view requestId) {
+    auto it  = m_orders.find(origClOrdId);
+    auto rep = m_orders.find(requestId);
+    if (rep != m_orders.end()) {
+        // A refused G: its replacement never existed. An F sent meanwhile
+        // still stands for the original.
+        if (rep->second.state != OrderState::Replacement && rep->second.state != OrderState::PendingCancel) return;
+        m_orders.erase(rep);
+        if (it == m_orders.end()) return;
+        it->second.replacement.clear();
+        if (it->second.state == OrderState::PendingReplace) it->second.state = OrderState::Working;
+        return;
+    }
+    // A refused F: back to working, or to replacing if its G is still out.
+    if (it == m_orders.end() || it->second.state != OrderState::PendingCancel) return;
+    auto pending = it->second.replacement.empty() ? m_orders.end() : m_orders.find(it->second.replacement);
+    if (pending != m_orders.end() && pending->second.state == OrderState::PendingCancel) {
+        pending->second.state = OrderState::Replacement;
+        it->second.state      = OrderState::PendingReplace;
+    } else {
+        it->second.state = OrderState::Working;
+    }
+}
+
+void FixAdapter::Disconnected() {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    bool was = m_loggedOn.exchange(false);
+    m_socket.Close();
+    m_sendBuf.clear();
+    // Nobody will answer these now; waiting callers get RC_NOT_CONNECTED.
+    for (auto it = m_pending.begin(); it != m_pending.end();) {
+        if (!it->second.waited) {
+            it = m_pending.erase(it);
+            continue;
+        }
+        if (it->second.rc == RC_PENDING) it->second.rc = RC_NOT_CONNECTED;
+        ++it;
+    }
+    m_answered.notify_all();
+    if (was && !m_stop) BRIDGE_LOG_WARN("FIX: session lost; reconnecting");
+    if (was && m_stop)  BRIDGE_LOG_INFO("FIX: logged out");
+}
+
+} // namespace Bridge
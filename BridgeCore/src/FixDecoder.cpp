@@ -0,0 +1,183 @@
+#include "FixDecoder.h"
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cstring>
+#include <iterator>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define BRIDGE_FIXSCAN_SSE2 1
+#  include <emmintrin.h>
+#endif
+
+namespace Bridge {
+
+namespace {
+
+constexpr uint8_t kNotIndexed = 0xFF;
+constexpr int     kMaxIndexedTag = 256;
+
+constexpr int kIndexedTags[] = {
+    FixTag::MsgType, FixTag::ClOrdID, FixTag::OrderID, FixTag::OrdStatus, FixTag::ExecType,
+    FixTag::CumQty, FixTag::LeavesQty, FixTag::LastPx, FixTag::LastShares, FixTag::Text,
+    FixTag::MsgSeqNum, FixTag::PossDupFlag, FixTag::SenderCompID, FixTag::TargetCompID,
+    FixTag::Account, FixTag::AvgPx, FixTag::ExecID, FixTag::OrigClOrdID, FixTag::Side, FixTag::Symbol,
+};
+
+// tag -> slot in FixDecoder::m_index, for tags below kMaxIndexedTag.
+constexpr std::array<uint8_t, kMaxIndexedTag> MakeSlots() {
+    std::array<uint8_t, kMaxIndexedTag> slots{};
+    for (auto& s : slots) s = kNotIndexed;
+    for (size_t i = 0; i < std::size(kIndexedTags); ++i)
+        slots[static_cast<size_t>(kIndexedTags[i])] = static_cast<uint8_t>(i);
+    return slots;
+}
+
+constexpr std::array<uint8_t, kMaxIndexedTag> kSlots = MakeSlots();
+
+uint8_t SlotOf(int tag) noexcept {
+    return tag >= 0 && tag < kMaxIndexedTag ? kSlots[static_cast<size_t>(tag)] : kNotIndexed;
+}
+
+// Finds the SOHs of a message 16 bytes at a time: one compare and movemask
+// per block, then a bit scan per field instead of a byte loop whose exit
+// branch mispredicts on every value.
+class SohScanner {
+public:
+    SohScanner(const char* base, size_t size) noexcept : m_base(base), m_size(size), m_bits(Load(0)) {}
+
+    // First SOH at or after 'from', or the message size if there is none.
+    size_t Next(size_t from) noexcept {
+        if (from >= m_at + kBlock) {
+            m_at   = from & ~(kBlock - 1);
+            m_bits = Load(m_at);
+        }
+        uint32_t bits = m_bits & (~0u << (from - m_at));
+        while (bits == 0) {
+            m_at += kBlock;
+            if (m_at >= m_size) return m_size;
+            bits = m_bits = Load(m_at);
+        }
+        return m_at + static_cast<size_t>(std::countr_zero(bits));
+    }
+
+private:
+    static constexpr size_t kBlock = 16;
+
+    uint32_t Load(size_t at) const noexcept {
+#if defined(BRIDGE_FIXSCAN_SSE2)
+        if (at + kBlock <= m_size) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(m_base + at));
+            return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8(kFixSoh))));
+        }
+#endif
+        uint32_t bits = 0;
+        for (size_t i = at; i < m_size && i < at + kBlock; ++i)
+            if (m_base[i] == kFixSoh) bits |= 1u << (i - at);
+        return bits;
+    }
+
+    const char* m_base;
+    size_t      m_size;
+    size_t      m_at = 0;
+    uint32_t    m_bits;
+};
+
+// Parse "tag=" at msg[pos]; returns the tag and leaves pos on the value,
+// or -1 if the field is malformed.
+int ParseTag(std::string_view msg, size_t& pos) noexcept {
+    int    tag    = 0;
+    size_t digits = 0;
+    while (pos < msg.size() && msg[pos] >= '0' && msg[pos] <= '9' && digits < 9) {
+        tag = tag * 10 + (msg[pos] - '0');
+        ++pos;
+        ++digits;
+    }
+    if (digits == 0 || pos >= msg.size() || msg[pos] != '=') return -1;
+    ++pos;
+    return tag;
+}
+
+} // anonymous namespace
+
+static_assert(std::size(kIndexedTags) == FixDecoder::kIndexed, "one index slot per indexed tag");
+
+bool FixDecoder::IsIndexed(int tag) noexcept {
+    return SlotOf(tag) != kNotIndexed;
+}
+
+ptrdiff_t FixDecoder::Decode(std::string_view buf) noexcept {
+    m_msg = {};
+    std::memset(m_index, 0, sizeof(m_index));
+    ptrdiff_t size = FixFrame(buf);
+    if (size <= 0) return size;
+
+    std::string_view msg = buf.substr(0, static_cast<size_t>(size));
+    SohScanner       soh(msg.data(), msg.size());
+    size_t           pos = 0;
+    while (pos < msg.size()) {
+        int    tag = ParseTag(msg, pos);
+        size_t end = tag < 0 ? msg.size() : soh.Next(pos);
+        if (end >= msg.size()) {
+            std::memset(m_index, 0, sizeof(m_index));
+            return -1;
+        }
+        uint8_t slot = SlotOf(tag);
+        if (slot != kNotIndexed && m_index[slot].offset == 0) {
+            m_index[slot].offset = static_cast<uint32_t>(pos);
+            m_index[slot].length = static_cast<uint32_t>(end - pos);
+        }
+        pos = end + 1;
+    }
+    m_msg = msg;
+    return size;
+}
+
+std::string_view FixDecoder::Scan(int tag, bool& found) const noexcept {
+    size_t pos = 0;
+    while (pos < m_msg.size()) {
+        int t = ParseTag(m_msg, pos);
+        if (t < 0) break;
+        size_t end = m_msg.find(kFixSoh, pos);
+        if (end == std::string_view::npos) break;
+        if (t == tag) {
+            found = true;
+            return m_msg.substr(pos, end - pos);
+        }
+        pos = end + 1;
+    }
+    found = false;
+    return {};
+}
+
+std::string_view FixDecoder::Get(int tag) const noexcept {
+    uint8_t slot = SlotOf(tag);
+    if (slot != kNotIndexed) {
+        const Span& s = m_index[slot];
+        return s.offset ? m_msg.substr(s.offset, s.length) : std::string_view();
+    }
+    bool found;
+    return Scan(tag, found);
+}
+
+bool FixDecoder::Has(int tag) const noexcept {
+    uint8_t slot = SlotOf(tag);
+    if (slot != kNotIndexed) return m_index[slot].offset != 0;
+    bool found;
+    Scan(tag, found);
+    return found;
+}
+
+int64_t FixDecoder::GetInt(int tag, int64_t fallback) const noexcept {
+    std::string_view v = Get(tag);
+    int64_t out = 0;
+    auto r = std::from_chars(v.data(), v.data() + v.size(), out);
+    return (r.ec == std::errc{} && r.ptr == v.data() + v.size() && !v.empty()) ? out : fallback;
+}
+
+char FixDecoder::GetChar(int tag, char fallback) const noexcept {
+    std::string_view v = Get(tag);
+    return v.size() == 1 ? v[0] : fallback;
+}
+
+} // namespace Bridge
@@ -0,0 +1,256 @@
+#include "FixMessage.h"
+#include "Numeric.h"
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+
+#if defined(__AVX2__)
+#  define BRIDGE_FIXSUM_AVX2 1
+#  include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define BRIDGE_FIXSUM_SSE2 1
+#  include <emmintrin.h>
+#endif
+
+namespace Bridge {
+
+namespace {
+
+constexpr std::string_view kBeginString = "8=FIX.4.2\x01";
+constexpr size_t           kTrailerLen  = 7;          // "10=nnn|"
+constexpr size_t           kMaxBody     = 1 << 20;
+
+unsigned CheckSum(const char* p, size_t n) noexcept {
+    return FixByteSum(p, n) & 0xFF;
+}
+
+} // anonymous namespace
+
+unsigned FixByteSum(const char* p, size_t n) noexcept {
+    size_t   i   = 0;
+    uint64_t sum = 0;
+#if defined(BRIDGE_FIXSUM_AVX2)
+    // _mm256_sad_epu8 against zero adds each group of 8 bytes into a 64-bit lane.
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i       acc  = zero;
+    for (; i + 32 <= n; i += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        acc = _mm256_add_epi64(acc, _mm256_sad_epu8(v, zero));
+    }
+    __m128i half = _mm_add_epi64(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+    sum = static_cast<uint64_t>(_mm_cvtsi128_si64(half)) + static_cast<uint64_t>(_mm_extract_epi64(half, 1));
+#elif defined(BRIDGE_FIXSUM_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    __m128i       acc  = zero;
+    for (; i + 16 <= n; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        acc = _mm_add_epi64(acc, _mm_sad_epu8(v, zero));
+    }
+    sum = static_cast<uint64_t>(_mm_cvtsi128_si32(acc)) +
+          static_cast<uint64_t>(_mm_cvtsi128_si32(_mm_srli_si128(acc, 8)));
+#endif
+    for (; i < n; ++i) sum += static_cast<unsigned char>(p[i]);
+    return static_cast<unsigned>(sum);
+}
+
+void FixTimestamp(char* out) noexcept {
+    thread_local int64_t cachedSec = -1;
+    thread_local char    cached[17];   // "YYYYMMDD-HH:MM:SS"
+    int64_t ms  = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    int64_t sec = ms / 1000;
+    if (sec != cachedSec) {
+        std::time_t t = static_cast<std::time_t>(sec);
+        struct tm tm_utc;
+#ifdef _WIN32
+        gmtime_s(&tm_utc, &t);
+#else
+        gmtime_r(&t, &tm_utc);
+#endif
+        char tmp[32];
+        std::strftime(tmp, sizeof(tmp), "%Y%m%d-%H:%M:%S", &tm_utc);
+        std::memcpy(cached, tmp, sizeof(cached));
+        cachedSec = sec;
+    }
+    std::memcpy(out, cached, sizeof(cached));
+    unsigned milli = static_cast<unsigned>(ms % 1000);
+    out[17] = '.';
+    out[18] = static_cast<char>('0' + milli / 100);
+    out[19] = static_cast<char>('0' + milli / 10 % 10);
+    out[20] = static_cast<char>('0' + milli % 10);
+}
+
+// ---- FixWriter ----------------------------------------------------------
+
+char* FixWriter::Reserve(size_t n) noexcept {
+    if (m_overflow || m_pos + n > kCapacity - kTrailerLen) {
+        m_overflow = true;
+        return nullptr;
+    }
+    return m_buf + m_pos;
+}
+
+void FixWriter::AddTag(int tag) noexcept {
+    char* p = Reserve(12);
+    if (!p) return;
+    auto r = std::to_chars(p, p + 11, tag);
+    *r.ptr = '=';
+    m_pos = static_cast<size_t>(r.ptr + 1 - m_buf);
+}
+
+void FixWriter::Begin(std::string_view msgType) noexcept {
+    m_pos      = kHeaderRoom;
+    m_overflow = false;
+    Add(FixTag::MsgType, msgType);
+}
+
+void FixWriter::Add(int tag, std::string_view value) noexcept {
+    AddTag(tag);
+    char* p = Reserve(value.size() + 1);
+    if (!p) return;
+    std::memcpy(p, value.data(), value.size());
+    p[value.size()] = kFixSoh;
+    m_pos += value.size() + 1;
+}
+
+void FixWriter::Add(int tag, int64_t value) noexcept {
+    AddTag(tag);
+    char* p = Reserve(21);
+    if (!p) return;
+    auto r = std::to_chars(p, p + 20, value);
+    *r.ptr = kFixSoh;
+    m_pos = static_cast<size_t>(r.ptr + 1 - m_buf);
+}
+
+void FixWriter::Add(int tag, char value) noexcept {
+    Add(tag, std::string_view(&value, 1));
+}
+
+void FixWriter::AddPrice(int tag, const FixedPrice& px, double fallback) noexcept {
+    FixedPrice p = px.IsSet() ? px : PriceFromDouble(fallback);
+    char   text[40];
+    size_t n = FormatPrice(p, text, sizeof(text));
+    if (n == 0) {
+        m_overflow = true;   // NaN or out of range: refuse rather than send a bad price
+        return;
+    }
+    Add(tag, std::string_view(text, n));
+}
+
+void FixWriter::AddTimestamp(int tag) noexcept {
+    char ts[kFixTimestampLen];
+    FixTimestamp(ts);
+    Add(tag, std::string_view(ts, sizeof(ts)));
+}
+
+std::string_view FixWriter::Finish() noexcept {
+    if (m_overflow) return {};
+    size_t bodyLen = m_pos - kHeaderRoom;
+
+    char  header[kHeaderRoom];
+    char* h = header;
+    std::memcpy(h, kBeginString.data(), kBeginString.size());
+    h += kBeginString.size();
+    *h++ = '9';
+    *h++ = '=';
+    h = std::to_chars(h, header + sizeof(header) - 1, bodyLen).ptr;
+    *h++ = kFixSoh;
+    size_t headerLen = static_cast<size_t>(h - header);
+    char*  start     = m_buf + kHeaderRoom - headerLen;
+    std::memcpy(start, header, headerLen);
+
+    unsigned sum = CheckSum(start, static_cast<size_t>(m_buf + m_pos - start));
+    char*    t   = m_buf + m_pos;
+    t[0] = '1';
+    t[1] = '0';
+    t[2] = '=';
+    t[3] = static_cast<char>('0' + sum / 100);
+    t[4] = static_cast<char>('0' + sum / 10 % 10);
+    t[5] = static_cast<char>('0' + sum % 10);
+    t[6] = kFixSoh;
+    return std::string_view(start, static_cast<size_t>(t + kTrailerLen - start));
+}
+
+// ---- Framing and fields ---------------------------------------------------
+
+ptrdiff_t FixFrame(std::string_view buf) noexcept {
+    // "8=FIX.x.y|9=<len>|"
+    if (buf.size() < 2) return 0;
+    if (buf[0] != '8' || buf[1] != '=') return -1;
+    size_t soh = buf.find(kFixSoh);
+    if (soh == std::string_view::npos) return buf.size() > 16 ? -1 : 0;
+    size_t pos = soh + 1;
+    if (buf.size() < pos + 2) return 0;
+    if (buf[pos] != '9' || buf[pos + 1] != '=') return -1;
+    pos += 2;
+    size_t bodyLen = 0;
+    size_t digits  = 0;
+    for (;; ++pos, ++digits) {
+        if (pos >= buf.size()) return digits > 7 ? -1 : 0;
+        char c = buf[pos];
+        if (c == kFixSoh) break;
+        if (c < '0' || c > '9' || digits >= 7) return -1;
+        bodyLen = bodyLen * 10 + static_cast<size_t>(c - '0');
+    }
+    if (digits == 0 || bodyLen > kMaxBody) return -1;
+    size_t trailer = pos + 1 + bodyLen;
+    size_t total   = trailer + kTrailerLen;
+    if (buf.size() < total) return 0;
+
+    const char* t = buf.data() + trailer;
+    if (t[0] != '1' || t[1] != '0' || t[2] != '=' || t[6] != kFixSoh) return -1;
+    unsigned want = 0;
+    for (int i = 3; i < 6; ++i) {
+        if (t[i] < '0' || t[i] > '9') return -1;
+        want = want * 10 + static_cast<unsigned>(t[i] - '0');
+    }
+    if (CheckSum(buf.data(), trailer) != want) return -1;
+    return static_cast<ptrdiff_t>(total);
+}
+
+bool FixFields::Parse(std::string_view msg) noexcept {
+    m_count = 0;
+    size_t pos = 0;
+    while (pos < msg.size()) {
+        int    tag    = 0;
+        size_t digits = 0;
+        while (pos < msg.size() && msg[pos] >= '0' && msg[pos] <= '9' && digits < 9) {
+            tag = tag * 10 + (msg[pos] - '0');
+            ++pos;
+            ++digits;
+        }
+        if (digits == 0 || pos >= msg.size() || msg[pos] != '=') return false;
+        size_t end = msg.find(kFixSoh, ++pos);
+        if (end == std::string_view::npos || m_count == kMaxFields) return false;
+        m_fields[m_count++] = { tag, msg.substr(pos, end - pos) };
+        pos = end + 1;
+    }
+    return true;
+}
+
+std::string_view FixFields::Get(int tag) const noexcept {
+    for (size_t i = 0; i < m_count; ++i)
+        if (m_fields[i].tag == tag) return m_fields[i].value;
+    return {};
+}
+
+bool FixFields::Has(int tag) const noexcept {
+    for (size_t i = 0; i < m_count; ++i)
+        if (m_fields[i].tag == tag) return true;
+    return false;
+}
+
+int64_t FixFields::GetInt(int tag, int64_t fallback) const noexcept {
+    std::string_view v = Get(tag);
+    int64_t out = 0;
+    auto r = std::from_chars(v.data(), v.data() + v.size(), out);
+    return (r.ec == std::errc{} && r.ptr == v.data() + v.size() && !v.empty()) ? out : fallback;
+}
+
+char FixFields::GetChar(int tag, char fallback) const noexcept {
+    std::string_view v = Get(tag);
+    return v.size() == 1 ? v[0] : fallback;
+}
+
+} // namespace Bridge
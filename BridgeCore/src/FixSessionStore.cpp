@@ -0,0 +1,180 @@
+#include "FixSessionStore.h"
+#include <chrono>
+#include <cstring>
+
+namespace Bridge {
+
+namespace {
+
+constexpr char     kMagic[8]    = { 'B', 'R', 'F', 'I', 'X', 'S', '0', '1' };
+constexpr uint32_t kVersion     = 1;
+constexpr size_t   kHeaderBytes = 4096;
+constexpr size_t   kCompIdBytes = 64;
+
+constexpr size_t Align8(size_t n) noexcept { return (n + 7) & ~size_t(7); }
+
+bool Overlaps(size_t a, size_t aLen, size_t b, size_t bLen) noexcept {
+    return a < b + bLen && b < a + aLen;
+}
+
+} // anonymous namespace
+
+struct FixSessionStore::Header {
+    char     magic[8];
+    uint32_t version;
+    uint32_t headerSize;
+    uint64_t ringBytes;
+    uint64_t indexSlots;
+    int64_t  createdNs;
+    char     senderCompId[kCompIdBytes];
+    char     targetCompId[kCompIdBytes];
+    uint64_t nextOut;
+    uint64_t nextIn;
+    uint64_t firstKept;    // messages below this are gone
+    uint64_t lastStored;   // 0: none yet
+    uint64_t head;         // ring offset where the next message goes
+};
+
+struct FixSessionStore::Slot {
+    uint64_t seq;
+    uint32_t offset;
+    uint32_t length;
+};
+
+FixSessionStore::Slot* FixSessionStore::Slots() const noexcept {
+    return reinterpret_cast<Slot*>(m_file.Data() + kHeaderBytes);
+}
+
+char* FixSessionStore::Ring() const noexcept {
+    return m_file.Data() + kHeaderBytes + m_indexSlots * sizeof(Slot);
+}
+
+bool FixSessionStore::Open(const std::string& path, std::string_view senderCompId, std::string_view targetCompId,
+                           size_t ringBytes, size_t indexSlots) noexcept {
+    static_assert(sizeof(Header) <= kHeaderBytes, "session store header fits its page");
+    static_assert(sizeof(Slot) == 16, "session store index slot is 16 bytes");
+    Close();
+    ringBytes = Align8(ringBytes);
+    if (senderCompId.size() >= kCompIdBytes || targetCompId.size() >= kCompIdBytes) return false;
+    if (ringBytes == 0 || ringBytes > UINT32_MAX || indexSlots == 0) return false;
+    size_t total = kHeaderBytes + indexSlots * sizeof(Slot) + ringBytes;
+
+    // Reserve the blocks up front so a Store never waits on the file system.
+    if (!MappedFile::Preallocate(path, total) || !m_file.Open(path, MappedFile::Mode::ReadWrite, total))
+        return false;
+    m_ringBytes  = ringBytes;
+    m_indexSlots = indexSlots;
+
+    Header* h = Head();
+    static const char zero[sizeof(kMagic)] = {};
+    if (std::memcmp(h->magic, zero, sizeof(zero)) == 0) {
+        std::memset(h, 0, kHeaderBytes);
+        h->version    = kVersion;
+        h->headerSize = static_cast<uint32_t>(kHeaderBytes);
+        h->ringBytes  = ringBytes;
+        h->indexSlots = indexSlots;
+        h->createdNs  = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        std::memcpy(h->senderCompId, senderCompId.data(), senderCompId.size());
+        std::memcpy(h->targetCompId, targetCompId.data(), targetCompId.size());
+        h->nextOut   = 1;
+        h->nextIn    = 1;
+        h->firstKept = 1;
+        std::memcpy(h->magic, kMagic, sizeof(kMagic));   // last: the store is complete
+        return true;
+    }
+
+    // Reopening costs this check, nothing more: the index is already on disk.
+    bool valid = std::memcmp(h->magic, kMagic, sizeof(kMagic)) == 0 && h->version == kVersion &&
+                 h->headerSize == kHeaderBytes && h->ringBytes == ringBytes && h->indexSlots == indexSlots &&
+                 std::string_view(h->senderCompId, strnlen(h->senderCompId, kCompIdBytes)) == senderCompId &&
+                 std::string_view(h->targetCompId, strnlen(h->targetCompId, kCompIdBytes)) == targetCompId &&
+                 m_file.Size() >= total && h->head <= ringBytes && h->nextOut >= 1 && h->nextIn >= 1 &&
+                 h->firstKept >= 1 && h->firstKept <= h->lastStored + 1;
+    if (!valid) Close();
+    return valid;
+}
+
+void FixSessionStore::Close() noexcept {
+    if (!m_file.IsOpen()) return;
+    m_file.Flush();
+    m_file.Close();
+    m_ringBytes = m_indexSlots = 0;
+}
+
+uint64_t FixSessionStore::NextOutgoing() const noexcept { return IsOpen() ? Head()->nextOut : 1; }
+uint64_t FixSessionStore::NextIncoming() const noexcept { return IsOpen() ? Head()->nextIn : 1; }
+uint64_t FixSessionStore::FirstKept() const noexcept    { return IsOpen() ? Head()->firstKept : 1; }
+
+void FixSessionStore::SetNextOutgoing(uint64_t seq) noexcept {
+    if (IsOpen()) Head()->nextOut = seq;
+}
+
+void FixSessionStore::SetNextIncoming(uint64_t seq) noexcept {
+    if (IsOpen()) Head()->nextIn = seq;
+}
+
+bool FixSessionStore::Store(uint64_t seq, std::string_view msg) noexcept {
+    if (!IsOpen() || msg.empty()) return false;
+    Header* h    = Head();
+    size_t  size = Align8(msg.size());
+    if (seq <= h->lastStored || size > m_ringBytes / 4) return false;
+
+    // Claim [at, at + size), or the rest of the ring and its start if the
+    // message does not fit before the end.
+    size_t at        = static_cast<size_t>(h->head);
+    size_t skipStart = 0, skipLen = 0;
+    if (at + size > m_ringBytes) {
+        skipStart = at;
+        skipLen   = m_ringBytes - at;
+        at        = 0;
+    }
+
+    // Messages lie in the ring oldest first from the head on, so drop from
+    // the oldest until one is clear of the claim. Unstored numbers (session
+    // messages) are stepped over, each once.
+    uint64_t first = h->firstKept;
+    if (seq >= m_indexSlots && first < seq + 1 - m_indexSlots) first = seq + 1 - m_indexSlots;
+    const Slot* slots = Slots();
+    while (first <= h->lastStored) {
+        const Slot& s = slots[first % m_indexSlots];
+        if (s.seq == first) {
+            size_t len = Align8(s.length);
+            if (!Overlaps(s.offset, len, at, size) && !Overlaps(s.offset, len, skipStart, skipLen)) break;
+        }
+        ++first;
+    }
+    if (first > h->lastStored) first = seq;
+    h->firstKept = first;
+
+    std::memcpy(Ring() + at, msg.data(), msg.size());
+    Slot& slot  = Slots()[seq % m_indexSlots];
+    slot.seq    = seq;
+    slot.offset = static_cast<uint32_t>(at);
+    slot.length = static_cast<uint32_t>(msg.size());
+    h->head       = at + size;
+    h->lastStored = seq;
+    return true;
+}
+
+std::string_view FixSessionStore::Find(uint64_t seq) const noexcept {
+    if (!IsOpen()) return {};
+    const Header* h = Head();
+    if (seq < h->firstKept || seq > h->lastStored) return {};
+    const Slot& s = Slots()[seq % m_indexSlots];
+    if (s.seq != seq || size_t(s.offset) + s.length > m_ringBytes) return {};
+    return std::string_view(Ring() + s.offset, s.length);
+}
+
+void FixSessionStore::Reset() noexcept {
+    if (!IsOpen()) return;
+    Header* h = Head();
+    std::memset(Slots(), 0, m_indexSlots * sizeof(Slot));
+    h->nextOut    = 1;
+    h->nextIn     = 1;
+    h->firstKept  = 1;
+    h->lastStored = 0;
+    h->head       = 0;
+}
+
+} // namespace Bridge
@@ -0,0 +1,213 @@
+#include "FixTemplate.h"
+#include "Numeric.h"
+#include <charconv>
+#include <cstring>
+
+namespace Bridge {
+
+namespace {
+
+constexpr std::string_view kBeginString = "8=FIX.4.2\x01" "9=";
+constexpr size_t           kTrailerLen  = 7;    // "10=nnn|"
+constexpr size_t           kSeqWidth    = 9;
+constexpr size_t           kQtyWidth    = 9;
+constexpr size_t           kPriceWidth  = 18;
+
+bool HasLimit(char ordType) noexcept { return ordType == '2' || ordType == '4'; }
+bool HasStop(char ordType) noexcept  { return ordType == '3' || ordType == '4'; }
+
+// 'v' right-aligned in 'width' digits with leading zeros.
+bool PutPadded(char* out, size_t width, uint64_t v) noexcept {
+    for (size_t i = width; i-- > 0;) {
+        out[i] = static_cast<char>('0' + v % 10);
+        v /= 10;
+    }
+    return v == 0;
+}
+
+// "-0004900.25": sign first, then zeros up to 'width'.
+bool PutPrice(char* out, size_t width, const FixedPrice& px) noexcept {
+    char   text[40];
+    size_t n = FormatPrice(px, text, sizeof(text));
+    if (n == 0 || n > width) return false;
+    size_t sign = text[0] == '-' ? 1 : 0;
+    if (sign) out[0] = '-';
+    std::memset(out + sign, '0', width - n);
+    std::memcpy(out + width - (n - sign), text + sign, n - sign);
+    return true;
+}
+
+} // anonymous namespace
+
+std::string_view EncodeOrder(FixWriter& w, char msgType, std::string_view senderCompId,
+                             std::string_view targetCompId, uint64_t seq, const FixOrderFields& f) noexcept {
+    bool order = msgType == 'D' || msgType == 'G';
+    if (order && ((HasLimit(f.ordType) && !f.price.IsSet()) || (HasStop(f.ordType) && !f.stopPx.IsSet())))
+        return {};
+    w.Begin(std::string_view(&msgType, 1));
+    w.Add(FixTag::SenderCompID, senderCompId);
+    w.Add(FixTag::TargetCompID, targetCompId);
+    w.Add(FixTag::MsgSeqNum, static_cast<int64_t>(seq));
+    w.AddTimestamp(FixTag::SendingTime);
+    if (msgType != 'D') w.Add(FixTag::OrigClOrdID, f.origClOrdId);
+    w.Add(FixTag::ClOrdID, f.clOrdId);
+    if (!f.account.empty()) w.Add(FixTag::Account, f.account);
+    if (order) w.Add(FixTag::HandlInst, '1');
+    w.Add(FixTag::Symbol, f.symbol);
+    w.Add(FixTag::Side, f.side);
+    w.AddTimestamp(FixTag::TransactTime);
+    w.Add(FixTag::OrderQty, f.quantity);
+    if (order) {
+        w.Add(FixTag::OrdType, f.ordType);
+        if (HasLimit(f.ordType)) w.AddPrice(FixTag::Price, f.price, 0.0);
+        if (HasStop(f.ordType))  w.AddPrice(FixTag::StopPx, f.stopPx, 0.0);
+        w.Add(FixTag::TimeInForce, f.tif);
+    }
+    return w.Finish();
+}
+
+FixOrderTemplates::FixOrderTemplates(std::string_view senderCompId, std::string_view targetCompId) noexcept {
+    for (int i = 0; i < 4; ++i) {
+        Build(m_new[i], 'D', static_cast<char>('1' + i), senderCompId, targetCompId);
+        Build(m_replace[i], 'G', static_cast<char>('1' + i), senderCompId, targetCompId);
+    }
+    Build(m_cancel, 'F', '1', senderCompId, targetCompId);
+}
+
+void FixOrderTemplates::Build(Template& t, char msgType, char ordType,
+                              std::string_view sender, std::string_view target) noexcept {
+    // Leave room for the strings Render appends; CompIDs longer than that
+    // are not worth a template.
+    constexpr size_t kLimit = kCapacity / 2;
+    size_t pos = kHeaderRoom;
+    auto tag = [&](int number) {
+        auto r = std::to_chars(t.buf + pos, t.buf + kLimit, number);
+        pos = static_cast<size_t>(r.ptr - t.buf);
+        t.buf[pos++] = '=';
+    };
+    auto put = [&](int number, std::string_view value) {
+        if (pos + 12 + value.size() > kLimit) {
+            m_valid = false;
+            return;
+        }
+        tag(number);
+        std::memcpy(t.buf + pos, value.data(), value.size());
+        pos += value.size();
+        t.buf[pos++] = kFixSoh;
+    };
+    // Slots hold NULs until Render fills them, so they add nothing to constSum.
+    auto slot = [&](int number, size_t width, size_t& offset) {
+        if (pos + 12 + width > kLimit) {
+            m_valid = false;
+            return;
+        }
+        tag(number);
+        offset = pos;
+        std::memset(t.buf + pos, 0, width);
+        pos += width;
+        t.buf[pos++] = kFixSoh;
+    };
+
+    bool order = msgType == 'D' || msgType == 'G';
+    put(FixTag::MsgType, std::string_view(&msgType, 1));
+    put(FixTag::SenderCompID, sender);
+    put(FixTag::TargetCompID, target);
+    slot(FixTag::MsgSeqNum, kSeqWidth, t.seq);
+    slot(FixTag::SendingTime, kFixTimestampLen, t.sendTime);
+    if (order) put(FixTag::HandlInst, "1");
+    slot(FixTag::Side, 1, t.side);
+    slot(FixTag::TransactTime, kFixTimestampLen, t.xactTime);
+    slot(FixTag::OrderQty, kQtyWidth, t.qty);
+    if (order) {
+        put(FixTag::OrdType, std::string_view(&ordType, 1));
+        if (HasLimit(ordType)) slot(FixTag::Price, kPriceWidth, t.price);
+        if (HasStop(ordType))  slot(FixTag::StopPx, kPriceWidth, t.stopPx);
+        slot(FixTag::TimeInForce, 1, t.tif);
+    }
+    t.fixedEnd = pos;
+    t.constSum = FixByteSum(t.buf + kHeaderRoom, pos - kHeaderRoom);
+}
+
+std::string_view FixOrderTemplates::Render(char msgType, uint64_t seq, const FixOrderFields& f) noexcept {
+    if (!m_valid) return {};
+    Template* t = nullptr;
+    switch (msgType) {
+        case 'D':
+        case 'G':
+            if (f.ordType < '1' || f.ordType > '4') return {};
+            t = &(msgType == 'D' ? m_new : m_replace)[f.ordType - '1'];
+            break;
+        case 'F':
+            t = &m_cancel;
+            break;
+        default:
+            return {};
+    }
+    char* buf = t->buf;
+
+    // Patch the slots.
+    if (!PutPadded(buf + t->seq, kSeqWidth, seq)) return {};
+    if (f.quantity < 0 || !PutPadded(buf + t->qty, kQtyWidth, static_cast<uint64_t>(f.quantity))) return {};
+    if (t->price != kNoSlot && !PutPrice(buf + t->price, kPriceWidth, f.price)) return {};
+    if (t->stopPx != kNoSlot && !PutPrice(buf + t->stopPx, kPriceWidth, f.stopPx)) return {};
+    FixTimestamp(buf + t->sendTime);
+    std::memcpy(buf + t->xactTime, buf + t->sendTime, kFixTimestampLen);
+    buf[t->side] = f.side;
+    if (t->tif != kNoSlot) buf[t->tif] = f.tif;
+
+    unsigned sum = t->constSum;
+    sum += FixByteSum(buf + t->seq, kSeqWidth) + FixByteSum(buf + t->qty, kQtyWidth) +
+           2 * FixByteSum(buf + t->sendTime, kFixTimestampLen) + static_cast<unsigned char>(f.side);
+    if (t->price != kNoSlot)  sum += FixByteSum(buf + t->price, kPriceWidth);
+    if (t->stopPx != kNoSlot) sum += FixByteSum(buf + t->stopPx, kPriceWidth);
+    if (t->tif != kNoSlot)    sum += static_cast<unsigned char>(f.tif);
+
+    // Append the strings.
+    size_t pos  = t->fixedEnd;
+    size_t need = f.origClOrdId.size() + f.clOrdId.size() + f.account.size() + f.symbol.size() + 4 * 4;
+    if (pos + need + kTrailerLen > kCapacity) return {};
+    size_t tailStart = pos;
+    auto put = [&](char a, char b, std::string_view value) {
+        char* p = buf + pos;
+        p[0] = a;
+        p[1] = b;
+        p[2] = '=';
+        std::memcpy(p + 3, value.data(), value.size());
+        p[3 + value.size()] = kFixSoh;
+        pos += value.size() + 4;
+    };
+    if (msgType != 'D') put('4', '1', f.origClOrdId);
+    put('1', '1', f.clOrdId);
+    if (!f.account.empty()) {
+        buf[pos++] = '1';
+        buf[pos++] = '=';
+        std::memcpy(buf + pos, f.account.data(), f.account.size());
+        pos += f.account.size();
+        buf[pos++] = kFixSoh;
+    }
+    put('5', '5', f.symbol);
+    sum += FixByteSum(buf + tailStart, pos - tailStart);
+
+    // BeginString and BodyLength, right-aligned against the body.
+    char   len[8];
+    char*  lenEnd    = std::to_chars(len, len + sizeof(len), pos - kHeaderRoom).ptr;
+    size_t lenDigits = static_cast<size_t>(lenEnd - len);
+    char*  start     = buf + kHeaderRoom - (kBeginString.size() + lenDigits + 1);
+    std::memcpy(start, kBeginString.data(), kBeginString.size());
+    std::memcpy(start + kBeginString.size(), len, lenDigits);
+    buf[kHeaderRoom - 1] = kFixSoh;
+    sum += FixByteSum(start, static_cast<size_t>(buf + kHeaderRoom - start));
+
+    sum &= 0xFF;
+    char* tr = buf + pos;
+    tr[0] = '1';
+    tr[1] = '0';
+    tr[2] = '=';
+    tr[3] = static_cast<char>('0' + sum / 100);
+    tr[4] = static_cast<char>('0' + sum / 10 % 10);
+    tr[5] = static_cast<char>('0' + sum % 10);
+    tr[6] = kFixSoh;
+    return std::string_view(start, static_cast<size_t>(tr + kTrailerLen - start));
+}
+
+} // namespace Bridge
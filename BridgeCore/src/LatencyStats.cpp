@@ -0,0 +1,372 @@
+#include "LatencyStats.h"
+#include "Keywords.h"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define BRIDGE_LATENCY_TSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BRIDGE_LATENCY_TSC 1
+#endif
+
+namespace Bridge {
+
+namespace {
+
+int64_t SteadyNs() noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// The TSC where there is one (a few ns to read, no syscall); converted to
+// nanoseconds only when a report is built.
+uint64_t Ticks() noexcept {
+#ifdef BRIDGE_LATENCY_TSC
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(SteadyNs());
+#endif
+}
+
+struct ClockBase {
+    uint64_t ticks;
+    int64_t  ns;
+};
+const ClockBase g_clockBase{ Ticks(), SteadyNs() };
+
+// Ticks per nanosecond, measured against steady_clock since startup.
+double TicksPerNs() {
+#ifdef BRIDGE_LATENCY_TSC
+    constexpr int64_t kMinSpanNs = 20 * 1000000;
+    int64_t span = SteadyNs() - g_clockBase.ns;
+    if (span < kMinSpanNs) std::this_thread::sleep_for(std::chrono::nanoseconds(kMinSpanNs - span));
+    uint64_t ticks = Ticks();
+    int64_t  ns    = SteadyNs();
+    return static_cast<double>(ticks - g_clockBase.ticks) / static_cast<double>(ns - g_clockBase.ns);
+#else
+    return 1.0;
+#endif
+}
+
+constexpr size_t kStages = static_cast<size_t>(Stage::Count);
+constexpr size_t kKeys   = kStages * kLatencyCommands * kLatencyAdapters;
+
+size_t KeyOf(Stage s, uint8_t command, uint8_t adapter) noexcept {
+    return (static_cast<size_t>(command) * kLatencyAdapters + adapter) * kStages + static_cast<size_t>(s);
+}
+
+static_assert(kStages <= 8, "LatencyRequest::marked has a bit per stage");
+
+// One thread's histograms, allocated on first use per key. A shard whose
+// thread has exited is handed to the next new thread, counts and all.
+struct Shard {
+    std::atomic<LatencyHistogram*> hist[kKeys] = {};
+    ~Shard() {
+        for (auto& h : hist) delete h.load(std::memory_order_relaxed);
+    }
+};
+
+struct Registry {
+    std::mutex                          mutex;
+    std::vector<std::unique_ptr<Shard>> shards;
+    std::vector<Shard*>                 free;
+    std::vector<std::string>            adapters{ "-" };
+};
+
+Registry& GetRegistry() {
+    static Registry* r = new Registry();   // never destroyed: threads may record during shutdown
+    return *r;
+}
+
+struct ShardLease {
+    Shard* shard = nullptr;
+    ~ShardLease() {
+        if (!shard) return;
+        detail::t_latency.shard = nullptr;
+        Registry& r = GetRegistry();
+        std::lock_guard<std::mutex> lk(r.mutex);
+        r.free.push_back(shard);
+    }
+};
+
+Shard& LocalShard() {
+    thread_local ShardLease lease;
+    if (!lease.shard) {
+        Registry& r = GetRegistry();
+        std::lock_guard<std::mutex> lk(r.mutex);
+        if (!r.free.empty()) {
+            lease.shard = r.free.back();
+            r.free.pop_back();
+        } else {
+            r.shards.push_back(std::make_unique<Shard>());
+            lease.shard = r.shards.back().get();
+        }
+    }
+    return *lease.shard;
+}
+
+void Record(Shard& shard, size_t key, uint64_t ticks) {
+    LatencyHistogram* h = shard.hist[key].load(std::memory_order_relaxed);
+    if (!h) {
+        h = new LatencyHistogram();
+        shard.hist[key].store(h, std::memory_order_release);
+    }
+    h->Record(ticks);
+}
+
+const char* CommandName(uint8_t command) noexcept {
+    if (command == kLatencyBatch) return "BATCH";
+    for (const Keyword& k : Keywords::kAll)
+        if (k.kind == KeywordKind::Command && k.value == command) return k.text.data();
+    return "UNKNOWN";
+}
+
+// Merged histograms of every key with samples, in key order.
+std::map<size_t, std::unique_ptr<LatencyHistogram>> MergeAll(std::vector<std::string>& adapters) {
+    std::map<size_t, std::unique_ptr<LatencyHistogram>> merged;
+    Registry& r = GetRegistry();
+    std::lock_guard<std::mutex> lk(r.mutex);
+    adapters = r.adapters;
+    for (const auto& shard : r.shards) {
+        for (size_t key = 0; key < kKeys; ++key) {
+            const LatencyHistogram* h = shard->hist[key].load(std::memory_order_acquire);
+            if (!h || h->Count() == 0) continue;
+            auto& m = merged[key];
+            if (!m) m = std::make_unique<LatencyHistogram>();
+            m->Merge(*h);
+        }
+    }
+    return merged;
+}
+
+LatencySummary Summarise(const LatencyHistogram& h, double ticksPerNs) {
+    auto ns = [&](uint64_t ticks) { return static_cast<uint64_t>(static_cast<double>(ticks) / ticksPerNs); };
+    LatencySummary s;
+    s.count = h.Count();
+    s.p50   = ns(h.Percentile(0.50));
+    s.p99   = ns(h.Percentile(0.99));
+    s.p999  = ns(h.Percentile(0.999));
+    s.max   = ns(h.Max());
+    s.mean  = s.count ? ns(h.Sum() / s.count) : 0;
+    return s;
+}
+
+} // anonymous namespace
+
+const char* StageName(Stage s) noexcept {
+    switch (s) {
+        case Stage::Convert:   return "CONVERT";
+        case Stage::Parse:     return "PARSE";
+        case Stage::Validate:  return "VALIDATE";
+        case Stage::GetEngine: return "GETENGINE";
+        case Stage::Dispatch:  return "DISPATCH";
+        case Stage::Adapter:   return "ADAPTER";
+        case Stage::Log:       return "LOG";
+        case Stage::Total:     return "TOTAL";
+        default:               return "?";
+    }
+}
+
+size_t LatencyHistogram::BucketOf(uint64_t v) noexcept {
+    constexpr uint64_t kMax = (uint64_t{ 1 } << kMaxBits) - 1;
+    if (v > kMax) v = kMax;
+    int width = 0;
+    for (uint64_t x = v >> kSubBits; x; x >>= 1) ++width;   // bits above the sub-bucket range
+    int e = width > 1 ? width - 1 : 0;
+    return (static_cast<size_t>(e) << kSubBits) + static_cast<size_t>(v >> e);
+}
+
+uint64_t LatencyHistogram::BucketHigh(size_t bucket) noexcept {
+    size_t   e = bucket < (2u << kSubBits) ? 0 : (bucket >> kSubBits) - 1;
+    uint64_t m = bucket - (e << kSubBits);
+    return ((m + 1) << e) - 1;
+}
+
+void LatencyHistogram::Merge(const LatencyHistogram& other) noexcept {
+    for (size_t b = 0; b < kBuckets; ++b) {
+        uint64_t n = other.CountAt(b);
+        if (n) Bump(m_counts[b], n);
+    }
+    Bump(m_count, other.Count());
+    Bump(m_sum, other.Sum());
+    if (other.Max() > Max()) m_max.store(other.Max(), std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::Percentile(double q) const noexcept {
+    uint64_t total = Count();
+    if (total == 0) return 0;
+    uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(total) + 0.5);
+    if (rank < 1)     rank = 1;
+    if (rank > total) rank = total;
+    uint64_t seen = 0;
+    for (size_t b = 0; b < kBuckets; ++b) {
+        seen += CountAt(b);
+        if (seen >= rank) return std::min(BucketHigh(b), Max());
+    }
+    return Max();
+}
+
+namespace detail {
+
+constinit thread_local LatencyRequest t_latency;
+std::atomic<bool> g_latencyEnabled{ true };
+
+void LatencyBegin(LatencyRequest& r) noexcept {
+    r.active  = true;
+    r.command = static_cast<uint8_t>(Command::UNKNOWN);
+    r.adapter = 0;
+    r.marked  = 0;
+    r.start   = r.last = Ticks();
+}
+
+void LatencyEnd(LatencyRequest& r) noexcept {
+    uint64_t now = Ticks();
+    r.active = false;
+    try {
+        if (!r.shard) r.shard = &LocalShard();
+        Shard&   shard = *static_cast<Shard*>(r.shard);
+        uint32_t left  = r.marked;
+        while (left) {
+            int s = std::countr_zero(left);
+            left &= left - 1;
+            Record(shard, KeyOf(static_cast<Stage>(s), r.command, r.adapter), r.ticks[s]);
+        }
+        Record(shard, KeyOf(Stage::Total, r.command, r.adapter), now - r.start);
+    }
+    catch (...) {}
+}
+
+void LatencyMark(LatencyRequest& r, Stage s) noexcept {
+    uint64_t now = Ticks();
+    size_t   i   = static_cast<size_t>(s);
+    uint8_t  bit = static_cast<uint8_t>(1u << i);
+    r.ticks[i] = (r.marked & bit) ? r.ticks[i] + (now - r.last) : now - r.last;
+    r.marked  |= bit;
+    r.last     = now;
+}
+
+} // namespace detail
+
+void LatencySetEnabled(bool enabled) noexcept {
+    detail::g_latencyEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool LatencyEnabled() noexcept {
+    return detail::g_latencyEnabled.load(std::memory_order_relaxed);
+}
+
+uint8_t LatencyAdapterId(std::string_view name) noexcept {
+    try {
+        Registry& r = GetRegistry();
+        std::lock_guard<std::mutex> lk(r.mutex);
+        for (size_t i = 1; i < r.adapters.size(); ++i)
+            if (r.adapters[i] == name) return static_cast<uint8_t>(i);
+        if (r.adapters.size() + 1 < kLatencyAdapters) {
+            r.adapters.emplace_back(name);
+        } else if (r.adapters.size() + 1 == kLatencyAdapters) {
+            r.adapters.emplace_back("OTHER");
+        }
+        return static_cast<uint8_t>(r.adapters.size() - 1);
+    }
+    catch (...) {
+        return 0;
+    }
+}
+
+LatencySummary LatencyQuery(Stage s, uint8_t command, std::string_view adapter) {
+    std::vector<std::string> adapters;
+    auto merged = MergeAll(adapters);
+    for (size_t a = 0; a < adapters.size(); ++a) {
+        if (adapters[a] != adapter) continue;
+        auto it = merged.find(KeyOf(s, command, static_cast<uint8_t>(a)));
+        if (it != merged.end()) return Summarise(*it->second, TicksPerNs());
+    }
+    return {};
+}
+
+std::string LatencyReport() {
+    std::vector<std::string> adapters;
+    auto merged = MergeAll(adapters);
+    if (merged.empty()) return {};
+
+    double      ticksPerNs = TicksPerNs();
+    std::string out;
+    char        line[160];
+    std::snprintf(line, sizeof(line), "%-17s %-12s %-9s %10s %9s %9s %9s %10s\n",
+                  "command", "adapter", "stage", "count", "p50_ns", "p99_ns", "p999_ns", "max_ns");
+    out += line;
+    for (const auto& [key, hist] : merged) {
+        size_t   stage   = key % kStages;
+        uint8_t  adapter = static_cast<uint8_t>(key / kStages % kLatencyAdapters);
+        uint8_t  command = static_cast<uint8_t>(key / kStages / kLatencyAdapters);
+        LatencySummary s = Summarise(*hist, ticksPerNs);
+        std::snprintf(line, sizeof(line), "%-17s %-12s %-9s %10llu %9llu %9llu %9llu %10llu\n",
+                      CommandName(command),
+                      adapter < adapters.size() ? adapters[adapter].c_str() : "?",
+                      StageName(static_cast<Stage>(stage)),
+                      static_cast<unsigned long long>(s.count), static_cast<unsigned long long>(s.p50),
+                      static_cast<unsigned long long>(s.p99), static_cast<unsigned long long>(s.p999),
+                      static_cast<unsigned long long>(s.max));
+        out += line;
+    }
+    return out;
+}
+
+uint64_t LatencyStageBuckets(Stage s, uint64_t* buckets, uint64_t& sumTicks, uint64_t& maxTicks) noexcept {
+    try {
+        uint64_t  count = 0;
+        Registry& r     = GetRegistry();
+        std::lock_guard<std::mutex> lk(r.mutex);
+        for (const auto& shard : r.shards) {
+            for (size_t key = static_cast<size_t>(s); key < kKeys; key += kStages) {
+                const LatencyHistogram* h = shard->hist[key].load(std::memory_order_acquire);
+                if (!h || h->Count() == 0) continue;
+                for (size_t b = 0; b < LatencyHistogram::kBuckets; ++b) buckets[b] += h->CountAt(b);
+                count    += h->Count();
+                sumTicks += h->Sum();
+                maxTicks  = std::max(maxTicks, h->Max());
+            }
+        }
+        return count;
+    }
+    catch (...) {
+        return 0;
+    }
+}
+
+double LatencyTicksPerNs() noexcept {
+    try {
+        return TicksPerNs();
+    }
+    catch (...) {
+        return 1.0;
+    }
+}
+
+int LatencyReport(char* buffer, int capacity) noexcept {
+    try {
+        std::string report = LatencyReport();
+        if (buffer && capacity > 0) {
+            size_t n = std::min(report.size(), static_cast<size_t>(capacity) - 1);
+            std::memcpy(buffer, report.data(), n);
+            buffer[n] = '\0';
+        }
+        return static_cast<int>(report.size());
+    }
+    catch (...) {
+        if (buffer && capacity > 0) buffer[0] = '\0';
+        return 0;
+    }
+}
+
+} // namespace Bridge
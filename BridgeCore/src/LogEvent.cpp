@@ -0,0 +1,91 @@
+#include "LogEvent.h"
+#include <charconv>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+namespace Bridge {
+
+namespace {
+
+// Render the argument at 'pos' and step past it; "?" if there is none.
+std::string_view NextArg(const unsigned char* args, size_t size, size_t& pos, char (&buf)[32]) {
+    if (pos >= size) return "?";
+    auto type = static_cast<LogArgType>(args[pos]);
+    if (type == LogArgType::Str) {
+        if (pos + 2 > size || pos + 2 + args[pos + 1] > size) { pos = size; return "?"; }
+        std::string_view s(reinterpret_cast<const char*>(args + pos + 2), args[pos + 1]);
+        pos += 2 + s.size();
+        return s;
+    }
+    if (pos + 9 > size) { pos = size; return "?"; }
+    std::to_chars_result r{ buf, std::errc{} };
+    if (type == LogArgType::Int) {
+        int64_t v;
+        std::memcpy(&v, args + pos + 1, 8);
+        r = std::to_chars(buf, buf + sizeof(buf), v);
+    } else if (type == LogArgType::UInt) {
+        uint64_t v;
+        std::memcpy(&v, args + pos + 1, 8);
+        r = std::to_chars(buf, buf + sizeof(buf), v);
+    } else if (type == LogArgType::Double) {
+        double v;
+        std::memcpy(&v, args + pos + 1, 8);
+        r = std::to_chars(buf, buf + sizeof(buf), v);
+    } else {
+        pos = size;
+        return "?";
+    }
+    pos += 9;
+    return r.ec == std::errc{} ? std::string_view(buf, static_cast<size_t>(r.ptr - buf)) : "?";
+}
+
+} // anonymous namespace
+
+void FormatLogEvent(std::string& out, const char* format, const unsigned char* args, size_t size) {
+    std::string_view fmt(format);
+    size_t pos = 0;
+    char   buf[32];
+    for (;;) {
+        size_t open = fmt.find('{');
+        size_t close = (open == std::string_view::npos) ? open : fmt.find('}', open);
+        if (close == std::string_view::npos) {
+            out.append(fmt);
+            return;
+        }
+        out.append(fmt.substr(0, open));
+
+        // "{}" or "{:N}" / "{:0N}": right-align in N columns, zero-filled
+        // for numbers when N has a leading 0.
+        std::string_view spec = fmt.substr(open + 1, close - open - 1);
+        bool   zero  = false;
+        size_t width = 0;
+        if (!spec.empty()) {
+            if (spec[0] != ':') {                      // not a placeholder
+                out.append(fmt.substr(open, close - open + 1));
+                fmt.remove_prefix(close + 1);
+                continue;
+            }
+            spec.remove_prefix(1);
+            zero = !spec.empty() && spec[0] == '0';
+            std::from_chars(spec.data(), spec.data() + spec.size(), width);
+        }
+
+        bool isNumber = pos < size && static_cast<LogArgType>(args[pos]) != LogArgType::Str;
+        std::string_view text = NextArg(args, size, pos, buf);
+        if (text.size() < width) {
+            size_t pad = width - text.size();
+            if (zero && isNumber) {
+                bool negative = !text.empty() && text[0] == '-';
+                if (negative) { out.push_back('-'); text.remove_prefix(1); }
+                out.append(pad, '0');
+            } else {
+                out.append(pad, ' ');
+            }
+        }
+        out.append(text);
+        fmt.remove_prefix(close + 1);
+    }
+}
+
+} // namespace Bridge
@@ -0,0 +1,234 @@
+#include "LogFile.h"
+#include "BinaryLog.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <system_error>
+#include <utility>
+
+namespace fs = std::filesystem;
+
+namespace Bridge {
+
+namespace {
+
+constexpr size_t kGrowBytes  = 16 * 1024 * 1024;           // mapping growth when there is no size limit
+constexpr size_t kStampLen   = 15;                         // yyyymmdd-hhmmss
+constexpr auto   kRetryDelay = std::chrono::seconds(30);   // after a failed rename (e.g. file held open)
+
+// "<dir>/<stem>.<middle><ext>"
+std::string SiblingPath(const fs::path& live, const std::string& middle) {
+    fs::path p = live;
+    p.replace_filename(live.stem().string() + "." + middle + live.extension().string());
+    return p.string();
+}
+
+// The stamp (and collision counter) of an archived segment's name, or -1
+// if 'name' is not one.
+long long ArchiveOrder(const std::string& name, const std::string& prefix, const std::string& ext,
+                       std::string& stamp) {
+    if (name.size() < prefix.size() + kStampLen + ext.size() ||
+        name.compare(0, prefix.size(), prefix) != 0 ||
+        name.compare(name.size() - ext.size(), ext.size(), ext) != 0)
+        return -1;
+    std::string mid = name.substr(prefix.size(), name.size() - prefix.size() - ext.size());
+    for (size_t i = 0; i < kStampLen; ++i) {
+        bool ok = (i == 8) ? mid[i] == '-' : std::isdigit(static_cast<unsigned char>(mid[i])) != 0;
+        if (!ok) return -1;
+    }
+    stamp = mid.substr(0, kStampLen);
+    if (mid.size() == kStampLen) return 0;
+    if (mid[kStampLen] != '-' || mid.size() == kStampLen + 1) return -1;
+    for (size_t i = kStampLen + 1; i < mid.size(); ++i)
+        if (!std::isdigit(static_cast<unsigned char>(mid[i]))) return -1;
+    return std::atoll(mid.c_str() + kStampLen + 1);
+}
+
+// Bytes of real content in a mapped segment: complete binary records, or
+// text up to the zero tail.
+size_t ContentLength(const char* data, size_t size, bool binary) noexcept {
+    if (binary) {
+        size_t valid = BinaryLog::ValidLength(data, size);
+        if (valid > 0 || size == 0 || data[0] == 0) return valid;
+        return size;   // not a binary log: append after it rather than overwrite it
+    }
+    while (size > 0 && data[size - 1] == 0) --size;
+    return size;
+}
+
+} // anonymous namespace
+
+bool LogFile::Open(const Options& options) noexcept {
+    Close();
+    try {
+        m_opts    = options;
+        m_retryAt = {};
+        m_mapped  = options.segmentBytes > 0 || options.rotateMinutes > 0;
+        fs::path p(options.path);
+        if (p.has_parent_path()) fs::create_directories(p.parent_path());
+
+        if (!m_mapped) {
+            std::error_code ec;
+            auto size = fs::exists(p, ec) ? fs::file_size(p, ec) : 0;
+            m_used = ec ? 0 : static_cast<size_t>(size);
+            m_stream.open(p, options.binary ? std::ios::app | std::ios::binary : std::ios::app);
+            return m_stream.is_open();
+        }
+
+        m_next = SiblingPath(p, "next");
+        if (!MapLive()) return false;
+        PrepareNext();
+        if (m_opts.segmentBytes > 0 && m_used >= m_opts.segmentBytes) Rotate();
+        return m_map.IsOpen();
+    }
+    catch (...) {
+        Close();
+        return false;
+    }
+}
+
+void LogFile::Close() noexcept {
+    if (m_stream.is_open()) m_stream.close();
+    if (m_map.IsOpen()) m_map.Close(m_used);
+    if (m_mapped && !m_next.empty()) {
+        std::error_code ec;
+        fs::remove(m_next, ec);
+    }
+    m_next.clear();
+    m_mapped = false;
+    m_used   = 0;
+}
+
+void LogFile::Write(const char* data, size_t size) {
+    if (!m_mapped) {
+        if (!m_stream.is_open()) return;
+        m_stream.write(data, static_cast<std::streamsize>(size));
+        m_used += size;
+        return;
+    }
+    if (!m_map.IsOpen()) return;
+    if (m_used + size > m_map.Size() &&
+        !m_map.Resize(std::max(m_map.Size() + kGrowBytes, m_used + size)))
+        return;
+    std::memcpy(m_map.Data() + m_used, data, size);
+    m_used += size;
+}
+
+void LogFile::Flush() noexcept {
+    try {
+        if (m_mapped) m_map.Flush();
+        else if (m_stream.is_open()) m_stream.flush();
+    }
+    catch (...) {}
+}
+
+bool LogFile::SizeDue(size_t pending) const noexcept {
+    return m_mapped && m_opts.segmentBytes > 0 && m_used + pending > m_opts.segmentBytes &&
+           std::chrono::steady_clock::now() >= m_retryAt;
+}
+
+bool LogFile::AgeDue() const noexcept {
+    if (!m_mapped || m_opts.rotateMinutes <= 0 || m_used == 0) return false;
+    auto now = std::chrono::steady_clock::now();
+    return now - m_opened >= std::chrono::minutes(m_opts.rotateMinutes) && now >= m_retryAt;
+}
+
+bool LogFile::Rotate() noexcept {
+    if (!m_mapped) return false;
+    try {
+        m_map.Close(m_used);
+
+        std::time_t t = std::time(nullptr);
+        struct tm tm_info;
+#ifdef _WIN32
+        localtime_s(&tm_info, &t);
+#else
+        localtime_r(&t, &tm_info);
+#endif
+        char stamp[32];
+        std::strftime(stamp, sizeof(stamp), "%Y%m%d-%H%M%S", &tm_info);
+        fs::path    live(m_opts.path);
+        std::string archive = SiblingPath(live, stamp);
+        for (int n = 1; fs::exists(archive); ++n)
+            archive = SiblingPath(live, std::string(stamp) + "-" + std::to_string(n));
+
+        std::error_code ec;
+        fs::rename(live, archive, ec);
+        bool rotated = !ec;
+        if (!rotated) m_retryAt = std::chrono::steady_clock::now() + kRetryDelay;
+        if (rotated && !m_next.empty()) {
+            fs::rename(m_next, live, ec);   // on failure MapLive preallocates a new one
+        }
+        auto opened = m_opened;
+        if (!MapLive()) return false;
+        if (!rotated) m_opened = opened;   // still the same segment
+        if (rotated) {
+            PrepareNext();
+            Prune();
+        }
+        return rotated;
+    }
+    catch (...) {
+        return false;
+    }
+}
+
+std::vector<std::string> LogFile::ArchivedSegments(const std::string& path) {
+    fs::path    live(path);
+    fs::path    dir    = live.has_parent_path() ? live.parent_path() : fs::path(".");
+    std::string prefix = live.stem().string() + ".";
+    std::string ext    = live.extension().string();
+
+    std::vector<std::pair<std::pair<std::string, long long>, std::string>> found;
+    std::error_code ec;
+    for (fs::directory_iterator it(dir, ec), end; !ec && it != end; it.increment(ec)) {
+        std::string stamp;
+        long long   order = ArchiveOrder(it->path().filename().string(), prefix, ext, stamp);
+        if (order >= 0) found.push_back({ { stamp, order }, it->path().string() });
+    }
+    std::sort(found.begin(), found.end());
+    std::vector<std::string> out;
+    out.reserve(found.size());
+    for (auto& f : found) out.push_back(std::move(f.second));
+    return out;
+}
+
+// Map the live file, preallocating it first, and find where its content
+// ends.
+bool LogFile::MapLive() noexcept {
+    MappedFile::Preallocate(m_opts.path, Reserve());   // best effort: Open still sizes it
+    if (!m_map.Open(m_opts.path, MappedFile::Mode::ReadWrite, Reserve())) return false;
+    m_used   = ContentLength(m_map.Data(), m_map.Size(), m_opts.binary);
+    m_opened = std::chrono::steady_clock::now();
+    return true;
+}
+
+void LogFile::PrepareNext() noexcept {
+    if (m_next.empty()) return;
+    if (!MappedFile::Preallocate(m_next, Reserve())) {
+        std::error_code ec;
+        fs::remove(m_next, ec);
+    }
+}
+
+void LogFile::Prune() noexcept {
+    if (m_opts.keepSegments <= 0) return;
+    try {
+        std::vector<std::string> archived = ArchivedSegments(m_opts.path);
+        size_t keep = static_cast<size_t>(m_opts.keepSegments);
+        for (size_t i = 0; i + keep < archived.size(); ++i) {
+            std::error_code ec;
+            fs::remove(archived[i], ec);
+        }
+    }
+    catch (...) {}
+}
+
+size_t LogFile::Reserve() const noexcept {
+    return m_opts.segmentBytes > 0 ? m_opts.segmentBytes : kGrowBytes;
+}
+
+} // namespace Bridge
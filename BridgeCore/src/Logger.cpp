@@ -1,37 +1,330 @@
 #include "Logger.h"
-#include <fstream>
-#include <iostream>
-#include <mutex>
-#include <string>
+#include "BinaryLog.h"
+#include "BoundedQueue.h"
+#include "LogEvent.h"
+#include "LogFile.h"
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <condition_variable>
 #include <ctime>
 #include <filesystem>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
 
 namespace Bridge {
 
-static std::mutex    g_logMutex;
-static std::ofstream g_logFile;
-static bool          g_logToConsole = false;
+namespace {
 
-static std::string CurrentTimestamp() noexcept {
-    try {
-        auto now  = std::chrono::system_clock::now();
-        std::time_t t = std::chrono::system_clock::to_time_t(now);
-        char buf[32] = {};
+// A plain line ('text') or a structured statement ('format' + packed args).
+struct LogRecord {
+    int64_t          timeNs  = 0;   // steady_clock, taken by the caller
+    LogLevel         level   = LogLevel::INFO;
+    const LogFormat* format  = nullptr;
+    uint8_t          argSize = 0;
+    unsigned char    args[kLogArgBytes];
+    std::string      text;
+};
+
+int64_t SteadyNs() noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+int64_t WallNs() noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+constexpr size_t  kBatchBytes   = 64 * 1024;   // write out once this much is formatted
+constexpr int64_t kAnchorSlack  = 1000000;     // re-anchor a binary log once the clocks drift 1 ms
+
+// Callers push records into a lock-free MPSC ring (BoundedQueue with one
+// consumer); the writer thread drains it, formats the lines into one buffer
+// (as text, or as BinaryLog records) and hands that to the stream in a
+// single write. The writer sleeps for the flush interval between drains and
+// is woken early by an ERROR line, a full queue or every quarter-queue of
+// lines, so a burst does not overflow it.
+//
+// Segment rotation (LogFile) also happens on the writer thread, between
+// batches, so it never holds up a caller.
+class LogWriter {
+public:
+    explicit LogWriter(size_t depth)
+        : m_queue(std::max<size_t>(depth, 16)),
+          m_wakeEvery(std::max<size_t>(m_queue.Capacity() / 4, 1)),
+          m_thread([this] { Run(); })
+    {
+    }
+
+    ~LogWriter() {
+        m_stop.store(true, std::memory_order_release);
+        Wake();
+        if (m_thread.joinable()) m_thread.join();
+        std::lock_guard<std::mutex> lk(m_fileMutex);
+        DrainLocked(true);
+    }
+
+    LogWriter(const LogWriter&) = delete;
+    LogWriter& operator=(const LogWriter&) = delete;
+
+    void Configure(const LogOptions& o) {
+        std::lock_guard<std::mutex> lk(m_fileMutex);
+        DrainLocked(true);                       // queued lines belong to the old file
+        m_file.Close();
+        m_binary  = o.binary;
+        m_console = o.toConsole && !m_binary;
+        if (!o.filePath.empty()) {
+            std::filesystem::path p(o.filePath);
+            if (m_binary) p.replace_extension(".blog");
+            LogFile::Options fo;
+            fo.path          = p.string();
+            fo.segmentBytes  = o.segmentBytes;
+            fo.rotateMinutes = o.rotateMinutes;
+            fo.keepSegments  = o.keepSegments;
+            fo.binary        = m_binary;
+            if (m_file.Open(fo)) StartSegment();
+        }
+        m_flushMs.store(std::max(o.flushIntervalMs, 1), std::memory_order_relaxed);
+        m_block.store(o.blockWhenFull, std::memory_order_relaxed);
+    }
+
+    void Push(LogRecord&& r) noexcept {
+        bool urgent = (r.level == LogLevel::ERROR_);
+        while (!m_queue.TryPush(std::move(r))) {
+            Wake();
+            if (!m_block.load(std::memory_order_relaxed) || m_stop.load(std::memory_order_acquire)) {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            std::this_thread::yield();
+        }
+        uint64_t n = m_pushed.fetch_add(1, std::memory_order_relaxed) + 1;
+        if (urgent || n % m_wakeEvery == 0) Wake();
+    }
+
+    void Flush() noexcept {
+        std::lock_guard<std::mutex> lk(m_fileMutex);
+        DrainLocked(true);
+    }
+
+    uint64_t Dropped() const noexcept { return m_dropped.load(std::memory_order_relaxed); }
+    size_t   Queued()  const noexcept { return m_queue.SizeApprox(); }
+
+private:
+    void Wake() noexcept {
+        {
+            std::lock_guard<std::mutex> lk(m_wakeMutex);
+            m_signal = true;
+        }
+        m_wake.notify_one();
+    }
+
+    void Run() noexcept {
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lk(m_wakeMutex);
+                m_wake.wait_for(lk, std::chrono::milliseconds(m_flushMs.load(std::memory_order_relaxed)),
+                                [this] { return m_signal; });
+                m_signal = false;
+            }
+            bool stopping = m_stop.load(std::memory_order_acquire);
+            {
+                std::lock_guard<std::mutex> lk(m_fileMutex);
+                DrainLocked(false);
+            }
+            if (stopping) break;
+        }
+    }
+
+    // Write out everything queued; flush if asked to, if an ERROR line went
+    // out, or if the flush interval has passed. Caller holds m_fileMutex.
+    void DrainLocked(bool flush) noexcept {
+        try {
+            m_wallOffset = WallNs() - SteadyNs();
+            if (m_file.AgeDue()) RotateFile();
+            if (m_binary && m_file.IsOpen() &&
+                std::abs(m_wallOffset - m_anchorOffset) > kAnchorSlack)
+                WriteAnchor();
+
+            LogRecord r;
+            while (m_queue.TryPop(r)) {
+                flush |= (r.level == LogLevel::ERROR_);
+                Emit(r);
+                if (m_batch.size() >= kBatchBytes) WriteBatch();
+            }
+            uint64_t dropped = m_dropped.load(std::memory_order_relaxed);
+            if (dropped != m_droppedReported) {
+                r.timeNs = SteadyNs();
+                r.level  = LogLevel::WARNING_;
+                r.format = nullptr;
+                r.text   = "Log queue full: " + std::to_string(dropped - m_droppedReported) + " line(s) dropped";
+                Emit(r);
+                m_droppedReported = dropped;
+            }
+            WriteBatch();
+
+            auto now = std::chrono::steady_clock::now();
+            if (m_dirty && (flush || now - m_lastFlush >= std::chrono::milliseconds(m_flushMs.load()))) {
+                m_file.Flush();
+                if (m_console) std::cout.flush();
+                m_dirty     = false;
+                m_lastFlush = now;
+            }
+        }
+        catch (...) {
+            m_batch.clear();
+        }
+    }
+
+    // Format 'r' into the batch. If that takes the segment past its size
+    // limit, the segment is cut before 'r' and 'r' starts the next one
+    // (formatted again: a new binary segment has its own format ids).
+    void Emit(const LogRecord& r) {
+        size_t mark = m_batch.size();
+        Append(r);
+        if (m_file.SizeDue(m_batch.size()) && (mark > 0 || m_file.Used() > 0)) {
+            m_batch.resize(mark);
+            RotateFile();
+            Append(r);
+        }
+    }
+
+    void Append(const LogRecord& r) {
+        if (!m_binary) {
+            AppendPrefix(r.timeNs + m_wallOffset, r.level);
+            if (r.format) FormatLogEvent(m_batch, r.format->Text(), r.args, r.argSize);
+            else          m_batch.append(r.text);
+            m_batch.push_back('\n');
+        } else if (!r.format) {
+            BinaryLog::AppendText(m_batch, r.timeNs, r.level, r.text);
+        } else {
+            auto it = m_formatIds.find(r.format);
+            if (it == m_formatIds.end()) {
+                if (m_formatIds.size() >= UINT16_MAX) WriteAnchor();   // out of ids: start over
+                uint16_t id = static_cast<uint16_t>(m_formatIds.size() + 1);
+                it = m_formatIds.emplace(r.format, id).first;
+                BinaryLog::AppendFormat(m_batch, id, r.format->Text());
+            }
+            BinaryLog::AppendEvent(m_batch, r.timeNs, r.level, it->second, r.args, r.argSize);
+        }
+    }
+
+    // An anchor also retires the formats sent so far (see BinaryLog.h).
+    void WriteAnchor() {
+        m_wallOffset   = WallNs() - SteadyNs();
+        m_anchorOffset = m_wallOffset;
+        int64_t steady = SteadyNs();
+        BinaryLog::AppendAnchor(m_batch, steady + m_wallOffset, steady);
+        m_formatIds.clear();
+    }
+
+    void RotateFile() {
+        WriteBatch();
+        if (m_file.Rotate())  StartSegment();
+        else if (m_binary)    WriteAnchor();   // Emit may have dropped a format record it numbered
+    }
+
+    // A binary segment starts with the header (unless it is being continued)
+    // and an anchor, so each segment decodes on its own.
+    void StartSegment() {
+        if (!m_binary) return;
+        if (m_file.Used() == 0) m_batch.append(BinaryLog::kMagic, sizeof(BinaryLog::kMagic));
+        WriteAnchor();
+        WriteBatch();
+    }
+
+    void AppendPrefix(int64_t wallNs, LogLevel level) {
+        int64_t sec = wallNs / 1000000000;
+        if (sec != m_stampSec) {
+            std::time_t t = static_cast<std::time_t>(sec);
+            struct tm tm_info;
 #ifdef _WIN32
-        struct tm tm_info;
-        localtime_s(&tm_info, &t);
-        std::strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S", &tm_info);
+            localtime_s(&tm_info, &t);
 #else
-        struct tm* tm_info = std::localtime(&t);
-        std::strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S", tm_info);
+            localtime_r(&t, &tm_info);
 #endif
-        return buf;
+            std::strftime(m_stamp, sizeof(m_stamp), "%Y-%m-%d %H:%M:%S", &tm_info);
+            m_stampSec = sec;
+        }
+        m_batch.append("[").append(m_stamp).append("] [").append(LogLevelName(level)).append("] ");
+    }
+
+    void WriteBatch() {
+        if (m_batch.empty()) return;
+        m_file.Write(m_batch.data(), m_batch.size());
+        if (m_console)        std::cout.write(m_batch.data(), static_cast<std::streamsize>(m_batch.size()));
+        m_batch.clear();
+        m_dirty = true;
     }
-    catch (...) { return "0000-00-00 00:00:00"; }
+
+    BoundedQueue<LogRecord> m_queue;
+    const size_t            m_wakeEvery;
+    std::atomic<uint64_t>   m_pushed{ 0 };
+    std::atomic<uint64_t>   m_dropped{ 0 };
+    std::atomic<bool>       m_block{ false };
+    std::atomic<bool>       m_stop{ false };
+    std::atomic<int>        m_flushMs{ 200 };
+
+    std::mutex              m_wakeMutex;
+    std::condition_variable m_wake;
+    bool                    m_signal = false;   // guarded by m_wakeMutex
+
+    // Guarded by m_fileMutex.
+    std::mutex    m_fileMutex;
+    LogFile       m_file;
+    bool          m_console = false;
+    bool          m_binary  = false;
+    // Binary: ids of the formats written since the last anchor.
+    std::unordered_map<const LogFormat*, uint16_t> m_formatIds;
+    int64_t       m_wallOffset   = 0;       // system_clock - steady_clock, refreshed per drain
+    int64_t       m_anchorOffset = 0;       // the offset in the last anchor written
+    std::string   m_batch;
+    bool          m_dirty = false;
+    uint64_t      m_droppedReported = 0;
+    int64_t       m_stampSec = -1;
+    char          m_stamp[32] = {};
+    std::chrono::steady_clock::time_point m_lastFlush{};
+
+    std::thread   m_thread;   // last, so it starts after everything above exists
+};
+
+std::atomic<LogWriter*> g_writer{ nullptr };
+std::mutex              g_initMutex;
+
+// Owns the writer for the life of the process. Created by the first LogInit,
+// so it outlives any engine that initialised logging, and unpublished before
+// the writer is torn down.
+struct LogWriterOwner {
+    std::unique_ptr<LogWriter> writer;
+    ~LogWriterOwner() {
+        g_writer.store(nullptr, std::memory_order_release);
+        writer.reset();
+    }
+};
+
+LogWriterOwner& Owner() {
+    static LogWriterOwner owner;
+    return owner;
+}
+
+} // anonymous namespace
+
+namespace detail {
+std::atomic<int> g_logMinLevel{ static_cast<int>(LogLevel::INFO) };
+}
+
+void LogSetLevel(LogLevel level) noexcept {
+    detail::g_logMinLevel.store(static_cast<int>(level), std::memory_order_relaxed);
 }
 
-static const char* LevelStr(LogLevel level) noexcept {
+const char* LogLevelName(LogLevel level) noexcept {
     switch (level) {
         case LogLevel::DEBUG_:   return "DEBUG";
         case LogLevel::INFO:     return "INFO ";
@@ -41,32 +334,74 @@ static const char* LevelStr(LogLevel level) noexcept {
     }
 }
 
-void LogInit(const std::string& filePath, bool logToConsole) noexcept {
+void LogInit(const LogOptions& options) noexcept {
     try {
-        std::lock_guard<std::mutex> lk(g_logMutex);
-        g_logToConsole = logToConsole;
-        if (!filePath.empty()) {
-            // Create parent directories if needed
-            std::filesystem::path p(filePath);
-            if (p.has_parent_path())
-                std::filesystem::create_directories(p.parent_path());
-            g_logFile.open(filePath, std::ios::app);
-        }
+        std::lock_guard<std::mutex> lk(g_initMutex);
+        LogWriterOwner& owner = Owner();
+        if (!owner.writer) owner.writer = std::make_unique<LogWriter>(options.queueDepth);
+        owner.writer->Configure(options);
+        LogSetLevel(options.minLevel);
+        g_writer.store(owner.writer.get(), std::memory_order_release);
     }
     catch (...) {}
 }
 
-void Log(LogLevel level, const std::string& message) noexcept {
+void LogShutdown() noexcept {
+    try {
+        std::lock_guard<std::mutex> lk(g_initMutex);
+        LogWriterOwner& owner = Owner();
+        g_writer.store(nullptr, std::memory_order_release);
+        owner.writer.reset();
+    }
+    catch (...) {}
+}
+
+void LogInit(const std::string& filePath, bool logToConsole) noexcept {
     try {
-        std::string line = "[" + CurrentTimestamp() + "] [" +
-                           LevelStr(level) + "] " + message + "\n";
-        std::lock_guard<std::mutex> lk(g_logMutex);
-        if (g_logFile.is_open())
-            g_logFile << line << std::flush;
-        if (g_logToConsole)
-            std::cout << line << std::flush;
+        LogOptions o;
+        o.filePath  = filePath;
+        o.toConsole = logToConsole;
+        LogInit(o);
     }
     catch (...) {}
 }
 
+void Log(LogLevel level, std::string message) noexcept {
+    if (!LogEnabled(level)) return;
+    LogWriter* w = g_writer.load(std::memory_order_acquire);
+    if (!w) return;
+    LogRecord r;
+    r.timeNs = SteadyNs();
+    r.level  = level;
+    r.text   = std::move(message);
+    w->Push(std::move(r));
+}
+
+void LogPacked(LogLevel level, const LogFormat& format, const LogArgs& args) noexcept {
+    if (!LogEnabled(level)) return;
+    LogWriter* w = g_writer.load(std::memory_order_acquire);
+    if (!w) return;
+    LogRecord r;
+    r.timeNs  = SteadyNs();
+    r.level   = level;
+    r.format  = &format;
+    r.argSize = args.size;
+    std::memcpy(r.args, args.bytes, args.size);
+    w->Push(std::move(r));
+}
+
+void LogFlush() noexcept {
+    if (LogWriter* w = g_writer.load(std::memory_order_acquire)) w->Flush();
+}
+
+uint64_t LogDropped() noexcept {
+    LogWriter* w = g_writer.load(std::memory_order_acquire);
+    return w ? w->Dropped() : 0;
+}
+
+size_t LogQueued() noexcept {
+    LogWriter* w = g_writer.load(std::memory_order_acquire);
+    return w ? w->Queued() : 0;
+}
+
 } // namespace Bridge
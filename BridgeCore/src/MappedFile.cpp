@@ -0,0 +1,188 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Bridge {
+
+MappedFile::~MappedFile() {
+    Close();
+}
+
+#ifdef _WIN32
+
+bool MappedFile::Open(const std::string& path, Mode mode, size_t minSize) noexcept {
+    Close();
+    m_mode = mode;
+    bool rw = (mode == Mode::ReadWrite);
+    HANDLE f = CreateFileA(path.c_str(),
+                           rw ? (GENERIC_READ | GENERIC_WRITE) : GENERIC_READ,
+                           FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+                           rw ? OPEN_ALWAYS : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (f == INVALID_HANDLE_VALUE) return false;
+    m_file = f;
+
+    LARGE_INTEGER len;
+    if (!GetFileSizeEx(f, &len)) { Close(); return false; }
+    m_size = static_cast<size_t>(len.QuadPart);
+    if (rw && m_size < minSize) return Resize(minSize);
+    if (!Map()) { Close(); return false; }
+    return true;
+}
+
+bool MappedFile::Map() noexcept {
+    if (m_size == 0) return false;
+    bool rw = (m_mode == Mode::ReadWrite);
+    LARGE_INTEGER len;
+    len.QuadPart = static_cast<LONGLONG>(m_size);
+    HANDLE mapping = CreateFileMappingA(static_cast<HANDLE>(m_file), nullptr,
+                                        rw ? PAGE_READWRITE : PAGE_READONLY,
+                                        static_cast<DWORD>(len.HighPart), len.LowPart, nullptr);
+    if (!mapping) return false;
+    void* view = MapViewOfFile(mapping, rw ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, m_size);
+    if (!view) {
+        CloseHandle(mapping);
+        return false;
+    }
+    m_mapping = mapping;
+    m_data    = static_cast<char*>(view);
+    return true;
+}
+
+void MappedFile::Unmap() noexcept {
+    if (m_data)    UnmapViewOfFile(m_data);
+    if (m_mapping) CloseHandle(static_cast<HANDLE>(m_mapping));
+    m_data    = nullptr;
+    m_mapping = nullptr;
+}
+
+bool MappedFile::Resize(size_t size) noexcept {
+    if (!m_file || m_mode != Mode::ReadWrite || size == 0) return false;
+    Unmap();
+    LARGE_INTEGER len;
+    len.QuadPart = static_cast<LONGLONG>(size);
+    if (!SetFilePointerEx(static_cast<HANDLE>(m_file), len, nullptr, FILE_BEGIN) ||
+        !SetEndOfFile(static_cast<HANDLE>(m_file))) {
+        Close();
+        return false;
+    }
+    m_size = size;
+    if (!Map()) { Close(); return false; }
+    return true;
+}
+
+bool MappedFile::Preallocate(const std::string& path, size_t size) noexcept {
+    HANDLE f = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE,
+                           FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+                           OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (f == INVALID_HANDLE_VALUE) return false;
+    FILE_ALLOCATION_INFO alloc;
+    alloc.AllocationSize.QuadPart = static_cast<LONGLONG>(size);
+    bool ok = SetFileInformationByHandle(f, FileAllocationInfo, &alloc, sizeof(alloc)) != 0;
+    LARGE_INTEGER len;
+    if (ok && GetFileSizeEx(f, &len) && static_cast<size_t>(len.QuadPart) < size) {
+        FILE_END_OF_FILE_INFO eof;
+        eof.EndOfFile.QuadPart = static_cast<LONGLONG>(size);
+        ok = SetFileInformationByHandle(f, FileEndOfFileInfo, &eof, sizeof(eof)) != 0;
+    }
+    CloseHandle(f);
+    return ok;
+}
+
+void MappedFile::Flush() noexcept {
+    if (m_data) FlushViewOfFile(m_data, 0);
+}
+
+void MappedFile::Close(size_t finalSize) noexcept {
+    bool cut = m_file && m_mode == Mode::ReadWrite && finalSize < m_size;
+    Unmap();
+    if (cut) {
+        LARGE_INTEGER len;
+        len.QuadPart = static_cast<LONGLONG>(finalSize);
+        SetFilePointerEx(static_cast<HANDLE>(m_file), len, nullptr, FILE_BEGIN);
+        SetEndOfFile(static_cast<HANDLE>(m_file));
+    }
+    if (m_file) CloseHandle(static_cast<HANDLE>(m_file));
+    m_file = nullptr;
+    m_size = 0;
+}
+
+#else
+
+bool MappedFile::Open(const std::string& path, Mode mode, size_t minSize) noexcept {
+    Close();
+    m_mode = mode;
+    bool rw = (mode == Mode::ReadWrite);
+    m_fd = ::open(path.c_str(), rw ? (O_RDWR | O_CREAT | O_CLOEXEC) : (O_RDONLY | O_CLOEXEC), 0644);
+    if (m_fd < 0) return false;
+
+    struct stat st;
+    if (::fstat(m_fd, &st) != 0) { Close(); return false; }
+    m_size = static_cast<size_t>(st.st_size);
+    if (rw && m_size < minSize) return Resize(minSize);
+    if (!Map()) { Close(); return false; }
+    return true;
+}
+
+bool MappedFile::Map() noexcept {
+    if (m_size == 0) return false;
+    int prot = (m_mode == Mode::ReadWrite) ? (PROT_READ | PROT_WRITE) : PROT_READ;
+    void* p = ::mmap(nullptr, m_size, prot, MAP_SHARED, m_fd, 0);
+    if (p == MAP_FAILED) return false;
+    m_data = static_cast<char*>(p);
+    return true;
+}
+
+void MappedFile::Unmap() noexcept {
+    if (m_data) ::munmap(m_data, m_size);
+    m_data = nullptr;
+}
+
+bool MappedFile::Resize(size_t size) noexcept {
+    if (m_fd < 0 || m_mode != Mode::ReadWrite || size == 0) return false;
+    Unmap();
+    if (::ftruncate(m_fd, static_cast<off_t>(size)) != 0) { Close(); return false; }
+    m_size = size;
+    if (!Map()) { Close(); return false; }
+    return true;
+}
+
+bool MappedFile::Preallocate(const std::string& path, size_t size) noexcept {
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) return false;
+#ifdef __linux__
+    bool ok = ::posix_fallocate(fd, 0, static_cast<off_t>(size)) == 0;
+#else
+    struct stat st;
+    bool ok = ::fstat(fd, &st) == 0 &&
+              (static_cast<size_t>(st.st_size) >= size || ::ftruncate(fd, static_cast<off_t>(size)) == 0);
+#endif
+    ::close(fd);
+    return ok;
+}
+
+void MappedFile::Flush() noexcept {
+    if (m_data) ::msync(m_data, m_size, MS_ASYNC);
+}
+
+void MappedFile::Close(size_t finalSize) noexcept {
+    bool cut = m_fd >= 0 && m_mode == Mode::ReadWrite && finalSize < m_size;
+    Unmap();
+    if (cut && ::ftruncate(m_fd, static_cast<off_t>(finalSize)) != 0) {
+        // Leave the zero tail; readers stop at the first empty record.
+    }
+    if (m_fd >= 0) ::close(m_fd);
+    m_fd   = -1;
+    m_size = 0;
+}
+
+#endif
+
+} // namespace Bridge
@@ -0,0 +1,97 @@
+#include "MarketDataFeed.h"
+#include "Numeric.h"
+#include "SymbolTable.h"
+#include <charconv>
+#include <fstream>
+#include <sstream>
+
+namespace Bridge {
+
+// Split off the text up to the next ',' (or the end).
+static std::string_view NextField(std::string_view& rest) noexcept {
+    size_t comma = rest.find(',');
+    std::string_view field = rest.substr(0, comma);
+    rest = (comma == std::string_view::npos) ? std::string_view{} : rest.substr(comma + 1);
+    return field;
+}
+
+static bool ParseBookPrice(std::string_view s, PriceTicks& out) noexcept {
+    FixedPrice p;
+    return ParsePrice(s, p) == std::errc{} && ToBookPrice(p, out);
+}
+
+static bool ParseSize(std::string_view s, int& out) noexcept {
+    return ParseInt(s, out) == std::errc{} && out >= 0;
+}
+
+static bool ParseLine(std::string_view line, MarketEvent& ev) noexcept {
+    std::string_view ts   = NextField(line);
+    std::string_view kind = NextField(line);
+    std::string_view inst = NextField(line);
+
+    auto [ptr, ec] = std::from_chars(ts.data(), ts.data() + ts.size(), ev.timeUs);
+    if (ec != std::errc{} || ptr != ts.data() + ts.size()) return false;
+    if (inst.empty() || kind.size() != 1) return false;
+    ev.instrument = InternSymbol(inst);
+    if (ev.instrument == kNoSymbol) return false;
+
+    if (kind[0] == 'T') {
+        ev.kind = MarketEvent::Kind::Trade;
+        ev.ask = 0;
+        ev.askSize = 0;
+        return ParseBookPrice(NextField(line), ev.price)
+            && ParseSize(NextField(line), ev.size)
+            && line.empty();
+    }
+    if (kind[0] == 'Q') {
+        ev.kind = MarketEvent::Kind::Quote;
+        return ParseBookPrice(NextField(line), ev.price)
+            && ParseSize(NextField(line), ev.size)
+            && ParseBookPrice(NextField(line), ev.ask)
+            && ParseSize(NextField(line), ev.askSize)
+            && line.empty();
+    }
+    return false;
+}
+
+int MarketDataFeed::Parse(std::string_view text) noexcept {
+    try {
+        m_errorLine = 0;
+        size_t lineNo = 0;
+        while (!text.empty()) {
+            size_t nl = text.find('\n');
+            std::string_view line = text.substr(0, nl);
+            text = (nl == std::string_view::npos) ? std::string_view{} : text.substr(nl + 1);
+            ++lineNo;
+
+            if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+            if (line.empty() || line[0] == '#') continue;
+
+            MarketEvent ev;
+            if (!ParseLine(line, ev)) {
+                m_errorLine = lineNo;
+                return RC_INVALID_PARAM;
+            }
+            m_events.push_back(ev);
+        }
+        return RC_SUCCESS;
+    }
+    catch (...) {
+        return RC_INTERNAL_ERR;
+    }
+}
+
+int MarketDataFeed::Load(const std::string& path) noexcept {
+    try {
+        std::ifstream f(path, std::ios::binary);
+        if (!f.is_open()) return RC_CONFIG_ERR;
+        std::ostringstream text;
+        text << f.rdbuf();
+        return Parse(text.str());
+    }
+    catch (...) {
+        return RC_CONFIG_ERR;
+    }
+}
+
+} // namespace Bridge
@@ -1,12 +1,32 @@
 #include "MockAdapter.h"
 #include "Types.h"
+#include "SymbolTable.h"
 #include <string>
-#include <sstream>
+#include <thread>
 
 namespace Bridge {
 
+void MockAdapter::simulateLatency() const {
+    long long us = m_latencyUs.load(std::memory_order_relaxed);
+    if (us > 0) std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
 int MockAdapter::Execute(const OrderRequest& req) {
+    simulateLatency();
+    std::lock_guard<std::mutex> lk(m_mutex);
+    return dispatch(req);
+}
+
+void MockAdapter::ExecuteBatch(const OrderRequest* reqs, size_t count, int* results) {
+    simulateLatency();
+    // One lock (and one round trip) for the whole batch.
     std::lock_guard<std::mutex> lk(m_mutex);
+    for (size_t i = 0; i < count; ++i)
+        results[i] = dispatch(reqs[i]);
+}
+
+int MockAdapter::dispatch(const OrderRequest& req) {
+    if (!SymbolsResolved(req)) return RC_INVALID_PARAM;   // symbol table full
     switch (req.command) {
         case Command::PLACE:            return doPlace(req);
         case Command::CANCEL:           return doCancel(req);
@@ -21,38 +41,19 @@ int MockAdapter::Execute(const OrderRequest& req) {
 }
 
 int MockAdapter::doPlace(const OrderRequest& req) {
-    MockOrder o{};
-    std::ostringstream oss;
-    oss << "MOCK-" << m_nextId++;
-    o.orderId    = oss.str();
-    o.account    = req.account;
-    o.instrument = req.instrument;
-    o.action     = req.action;
-    o.quantity   = req.quantity;
-    o.orderType  = req.orderType;
-    o.limitPrice = req.limitPrice;
-    o.stopPrice  = req.stopPrice;
-    o.timeInForce= req.timeInForce;
-    o.working    = true;
-    m_orders.push_back(std::move(o));
+    m_store.Add(req, AccountIdOf(req), InstrumentIdOf(req));
     return RC_SUCCESS;
 }
 
 int MockAdapter::doCancel(const OrderRequest& req) {
     // Cancel all working orders for account+instrument
-    for (auto& o : m_orders) {
-        if (o.account == req.account && o.instrument == req.instrument && o.working)
-            o.working = false;
-    }
+    m_store.CancelWorking(AccountIdOf(req), InstrumentIdOf(req));
     return RC_SUCCESS;
 }
 
 int MockAdapter::doCancelAll(const OrderRequest& req) {
     // Cancel all working orders regardless of instrument
-    for (auto& o : m_orders) {
-        if (o.account == req.account && o.working)
-            o.working = false;
-    }
+    m_store.CancelAccount(AccountIdOf(req));
     return RC_SUCCESS;
 }
 
@@ -69,8 +70,7 @@ int MockAdapter::doClosePosition(const OrderRequest& req) {
 
 int MockAdapter::doFlattenEverything(const OrderRequest& req) {
     (void)req;
-    for (auto& o : m_orders)
-        o.working = false;
+    m_store.CancelAll();
     return RC_SUCCESS;
 }
 
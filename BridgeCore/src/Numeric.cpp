@@ -0,0 +1,177 @@
+#include "Numeric.h"
+#include "Types.h"
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace Bridge {
+
+static constexpr int64_t kPow10[] = {
+    1LL, 10LL, 100LL, 1000LL, 10000LL, 100000LL, 1000000LL, 10000000LL,
+    100000000LL, 1000000000LL, 10000000000LL, 100000000000LL,
+    1000000000000LL, 10000000000000LL, 100000000000000LL,
+    1000000000000000LL, 10000000000000000LL, 100000000000000000LL,
+    1000000000000000000LL
+};
+
+// Largest magnitude PriceFromDouble accepts at kMaxScale without overflow.
+static constexpr double kMaxPriceMagnitude = 9.0e9;
+
+// from_chars rejects a leading '+'; stoi/stod accepted it, so keep doing so.
+static std::string_view SkipPlus(std::string_view s) noexcept {
+    if (s.size() > 1 && s[0] == '+' && s[1] != '-') s.remove_prefix(1);
+    return s;
+}
+
+std::errc ParseInt(std::string_view s, int& out) noexcept {
+    s = SkipPlus(s);
+    if (s.empty()) return std::errc::invalid_argument;
+    int v = 0;
+    auto [ptr, ec] = std::from_chars(s.data(), s.data() + s.size(), v);
+    if (ec != std::errc{}) return ec;
+    if (ptr != s.data() + s.size()) return std::errc::invalid_argument;
+    out = v;
+    return std::errc{};
+}
+
+std::errc ParseDouble(std::string_view s, double& out) noexcept {
+    s = SkipPlus(s);
+    if (s.empty()) return std::errc::invalid_argument;
+    double v = 0.0;
+    auto [ptr, ec] = std::from_chars(s.data(), s.data() + s.size(), v);
+    if (ec != std::errc{}) return ec;
+    if (ptr != s.data() + s.size()) return std::errc::invalid_argument;
+    out = v;
+    return std::errc{};
+}
+
+static std::errc ParsePriceViaDouble(std::string_view s, FixedPrice& out) noexcept {
+    double v = 0.0;
+    std::errc ec = ParseDouble(s, v);
+    if (ec != std::errc{}) return ec;
+    FixedPrice p = PriceFromDouble(v);
+    if (!p.IsSet()) return std::errc::result_out_of_range;
+    out = p;
+    return std::errc{};
+}
+
+std::errc ParsePrice(std::string_view s, FixedPrice& out) noexcept {
+    const char* p   = s.data();
+    const char* end = p + s.size();
+    bool neg = false;
+    if (p != end && (*p == '+' || *p == '-')) { neg = (*p == '-'); ++p; }
+
+    uint64_t ticks  = 0;
+    int      scale  = -1;   // -1 until the decimal point is seen
+    int      digits = 0;
+    for (; p != end; ++p) {
+        char c = *p;
+        if (c >= '0' && c <= '9') {
+            if (scale == FixedPrice::kMaxScale)
+                return ParsePriceViaDouble(s, out);     // finer than we keep: round
+            if (ticks > (static_cast<uint64_t>(std::numeric_limits<int64_t>::max()) - 9) / 10)
+                return std::errc::result_out_of_range;
+            ticks = ticks * 10 + static_cast<uint64_t>(c - '0');
+            ++digits;
+            if (scale >= 0) ++scale;
+        }
+        else if (c == '.' && scale < 0) {
+            scale = 0;
+        }
+        else {
+            return ParsePriceViaDouble(s, out);         // exponent form, or junk
+        }
+    }
+    if (digits == 0) return std::errc::invalid_argument;
+
+    out.ticks = neg ? -static_cast<int64_t>(ticks) : static_cast<int64_t>(ticks);
+    out.scale = static_cast<uint8_t>(scale < 0 ? 0 : scale);
+    return std::errc{};
+}
+
+FixedPrice PriceFromDouble(double v) noexcept {
+    FixedPrice p;
+    if (!std::isfinite(v) || std::fabs(v) >= kMaxPriceMagnitude)
+        return p;
+    p.ticks = std::llround(v * static_cast<double>(kPow10[FixedPrice::kMaxScale]));
+    p.scale = FixedPrice::kMaxScale;
+    while (p.scale > 0 && p.ticks % 10 == 0) {
+        p.ticks /= 10;
+        --p.scale;
+    }
+    return p;
+}
+
+double PriceToDouble(const FixedPrice& p) noexcept {
+    if (!p.IsSet()) return 0.0;
+    // Both operands are exact, so IEEE division yields the nearest double.
+    return static_cast<double>(p.ticks) / static_cast<double>(kPow10[p.scale]);
+}
+
+std::errc RescalePrice(const FixedPrice& p, uint8_t scale, FixedPrice& out) noexcept {
+    if (!p.IsSet() || scale > FixedPrice::kMaxScale) return std::errc::invalid_argument;
+    FixedPrice r;
+    r.scale = scale;
+    if (scale >= p.scale) {
+        int64_t mult = kPow10[scale - p.scale];
+        if (p.ticks > std::numeric_limits<int64_t>::max() / mult ||
+            p.ticks < std::numeric_limits<int64_t>::min() / mult)
+            return std::errc::result_out_of_range;
+        r.ticks = p.ticks * mult;
+    } else {
+        int64_t div = kPow10[p.scale - scale];
+        if (p.ticks % div != 0) return std::errc::invalid_argument;
+        r.ticks = p.ticks / div;
+    }
+    out = r;
+    return std::errc{};
+}
+
+int ComparePrice(const FixedPrice& a, const FixedPrice& b) noexcept {
+    int64_t x = a.ticks;
+    int64_t y = b.ticks;
+    if (a.scale < b.scale) {
+        int64_t mult = kPow10[b.scale - a.scale];
+        if (x > std::numeric_limits<int64_t>::max() / mult) return  1;
+        if (x < std::numeric_limits<int64_t>::min() / mult) return -1;
+        x *= mult;
+    } else if (b.scale < a.scale) {
+        int64_t mult = kPow10[a.scale - b.scale];
+        if (y > std::numeric_limits<int64_t>::max() / mult) return -1;
+        if (y < std::numeric_limits<int64_t>::min() / mult) return  1;
+        y *= mult;
+    }
+    return (x < y) ? -1 : (x > y) ? 1 : 0;
+}
+
+size_t FormatPrice(const FixedPrice& p, char* buf, size_t cap) noexcept {
+    if (!p.IsSet()) return 0;
+    uint64_t mag = p.ticks < 0 ? 0 - static_cast<uint64_t>(p.ticks)
+                               : static_cast<uint64_t>(p.ticks);
+    uint64_t unit = static_cast<uint64_t>(kPow10[p.scale]);
+    uint64_t whole = mag / unit;
+    uint64_t frac  = mag % unit;
+
+    char* out = buf;
+    char* end = buf + cap;
+    if (p.ticks < 0) {
+        if (out == end) return 0;
+        *out++ = '-';
+    }
+    auto [ptr, ec] = std::to_chars(out, end, whole);
+    if (ec != std::errc{}) return 0;
+    out = ptr;
+    if (p.scale > 0) {
+        if (end - out < 1 + p.scale) return 0;
+        *out++ = '.';
+        for (int i = p.scale - 1; i >= 0; --i) {
+            out[i] = static_cast<char>('0' + frac % 10);
+            frac /= 10;
+        }
+        out += p.scale;
+    }
+    return static_cast<size_t>(out - buf);
+}
+
+} // namespace Bridge
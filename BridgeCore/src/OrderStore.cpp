@@ -0,0 +1,244 @@
+#include "OrderStore.h"
+#include <algorithm>
+#include <cstring>
+
+namespace Bridge {
+
+// ---------------------------------------------------------------------------
+// OrderIdCounter
+// ---------------------------------------------------------------------------
+
+OrderIdCounter::OrderIdCounter(std::string_view prefix)
+    : m_prefixLen(prefix.size() < kCap - 21 ? prefix.size() : kCap - 21)
+{
+    std::memcpy(m_buf, prefix.data(), m_prefixLen);
+    Reset();
+}
+
+void OrderIdCounter::Reset() noexcept {
+    m_buf[m_prefixLen] = '0';
+    m_len = m_prefixLen + 1;
+}
+
+std::string_view OrderIdCounter::Next() noexcept {
+    // Decimal increment on the text: bump the last digit, carrying left.
+    size_t i = m_len;
+    while (i > m_prefixLen) {
+        char& d = m_buf[--i];
+        if (d != '9') {
+            ++d;
+            return std::string_view(m_buf, m_len);
+        }
+        d = '0';
+    }
+    // All nines: grow by one digit ("99" -> "100").
+    std::memmove(m_buf + m_prefixLen + 1, m_buf + m_prefixLen, m_len - m_prefixLen);
+    m_buf[m_prefixLen] = '1';
+    ++m_len;
+    return std::string_view(m_buf, m_len);
+}
+
+// ---------------------------------------------------------------------------
+// OrderStore
+// ---------------------------------------------------------------------------
+
+OrderStore::OrderStore()
+    : m_ids("MOCK-")
+{
+}
+
+OrderStore::Slot OrderStore::AllocSlot() {
+    if (!m_free.empty()) {
+        Slot s = m_free.back();
+        m_free.pop_back();
+        return s;
+    }
+    Slot s = static_cast<Slot>(m_sequence.size());
+    m_sequence.push_back(0);
+    m_account.push_back(kNoSymbol);
+    m_instrument.push_back(kNoSymbol);
+    m_keyPrev.push_back(kNil);
+    m_keyNext.push_back(kNil);
+    m_acctPrev.push_back(kNil);
+    m_acctNext.push_back(kNil);
+    m_action.push_back(Action::UNKNOWN);
+    m_quantity.push_back(0);
+    m_orderType.push_back(OrderType::UNKNOWN);
+    m_timeInForce.push_back(TimeInForce::UNKNOWN);
+    m_limitPrice.push_back(0.0);
+    m_stopPrice.push_back(0.0);
+    m_limitPx.push_back(FixedPrice{});
+    m_stopPx.push_back(FixedPrice{});
+    m_orderId.push_back(OrderIdText{});
+    return s;
+}
+
+void OrderStore::LinkKey(Slot s, uint64_t key) {
+    auto [it, inserted] = m_keyHead.try_emplace(key, s);
+    m_keyPrev[s] = kNil;
+    m_keyNext[s] = inserted ? kNil : it->second;
+    if (!inserted) {
+        m_keyPrev[it->second] = s;
+        it->second = s;
+    }
+}
+
+void OrderStore::UnlinkKey(Slot s) {
+    Slot prev = m_keyPrev[s];
+    Slot next = m_keyNext[s];
+    if (next != kNil) m_keyPrev[next] = prev;
+    if (prev != kNil) {
+        m_keyNext[prev] = next;
+    } else {
+        uint64_t key = KeyOf(m_account[s], m_instrument[s]);
+        if (next == kNil) m_keyHead.erase(key);
+        else              m_keyHead[key] = next;
+    }
+}
+
+void OrderStore::LinkAccount(Slot s, SymbolId account) {
+    auto [it, inserted] = m_acctHead.try_emplace(account, s);
+    m_acctPrev[s] = kNil;
+    m_acctNext[s] = inserted ? kNil : it->second;
+    if (!inserted) {
+        m_acctPrev[it->second] = s;
+        it->second = s;
+    }
+}
+
+void OrderStore::UnlinkAccount(Slot s) {
+    Slot prev = m_acctPrev[s];
+    Slot next = m_acctNext[s];
+    if (next != kNil) m_acctPrev[next] = prev;
+    if (prev != kNil) {
+        m_acctNext[prev] = next;
+    } else {
+        if (next == kNil) m_acctHead.erase(m_account[s]);
+        else              m_acctHead[m_account[s]] = next;
+    }
+}
+
+MockOrder OrderStore::Materialize(Slot s, bool working) const {
+    MockOrder o{};
+    o.orderId.assign(m_orderId[s].text, m_orderId[s].len);
+    o.account     = m_account[s];
+    o.instrument  = m_instrument[s];
+    o.action      = m_action[s];
+    o.quantity    = m_quantity[s];
+    o.orderType   = m_orderType[s];
+    o.limitPrice  = m_limitPrice[s];
+    o.stopPrice   = m_stopPrice[s];
+    o.limitPx     = m_limitPx[s];
+    o.stopPx      = m_stopPx[s];
+    o.timeInForce = m_timeInForce[s];
+    o.working     = working;
+    o.sequence    = m_sequence[s];
+    return o;
+}
+
+void OrderStore::Retire(Slot s) {
+    m_archive.push_back(Materialize(s, false));
+    UnlinkKey(s);
+    UnlinkAccount(s);
+    m_sequence[s] = 0;
+    m_free.push_back(s);
+    --m_workingCount;
+}
+
+std::string_view OrderStore::Add(const OrderRequest& req, SymbolId account, SymbolId instrument) {
+    Slot s = AllocSlot();
+    std::string_view id = m_ids.Next();
+    OrderIdText& text = m_orderId[s];
+    text.len = static_cast<uint8_t>(id.size() < sizeof(text.text) ? id.size() : sizeof(text.text));
+    std::memcpy(text.text, id.data(), text.len);
+
+    m_sequence[s]    = m_nextSequence++;
+    m_account[s]     = account;
+    m_instrument[s]  = instrument;
+    m_action[s]      = req.action;
+    m_quantity[s]    = req.quantity;
+    m_orderType[s]   = req.orderType;
+    m_timeInForce[s] = req.timeInForce;
+    m_limitPrice[s]  = req.limitPrice;
+    m_stopPrice[s]   = req.stopPrice;
+    m_limitPx[s]     = req.limitPx;
+    m_stopPx[s]      = req.stopPx;
+    LinkKey(s, KeyOf(account, instrument));
+    LinkAccount(s, account);
+    ++m_workingCount;
+    return std::string_view(text.text, text.len);
+}
+
+size_t OrderStore::CancelWorking(SymbolId account, SymbolId instrument) {
+    auto it = m_keyHead.find(KeyOf(account, instrument));
+    if (it == m_keyHead.end()) return 0;
+    size_t n = 0;
+    for (Slot s = it->second; s != kNil; ) {
+        Slot next = m_keyNext[s];
+        Retire(s);          // may erase the map entry; 'it' is not used again
+        s = next;
+        ++n;
+    }
+    return n;
+}
+
+size_t OrderStore::CancelAccount(SymbolId account) {
+    auto it = m_acctHead.find(account);
+    if (it == m_acctHead.end()) return 0;
+    size_t n = 0;
+    for (Slot s = it->second; s != kNil; ) {
+        Slot next = m_acctNext[s];
+        Retire(s);
+        s = next;
+        ++n;
+    }
+    return n;
+}
+
+size_t OrderStore::CancelAll() {
+    size_t n = 0;
+    while (!m_acctHead.empty())
+        n += CancelAccount(m_acctHead.begin()->first);
+    return n;
+}
+
+size_t OrderStore::WorkingCount(SymbolId account, SymbolId instrument) const {
+    auto it = m_keyHead.find(KeyOf(account, instrument));
+    if (it == m_keyHead.end()) return 0;
+    size_t n = 0;
+    for (Slot s = it->second; s != kNil; s = m_keyNext[s]) ++n;
+    return n;
+}
+
+std::vector<MockOrder> OrderStore::Snapshot() const {
+    std::vector<MockOrder> all;
+    all.reserve(m_archive.size() + m_workingCount);
+    all.insert(all.end(), m_archive.begin(), m_archive.end());
+    for (Slot s = 0; s < m_sequence.size(); ++s) {
+        if (m_sequence[s] != 0) all.push_back(Materialize(s, true));
+    }
+    std::sort(all.begin(), all.end(),
+              [](const MockOrder& a, const MockOrder& b) { return a.sequence < b.sequence; });
+    return all;
+}
+
+void OrderStore::Clear() {
+    m_sequence.clear();
+    m_account.clear();   m_instrument.clear();
+    m_keyPrev.clear();   m_keyNext.clear();
+    m_acctPrev.clear();  m_acctNext.clear();
+    m_action.clear();    m_quantity.clear();
+    m_orderType.clear(); m_timeInForce.clear();
+    m_limitPrice.clear(); m_stopPrice.clear();
+    m_limitPx.clear();   m_stopPx.clear();
+    m_orderId.clear();
+    m_free.clear();
+    m_keyHead.clear();
+    m_acctHead.clear();
+    m_archive.clear();
+    m_workingCount = 0;
+    m_nextSequence = 1;
+    m_ids.Reset();
+}
+
+} // namespace Bridge
@@ -1,82 +1,83 @@
 #include "Parser.h"
 #include "Validation.h"
+#include "DedupCache.h"
+#include "Keywords.h"
+#include "LatencyStats.h"
+#include "Numeric.h"
+#include "SymbolTable.h"
+#include "WideText.h"
 #include "Types.h"
 #include <string>
-#include <sstream>
-#include <algorithm>
-#include <cctype>
-#include <stdexcept>
-
-#ifdef _WIN32
-#define WIN32_LEAN_AND_MEAN
-#include <windows.h>
-#endif
+#include <string_view>
+#include <system_error>
 
 namespace Bridge {
 
-static std::string WideToNarrow(const wchar_t* w) {
-    if (!w) return {};
-#ifdef _WIN32
-    int len = WideCharToMultiByte(CP_UTF8, 0, w, -1, nullptr, 0, nullptr, nullptr);
-    if (len <= 0) return {};
-    std::string s(static_cast<size_t>(len - 1), '\0');
-    WideCharToMultiByte(CP_UTF8, 0, w, -1, s.data(), len, nullptr, nullptr);
-    return s;
-#else
-    // Fallback for non-Windows compilation (tests on Linux)
-    std::string s;
-    while (*w) { s += static_cast<char>(*w++); }
-    return s;
-#endif
+static bool IsSpace(char c) noexcept {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+static std::string_view Trim(std::string_view s) noexcept {
+    size_t b = 0, e = s.size();
+    while (b < e && IsSpace(s[b]))     ++b;
+    while (e > b && IsSpace(s[e - 1])) --e;
+    return s.substr(b, e - b);
 }
 
-static std::string Trim(const std::string& s) {
-    size_t b = s.find_first_not_of(" \t\r\n");
-    if (b == std::string::npos) return {};
-    size_t e = s.find_last_not_of(" \t\r\n");
-    return s.substr(b, e - b + 1);
+// Validate, then resolve the names of an accepted request. Interning waits
+// until here because the table never frees a slot: a rejected or mistyped
+// name must not use one up.
+static int Validated(OrderRequest& out) noexcept {
+    int rc = ValidateRequest(out);
+    out.accountId    = rc == RC_SUCCESS ? InternSymbol(out.account)    : kNoSymbol;
+    out.instrumentId = rc == RC_SUCCESS ? InternSymbol(out.instrument) : kNoSymbol;
+    return rc;
 }
 
-int ParsePayload(const std::string& payload, OrderRequest& out) noexcept {
+int ParsePayload(std::string_view payload, OrderRequest& out) noexcept {
     try {
-        // Split on '|'
-        std::istringstream ss(payload);
-        std::string token;
-        while (std::getline(ss, token, '|')) {
-            token = Trim(token);
-            if (token.empty()) continue;
-            size_t eq = token.find('=');
-            if (eq == std::string::npos) continue;
-            std::string key = Trim(token.substr(0, eq));
-            std::string val = Trim(token.substr(eq + 1));
+        // Single pass over the payload: every field is viewed in place and
+        // written straight into 'out', so no per-token strings are built.
+        size_t pos = 0;
+        while (pos < payload.size()) {
+            size_t bar = payload.find('|', pos);
+            if (bar == std::string_view::npos) bar = payload.size();
+            std::string_view token = Trim(payload.substr(pos, bar - pos));
+            pos = bar + 1;
 
-            // Case-insensitive key match
-            std::string ku = key;
-            std::transform(ku.begin(), ku.end(), ku.begin(),
-                [](unsigned char c){ return static_cast<char>(std::toupper(c)); });
+            size_t eq = token.find('=');
+            if (eq == std::string_view::npos) continue;
+            const Keyword* k = LookupKeyword(Trim(token.substr(0, eq)));
+            if (!k || k->kind != KeywordKind::Field) continue;
+            std::string_view val = Trim(token.substr(eq + 1));
 
-            if      (ku == "COMMAND")     out.command     = ParseCommand(val);
-            else if (ku == "ACCOUNT")     out.account     = val;
-            else if (ku == "INSTRUMENT")  out.instrument  = val;
-            else if (ku == "ACTION")      out.action      = ParseAction(val);
-            else if (ku == "QUANTITY")    {
-                if (val.empty()) return RC_INVALID_PARAM;
-                out.quantity = std::stoi(val);
-            }
-            else if (ku == "ORDERTYPE")   out.orderType   = ParseOrderType(val);
-            else if (ku == "LIMITPRICE")  {
-                if (val.empty()) return RC_INVALID_PARAM;
-                out.limitPrice = std::stod(val);
+            switch (static_cast<PayloadField>(k->value)) {
+                case PayloadField::COMMAND:     out.command     = ParseCommand(val);     break;
+                case PayloadField::ACCOUNT:     out.account.assign(val.data(), val.size());    break;
+                case PayloadField::INSTRUMENT:  out.instrument.assign(val.data(), val.size()); break;
+                case PayloadField::ACTION:      out.action      = ParseAction(val);      break;
+                case PayloadField::QUANTITY:
+                    if (ParseInt(val, out.quantity) != std::errc{}) return RC_INVALID_PARAM;
+                    break;
+                case PayloadField::ORDERTYPE:   out.orderType   = ParseOrderType(val);   break;
+                case PayloadField::LIMITPRICE:
+                    if (ParsePrice(val, out.limitPx) != std::errc{}) return RC_INVALID_PARAM;
+                    out.limitPrice = PriceToDouble(out.limitPx);
+                    break;
+                case PayloadField::STOPPRICE:
+                    if (ParsePrice(val, out.stopPx) != std::errc{}) return RC_INVALID_PARAM;
+                    out.stopPrice = PriceToDouble(out.stopPx);
+                    break;
+                case PayloadField::TIMEINFORCE: out.timeInForce = ParseTimeInForce(val); break;
+                case PayloadField::BARKEY:      out.barKey      = val.empty() ? 0 : BarKeyOf(val); break;
             }
-            else if (ku == "STOPPRICE")   {
-                if (val.empty()) return RC_INVALID_PARAM;
-                out.stopPrice = std::stod(val);
-            }
-            else if (ku == "TIMEINFORCE") out.timeInForce = ParseTimeInForce(val);
         }
-        return ValidateRequest(out);
+        BRIDGE_LATENCY_MARK(Parse);
+        BRIDGE_LATENCY_COMMAND(out.command);
+        return Validated(out);
     }
     catch (...) {
+        // Numeric fields no longer throw; only string growth can get here.
         return RC_INVALID_PARAM;
     }
 }
@@ -92,16 +93,26 @@ int BuildRequest(const wchar_t* command,
                  const wchar_t* timeInForce,
                  OrderRequest&  out) noexcept {
     try {
-        out.command     = ParseCommand(WideToNarrow(command));
-        out.account     = WideToNarrow(account);
-        out.instrument  = WideToNarrow(instrument);
-        out.action      = ParseAction(WideToNarrow(action));
+        // Each field is narrowed into stack storage (ASCII fast path); the
+        // enum tokens are parsed straight from those buffers.
+        NarrowArg<64>  cmd(command), act(action), ot(orderType), tif(timeInForce);
+        NarrowArg<128> acc(account), inst(instrument);
+        BRIDGE_LATENCY_MARK(Convert);
+
+        out.command     = ParseCommand(cmd.view());
+        out.account.assign(acc.view().data(), acc.view().size());
+        out.instrument.assign(inst.view().data(), inst.view().size());
+        out.action      = ParseAction(act.view());
         out.quantity    = quantity;
-        out.orderType   = ParseOrderType(WideToNarrow(orderType));
+        out.orderType   = ParseOrderType(ot.view());
         out.limitPrice  = limitPrice;
         out.stopPrice   = stopPrice;
-        out.timeInForce = ParseTimeInForce(WideToNarrow(timeInForce));
-        return ValidateRequest(out);
+        out.limitPx     = PriceFromDouble(limitPrice);
+        out.stopPx      = PriceFromDouble(stopPrice);
+        out.timeInForce = ParseTimeInForce(tif.view());
+        BRIDGE_LATENCY_MARK(Parse);
+        BRIDGE_LATENCY_COMMAND(out.command);
+        return Validated(out);
     }
     catch (...) {
         return RC_INVALID_PARAM;
@@ -127,8 +138,12 @@ int BuildRequest(const char* command,
         out.orderType   = ParseOrderType(orderType ? orderType   : "");
         out.limitPrice  = limitPrice;
         out.stopPrice   = stopPrice;
+        out.limitPx     = PriceFromDouble(limitPrice);
+        out.stopPx      = PriceFromDouble(stopPrice);
         out.timeInForce = ParseTimeInForce(timeInForce ? timeInForce : "");
-        return ValidateRequest(out);
+        BRIDGE_LATENCY_MARK(Parse);
+        BRIDGE_LATENCY_COMMAND(out.command);
+        return Validated(out);
     }
     catch (...) {
         return RC_INVALID_PARAM;
@@ -0,0 +1,298 @@
+#include "PipeChannel.h"
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <cerrno>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace Bridge {
+
+namespace {
+
+#ifdef _WIN32
+constexpr DWORD kPipeBuffer = 64 * 1024;
+
+HANDLE Native(intptr_t h) noexcept { return reinterpret_cast<HANDLE>(h); }
+
+HANDLE CreateInstance(const std::string& path) noexcept {
+    return CreateNamedPipeA(path.c_str(), PIPE_ACCESS_DUPLEX | FILE_FLAG_OVERLAPPED,
+                            PIPE_TYPE_BYTE | PIPE_READMODE_BYTE | PIPE_WAIT, PIPE_UNLIMITED_INSTANCES,
+                            kPipeBuffer, kPipeBuffer, 0, nullptr);
+}
+
+// One overlapped operation with its own event: the handle is opened for
+// overlapped I/O so a Receive on one thread never blocks a Send on another.
+struct Overlapped {
+    OVERLAPPED ov{};
+    Overlapped() noexcept { ov.hEvent = CreateEventA(nullptr, TRUE, FALSE, nullptr); }
+    ~Overlapped() { if (ov.hEvent) CloseHandle(ov.hEvent); }
+    Overlapped(const Overlapped&) = delete;
+    Overlapped& operator=(const Overlapped&) = delete;
+};
+#else
+bool FillAddress(const std::string& path, sockaddr_un& addr) noexcept {
+    addr = sockaddr_un{};
+    addr.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(addr.sun_path)) return false;
+    std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+    return true;
+}
+#endif
+
+} // anonymous namespace
+
+PipeChannel::~PipeChannel() {
+    Close();
+}
+
+PipeChannel::PipeChannel(PipeChannel&& other) noexcept
+    : m_handle(other.m_handle), m_path(std::move(other.m_path)), m_listening(other.m_listening),
+      m_shut(other.m_shut.load()) {
+    other.m_handle = kInvalid;
+}
+
+PipeChannel& PipeChannel::operator=(PipeChannel&& other) noexcept {
+    if (this != &other) {
+        Close();
+        m_handle    = other.m_handle;
+        m_path      = std::move(other.m_path);
+        m_listening = other.m_listening;
+        m_shut.store(other.m_shut.load());
+        other.m_handle = kInvalid;
+    }
+    return *this;
+}
+
+std::string PipeChannel::PathOf(const std::string& name) {
+#ifdef _WIN32
+    if (name.rfind("\\\\", 0) == 0) return name;
+    return "\\\\.\\pipe\\" + name;
+#else
+    if (name.find('/') != std::string::npos) return name;
+    const char* tmp = std::getenv("TMPDIR");
+    std::string dir = tmp && *tmp ? tmp : "/tmp";
+    if (dir.back() != '/') dir += '/';
+    return dir + "CoreFxPipe_" + name;
+#endif
+}
+
+#ifdef _WIN32
+
+PipeChannel PipeChannel::Connect(const std::string& name, int timeoutMs) noexcept {
+    try {
+        std::string path     = PathOf(name);
+        auto        deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+        for (;;) {
+            HANDLE h = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, OPEN_EXISTING,
+                                   FILE_FLAG_OVERLAPPED, nullptr);
+            if (h != INVALID_HANDLE_VALUE) return PipeChannel(reinterpret_cast<intptr_t>(h), path, false);
+            if (GetLastError() != ERROR_PIPE_BUSY) return PipeChannel();
+            auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+                deadline - std::chrono::steady_clock::now()).count();
+            if (left <= 0 || !WaitNamedPipeA(path.c_str(), static_cast<DWORD>(left))) return PipeChannel();
+        }
+    }
+    catch (...) {
+        return PipeChannel();
+    }
+}
+
+PipeChannel PipeChannel::Listen(const std::string& name) noexcept {
+    try {
+        std::string path = PathOf(name);
+        HANDLE      h    = CreateInstance(path);
+        if (h == INVALID_HANDLE_VALUE) return PipeChannel();
+        return PipeChannel(reinterpret_cast<intptr_t>(h), path, true);
+    }
+    catch (...) {
+        return PipeChannel();
+    }
+}
+
+PipeChannel PipeChannel::Accept(int timeoutMs) noexcept {
+    if (!IsOpen() || !m_listening) return PipeChannel();
+    Overlapped o;
+    HANDLE     h = Native(m_handle);
+    if (!ConnectNamedPipe(h, &o.ov)) {
+        DWORD err = GetLastError();
+        if (err == ERROR_IO_PENDING) {
+            DWORD n = 0;
+            if (WaitForSingleObject(o.ov.hEvent, static_cast<DWORD>(timeoutMs)) != WAIT_OBJECT_0) {
+                CancelIoEx(h, &o.ov);
+                GetOverlappedResult(h, &o.ov, &n, TRUE);
+                return PipeChannel();
+            }
+            if (!GetOverlappedResult(h, &o.ov, &n, FALSE)) return PipeChannel();
+        } else if (err != ERROR_PIPE_CONNECTED) {
+            return PipeChannel();
+        }
+    }
+    // This instance is now the connection; the next client gets a new one.
+    HANDLE next = CreateInstance(m_path);
+    try {
+        PipeChannel conn(m_handle, m_path, false);
+        m_handle = next == INVALID_HANDLE_VALUE ? kInvalid : reinterpret_cast<intptr_t>(next);
+        return conn;
+    }
+    catch (...) {
+        if (next != INVALID_HANDLE_VALUE) CloseHandle(next);
+        return PipeChannel();
+    }
+}
+
+bool PipeChannel::SendAll(const char* data, size_t len) noexcept {
+    if (!IsOpen() || m_shut.load(std::memory_order_relaxed)) return false;
+    HANDLE h = Native(m_handle);
+    while (len > 0) {
+        Overlapped o;
+        DWORD      n     = 0;
+        DWORD      chunk = static_cast<DWORD>(std::min<size_t>(len, kPipeBuffer));
+        if (!WriteFile(h, data, chunk, nullptr, &o.ov) && GetLastError() != ERROR_IO_PENDING) return false;
+        if (!GetOverlappedResult(h, &o.ov, &n, TRUE) || n == 0) return false;
+        data += n;
+        len  -= n;
+    }
+    return true;
+}
+
+int PipeChannel::Receive(char* buf, size_t cap, int timeoutMs) noexcept {
+    if (!IsOpen() || m_shut.load(std::memory_order_acquire)) return -1;
+    HANDLE     h = Native(m_handle);
+    Overlapped o;
+    DWORD      n = 0;
+    DWORD      want = static_cast<DWORD>(std::min<size_t>(cap, INT_MAX));
+    if (!ReadFile(h, buf, want, nullptr, &o.ov)) {
+        if (GetLastError() != ERROR_IO_PENDING) return -1;   // ERROR_BROKEN_PIPE: the peer closed
+        if (WaitForSingleObject(o.ov.hEvent, static_cast<DWORD>(timeoutMs)) != WAIT_OBJECT_0)
+            CancelIoEx(h, &o.ov);
+    }
+    // After a cancel the read may still have completed with data.
+    if (!GetOverlappedResult(h, &o.ov, &n, TRUE)) {
+        if (GetLastError() != ERROR_OPERATION_ABORTED) return -1;
+        return m_shut.load(std::memory_order_acquire) ? -1 : 0;
+    }
+    return n > 0 ? static_cast<int>(n) : (m_shut.load(std::memory_order_acquire) ? -1 : 0);
+}
+
+void PipeChannel::Shutdown() noexcept {
+    if (!IsOpen()) return;
+    m_shut.store(true, std::memory_order_release);
+    CancelIoEx(Native(m_handle), nullptr);
+}
+
+void PipeChannel::Close() noexcept {
+    if (!IsOpen()) return;
+    CloseHandle(Native(m_handle));
+    m_handle = kInvalid;
+}
+
+#else
+
+PipeChannel PipeChannel::Connect(const std::string& name, int /*timeoutMs*/) noexcept {
+    try {
+        // A Unix socket connect either succeeds or fails at once.
+        std::string path = PathOf(name);
+        sockaddr_un addr;
+        if (!FillAddress(path, addr)) return PipeChannel();
+        int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) return PipeChannel();
+        if (::connect(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0) {
+            ::close(fd);
+            return PipeChannel();
+        }
+        return PipeChannel(fd, path, false);
+    }
+    catch (...) {
+        return PipeChannel();
+    }
+}
+
+PipeChannel PipeChannel::Listen(const std::string& name) noexcept {
+    try {
+        std::string path = PathOf(name);
+        sockaddr_un addr;
+        if (!FillAddress(path, addr)) return PipeChannel();
+        ::unlink(path.c_str());
+        int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) return PipeChannel();
+        if (::bind(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0 || ::listen(fd, 8) != 0) {
+            ::close(fd);
+            return PipeChannel();
+        }
+        return PipeChannel(fd, path, true);
+    }
+    catch (...) {
+        return PipeChannel();
+    }
+}
+
+PipeChannel PipeChannel::Accept(int timeoutMs) noexcept {
+    if (!IsOpen() || !m_listening) return PipeChannel();
+    pollfd p{};
+    p.fd     = static_cast<int>(m_handle);
+    p.events = POLLIN;
+    if (::poll(&p, 1, timeoutMs) != 1) return PipeChannel();
+    int fd = ::accept(static_cast<int>(m_handle), nullptr, nullptr);
+    if (fd < 0) return PipeChannel();
+    try {
+        return PipeChannel(fd, m_path, false);
+    }
+    catch (...) {
+        ::close(fd);
+        return PipeChannel();
+    }
+}
+
+bool PipeChannel::SendAll(const char* data, size_t len) noexcept {
+    if (!IsOpen()) return false;
+    while (len > 0) {
+        ssize_t n = ::send(static_cast<int>(m_handle), data, len, MSG_NOSIGNAL);
+        if (n <= 0) {
+            if (n < 0 && errno == EINTR) continue;
+            return false;
+        }
+        data += n;
+        len  -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+int PipeChannel::Receive(char* buf, size_t cap, int timeoutMs) noexcept {
+    if (!IsOpen() || m_shut.load(std::memory_order_acquire)) return -1;
+    pollfd p{};
+    p.fd     = static_cast<int>(m_handle);
+    p.events = POLLIN;
+    int ready = ::poll(&p, 1, timeoutMs);
+    if (ready == 0) return 0;
+    if (ready < 0) return errno == EINTR ? 0 : -1;
+    ssize_t n = ::recv(static_cast<int>(m_handle), buf, std::min<size_t>(cap, INT_MAX), 0);
+    return n > 0 ? static_cast<int>(n) : -1;
+}
+
+void PipeChannel::Shutdown() noexcept {
+    if (!IsOpen()) return;
+    m_shut.store(true, std::memory_order_release);
+    ::shutdown(static_cast<int>(m_handle), SHUT_RDWR);
+}
+
+void PipeChannel::Close() noexcept {
+    if (!IsOpen()) return;
+    ::close(static_cast<int>(m_handle));
+    if (m_listening) ::unlink(m_path.c_str());
+    m_handle = kInvalid;
+}
+
+#endif
+
+} // namespace Bridge
@@ -0,0 +1,127 @@
+#include "PriceLevelBook.h"
+#include "Numeric.h"
+#include <algorithm>
+
+namespace Bridge {
+
+bool ToBookPrice(const FixedPrice& p, PriceTicks& out) noexcept {
+    FixedPrice r;
+    if (RescalePrice(p, kBookScale, r) != std::errc{}) return false;
+    out = r.ticks;
+    return true;
+}
+
+FixedPrice FromBookPrice(PriceTicks ticks) noexcept {
+    FixedPrice p{ ticks, kBookScale };
+    while (p.scale > 0 && p.ticks % 10 == 0) {
+        p.ticks /= 10;
+        --p.scale;
+    }
+    return p;
+}
+
+// Levels are ordered worst-to-best, so "before" means less aggressive.
+static auto LevelBefore(BookSide side) {
+    return [side](const auto& level, PriceTicks price) {
+        return side == BookSide::Bid ? level.price < price : level.price > price;
+    };
+}
+
+PriceLevelBook::Level* PriceLevelBook::FindLevel(BookSide side, PriceTicks price) noexcept {
+    std::vector<Level>& levels = m_levels[Index(side)];
+    auto it = std::lower_bound(levels.begin(), levels.end(), price, LevelBefore(side));
+    return (it != levels.end() && it->price == price) ? &*it : nullptr;
+}
+
+const PriceLevelBook::Level* PriceLevelBook::FindLevel(BookSide side, PriceTicks price) const noexcept {
+    const std::vector<Level>& levels = m_levels[Index(side)];
+    auto it = std::lower_bound(levels.begin(), levels.end(), price, LevelBefore(side));
+    return (it != levels.end() && it->price == price) ? &*it : nullptr;
+}
+
+PriceLevelBook::Handle PriceLevelBook::Add(BookSide side, PriceTicks price, int qty, uint64_t tag) {
+    if (qty <= 0) return kNoHandle;
+
+    Handle h;
+    if (!m_free.empty()) {
+        h = m_free.back();
+        m_free.pop_back();
+    } else {
+        h = static_cast<Handle>(m_nodes.size());
+        m_nodes.push_back(Node{});
+    }
+    Node& n = m_nodes[h];
+    n.tag   = tag;
+    n.price = price;
+    n.qty   = qty;
+    n.next  = kNoHandle;
+    n.side  = side;
+
+    std::vector<Level>& levels = m_levels[Index(side)];
+    auto it = std::lower_bound(levels.begin(), levels.end(), price, LevelBefore(side));
+    if (it == levels.end() || it->price != price)
+        it = levels.insert(it, Level{ price, 0, kNoHandle, kNoHandle });
+
+    n.prev = it->tail;
+    if (it->tail != kNoHandle) m_nodes[it->tail].next = h;
+    else                       it->head = h;
+    it->tail = h;
+    it->qty += qty;
+    ++m_orders;
+    return h;
+}
+
+int PriceLevelBook::Cancel(Handle h) {
+    if (h >= m_nodes.size() || m_nodes[h].qty == 0) return 0;
+    Node& n = m_nodes[h];
+    Level* level = FindLevel(n.side, n.price);
+    if (!level) return 0;
+
+    if (n.prev != kNoHandle) m_nodes[n.prev].next = n.next;
+    else                     level->head = n.next;
+    if (n.next != kNoHandle) m_nodes[n.next].prev = n.prev;
+    else                     level->tail = n.prev;
+
+    int leaves = n.qty;
+    level->qty -= leaves;
+    n.qty = 0;
+    m_free.push_back(h);
+    --m_orders;
+
+    if (level->head == kNoHandle) {
+        std::vector<Level>& levels = m_levels[Index(n.side)];
+        levels.erase(levels.begin() + (level - levels.data()));
+    }
+    return leaves;
+}
+
+void PriceLevelBook::ReleaseFront(Level& level) {
+    Handle h = level.head;
+    level.head = m_nodes[h].next;
+    if (level.head != kNoHandle) m_nodes[level.head].prev = kNoHandle;
+    else                         level.tail = kNoHandle;
+    m_free.push_back(h);
+    --m_orders;
+}
+
+bool PriceLevelBook::Best(BookSide side, PriceTicks& price) const noexcept {
+    const std::vector<Level>& levels = m_levels[Index(side)];
+    if (levels.empty()) return false;
+    price = levels.back().price;
+    return true;
+}
+
+int PriceLevelBook::QtyAt(BookSide side, PriceTicks price) const noexcept {
+    const Level* level = FindLevel(side, price);
+    return level ? level->qty : 0;
+}
+
+void PriceLevelBook::Clear() {
+    m_levels[0].clear();
+    m_levels[1].clear();
+    m_nodes.clear();
+    m_free.clear();
+    m_orders = 0;
+}
+
+} // namespace Bridge
@@ -0,0 +1,227 @@
+#include "RequestJournal.h"
+#include <atomic>
+#include <chrono>
+#include <cstring>
+
+namespace Bridge {
+
+namespace {
+
+constexpr char     kMagic[8]     = { 'B', 'R', 'J', 'R', 'N', 'L', '0', '1' };
+constexpr uint32_t kVersion      = 1;
+constexpr size_t   kInitialSize  = size_t(4) << 20;
+constexpr size_t   kMaxGrowStep  = size_t(256) << 20;
+
+struct FileHeader {
+    char     magic[8];
+    uint32_t version;
+    uint32_t headerSize;
+    int64_t  createdNs;
+    char     reserved[40];
+};
+static_assert(sizeof(FileHeader) == 64, "journal file header is 64 bytes");
+
+struct RecordHeader {
+    uint32_t size;           // whole record, multiple of 8; stored last
+    uint8_t  version;
+    uint8_t  flags;
+    uint8_t  command;
+    uint8_t  action;
+    int64_t  timeNs;
+    int64_t  durationNs;
+    int32_t  rc;
+    int32_t  quantity;
+    uint8_t  orderType;
+    uint8_t  timeInForce;
+    uint8_t  limitScale;
+    uint8_t  stopScale;
+    uint16_t accountLen;
+    uint16_t instrumentLen;
+    int64_t  limitTicks;
+    int64_t  stopTicks;
+    double   limitPrice;
+    double   stopPrice;
+    uint64_t barKey;
+    // followed by account, then instrument text
+};
+static_assert(sizeof(RecordHeader) == 80, "journal record header is 80 bytes");
+
+constexpr size_t Align8(size_t n) noexcept { return (n + 7) & ~size_t(7); }
+
+uint32_t LoadSize(const char* record) noexcept {
+    auto* p = reinterpret_cast<uint32_t*>(const_cast<char*>(record));
+    return std::atomic_ref<uint32_t>(*p).load(std::memory_order_acquire);
+}
+
+// Size of the complete record at 'offset', or 0 if there is none.
+size_t RecordAt(const MappedFile& file, size_t offset) noexcept {
+    if (offset + sizeof(RecordHeader) > file.Size()) return 0;
+    const char* p  = file.Data() + offset;
+    size_t      sz = LoadSize(p);
+    if (sz < sizeof(RecordHeader) || sz % 8 != 0 || offset + sz > file.Size()) return 0;
+    RecordHeader h;
+    std::memcpy(&h, p, sizeof(h));
+    if (sizeof(RecordHeader) + h.accountLen + h.instrumentLen > sz) return 0;
+    return sz;
+}
+
+bool HeaderValid(const MappedFile& file) noexcept {
+    if (file.Size() < sizeof(FileHeader)) return false;
+    FileHeader h;
+    std::memcpy(&h, file.Data(), sizeof(h));
+    return std::memcmp(h.magic, kMagic, sizeof(kMagic)) == 0 && h.version == kVersion &&
+           h.headerSize == sizeof(FileHeader);
+}
+
+} // anonymous namespace
+
+int64_t RequestJournal::NowNs() noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+bool RequestJournal::Open(const std::string& path) noexcept {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    m_file.Close();
+    m_used = m_records = m_dropped = 0;
+    if (!m_file.Open(path, MappedFile::Mode::ReadWrite, kInitialSize)) return false;
+
+    FileHeader zero{};
+    if (std::memcmp(m_file.Data(), &zero, sizeof(zero)) == 0) {
+        FileHeader h{};
+        std::memcpy(h.magic, kMagic, sizeof(kMagic));
+        h.version    = kVersion;
+        h.headerSize = sizeof(FileHeader);
+        h.createdNs  = NowNs();
+        std::memcpy(m_file.Data(), &h, sizeof(h));
+    } else if (!HeaderValid(m_file)) {
+        m_file.Close();
+        return false;
+    }
+
+    // Append after the last complete record.
+    m_used = sizeof(FileHeader);
+    while (size_t sz = RecordAt(m_file, m_used)) {
+        m_used += sz;
+        ++m_records;
+    }
+    return true;
+}
+
+void RequestJournal::Close() noexcept {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    if (m_file.IsOpen()) m_file.Close(m_used);
+}
+
+bool RequestJournal::Reserve(size_t bytes) noexcept {
+    if (bytes <= m_file.Size()) return true;
+    size_t step = m_file.Size() < kMaxGrowStep ? m_file.Size() : kMaxGrowStep;
+    size_t size = m_file.Size() + step;
+    if (size < bytes) size = bytes;
+    return m_file.Resize(size);
+}
+
+void RequestJournal::Append(const OrderRequest& req, int64_t timeNs, int64_t durationNs, int rc,
+                            uint8_t flags) noexcept {
+    uint16_t accountLen    = static_cast<uint16_t>(req.account.size()    < 0xFFFF ? req.account.size()    : 0xFFFF);
+    uint16_t instrumentLen = static_cast<uint16_t>(req.instrument.size() < 0xFFFF ? req.instrument.size() : 0xFFFF);
+    size_t   size          = Align8(sizeof(RecordHeader) + accountLen + instrumentLen);
+
+    RecordHeader h{};
+    h.version       = static_cast<uint8_t>(kVersion);
+    h.flags         = flags;
+    h.command       = static_cast<uint8_t>(req.command);
+    h.action        = static_cast<uint8_t>(req.action);
+    h.timeNs        = timeNs;
+    h.durationNs    = durationNs;
+    h.rc            = rc;
+    h.quantity      = req.quantity;
+    h.orderType     = static_cast<uint8_t>(req.orderType);
+    h.timeInForce   = static_cast<uint8_t>(req.timeInForce);
+    h.limitScale    = req.limitPx.scale;
+    h.stopScale     = req.stopPx.scale;
+    h.accountLen    = accountLen;
+    h.instrumentLen = instrumentLen;
+    h.limitTicks    = req.limitPx.ticks;
+    h.stopTicks     = req.stopPx.ticks;
+    h.limitPrice    = req.limitPrice;
+    h.stopPrice     = req.stopPrice;
+    h.barKey        = req.barKey;
+
+    std::lock_guard<std::mutex> lk(m_mutex);
+    if (!m_file.IsOpen() || !Reserve(m_used + size)) {
+        ++m_dropped;
+        return;
+    }
+    char* p = m_file.Data() + m_used;
+    std::memcpy(p, &h, sizeof(h));          // size still 0: not yet visible
+    std::memcpy(p + sizeof(h), req.account.data(), accountLen);
+    std::memcpy(p + sizeof(h) + accountLen, req.instrument.data(), instrumentLen);
+    std::atomic_ref<uint32_t>(*reinterpret_cast<uint32_t*>(p))
+        .store(static_cast<uint32_t>(size), std::memory_order_release);
+    m_used += size;
+    ++m_records;
+}
+
+uint64_t RequestJournal::Records() const noexcept {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    return m_records;
+}
+
+uint64_t RequestJournal::Dropped() const noexcept {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    return m_dropped;
+}
+
+// ---------------------------------------------------------------------------
+// JournalReader
+// ---------------------------------------------------------------------------
+
+bool JournalReader::Open(const std::string& path) noexcept {
+    m_offset = 0;
+    if (!m_file.Open(path, MappedFile::Mode::ReadOnly)) return false;
+    if (!HeaderValid(m_file)) {
+        m_file.Close();
+        return false;
+    }
+    m_offset = sizeof(FileHeader);
+    return true;
+}
+
+void JournalReader::Rewind() noexcept {
+    if (m_file.IsOpen()) m_offset = sizeof(FileHeader);
+}
+
+bool JournalReader::Next(JournalEntry& out) {
+    if (!m_file.IsOpen()) return false;
+    size_t size = RecordAt(m_file, m_offset);
+    if (size == 0) return false;
+
+    const char* p = m_file.Data() + m_offset;
+    RecordHeader h;
+    std::memcpy(&h, p, sizeof(h));
+
+    OrderRequest& r = out.req;
+    r = OrderRequest{};
+    r.command     = static_cast<Command>(h.command);
+    r.action      = static_cast<Action>(h.action);
+    r.quantity    = h.quantity;
+    r.orderType   = static_cast<OrderType>(h.orderType);
+    r.timeInForce = static_cast<TimeInForce>(h.timeInForce);
+    r.limitPrice  = h.limitPrice;
+    r.stopPrice   = h.stopPrice;
+    r.limitPx     = FixedPrice{ h.limitTicks, h.limitScale };
+    r.stopPx      = FixedPrice{ h.stopTicks, h.stopScale };
+    r.barKey      = h.barKey;
+    r.account.assign(p + sizeof(h), h.accountLen);
+    r.instrument.assign(p + sizeof(h) + h.accountLen, h.instrumentLen);
+
+    out.timeNs     = h.timeNs;
+    out.durationNs = h.durationNs;
+    out.rc         = h.rc;
+    out.flags      = h.flags;
+    m_offset += size;
+    return true;
+}
+
+} // namespace Bridge
@@ -0,0 +1,368 @@
+#include "SharedStats.h"
+#include "Keywords.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Bridge {
+
+static_assert(std::is_trivially_copyable_v<StatsSnapshot>, "StatsSnapshot is copied word by word");
+static_assert(sizeof(StatsSnapshot) % sizeof(uint64_t) == 0, "StatsSnapshot is copied word by word");
+
+namespace {
+
+constexpr char     kMagic[8] = { 'B', 'R', 'S', 'T', 'A', 'T', 'S', '1' };
+constexpr uint32_t kVersion  = 1;
+constexpr size_t   kWords    = sizeof(StatsSnapshot) / sizeof(uint64_t);
+constexpr int      kReadAttempts = 1000;
+
+// Per-thread request counters, handed to the next new thread when their
+// thread exits (counts and all), so totals never go backwards.
+struct CounterRegistry {
+    std::mutex                                            mutex;
+    std::vector<std::unique_ptr<detail::RequestCounters>> all;
+    std::vector<detail::RequestCounters*>                 free;
+};
+
+CounterRegistry& Counters() {
+    static CounterRegistry* r = new CounterRegistry();   // never destroyed: threads may count during shutdown
+    return *r;
+}
+
+struct CounterLease {
+    detail::RequestCounters* counters = nullptr;
+    ~CounterLease() {
+        if (!counters) return;
+        detail::t_requestCounters = nullptr;
+        CounterRegistry& r = Counters();
+        std::lock_guard<std::mutex> lk(r.mutex);
+        r.free.push_back(counters);
+    }
+};
+
+// Names this process publishes under, so two engines cannot share one.
+std::mutex            g_publishedMutex;
+std::set<std::string> g_published;
+
+uint64_t CurrentPid() noexcept {
+#ifdef _WIN32
+    return GetCurrentProcessId();
+#else
+    return static_cast<uint64_t>(getpid());
+#endif
+}
+
+bool ProcessAlive(uint64_t pid) noexcept {
+    if (pid == 0) return false;
+#ifdef _WIN32
+    HANDLE h = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, static_cast<DWORD>(pid));
+    if (!h) return GetLastError() == ERROR_ACCESS_DENIED;
+    DWORD code = 0;
+    bool  alive = GetExitCodeProcess(h, &code) && code == STILL_ACTIVE;
+    CloseHandle(h);
+    return alive;
+#else
+    return kill(static_cast<pid_t>(pid), 0) == 0 || errno == EPERM;
+#endif
+}
+
+int64_t UnixMs() noexcept {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+} // anonymous namespace
+
+struct SharedStatsSegment::Layout {
+    char                  magic[8];
+    uint32_t              version;
+    uint32_t              size;          // sizeof(Layout)
+    std::atomic<uint64_t> pid;           // publisher; 0 once it has closed
+    std::atomic<uint64_t> startedUnixMs;
+    alignas(64) std::atomic<uint64_t> seq;   // odd while a snapshot is being written
+    std::atomic<uint64_t> words[kWords];
+};
+
+namespace detail {
+
+constinit thread_local RequestCounters* t_requestCounters = nullptr;
+
+RequestCounters* AcquireRequestCounters() noexcept {
+    try {
+        thread_local CounterLease lease;
+        if (!lease.counters) {
+            CounterRegistry& r = Counters();
+            std::lock_guard<std::mutex> lk(r.mutex);
+            if (!r.free.empty()) {
+                lease.counters = r.free.back();
+                r.free.pop_back();
+            } else {
+                r.all.push_back(std::make_unique<RequestCounters>());
+                lease.counters = r.all.back().get();
+            }
+        }
+        t_requestCounters = lease.counters;
+        return lease.counters;
+    }
+    catch (...) {
+        return nullptr;
+    }
+}
+
+} // namespace detail
+
+const char* StatsResultName(int slot) noexcept {
+    if (slot < 0 || slot >= kStatsResults - 1) return "OTHER";
+    switch (slot + RC_TIMEOUT) {
+        case RC_SUCCESS:        return "OK";
+        case RC_INVALID_CMD:    return "INVALID_CMD";
+        case RC_INVALID_PARAM:  return "INVALID_PARAM";
+        case RC_NOT_CONNECTED:  return "NOT_CONNECTED";
+        case RC_INTERNAL_ERR:   return "INTERNAL_ERR";
+        case RC_CONFIG_ERR:     return "CONFIG_ERR";
+        case RC_QUEUE_FULL:     return "QUEUE_FULL";
+        case RC_UNKNOWN_TICKET: return "UNKNOWN_TICKET";
+        case RC_REJECTED:       return "REJECTED";
+        case RC_TIMEOUT:        return "TIMEOUT";
+        case RC_PENDING:        return "PENDING";
+        default:                return "OTHER";
+    }
+}
+
+const char* StatsCommandName(size_t command) noexcept {
+    for (const Keyword& k : Keywords::kAll)
+        if (k.kind == KeywordKind::Command && k.value == command) return k.text.data();
+    return "UNKNOWN";
+}
+
+void CollectStats(StatsSnapshot& out) noexcept {
+    try {
+        CounterRegistry& r = Counters();
+        std::lock_guard<std::mutex> lk(r.mutex);
+        for (const auto& c : r.all) {
+            for (size_t cmd = 0; cmd < kStatsCommands; ++cmd)
+                for (int rc = 0; rc < kStatsResults; ++rc)
+                    out.requests[cmd][rc] += c->n[cmd][rc].load(std::memory_order_relaxed);
+        }
+    }
+    catch (...) {}
+    out.ticksPerNs = LatencyTicksPerNs();
+    for (size_t s = 0; s < kStatsStages; ++s)
+        out.latencyCount[s] += LatencyStageBuckets(static_cast<Stage>(s), out.latencyBuckets[s],
+                                                   out.latencySum[s], out.latencyMax[s]);
+}
+
+uint64_t StatsPercentile(const uint64_t* buckets, double q) noexcept {
+    uint64_t total = 0;
+    for (size_t b = 0; b < LatencyHistogram::kBuckets; ++b) total += buckets[b];
+    if (total == 0) return 0;
+    uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(total) + 0.5);
+    rank = std::clamp<uint64_t>(rank, 1, total);
+    uint64_t seen = 0;
+    for (size_t b = 0; b < LatencyHistogram::kBuckets; ++b) {
+        seen += buckets[b];
+        if (seen >= rank) return LatencyHistogram::BucketHigh(b);
+    }
+    return 0;
+}
+
+SharedStatsSegment::~SharedStatsSegment() {
+    Close();
+}
+
+bool SharedStatsSegment::Create(const std::string& name) noexcept {
+    Close();
+    try {
+        {
+            std::lock_guard<std::mutex> lk(g_publishedMutex);
+            if (!g_published.insert(name).second) return false;
+        }
+        if (!Map(name, true)) {
+            std::lock_guard<std::mutex> lk(g_publishedMutex);
+            g_published.erase(name);
+            return false;
+        }
+        m_owner = true;
+        m_name  = name;
+
+        // Keep the sequence number going (and even) for readers still
+        // attached to a segment taken over from an exited publisher.
+        uint64_t seq = m_layout->seq.load(std::memory_order_relaxed);
+        m_layout->seq.store((seq + 1) & ~uint64_t{ 1 }, std::memory_order_relaxed);
+        m_layout->version = kVersion;
+        m_layout->size    = sizeof(Layout);
+        m_layout->startedUnixMs.store(static_cast<uint64_t>(UnixMs()), std::memory_order_relaxed);
+        std::memcpy(m_layout->magic, kMagic, sizeof(kMagic));
+        m_layout->pid.store(CurrentPid(), std::memory_order_release);
+        return true;
+    }
+    catch (...) {
+        Unmap();
+        return false;
+    }
+}
+
+bool SharedStatsSegment::Open(const std::string& name) noexcept {
+    Close();
+    if (!Map(name, false)) return false;
+    if (std::memcmp(m_layout->magic, kMagic, sizeof(kMagic)) != 0 || m_layout->version != kVersion ||
+        m_layout->size != sizeof(Layout)) {
+        Unmap();
+        return false;
+    }
+    return true;
+}
+
+void SharedStatsSegment::Close() noexcept {
+    if (!m_layout) return;
+    if (m_owner) {
+        m_layout->pid.store(0, std::memory_order_release);
+#ifndef _WIN32
+        shm_unlink(("/" + m_name).c_str());
+#endif
+        std::lock_guard<std::mutex> lk(g_publishedMutex);
+        g_published.erase(m_name);
+    }
+    Unmap();
+    m_owner = false;
+    m_name.clear();
+}
+
+void SharedStatsSegment::Publish(const StatsSnapshot& s) noexcept {
+    if (!m_layout || !m_owner) return;
+    uint64_t seq = m_layout->seq.load(std::memory_order_relaxed);
+    m_layout->seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    const char* src = reinterpret_cast<const char*>(&s);
+    for (size_t i = 0; i < kWords; ++i) {
+        uint64_t w;
+        std::memcpy(&w, src + i * sizeof(w), sizeof(w));
+        m_layout->words[i].store(w, std::memory_order_relaxed);
+    }
+    m_layout->seq.store(seq + 2, std::memory_order_release);
+}
+
+bool SharedStatsSegment::Read(StatsSnapshot& out) const noexcept {
+    if (!m_layout) return false;
+    char* dst = reinterpret_cast<char*>(&out);
+    for (int attempt = 0; attempt < kReadAttempts; ++attempt) {
+        uint64_t before = m_layout->seq.load(std::memory_order_acquire);
+        if (before & 1) {
+            std::this_thread::yield();
+            continue;
+        }
+        for (size_t i = 0; i < kWords; ++i) {
+            uint64_t w = m_layout->words[i].load(std::memory_order_relaxed);
+            std::memcpy(dst + i * sizeof(w), &w, sizeof(w));
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (m_layout->seq.load(std::memory_order_relaxed) == before) return true;
+    }
+    return false;
+}
+
+uint64_t SharedStatsSegment::PublisherPid() const noexcept {
+    return m_layout ? m_layout->pid.load(std::memory_order_acquire) : 0;
+}
+
+uint64_t SharedStatsSegment::StartedUnixMs() const noexcept {
+    return m_layout ? m_layout->startedUnixMs.load(std::memory_order_relaxed) : 0;
+}
+
+#ifdef _WIN32
+
+bool SharedStatsSegment::Map(const std::string& name, bool create) noexcept {
+    std::wstring os = L"Local\\" + std::wstring(name.begin(), name.end());
+    HANDLE h = create ? CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0,
+                                           static_cast<DWORD>(sizeof(Layout)), os.c_str())
+                      : OpenFileMappingW(FILE_MAP_READ, FALSE, os.c_str());
+    if (!h) return false;
+    bool existed = create && GetLastError() == ERROR_ALREADY_EXISTS;
+    void* view = MapViewOfFile(h, create ? FILE_MAP_ALL_ACCESS : FILE_MAP_READ, 0, 0, sizeof(Layout));
+    if (!view) {
+        CloseHandle(h);
+        return false;
+    }
+    m_mapping = h;
+    m_layout  = static_cast<Layout*>(view);
+    // An existing object stays alive while any reader holds it; take it
+    // over only if its publisher has gone and the layout matches.
+    if (existed && (ProcessAlive(m_layout->pid.load(std::memory_order_acquire)) ||
+                    (m_layout->size != 0 && m_layout->size != sizeof(Layout)))) {
+        Unmap();
+        return false;
+    }
+    return true;
+}
+
+void SharedStatsSegment::Unmap() noexcept {
+    if (m_layout) UnmapViewOfFile(m_layout);
+    if (m_mapping) CloseHandle(m_mapping);
+    m_layout  = nullptr;
+    m_mapping = nullptr;
+}
+
+#else
+
+bool SharedStatsSegment::Map(const std::string& name, bool create) noexcept {
+    std::string os = "/" + name;
+    int fd = shm_open(os.c_str(), create ? (O_RDWR | O_CREAT) : O_RDONLY, 0644);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return false;
+    }
+    size_t size = static_cast<size_t>(st.st_size);
+    if (create && size >= sizeof(Layout::magic) + 2 * sizeof(uint32_t) + sizeof(uint64_t)) {
+        // Someone's segment: only take it over if its publisher has exited.
+        void* p = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        bool  live = p == MAP_FAILED ||
+                     ProcessAlive(static_cast<Layout*>(p)->pid.load(std::memory_order_acquire));
+        if (p != MAP_FAILED) munmap(p, size);
+        if (live) {
+            close(fd);
+            return false;
+        }
+    }
+    if (create && size != sizeof(Layout) && ftruncate(fd, static_cast<off_t>(sizeof(Layout))) != 0) {
+        close(fd);
+        return false;
+    }
+    if (!create && size != sizeof(Layout)) {
+        close(fd);
+        return false;
+    }
+    void* p = mmap(nullptr, sizeof(Layout), create ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED) return false;
+    m_layout = static_cast<Layout*>(p);
+    return true;
+}
+
+void SharedStatsSegment::Unmap() noexcept {
+    if (m_layout) munmap(m_layout, sizeof(Layout));
+    m_layout = nullptr;
+}
+
+#endif
+
+} // namespace Bridge
@@ -0,0 +1,462 @@
+#include "SimExchangeAdapter.h"
+#include "Logger.h"
+#include "Numeric.h"
+#include "SymbolTable.h"
+#include "Types.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+namespace Bridge {
+
+// Book price of a request price, preferring the exact form.
+static PriceTicks BookPriceOf(const FixedPrice& exact, double approx) noexcept {
+    PriceTicks t = 0;
+    if (exact.IsSet() && ToBookPrice(exact, t)) return t;
+    FixedPrice p = PriceFromDouble(approx);
+    if (p.IsSet() && ToBookPrice(p, t)) return t;
+    return std::isfinite(approx) ? std::llround(approx * 1e6) : 0;
+}
+
+static bool IsStop(OrderType t) noexcept {
+    return t == OrderType::STOPMARKET || t == OrderType::STOPLIMIT;
+}
+
+static bool IsMarketPrice(PriceTicks px) noexcept {
+    return px == PriceLevelBook::kMarketBid || px == PriceLevelBook::kMarketAsk;
+}
+
+SimSettings SimSettingsOf(const BridgeConfig& cfg) {
+    SimSettings s;
+    s.feedPath = cfg.simFeedPath;
+    return s;
+}
+
+SimExchangeAdapter::SimExchangeAdapter()
+    : SimExchangeAdapter(SimSettings{})
+{
+}
+
+SimExchangeAdapter::SimExchangeAdapter(const SimSettings& settings)
+    : m_ids("SIM-")
+{
+    if (settings.feedPath.empty()) return;
+    int rc = m_feed.Load(settings.feedPath);
+    if (rc == RC_INVALID_PARAM)
+        BRIDGE_LOG_WARN("SIM: " + settings.feedPath + " line " + std::to_string(m_feed.ErrorLine()) +
+                        " is malformed; replaying the " + std::to_string(m_feed.Size()) + " event(s) before it");
+    else if (rc != RC_SUCCESS)
+        BRIDGE_LOG_ERROR("SIM: cannot read market data feed " + settings.feedPath + "; no market data");
+    if (m_feed.Size() == 0) return;
+    BRIDGE_LOG_INFO("SIM: replaying " + std::to_string(m_feed.Size()) + " market event(s) from " +
+                    settings.feedPath);
+    m_feedThread = std::thread([this] { RunFeed(); });
+}
+
+SimExchangeAdapter::~SimExchangeAdapter() {
+    {
+        std::lock_guard<std::mutex> lk(m_feedMutex);
+        m_feedStop = true;
+    }
+    m_feedWake.notify_all();
+    if (m_feedThread.joinable()) m_feedThread.join();
+}
+
+// Applies each event when its time, relative to the first, comes round;
+// events already due go in together under one lock.
+void SimExchangeAdapter::RunFeed() noexcept {
+    using Clock = std::chrono::steady_clock;
+    const std::vector<MarketEvent>& events = m_feed.Events();
+    const Clock::time_point start = Clock::now();
+    const uint64_t          t0    = events.front().timeUs;
+    auto dueAt = [&](size_t i) {
+        uint64_t t = events[i].timeUs > t0 ? events[i].timeUs - t0 : 0;
+        return start + std::chrono::microseconds(t);
+    };
+    try {
+        for (size_t i = 0; i < events.size();) {
+            {
+                std::unique_lock<std::mutex> lk(m_feedMutex);
+                if (m_feedWake.wait_until(lk, dueAt(i), [this] { return m_feedStop; })) return;
+            }
+            Clock::time_point now = Clock::now();
+            size_t n = 1;
+            while (i + n < events.size() && dueAt(i + n) <= now) ++n;
+            Replay(m_feed, i, n);
+            i += n;
+        }
+        BRIDGE_LOG_INFO("SIM: market data feed finished");
+    }
+    catch (...) {
+        BRIDGE_LOG_ERROR("SIM: unexpected exception replaying the market data feed");
+    }
+}
+
+int SimExchangeAdapter::Execute(const OrderRequest& req) {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    return dispatch(req);
+}
+
+void SimExchangeAdapter::ExecuteBatch(const OrderRequest* reqs, size_t count, int* results) {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    for (size_t i = 0; i < count; ++i)
+        results[i] = dispatch(reqs[i]);
+}
+
+void SimExchangeAdapter::SetExecutionSink(ExecutionSink sink) {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    m_sink = std::move(sink);
+}
+
+void SimExchangeAdapter::OnMarketEvent(const MarketEvent& ev) {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    apply(ev);
+}
+
+size_t SimExchangeAdapter::Replay(const MarketDataFeed& feed, size_t first, size_t count) {
+    const std::vector<MarketEvent>& events = feed.Events();
+    if (first >= events.size()) return 0;
+    size_t n = std::min(count, events.size() - first);
+    std::lock_guard<std::mutex> lk(m_mutex);
+    for (size_t i = first; i < first + n; ++i)
+        apply(events[i]);
+    return n;
+}
+
+int64_t SimExchangeAdapter::Position(SymbolId account, SymbolId instrument) const {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    auto it = m_positions.find(KeyOf(account, instrument));
+    return it == m_positions.end() ? 0 : it->second;
+}
+
+size_t SimExchangeAdapter::WorkingCount() const {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    return m_working;
+}
+
+uint64_t SimExchangeAdapter::FillCount() const {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    return m_fills;
+}
+
+void SimExchangeAdapter::Clear() {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    m_orders.clear();
+    m_freeOrders.clear();
+    m_markets.clear();
+    m_live.clear();
+    m_positions.clear();
+    m_ids.Reset();
+    m_working = 0;
+    m_fills   = 0;
+}
+
+// ---------------------------------------------------------------------------
+// Commands
+// ---------------------------------------------------------------------------
+
+int SimExchangeAdapter::dispatch(const OrderRequest& req) {
+    SymbolId account, instrument;
+    if (!SymbolsResolved(req, account, instrument)) return RC_INVALID_PARAM;   // symbol table full
+    uint64_t key = KeyOf(account, instrument);
+
+    switch (req.command) {
+        case Command::PLACE:
+            return doPlace(req);
+        case Command::CANCEL:
+            cancelKey(key);
+            return RC_SUCCESS;
+        case Command::CANCELALLORDERS:
+            cancelAccount(account);
+            return RC_SUCCESS;
+        case Command::CHANGE:
+            cancelKey(key);
+            return doPlace(req);
+        case Command::CLOSEPOSITION:
+            cancelKey(key);
+            flattenKey(key);
+            return RC_SUCCESS;
+        case Command::CLOSESTRATEGY:    // alias
+        case Command::FLATTENEVERYTHING: {
+            cancelAll();
+            std::vector<uint64_t> open;
+            for (const auto& [k, qty] : m_positions)
+                if (qty != 0) open.push_back(k);
+            for (uint64_t k : open) flattenKey(k);
+            return RC_SUCCESS;
+        }
+        case Command::REVERSEPOSITION: {
+            cancelKey(key);
+            auto it = m_positions.find(key);
+            int64_t pos = (it == m_positions.end()) ? 0 : it->second;
+            if (pos != 0) {
+                int64_t qty = 2 * (pos < 0 ? -pos : pos);
+                placeMarket(account, instrument, pos > 0 ? Action::SELL : Action::BUY,
+                            static_cast<int>(std::min<int64_t>(qty, std::numeric_limits<int>::max())));
+                return RC_SUCCESS;
+            }
+            // Flat: as MockAdapter, place the opposite of the request.
+            OrderRequest rev = req;
+            rev.action  = (req.action == Action::BUY) ? Action::SELL : Action::BUY;
+            rev.command = Command::PLACE;
+            return doPlace(rev);
+        }
+        default:
+            return RC_INVALID_CMD;
+    }
+}
+
+int SimExchangeAdapter::doPlace(const OrderRequest& req) {
+    SymbolId account    = AccountIdOf(req);
+    SymbolId instrument = InstrumentIdOf(req);
+    if (account == kNoSymbol || instrument == kNoSymbol) return RC_INVALID_PARAM;
+    if (req.quantity <= 0) return RC_INVALID_PARAM;
+    if (req.action != Action::BUY && req.action != Action::SELL) return RC_INVALID_PARAM;
+    if (req.orderType == OrderType::UNKNOWN) return RC_INVALID_PARAM;
+
+    uint32_t idx = newOrder(account, instrument, req.action, req.orderType, req.quantity);
+    SimOrder& o = m_orders[idx];
+    if (req.orderType == OrderType::LIMIT || req.orderType == OrderType::STOPLIMIT)
+        o.limit = BookPriceOf(req.limitPx, req.limitPrice);
+    if (IsStop(req.orderType))
+        o.stop = BookPriceOf(req.stopPx, req.stopPrice);
+    report(o, ExecutionReport::Type::New, 0, 0);
+    enter(idx);
+    return RC_SUCCESS;
+}
+
+void SimExchangeAdapter::placeMarket(SymbolId account, SymbolId instrument, Action action, int qty) {
+    if (qty <= 0) return;
+    uint32_t idx = newOrder(account, instrument, action, OrderType::MARKET, qty);
+    report(m_orders[idx], ExecutionReport::Type::New, 0, 0);
+    enter(idx);
+}
+
+uint32_t SimExchangeAdapter::newOrder(SymbolId account, SymbolId instrument, Action action,
+                                      OrderType type, int qty) {
+    uint32_t idx;
+    if (!m_freeOrders.empty()) {
+        idx = m_freeOrders.back();
+        m_freeOrders.pop_back();
+    } else {
+        idx = static_cast<uint32_t>(m_orders.size());
+        m_orders.emplace_back();
+    }
+    SimOrder& o = m_orders[idx];
+    o.orderId.assign(m_ids.Next());
+    o.account    = account;
+    o.instrument = instrument;
+    o.action     = action;
+    o.orderType  = type;
+    o.quantity   = qty;
+    o.cumQty     = 0;
+    o.limit      = 0;
+    o.stop       = 0;
+    o.state      = State::Resting;
+    o.handle     = PriceLevelBook::kNoHandle;
+
+    market(instrument);     // books exist before any order can rest in them
+    m_live[KeyOf(account, instrument)].push_back(idx);
+    ++m_working;
+    return idx;
+}
+
+// ---------------------------------------------------------------------------
+// Order life cycle
+// ---------------------------------------------------------------------------
+
+void SimExchangeAdapter::enter(uint32_t idx) {
+    SimOrder& o = m_orders[idx];
+    Market&   m = m_markets[o.instrument];
+    bool    buy = (o.action == Action::BUY);
+
+    if (IsStop(o.orderType)) {
+        bool elected = m.hasTrade && (buy ? m.last >= o.stop : m.last <= o.stop);
+        if (elected) {
+            trigger(idx);
+        } else {
+            o.state = State::StopPending;
+            m.stops.push_back(idx);
+        }
+        return;
+    }
+
+    PriceTicks px = (o.orderType == OrderType::MARKET)
+                  ? (buy ? PriceLevelBook::kMarketBid : PriceLevelBook::kMarketAsk)
+                  : o.limit;
+
+    // Take whatever the displayed quote offers at or better than our price.
+    if (m.hasQuote) {
+        int leaves = o.quantity - o.cumQty;
+        if (buy && m.askSize > 0 && px >= m.ask) {
+            int take = std::min(leaves, m.askSize);
+            m.askSize -= take;
+            fill(idx, take, m.ask);
+        } else if (!buy && m.bidSize > 0 && px <= m.bid) {
+            int take = std::min(leaves, m.bidSize);
+            m.bidSize -= take;
+            fill(idx, take, m.bid);
+        }
+    }
+    if (o.state == State::Free) return;     // filled in full
+
+    o.handle = m.book.Add(buy ? BookSide::Bid : BookSide::Ask, px, o.quantity - o.cumQty, idx);
+    o.state  = State::Resting;
+}
+
+void SimExchangeAdapter::trigger(uint32_t idx) {
+    SimOrder& o = m_orders[idx];
+    o.orderType = (o.orderType == OrderType::STOPLIMIT) ? OrderType::LIMIT : OrderType::MARKET;
+    o.state     = State::Resting;
+    enter(idx);
+}
+
+void SimExchangeAdapter::cancelOrder(uint32_t idx) {
+    SimOrder& o = m_orders[idx];
+    if (o.state == State::Free) return;
+    Market& m = m_markets[o.instrument];
+    if (o.state == State::StopPending) {
+        m.stops.erase(std::find(m.stops.begin(), m.stops.end(), idx));
+    } else {
+        m.book.Cancel(o.handle);
+    }
+    report(o, ExecutionReport::Type::Canceled, 0, 0);
+    retire(idx);
+}
+
+void SimExchangeAdapter::cancelKey(uint64_t key) {
+    auto it = m_live.find(key);
+    if (it == m_live.end() || it->second.empty()) return;
+    // Detach the list first: retire() removes from it as orders go.
+    std::vector<uint32_t> open;
+    open.swap(it->second);
+    for (uint32_t idx : open) cancelOrder(idx);
+    open.clear();
+    it->second.swap(open);      // keep the capacity for the next order
+}
+
+void SimExchangeAdapter::cancelAccount(SymbolId account) {
+    for (auto& [key, open] : m_live)
+        if (static_cast<SymbolId>(key >> 32) == account && !open.empty())
+            cancelKey(key);
+}
+
+void SimExchangeAdapter::cancelAll() {
+    for (auto& [key, open] : m_live)
+        if (!open.empty()) cancelKey(key);
+}
+
+void SimExchangeAdapter::flattenKey(uint64_t key) {
+    auto it = m_positions.find(key);
+    if (it == m_positions.end() || it->second == 0) return;
+    int64_t pos = it->second;
+    int64_t qty = pos < 0 ? -pos : pos;
+    placeMarket(static_cast<SymbolId>(key >> 32), static_cast<SymbolId>(key),
+                pos > 0 ? Action::SELL : Action::BUY,
+                static_cast<int>(std::min<int64_t>(qty, std::numeric_limits<int>::max())));
+}
+
+void SimExchangeAdapter::fill(uint32_t idx, int qty, PriceTicks px) {
+    SimOrder& o = m_orders[idx];
+    o.cumQty += qty;
+    m_positions[KeyOf(o.account, o.instrument)] += (o.action == Action::BUY) ? qty : -qty;
+    ++m_fills;
+    bool done = (o.cumQty == o.quantity);
+    report(o, done ? ExecutionReport::Type::Fill : ExecutionReport::Type::PartialFill, qty, px);
+    if (done) retire(idx);
+}
+
+void SimExchangeAdapter::retire(uint32_t idx) {
+    SimOrder& o = m_orders[idx];
+    auto it = m_live.find(KeyOf(o.account, o.instrument));
+    if (it != m_live.end()) {
+        auto pos = std::find(it->second.begin(), it->second.end(), idx);
+        if (pos != it->second.end()) it->second.erase(pos);
+    }
+    o.state  = State::Free;
+    o.handle = PriceLevelBook::kNoHandle;
+    m_freeOrders.push_back(idx);
+    --m_working;
+}
+
+void SimExchangeAdapter::report(const SimOrder& o, ExecutionReport::Type type, int lastQty, PriceTicks px) {
+    if (!m_sink) return;
+    ExecutionReport& r = m_scratch;
+    r.type       = type;
+    r.orderId.assign(o.orderId);
+    r.account    = o.account;
+    r.instrument = o.instrument;
+    r.action     = o.action;
+    r.lastQty    = lastQty;
+    r.lastPx     = lastQty > 0 ? FromBookPrice(px) : FixedPrice{};
+    r.cumQty     = o.cumQty;
+    r.leavesQty  = (type == ExecutionReport::Type::Canceled) ? 0 : o.quantity - o.cumQty;
+    r.timeUs     = m_markets[o.instrument].timeUs;
+    m_sink(r);
+}
+
+// ---------------------------------------------------------------------------
+// Market data
+// ---------------------------------------------------------------------------
+
+SimExchangeAdapter::Market& SimExchangeAdapter::market(SymbolId instrument) {
+    if (instrument >= m_markets.size()) m_markets.resize(static_cast<size_t>(instrument) + 1);
+    return m_markets[instrument];
+}
+
+void SimExchangeAdapter::apply(const MarketEvent& ev) {
+    Market& m = market(ev.instrument);
+    m.timeUs = ev.timeUs;
+    if (ev.kind == MarketEvent::Kind::Trade) {
+        onTrade(m, ev.price, ev.size);
+    } else {
+        m.bid      = ev.price;
+        m.bidSize  = ev.size;
+        m.ask      = ev.ask;
+        m.askSize  = ev.askSize;
+        m.hasQuote = true;
+        onQuote(m);
+    }
+}
+
+void SimExchangeAdapter::onQuote(Market& m) {
+    // Resting orders priced through the new quote take its displayed size.
+    if (m.book.OrderCount() == 0) return;
+    auto fillAt = [this](PriceTicks eventPx) {
+        return [this, eventPx](uint64_t tag, int qty, PriceTicks levelPx, int) {
+            fill(static_cast<uint32_t>(tag), qty, IsMarketPrice(levelPx) ? eventPx : levelPx);
+        };
+    };
+    if (m.askSize > 0) m.askSize -= m.book.Match(BookSide::Bid, m.ask, m.askSize, fillAt(m.ask));
+    if (m.bidSize > 0) m.bidSize -= m.book.Match(BookSide::Ask, m.bid, m.bidSize, fillAt(m.bid));
+}
+
+void SimExchangeAdapter::onTrade(Market& m, PriceTicks px, int size) {
+    m.last     = px;
+    m.hasTrade = true;
+
+    // Elect stops first, in arrival order, so they can trade on this print.
+    if (!m.stops.empty()) {
+        m_elected.clear();
+        size_t kept = 0;
+        for (uint32_t idx : m.stops) {
+            const SimOrder& o = m_orders[idx];
+            bool elected = (o.action == Action::BUY) ? px >= o.stop : px <= o.stop;
+            if (elected) m_elected.push_back(idx);
+            else         m.stops[kept++] = idx;
+        }
+        m.stops.resize(kept);
+        for (uint32_t idx : m_elected) trigger(idx);
+    }
+
+    if (m.book.OrderCount() == 0 || size <= 0) return;
+    auto onFill = [this, px](uint64_t tag, int qty, PriceTicks levelPx, int) {
+        fill(static_cast<uint32_t>(tag), qty, IsMarketPrice(levelPx) ? px : levelPx);
+    };
+    // One print is one quantity: what the bids take is gone for the asks.
+    int left = size - m.book.Match(BookSide::Bid, px, size, onFill);
+    if (left > 0) m.book.Match(BookSide::Ask, px, left, onFill);
+}
+
+} // namespace Bridge
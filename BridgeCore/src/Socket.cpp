@@ -0,0 +1,222 @@
+#include "Socket.h"
+#include <algorithm>
+#include <climits>
+#include <string>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#include <mutex>
+#pragma comment(lib, "Ws2_32.lib")
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace Bridge {
+
+namespace {
+
+#ifdef _WIN32
+using NativeSocket = SOCKET;
+constexpr int kSendFlags = 0;
+
+void StartWinsock() noexcept {
+    static std::once_flag once;
+    std::call_once(once, [] {
+        WSADATA data;
+        WSAStartup(MAKEWORD(2, 2), &data);
+    });
+}
+
+void CloseNative(NativeSocket s) noexcept { closesocket(s); }
+int  PollOne(pollfd& p, int timeoutMs) noexcept { return WSAPoll(&p, 1, timeoutMs); }
+bool InProgress() noexcept { return WSAGetLastError() == WSAEWOULDBLOCK; }
+
+void SetBlocking(NativeSocket s, bool blocking) noexcept {
+    u_long nonBlocking = blocking ? 0 : 1;
+    ioctlsocket(s, FIONBIO, &nonBlocking);
+}
+#else
+using NativeSocket = int;
+constexpr int kSendFlags = MSG_NOSIGNAL;
+
+void StartWinsock() noexcept {}
+void CloseNative(NativeSocket s) noexcept { ::close(s); }
+int  PollOne(pollfd& p, int timeoutMs) noexcept { return ::poll(&p, 1, timeoutMs); }
+bool InProgress() noexcept { return errno == EINPROGRESS; }
+
+void SetBlocking(NativeSocket s, bool blocking) noexcept {
+    int flags = fcntl(s, F_GETFL, 0);
+    fcntl(s, F_SETFL, blocking ? (flags & ~O_NONBLOCK) : (flags | O_NONBLOCK));
+}
+#endif
+
+NativeSocket Native(intptr_t fd) noexcept { return static_cast<NativeSocket>(fd); }
+
+void SetNoDelay(NativeSocket s) noexcept {
+    int on = 1;
+    setsockopt(s, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&on), sizeof(on));
+}
+
+// First IPv4/IPv6 address for host:port, or nullptr. Free with freeaddrinfo.
+addrinfo* Resolve(const std::string& host, uint16_t port, bool passive) noexcept {
+    addrinfo hints{};
+    hints.ai_family   = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_protocol = IPPROTO_TCP;
+    if (passive) hints.ai_flags = AI_PASSIVE;
+    addrinfo* res = nullptr;
+    std::string service = std::to_string(port);
+    if (getaddrinfo(host.empty() ? nullptr : host.c_str(), service.c_str(), &hints, &res) != 0) return nullptr;
+    return res;
+}
+
+} // anonymous namespace
+
+Socket::~Socket() {
+    Close();
+}
+
+Socket::Socket(Socket&& other) noexcept : m_fd(other.m_fd) {
+    other.m_fd = kInvalid;
+}
+
+Socket& Socket::operator=(Socket&& other) noexcept {
+    if (this != &other) {
+        Close();
+        m_fd       = other.m_fd;
+        other.m_fd = kInvalid;
+    }
+    return *this;
+}
+
+Socket Socket::Connect(const std::string& host, uint16_t port, int timeoutMs) noexcept {
+    StartWinsock();
+    addrinfo* res = Resolve(host, port, false);
+    if (!res) return Socket();
+    Socket out;
+    for (addrinfo* ai = res; ai && !out.IsOpen(); ai = ai->ai_next) {
+        NativeSocket s = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+        if (s == static_cast<NativeSocket>(kInvalid)) continue;
+        // Non-blocking connect so the timeout holds even for a silent host.
+        SetBlocking(s, false);
+        bool ok = connect(s, ai->ai_addr, static_cast<int>(ai->ai_addrlen)) == 0;
+        if (!ok && InProgress()) {
+            pollfd p{};
+            p.fd     = s;
+            p.events = POLLOUT;
+            int err = 0;
+            socklen_t len = sizeof(err);
+            ok = PollOne(p, timeoutMs) == 1 &&
+                 getsockopt(s, SOL_SOCKET, SO_ERROR, reinterpret_cast<char*>(&err), &len) == 0 && err == 0;
+        }
+        if (!ok) {
+            CloseNative(s);
+            continue;
+        }
+        SetBlocking(s, true);
+        SetNoDelay(s);
+        out = Socket(static_cast<intptr_t>(s));
+    }
+    freeaddrinfo(res);
+    return out;
+}
+
+Socket Socket::Listen(const std::string& host, uint16_t port) noexcept {
+    StartWinsock();
+    addrinfo* res = Resolve(host, port, true);
+    if (!res) return Socket();
+    Socket out;
+    NativeSocket s = socket(res->ai_family, res->ai_socktype, res->ai_protocol);
+    if (s != static_cast<NativeSocket>(kInvalid)) {
+        int on = 1;
+        setsockopt(s, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&on), sizeof(on));
+        if (bind(s, res->ai_addr, static_cast<int>(res->ai_addrlen)) == 0 && listen(s, 8) == 0)
+            out = Socket(static_cast<intptr_t>(s));
+        else
+            CloseNative(s);
+    }
+    freeaddrinfo(res);
+    return out;
+}
+
+Socket Socket::Accept(int timeoutMs) noexcept {
+    if (!IsOpen()) return Socket();
+    pollfd p{};
+    p.fd     = Native(m_fd);
+    p.events = POLLIN;
+    if (PollOne(p, timeoutMs) != 1) return Socket();
+    NativeSocket s = accept(Native(m_fd), nullptr, nullptr);
+    if (s == static_cast<NativeSocket>(kInvalid)) return Socket();
+    SetNoDelay(s);
+    return Socket(static_cast<intptr_t>(s));
+}
+
+uint16_t Socket::LocalPort() const noexcept {
+    if (!IsOpen()) return 0;
+    sockaddr_storage addr{};
+    socklen_t len = sizeof(addr);
+    if (getsockname(Native(m_fd), reinterpret_cast<sockaddr*>(&addr), &len) != 0) return 0;
+    if (addr.ss_family == AF_INET)  return ntohs(reinterpret_cast<sockaddr_in*>(&addr)->sin_port);
+    if (addr.ss_family == AF_INET6) return ntohs(reinterpret_cast<sockaddr_in6*>(&addr)->sin6_port);
+    return 0;
+}
+
+bool Socket::SendAll(const char* data, size_t len) noexcept {
+    if (!IsOpen()) return false;
+    while (len > 0) {
+        int chunk = static_cast<int>(std::min<size_t>(len, INT_MAX));
+        int n = static_cast<int>(send(Native(m_fd), data, chunk, kSendFlags));
+        if (n <= 0) {
+#ifndef _WIN32
+            if (n < 0 && errno == EINTR) continue;
+#endif
+            return false;
+        }
+        data += n;
+        len  -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+int Socket::Receive(char* buf, size_t cap, int timeoutMs) noexcept {
+    if (!IsOpen()) return -1;
+    pollfd p{};
+    p.fd     = Native(m_fd);
+    p.events = POLLIN;
+    int ready = PollOne(p, timeoutMs);
+    if (ready == 0) return 0;
+    if (ready < 0) {
+#ifndef _WIN32
+        if (errno == EINTR) return 0;
+#endif
+        return -1;
+    }
+    int n = static_cast<int>(recv(Native(m_fd), buf, static_cast<int>(std::min<size_t>(cap, INT_MAX)), 0));
+    return n > 0 ? n : -1;
+}
+
+void Socket::Shutdown() noexcept {
+    if (!IsOpen()) return;
+#ifdef _WIN32
+    shutdown(Native(m_fd), SD_BOTH);
+#else
+    shutdown(Native(m_fd), SHUT_RDWR);
+#endif
+}
+
+void Socket::Close() noexcept {
+    if (!IsOpen()) return;
+    CloseNative(Native(m_fd));
+    m_fd = kInvalid;
+}
+
+} // namespace Bridge
@@ -0,0 +1,98 @@
+#include "SymbolTable.h"
+#include "Logger.h"
+#include "Types.h"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+namespace Bridge {
+
+// Strategies use a handful of accounts and a few dozen contracts; these
+// limits leave generous head-room while keeping the probe array in L2.
+static constexpr uint32_t kMaxSymbols = 4096;
+static constexpr uint32_t kSlots      = 8192;   // power of two, 2x kMaxSymbols
+
+// Entries are written once, before their id is published to a slot with a
+// release store, and never modified afterwards.
+struct SymbolEntry {
+    uint64_t    hash = 0;
+    std::string text;
+};
+
+static std::atomic<uint32_t> g_slots[kSlots];          // 0 = empty
+static SymbolEntry           g_entries[kMaxSymbols + 1];
+static std::atomic<uint32_t> g_count{ 0 };             // written under g_insertMutex
+static std::mutex            g_insertMutex;
+
+static uint64_t HashSymbol(std::string_view s) noexcept {
+    uint64_t h = 14695981039346656037ull;              // FNV-1a 64
+    for (char c : s)
+        h = (h ^ static_cast<uint8_t>(c)) * 1099511628211ull;
+    return h;
+}
+
+// Probe for 's'. Returns its id, or kNoSymbol with 'emptySlot' set to the
+// slot where it would be inserted.
+static SymbolId Probe(std::string_view s, uint64_t hash, uint32_t& emptySlot) noexcept {
+    uint32_t i = static_cast<uint32_t>(hash) & (kSlots - 1);
+    for (;;) {
+        uint32_t id = g_slots[i].load(std::memory_order_acquire);
+        if (id == kNoSymbol) {
+            emptySlot = i;
+            return kNoSymbol;
+        }
+        const SymbolEntry& e = g_entries[id];
+        if (e.hash == hash && e.text == s)
+            return id;
+        i = (i + 1) & (kSlots - 1);
+    }
+}
+
+SymbolId FindSymbol(std::string_view s) noexcept {
+    if (s.empty()) return kNoSymbol;
+    uint32_t slot = 0;
+    return Probe(s, HashSymbol(s), slot);
+}
+
+SymbolId InternSymbol(std::string_view s) noexcept {
+    if (s.empty()) return kNoSymbol;
+    uint64_t hash = HashSymbol(s);
+    uint32_t slot = 0;
+    SymbolId id = Probe(s, hash, slot);
+    if (id != kNoSymbol) return id;
+
+    try {
+        std::lock_guard<std::mutex> lk(g_insertMutex);
+        // Another thread may have inserted it since the lock-free probe.
+        id = Probe(s, hash, slot);
+        if (id != kNoSymbol) return id;
+        uint32_t count = g_count.load(std::memory_order_relaxed);
+        if (count == kMaxSymbols) {
+            static bool warned = false;   // under g_insertMutex
+            if (!warned) {
+                warned = true;
+                BRIDGE_LOG_ERROR("Symbol table full (" + std::to_string(kMaxSymbols) +
+                                 " accounts and instruments); requests naming new ones are refused");
+            }
+            return kNoSymbol;
+        }
+
+        id = count + 1;
+        g_entries[id].hash = hash;
+        g_entries[id].text.assign(s.data(), s.size());
+        g_count.store(id, std::memory_order_release);
+        g_slots[slot].store(id, std::memory_order_release);
+        return id;
+    }
+    catch (...) {
+        return kNoSymbol;
+    }
+}
+
+std::string_view SymbolName(SymbolId id) noexcept {
+    if (id == kNoSymbol || id > g_count.load(std::memory_order_acquire)) return {};
+    return g_entries[id].text;
+}
+
+} // namespace Bridge
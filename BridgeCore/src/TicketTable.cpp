@@ -0,0 +1,43 @@
+#include "TicketTable.h"
+#include "Types.h"
+
+namespace Bridge {
+
+static size_t RoundUpPow2(size_t n) noexcept {
+    size_t p = 1;
+    while (p < n) p <<= 1;
+    return p;
+}
+
+static uint64_t Pack(int ticket, int rc) noexcept {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(ticket)) << 32) |
+           static_cast<uint32_t>(rc);
+}
+
+TicketTable::TicketTable(size_t capacity)
+    : m_mask(RoundUpPow2(capacity ? capacity : 1) - 1),
+      m_slots(new std::atomic<uint64_t>[m_mask + 1])
+{
+    // Ticket 0 is never issued, so an all-zero slot matches nothing.
+    for (size_t i = 0; i <= m_mask; ++i)
+        m_slots[i].store(0, std::memory_order_relaxed);
+}
+
+int TicketTable::NewTicket() noexcept {
+    uint32_t n = m_next.fetch_add(1, std::memory_order_relaxed);
+    return static_cast<int>(n % 0x7FFFFFFFu) + 1;
+}
+
+void TicketTable::Store(int ticket, int rc) noexcept {
+    m_slots[static_cast<uint32_t>(ticket) & m_mask].store(Pack(ticket, rc), std::memory_order_release);
+}
+
+int TicketTable::Load(int ticket) const noexcept {
+    if (ticket <= 0) return RC_UNKNOWN_TICKET;
+    uint64_t v = m_slots[static_cast<uint32_t>(ticket) & m_mask].load(std::memory_order_acquire);
+    if (static_cast<uint32_t>(v >> 32) != static_cast<uint32_t>(ticket))
+        return RC_UNKNOWN_TICKET;
+    return static_cast<int>(static_cast<uint32_t>(v));
+}
+
+} // namespace Bridge
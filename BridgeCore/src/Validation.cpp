@@ -1,52 +1,30 @@
 #include "Validation.h"
 #include "Types.h"
-#include <algorithm>
-#include <cctype>
-#include <string>
+#include "Keywords.h"
+#include <string_view>
 
 namespace Bridge {
 
-static std::string ToUpper(const std::string& s) {
-    std::string r = s;
-    std::transform(r.begin(), r.end(), r.begin(),
-        [](unsigned char c){ return static_cast<char>(std::toupper(c)); });
-    return r;
+Command ParseCommand(std::string_view s) noexcept {
+    return LookupKeywordAs(s, KeywordKind::Command, Command::UNKNOWN);
 }
 
-Command ParseCommand(const std::string& s) noexcept {
-    std::string u = ToUpper(s);
-    if (u == "PLACE")            return Command::PLACE;
-    if (u == "CANCEL")           return Command::CANCEL;
-    if (u == "CANCELALLORDERS")  return Command::CANCELALLORDERS;
-    if (u == "CHANGE")           return Command::CHANGE;
-    if (u == "CLOSEPOSITION")    return Command::CLOSEPOSITION;
-    if (u == "CLOSESTRATEGY")    return Command::CLOSESTRATEGY;
-    if (u == "FLATTENEVERYTHING")return Command::FLATTENEVERYTHING;
-    if (u == "REVERSEPOSITION")  return Command::REVERSEPOSITION;
-    return Command::UNKNOWN;
+Action ParseAction(std::string_view s) noexcept {
+    return LookupKeywordAs(s, KeywordKind::Action, Action::UNKNOWN);
 }
 
-Action ParseAction(const std::string& s) noexcept {
-    std::string u = ToUpper(s);
-    if (u == "BUY")  return Action::BUY;
-    if (u == "SELL") return Action::SELL;
-    return Action::UNKNOWN;
+OrderType ParseOrderType(std::string_view s) noexcept {
+    return LookupKeywordAs(s, KeywordKind::OrderType, OrderType::UNKNOWN);
 }
 
-OrderType ParseOrderType(const std::string& s) noexcept {
-    std::string u = ToUpper(s);
-    if (u == "MARKET")     return OrderType::MARKET;
-    if (u == "LIMIT")      return OrderType::LIMIT;
-    if (u == "STOPMARKET") return OrderType::STOPMARKET;
-    if (u == "STOPLIMIT")  return OrderType::STOPLIMIT;
-    return OrderType::UNKNOWN;
+TimeInForce ParseTimeInForce(std::string_view s) noexcept {
+    return LookupKeywordAs(s, KeywordKind::TimeInForce, TimeInForce::UNKNOWN);
 }
 
-TimeInForce ParseTimeInForce(const std::string& s) noexcept {
-    std::string u = ToUpper(s);
-    if (u == "DAY") return TimeInForce::DAY;
-    if (u == "GTC") return TimeInForce::GTC;
-    return TimeInForce::UNKNOWN;
+// Use the exact fixed-point price when the request carries one; hand-built
+// requests without it fall back to the double (NaN is not positive).
+static bool IsPositivePrice(const FixedPrice& px, double value) noexcept {
+    return px.IsSet() ? px.ticks > 0 : value > 0.0;
 }
 
 int ValidateRequest(const OrderRequest& req) noexcept {
@@ -73,11 +51,11 @@ int ValidateRequest(const OrderRequest& req) noexcept {
         if (req.timeInForce == TimeInForce::UNKNOWN) return RC_INVALID_PARAM;
 
         if (req.orderType == OrderType::LIMIT || req.orderType == OrderType::STOPLIMIT) {
-            if (req.limitPrice <= 0.0)
+            if (!IsPositivePrice(req.limitPx, req.limitPrice))
                 return RC_INVALID_PARAM;
         }
         if (req.orderType == OrderType::STOPMARKET || req.orderType == OrderType::STOPLIMIT) {
-            if (req.stopPrice <= 0.0)
+            if (!IsPositivePrice(req.stopPx, req.stopPrice))
                 return RC_INVALID_PARAM;
         }
     }
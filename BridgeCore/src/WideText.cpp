@@ -0,0 +1,175 @@
+#include "WideText.h"
+#include <cstdint>
+#include <cwchar>
+
+#if defined(__AVX2__)
+#  define BRIDGE_NARROW_AVX2 1
+#  include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define BRIDGE_NARROW_SSE2 1
+#  include <emmintrin.h>
+#endif
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#endif
+
+namespace Bridge {
+
+// wchar_t is UTF-16 on Windows and UTF-32 elsewhere; the vector paths
+// handle either width.
+static constexpr bool kWide16 = (sizeof(wchar_t) == 2);
+
+// Copy the leading run of ASCII code units of w[0..n) into out. Returns how
+// many were copied; stops at the first code unit above 0x7F.
+static size_t NarrowAsciiPrefix(const wchar_t* w, size_t n, char* out) noexcept {
+    size_t i = 0;
+#if defined(BRIDGE_NARROW_AVX2)
+    if constexpr (kWide16) {
+        const __m256i high = _mm256_set1_epi16(static_cast<short>(0xFF80));
+        for (; i + 16 <= n; i += 16) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(w + i));
+            if (!_mm256_testz_si256(v, high)) break;
+            __m128i packed = _mm_packus_epi16(_mm256_castsi256_si128(v),
+                                              _mm256_extracti128_si256(v, 1));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), packed);
+        }
+    } else {
+        const __m256i high = _mm256_set1_epi32(static_cast<int>(0xFFFFFF80u));
+        for (; i + 16 <= n; i += 16) {
+            __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(w + i));
+            __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(w + i + 8));
+            if (!_mm256_testz_si256(_mm256_or_si256(a, b), high)) break;
+            __m128i lo = _mm_packs_epi32(_mm256_castsi256_si128(a), _mm256_extracti128_si256(a, 1));
+            __m128i hi = _mm_packs_epi32(_mm256_castsi256_si128(b), _mm256_extracti128_si256(b, 1));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(lo, hi));
+        }
+    }
+#elif defined(BRIDGE_NARROW_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    if constexpr (kWide16) {
+        const __m128i high = _mm_set1_epi16(static_cast<short>(0xFF80));
+        for (; i + 8 <= n; i += 8) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(w + i));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(v, high), zero)) != 0xFFFF) break;
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(v, v));
+        }
+    } else {
+        const __m128i high = _mm_set1_epi32(static_cast<int>(0xFFFFFF80u));
+        for (; i + 8 <= n; i += 8) {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(w + i));
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(w + i + 4));
+            __m128i any = _mm_and_si128(_mm_or_si128(a, b), high);
+            if (_mm_movemask_epi8(_mm_cmpeq_epi32(any, zero)) != 0xFFFF) break;
+            __m128i p16 = _mm_packs_epi32(a, b);   // all values < 0x80: no saturation
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(p16, p16));
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        uint32_t c = static_cast<uint32_t>(w[i]);
+        if (c > 0x7F) break;
+        out[i] = static_cast<char>(c);
+    }
+    return i;
+}
+
+#ifndef _WIN32
+// Full UTF-8 encoding of w[0..n). Lone surrogates become U+FFFD, as
+// WideCharToMultiByte does. Writes at most 'cap' bytes; returns the length
+// the whole input needs.
+static size_t EncodeUtf8(const wchar_t* w, size_t n, char* out, size_t cap) noexcept {
+    size_t len = 0;
+    auto put = [&](uint32_t b) {
+        if (len < cap) out[len] = static_cast<char>(b);
+        ++len;
+    };
+    for (size_t i = 0; i < n; ++i) {
+        uint32_t cp = static_cast<uint32_t>(w[i]);
+        if (kWide16 && cp >= 0xD800 && cp <= 0xDBFF && i + 1 < n) {
+            uint32_t lo = static_cast<uint32_t>(w[i + 1]);
+            if (lo >= 0xDC00 && lo <= 0xDFFF) {
+                cp = 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00);
+                ++i;
+            }
+        }
+        if ((cp >= 0xD800 && cp <= 0xDFFF) || cp > 0x10FFFF) cp = 0xFFFD;
+
+        if (cp < 0x80) {
+            put(cp);
+        } else if (cp < 0x800) {
+            put(0xC0 | (cp >> 6));
+            put(0x80 | (cp & 0x3F));
+        } else if (cp < 0x10000) {
+            put(0xE0 | (cp >> 12));
+            put(0x80 | ((cp >> 6) & 0x3F));
+            put(0x80 | (cp & 0x3F));
+        } else {
+            put(0xF0 | (cp >> 18));
+            put(0x80 | ((cp >> 12) & 0x3F));
+            put(0x80 | ((cp >> 6) & 0x3F));
+            put(0x80 | (cp & 0x3F));
+        }
+    }
+    return len;
+}
+#endif
+
+size_t NarrowWide(const wchar_t* w, char* buf, size_t cap) noexcept {
+    if (!w) {
+        if (cap) buf[0] = '\0';
+        return 0;
+    }
+    size_t n    = std::wcslen(w);
+    bool   fits = n < cap;        // UTF-8 is never shorter than the code unit count
+    size_t done = 0;
+    if (fits) {
+        done = NarrowAsciiPrefix(w, n, buf);
+        if (done == n) {
+            buf[n] = '\0';
+            return n;
+        }
+    } else {
+        // Only measuring, so the caller can retry with a big enough buffer.
+        while (done < n && static_cast<uint32_t>(w[done]) <= 0x7F) ++done;
+        if (done == n) return n;
+    }
+
+    // Slow path: UTF-8 encode from the first non-ASCII code unit onwards.
+    const wchar_t* tail    = w + done;
+    size_t         tailLen = n - done;
+    char*          out     = fits ? buf + done : nullptr;
+    size_t         room    = fits ? cap - done - 1 : 0;
+#ifdef _WIN32
+    int need = WideCharToMultiByte(CP_UTF8, 0, tail, static_cast<int>(tailLen),
+                                   nullptr, 0, nullptr, nullptr);
+    if (need <= 0) {
+        if (fits) buf[done] = '\0';
+        return done;
+    }
+    size_t total = done + static_cast<size_t>(need);
+    if (out && static_cast<size_t>(need) <= room) {
+        WideCharToMultiByte(CP_UTF8, 0, tail, static_cast<int>(tailLen),
+                            out, need, nullptr, nullptr);
+        buf[total] = '\0';
+    }
+    return total;
+#else
+    size_t total = done + EncodeUtf8(tail, tailLen, out, room);
+    if (total < cap) buf[total] = '\0';
+    return total;
+#endif
+}
+
+const char* NarrowWideIsa() noexcept {
+#if defined(BRIDGE_NARROW_AVX2)
+    return "AVX2";
+#elif defined(BRIDGE_NARROW_SSE2)
+    return "SSE2";
+#else
+    return "scalar";
+#endif
+}
+
+} // namespace Bridge
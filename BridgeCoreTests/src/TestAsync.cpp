@@ -0,0 +1,182 @@
+#include "TestFramework.h"
+#include "../../BridgeCore/include/BoundedQueue.h"
+#include "../../BridgeCore/include/TicketTable.h"
+#include "../../BridgeCore/include/BridgeEngine.h"
+#include "../../BridgeCore/include/Config.h"
+#include "../../BridgeCore/include/MockAdapter.h"
+#include "../../BridgeCore/include/Types.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+static Bridge::OrderRequest MakeAsyncReq(int qty)
+{
+    Bridge::OrderRequest r;
+    r.command     = Bridge::Command::PLACE;
+    r.account     = "ACC1";
+    r.instrument  = "ES";
+    r.action      = Bridge::Action::BUY;
+    r.quantity    = qty;
+    r.orderType   = Bridge::OrderType::MARKET;
+    r.timeInForce = Bridge::TimeInForce::DAY;
+    return r;
+}
+
+// Poll until the ticket leaves RC_PENDING or ~5 s pass.
+static int WaitForResult(const Bridge::BridgeEngine& engine, int ticket)
+{
+    int rc = Bridge::RC_PENDING;
+    for (int i = 0; i < 5000 && rc == Bridge::RC_PENDING; ++i) {
+        rc = engine.PollResult(ticket);
+        if (rc == Bridge::RC_PENDING)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return rc;
+}
+
+void TestAsync() {
+    printf("\n-- TestAsync --\n");
+
+    // BoundedQueue: FIFO, capacity rounded up, push fails when full
+    {
+        Bridge::BoundedQueue<int> q(5);
+        CHECK_EQ((int)q.Capacity(), 8);
+        int pushed = 0;
+        for (int i = 0; i < 10; ++i) pushed += q.TryPush(int(i)) ? 1 : 0;
+        CHECK_EQ(pushed, 8);
+        int v = -1;
+        CHECK_TRUE(q.TryPop(v));
+        CHECK_EQ(v, 0);
+        CHECK_TRUE(q.TryPush(100));
+        bool inOrder = true;
+        for (int expect : { 1, 2, 3, 4, 5, 6, 7, 100 }) {
+            inOrder = inOrder && q.TryPop(v) && v == expect;
+        }
+        CHECK_TRUE(inOrder);
+        CHECK_FALSE(q.TryPop(v));
+    }
+
+    // BoundedQueue: concurrent producers and consumers lose nothing
+    {
+        constexpr int kProducers = 4, kConsumers = 2, kPerProducer = 20000;
+        Bridge::BoundedQueue<int> q(256);
+        std::atomic<long long> sum{ 0 };
+        std::atomic<int>       popped{ 0 };
+        std::vector<std::thread> threads;
+        for (int p = 0; p < kProducers; ++p) {
+            threads.emplace_back([&q, p] {
+                for (int i = 1; i <= kPerProducer; ++i) {
+                    int v = p * kPerProducer + i;
+                    while (!q.TryPush(int(v))) std::this_thread::yield();
+                }
+            });
+        }
+        for (int c = 0; c < kConsumers; ++c) {
+            threads.emplace_back([&] {
+                int v = 0;
+                while (popped.load() < kProducers * kPerProducer) {
+                    if (q.TryPop(v)) { sum += v; ++popped; }
+                    else std::this_thread::yield();
+                }
+            });
+        }
+        for (auto& t : threads) t.join();
+        long long n = (long long)kProducers * kPerProducer;
+        CHECK_EQ(popped.load(), kProducers * kPerProducer);
+        CHECK_TRUE(sum.load() == n * (n + 1) / 2);
+    }
+
+    // TicketTable: positive tickets, unknown until stored, recycled slots expire
+    {
+        Bridge::TicketTable t(4);
+        CHECK_EQ((int)t.Capacity(), 4);
+        CHECK_EQ(t.Load(0), Bridge::RC_UNKNOWN_TICKET);
+        CHECK_EQ(t.Load(-3), Bridge::RC_UNKNOWN_TICKET);
+        int first = t.NewTicket();
+        CHECK_EQ(first, 1);
+        CHECK_EQ(t.Load(first), Bridge::RC_UNKNOWN_TICKET);
+        t.Store(first, Bridge::RC_PENDING);
+        CHECK_EQ(t.Load(first), Bridge::RC_PENDING);
+        t.Store(first, Bridge::RC_INVALID_CMD);
+        CHECK_EQ(t.Load(first), Bridge::RC_INVALID_CMD);
+        int last = 0;
+        for (int i = 0; i < 4; ++i) { last = t.NewTicket(); t.Store(last, Bridge::RC_SUCCESS); }
+        CHECK_EQ(t.Load(first), Bridge::RC_UNKNOWN_TICKET);
+        CHECK_EQ(t.Load(last), Bridge::RC_SUCCESS);
+    }
+
+    // Engine with workers: tickets complete with the adapter's code
+    {
+        Bridge::BridgeConfig cfg;
+        cfg.adapterType     = "MOCK";
+        cfg.asyncWorkers    = 2;
+        cfg.asyncQueueDepth = 64;
+        Bridge::BridgeEngine engine(cfg);
+
+        std::vector<int> tickets;
+        for (int i = 0; i < 50; ++i) {
+            int t = engine.ExecuteAsync(MakeAsyncReq(1));
+            if (t == Bridge::RC_QUEUE_FULL) { --i; std::this_thread::yield(); continue; }
+            tickets.push_back(t);
+        }
+        bool allPositive = true, allOk = true;
+        for (int t : tickets) {
+            allPositive = allPositive && t > 0;
+            allOk = allOk && WaitForResult(engine, t) == Bridge::RC_SUCCESS;
+        }
+        CHECK_TRUE(allPositive);
+        CHECK_TRUE(allOk);
+
+        Bridge::OrderRequest bad;
+        bad.command = Bridge::Command::UNKNOWN;
+        int t = engine.ExecuteAsync(bad);
+        CHECK_TRUE(t > 0);
+        CHECK_EQ(WaitForResult(engine, t), Bridge::RC_INVALID_CMD);
+        CHECK_EQ(engine.PollResult(t + 1000), Bridge::RC_UNKNOWN_TICKET);
+    }
+
+    // asyncWorkers = 0: the order runs inline and the ticket is already final
+    {
+        Bridge::BridgeConfig cfg;
+        cfg.adapterType  = "MOCK";
+        cfg.asyncWorkers = 0;
+        Bridge::BridgeEngine engine(cfg);
+        int t = engine.ExecuteAsync(MakeAsyncReq(1));
+        CHECK_TRUE(t > 0);
+        CHECK_EQ(engine.PollResult(t), Bridge::RC_SUCCESS);
+    }
+
+    // Destroying an engine drains what is already queued
+    {
+        Bridge::BridgeConfig cfg;
+        cfg.adapterType  = "MOCK";
+        cfg.asyncWorkers = 1;
+        int submitted = 0;
+        {
+            Bridge::BridgeEngine engine(cfg);
+            for (int i = 0; i < 20; ++i)
+                submitted += engine.ExecuteAsync(MakeAsyncReq(1)) > 0 ? 1 : 0;
+        }
+        CHECK_EQ(submitted, 20);
+    }
+
+    // Shutdown drains the queue, releases the adapter and refuses what follows
+    {
+        Bridge::BridgeConfig cfg;
+        cfg.adapterType  = "MOCK";
+        cfg.asyncWorkers = 1;
+        auto adapter = std::make_shared<Bridge::MockAdapter>();
+        Bridge::BridgeEngine engine(cfg, adapter);
+        int t = engine.ExecuteAsync(MakeAsyncReq(1));
+        CHECK_TRUE(t > 0);
+        engine.Shutdown();
+        CHECK_EQ(engine.PollResult(t), Bridge::RC_SUCCESS);
+        CHECK_EQ((int)adapter.use_count(), 1);
+        CHECK_FALSE(engine.IsConnected());
+        CHECK_EQ(engine.Execute(MakeAsyncReq(1)), Bridge::RC_NOT_CONNECTED);
+        CHECK_EQ(engine.ExecuteAsync(MakeAsyncReq(1)), Bridge::RC_NOT_CONNECTED);
+        engine.Shutdown();   // again: no-op, as is the destructor's
+    }
+}
@@ -0,0 +1,142 @@
+#include "TestFramework.h"
+#include "../../BridgeCore/include/BridgeEngine.h"
+#include "../../BridgeCore/include/IBrokerAdapter.h"
+#include "../../BridgeCore/include/MockAdapter.h"
+#include "../../BridgeCore/include/Config.h"
+#include "../../BridgeCore/include/Types.h"
+#include <string>
+#include <vector>
+
+// Adapter that relies on the IBrokerAdapter::ExecuteBatch default.
+class CountingAdapter : public Bridge::IBrokerAdapter {
+public:
+    int calls = 0;
+    int  Execute(const Bridge::OrderRequest& req) override {
+        ++calls;
+        return req.quantity > 0 ? Bridge::RC_SUCCESS : Bridge::RC_INVALID_PARAM;
+    }
+    bool IsConnected() const noexcept override { return true; }
+};
+
+static Bridge::OrderRequest MakeBatchReq(const char* instrument, int qty)
+{
+    Bridge::OrderRequest r;
+    r.command     = Bridge::Command::PLACE;
+    r.account     = "ACC1";
+    r.instrument  = instrument;
+    r.action      = Bridge::Action::BUY;
+    r.quantity    = qty;
+    r.orderType   = Bridge::OrderType::MARKET;
+    r.timeInForce = Bridge::TimeInForce::DAY;
+    return r;
+}
+
+void TestBatch() {
+    printf("\n-- TestBatch --\n");
+
+    // Default ExecuteBatch loops over Execute in order
+    {
+        CountingAdapter adapter;
+        Bridge::OrderRequest reqs[3] = {
+            MakeBatchReq("ES", 1), MakeBatchReq("NQ", 0), MakeBatchReq("CL", 2)
+        };
+        int results[3] = { 99, 99, 99 };
+        adapter.ExecuteBatch(reqs, 3, results);
+        CHECK_EQ(adapter.calls, 3);
+        CHECK_EQ(results[0], Bridge::RC_SUCCESS);
+        CHECK_EQ(results[1], Bridge::RC_INVALID_PARAM);
+        CHECK_EQ(results[2], Bridge::RC_SUCCESS);
+    }
+
+    // MockAdapter batch override places orders in submission order
+    {
+        Bridge::MockAdapter adapter;
+        Bridge::OrderRequest reqs[3] = {
+            MakeBatchReq("ES", 1), MakeBatchReq("NQ", 2), MakeBatchReq("CL", 3)
+        };
+        reqs[2].command = Bridge::Command::UNKNOWN;
+        int results[3] = {};
+        adapter.ExecuteBatch(reqs, 3, results);
+        CHECK_EQ(results[0], Bridge::RC_SUCCESS);
+        CHECK_EQ(results[1], Bridge::RC_SUCCESS);
+        CHECK_EQ(results[2], Bridge::RC_INVALID_CMD);
+        CHECK_EQ((int)adapter.GetOrders().size(), 2);
+        CHECK_TRUE(adapter.GetOrders()[0].orderId == "MOCK-1");
+        CHECK_TRUE(adapter.GetOrders()[1].orderId == "MOCK-2");
+    }
+
+    Bridge::BridgeConfig cfg;
+    cfg.adapterType = "MOCK";
+    Bridge::BridgeEngine engine(cfg);
+
+    // Per-payload codes land in payload order; invalid lines do not block others
+    {
+        const char* batch =
+            "COMMAND=PLACE|ACCOUNT=ACC1|INSTRUMENT=ES|ACTION=BUY|QUANTITY=1|ORDERTYPE=MARKET|TIMEINFORCE=DAY\n"
+            "COMMAND=PLACE|ACCOUNT=ACC1|INSTRUMENT=ES|ACTION=BUY|QUANTITY=abc|ORDERTYPE=MARKET|TIMEINFORCE=DAY\n"
+            "COMMAND=BOGUS|ACCOUNT=ACC1|INSTRUMENT=ES\n"
+            "COMMAND=PLACE|ACCOUNT=ACC1|INSTRUMENT=NQ|ACTION=SELL|QUANTITY=2|ORDERTYPE=LIMIT|LIMITPRICE=15000.25|TIMEINFORCE=GTC";
+        int results[8];
+        int n = engine.ExecuteBatch(batch, results, 8);
+        CHECK_EQ(n, 4);
+        CHECK_EQ(results[0], Bridge::RC_SUCCESS);
+        CHECK_EQ(results[1], Bridge::RC_INVALID_PARAM);
+        CHECK_EQ(results[2], Bridge::RC_INVALID_CMD);
+        CHECK_EQ(results[3], Bridge::RC_SUCCESS);
+    }
+
+    // CRLF endings, blank lines and surrounding whitespace
+    {
+        const char* batch =
+            "\r\n"
+            "  COMMAND=CANCEL|ACCOUNT=ACC1|INSTRUMENT=ES  \r\n"
+            "\n"
+            "COMMAND=CANCELALLORDERS|ACCOUNT=ACC1\r\n";
+        int results[2];
+        int n = engine.ExecuteBatch(batch, results, 2);
+        CHECK_EQ(n, 2);
+        CHECK_EQ(results[0], Bridge::RC_SUCCESS);
+        CHECK_EQ(results[1], Bridge::RC_SUCCESS);
+    }
+
+    // Empty batch submits nothing
+    {
+        int results[1] = { 99 };
+        CHECK_EQ(engine.ExecuteBatch("", results, 1), 0);
+        CHECK_EQ(engine.ExecuteBatch("\n\r\n  \n", results, 1), 0);
+        CHECK_EQ(results[0], 99);
+    }
+
+    // More payloads than result slots: rejected without touching the buffer
+    {
+        int results[2] = { 99, 99 };
+        int n = engine.ExecuteBatch(
+            "COMMAND=CANCELALLORDERS|ACCOUNT=A\n"
+            "COMMAND=CANCELALLORDERS|ACCOUNT=B\n"
+            "COMMAND=CANCELALLORDERS|ACCOUNT=C", results, 2);
+        CHECK_EQ(n, Bridge::RC_INVALID_PARAM);
+        CHECK_EQ(results[0], 99);
+        CHECK_EQ(results[1], 99);
+    }
+
+    // Null results buffer / negative capacity
+    {
+        int results[1];
+        CHECK_EQ(engine.ExecuteBatch("COMMAND=CANCELALLORDERS|ACCOUNT=A", nullptr, 1),
+                 Bridge::RC_INVALID_PARAM);
+        CHECK_EQ(engine.ExecuteBatch("COMMAND=CANCELALLORDERS|ACCOUNT=A", results, -1),
+                 Bridge::RC_INVALID_PARAM);
+    }
+
+    // Larger batch
+    {
+        std::string batch;
+        for (int i = 0; i < 64; ++i)
+            batch += "COMMAND=PLACE|ACCOUNT=ACC1|INSTRUMENT=ES|ACTION=BUY|QUANTITY=1|ORDERTYPE=MARKET|TIMEINFORCE=DAY\n";
+        std::vector<int> results(64);
+        CHECK_EQ(engine.ExecuteBatch(batch, results.data(), 64), 64);
+        bool allOk = true;
+        for (int rc : results) allOk = allOk && rc == Bridge::RC_SUCCESS;
+        CHECK_TRUE(allOk);
+    }
+}
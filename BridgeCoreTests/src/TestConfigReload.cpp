@@ -0,0 +1,166 @@
+#include "TestFramework.h"
+#include "../../BridgeCore/include/BridgeEngine.h"
+#include "../../BridgeCore/include/ConfigStore.h"
+#include "../../BridgeCore/include/Config.h"
+#include "../../BridgeCore/include/IBrokerAdapter.h"
+#include "../../BridgeCore/include/Types.h"
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+
+// Adapter whose Execute blocks until released, to observe swap draining.
+class GateAdapter : public Bridge::IBrokerAdapter {
+public:
+    std::atomic<bool> entered{ false };
+    std::atomic<bool> release{ false };
+    std::atomic<bool> finished{ false };
+    std::atomic<int>  calls{ 0 };
+
+    bool IsConnected() const noexcept override { return true; }
+    int  Execute(const Bridge::OrderRequest&) override {
+        ++calls;
+        entered = true;
+        while (!release) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        finished = true;
+        return Bridge::RC_SUCCESS;
+    }
+};
+
+static Bridge::OrderRequest MakeReloadReq()
+{
+    Bridge::OrderRequest r;
+    r.command     = Bridge::Command::PLACE;
+    r.account     = "RELOAD1";
+    r.instrument  = "ES";
+    r.action      = Bridge::Action::BUY;
+    r.quantity    = 1;
+    r.orderType   = Bridge::OrderType::MARKET;
+    r.timeInForce = Bridge::TimeInForce::DAY;
+    return r;
+}
+
+static void WriteConfigFile(const std::filesystem::path& path, const std::string& body)
+{
+    // Write-then-rename, the way most editors save.
+    std::filesystem::path tmp = path;
+    tmp += ".tmp";
+    {
+        std::ofstream f(tmp, std::ios::trunc);
+        f << body;
+    }
+    std::filesystem::rename(tmp, path);
+}
+
+void TestConfigReload() {
+    printf("\n-- TestConfigReload --\n");
+
+    // Snapshots: old pointers stay valid and unchanged after a publish
+    {
+        Bridge::BridgeConfig a;
+        a.adapterType = "MOCK";
+        Bridge::ConfigStore store(a);
+        CHECK_EQ((int)store.Version(), 1);
+        const Bridge::BridgeConfig* first = store.Current();
+
+        Bridge::BridgeConfig b = a;
+        b.adapterType   = "FIX";
+        b.dedupWindowMs = 500;
+        const Bridge::BridgeConfig* prev = store.Publish(b);
+        CHECK_TRUE(prev == first);
+        CHECK_EQ((int)store.Version(), 2);
+        CHECK_STR_EQ(first->adapterType, std::string("MOCK"));
+        CHECK_STR_EQ(store.Current()->adapterType, std::string("FIX"));
+        CHECK_EQ(store.Current()->dedupWindowMs, 500);
+    }
+
+    // ApplyConfig: hot settings apply, startup-only settings are pinned
+    {
+        Bridge::BridgeConfig cfg;
+        cfg.adapterType = "MOCK";
+        Bridge::BridgeEngine engine(cfg);
+        auto req = MakeReloadReq();
+        engine.Execute(req);
+        engine.Execute(req);
+        CHECK_EQ((int)engine.DedupHits(), 0);
+
+        Bridge::BridgeConfig next = cfg;
+        next.dedupWindowMs  = 60000;
+        next.executionLanes = 4;
+        engine.ApplyConfig(next);
+        CHECK_EQ((int)engine.ConfigVersion(), 2);
+        CHECK_EQ(engine.Config().dedupWindowMs, 60000);
+        CHECK_EQ(engine.Config().executionLanes, 0);
+        engine.Execute(req);
+        engine.Execute(req);
+        CHECK_EQ((int)engine.DedupHits(), 1);
+
+        // Changing adapterType swaps the adapter
+        next.adapterType = "FIX";
+        engine.ApplyConfig(next);
+        CHECK_FALSE(engine.IsConnected());
+        CHECK_EQ(engine.Execute(req), Bridge::RC_NOT_CONNECTED);
+        CHECK_STR_EQ(engine.Config().adapterType, std::string("FIX"));   // published once swapped
+        CHECK_EQ((int)engine.ConfigVersion(), 3);
+        next.adapterType = "MOCK";
+        engine.ApplyConfig(next);
+        CHECK_TRUE(engine.IsConnected());
+    }
+
+    // SwapAdapter waits for in-flight calls on the old adapter
+    {
+        Bridge::BridgeConfig cfg;
+        cfg.adapterType = "MOCK";
+        auto oldAdapter = std::make_shared<GateAdapter>();
+        auto newAdapter = std::make_shared<GateAdapter>();
+        newAdapter->release = true;
+        Bridge::BridgeEngine engine(cfg, oldAdapter);
+
+        std::thread caller([&] { engine.Execute(MakeReloadReq()); });
+        while (!oldAdapter->entered) std::this_thread::yield();
+
+        std::atomic<bool> swapped{ false };
+        std::thread swapper([&] { engine.SwapAdapter(newAdapter); swapped = true; });
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        CHECK_FALSE(swapped.load());                       // still draining
+        engine.Execute(MakeReloadReq());                   // new calls already go to the new adapter
+        CHECK_EQ(newAdapter->calls.load(), 1);
+
+        oldAdapter->release = true;
+        caller.join();
+        swapper.join();
+        CHECK_TRUE(swapped.load());
+        CHECK_TRUE(oldAdapter->finished.load());
+        CHECK_EQ(oldAdapter->calls.load(), 1);
+    }
+
+    // Watching the config file reloads it on change
+    {
+        namespace fs = std::filesystem;
+        fs::path dir = fs::temp_directory_path() / "bridge_reload_test";
+        fs::remove_all(dir);
+        fs::create_directories(dir);
+        fs::path file = dir / "bridge.json";
+        WriteConfigFile(file, "{\n  \"adapterType\": \"MOCK\",\n  \"logFilePath\": \"\"\n}\n");
+
+        Bridge::BridgeConfig cfg;
+        CHECK_EQ(Bridge::LoadConfig(file.string(), cfg), Bridge::RC_SUCCESS);
+        cfg.logFilePath.clear();
+        Bridge::BridgeEngine engine(cfg);
+        CHECK_TRUE(engine.WatchConfigFile(file.string()));
+        CHECK_EQ(engine.Config().dedupWindowMs, 0);
+
+        WriteConfigFile(file, "{\n  \"adapterType\": \"MOCK\",\n  \"logFilePath\": \"\",\n"
+                              "  \"dedupWindowMs\": 250\n}\n");
+        for (int i = 0; i < 500 && engine.Config().dedupWindowMs != 250; ++i)
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        CHECK_EQ(engine.Config().dedupWindowMs, 250);
+        CHECK_TRUE(engine.IsConnected());
+
+        CHECK_FALSE(engine.WatchConfigFile(file.string()));   // already watching
+        fs::remove_all(dir);
+    }
+}
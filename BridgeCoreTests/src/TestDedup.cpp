@@ -0,0 +1,123 @@
+#include "TestFramework.h"
+#include "../../BridgeCore/include/DedupCache.h"
+#include "../../BridgeCore/include/BridgeEngine.h"
+#include "../../BridgeCore/include/Config.h"
+#include "../../BridgeCore/include/Parser.h"
+#include "../../BridgeCore/include/Types.h"
+#include <memory>
+
+static Bridge::OrderRequest ParseDedupReq(const char* payload)
+{
+    Bridge::OrderRequest r;
+    Bridge::ParsePayload(payload, r);
+    return r;
+}
+
+void TestDedup() {
+    printf("\n-- TestDedup --\n");
+
+    // Key normalization
+    {
+        using Bridge::DedupCache;
+        auto a = ParseDedupReq("COMMAND=PLACE|ACCOUNT=ACC1|INSTRUMENT=ES|ACTION=BUY|QUANTITY=1|ORDERTYPE=LIMIT|LIMITPRICE=5000.50|TIMEINFORCE=DAY");
+        auto b = ParseDedupReq("command=place|account=ACC1|instrument=ES|action=buy|quantity=1|orderType=limit|limitPrice=5000.5|timeInForce=day");
+        auto c = ParseDedupReq("COMMAND=PLACE|ACCOUNT=ACC1|INSTRUMENT=ES|ACTION=BUY|QUANTITY=2|ORDERTYPE=LIMIT|LIMITPRICE=5000.50|TIMEINFORCE=DAY");
+        auto d = ParseDedupReq("COMMAND=PLACE|ACCOUNT=ACC1|INSTRUMENT=ES|ACTION=BUY|QUANTITY=1|ORDERTYPE=LIMIT|LIMITPRICE=5000.50|TIMEINFORCE=DAY|BARKEY=20260105-0931");
+        CHECK_TRUE(DedupCache::KeyOf(a) == DedupCache::KeyOf(b));
+        CHECK_TRUE(DedupCache::KeyOf(a) != DedupCache::KeyOf(c));
+        CHECK_TRUE(DedupCache::KeyOf(a) != DedupCache::KeyOf(d));
+        CHECK_TRUE(d.barKey == Bridge::BarKeyOf("20260105-0931"));
+
+        // A request built from doubles keys the same as its parsed twin
+        Bridge::OrderRequest e = a;
+        e.limitPx = Bridge::FixedPrice{};
+        CHECK_TRUE(DedupCache::KeyOf(a) == DedupCache::KeyOf(e));
+    }
+
+    // Window expiry and cached code round trip
+    {
+        auto cache = std::make_unique<Bridge::DedupCache>();
+        int rc = 99;
+        CHECK_FALSE(cache->Lookup(42, 1000, 500, rc));
+        cache->Record(42, 1000, Bridge::RC_INVALID_CMD);
+        CHECK_TRUE(cache->Lookup(42, 1200, 500, rc));
+        CHECK_EQ(rc, Bridge::RC_INVALID_CMD);
+        CHECK_FALSE(cache->Lookup(42, 1500, 500, rc));
+        CHECK_FALSE(cache->Lookup(43, 1200, 500, rc));
+        CHECK_EQ((int)cache->Hits(), 1);
+        CHECK_EQ((int)cache->Misses(), 3);
+    }
+
+    // A full probe neighbourhood evicts its oldest entry
+    {
+        using Bridge::DedupCache;
+        auto cache = std::make_unique<DedupCache>();
+        const uint64_t base = 7;
+        for (uint64_t i = 0; i < DedupCache::kProbe; ++i)
+            cache->Record(base + i * DedupCache::kSlots, 100 + (int64_t)i, Bridge::RC_SUCCESS);
+        cache->Record(base + DedupCache::kProbe * DedupCache::kSlots, 200, Bridge::RC_SUCCESS);
+        int rc = 0;
+        CHECK_FALSE(cache->Lookup(base, 201, 1000, rc));
+        CHECK_TRUE(cache->Lookup(base + DedupCache::kSlots, 201, 1000, rc));
+        CHECK_TRUE(cache->Lookup(base + DedupCache::kProbe * DedupCache::kSlots, 201, 1000, rc));
+    }
+
+    const char* kOrder =
+        "COMMAND=PLACE|ACCOUNT=DEDUP1|INSTRUMENT=ES|ACTION=BUY|QUANTITY=1|ORDERTYPE=MARKET|TIMEINFORCE=DAY";
+
+    // Disabled by default: identical orders all reach the adapter
+    {
+        Bridge::BridgeConfig cfg;
+        cfg.adapterType = "MOCK";
+        Bridge::BridgeEngine engine(cfg);
+        auto req = ParseDedupReq(kOrder);
+        engine.Execute(req);
+        engine.Execute(req);
+        CHECK_EQ((int)engine.DedupHits(), 0);
+        CHECK_EQ((int)engine.DedupMisses(), 0);
+    }
+
+    // Time window: a repeat returns the cached code without the adapter
+    {
+        Bridge::BridgeConfig cfg;
+        cfg.adapterType   = "MOCK";
+        cfg.dedupWindowMs = 60000;
+        Bridge::BridgeEngine engine(cfg);
+        auto req = ParseDedupReq(kOrder);
+        CHECK_EQ(engine.Execute(req), Bridge::RC_SUCCESS);
+        CHECK_EQ(engine.Execute(req), Bridge::RC_SUCCESS);
+        CHECK_EQ((int)engine.DedupHits(), 1);
+        CHECK_EQ((int)engine.DedupMisses(), 1);
+
+        auto other = req;
+        other.quantity = 2;
+        engine.Execute(other);
+        CHECK_EQ((int)engine.DedupHits(), 1);
+
+        // Batches consult the cache too
+        Bridge::OrderRequest batch[3] = { req, other, req };
+        batch[2].quantity = 3;
+        Bridge::OrderRequest again[2] = { batch[2], batch[2] };
+        int results[3] = {};
+        engine.ExecuteBatch(batch, 3, results);
+        CHECK_EQ((int)engine.DedupHits(), 3);
+        CHECK_EQ(results[2], Bridge::RC_SUCCESS);
+        engine.ExecuteBatch(again, 2, results);
+        CHECK_EQ((int)engine.DedupHits(), 5);
+    }
+
+    // Bar key: deduplicated even with no time window, per bar
+    {
+        Bridge::BridgeConfig cfg;
+        cfg.adapterType = "MOCK";
+        Bridge::BridgeEngine engine(cfg);
+        auto bar1 = ParseDedupReq("COMMAND=PLACE|ACCOUNT=DEDUP2|INSTRUMENT=ES|ACTION=BUY|QUANTITY=1|ORDERTYPE=MARKET|TIMEINFORCE=DAY|BARKEY=1001");
+        auto bar2 = ParseDedupReq("COMMAND=PLACE|ACCOUNT=DEDUP2|INSTRUMENT=ES|ACTION=BUY|QUANTITY=1|ORDERTYPE=MARKET|TIMEINFORCE=DAY|BARKEY=1002");
+        engine.Execute(bar1);
+        engine.Execute(bar1);
+        engine.Execute(bar1);
+        engine.Execute(bar2);
+        CHECK_EQ((int)engine.DedupHits(), 2);
+        CHECK_EQ((int)engine.DedupMisses(), 2);
+    }
+}
@@ -0,0 +1,317 @@
+#include "TestFramework.h"
+#include "../../BridgeCore/include/AdapterFactory.h"
+#include "../../BridgeCore/include/Config.h"
+#include "../../BridgeCore/include/DotNetAdapter.h"
+#include "../../BridgeCore/include/PipeChannel.h"
+#include "../../BridgeCore/include/Types.h"
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using Bridge::DotNetAdapter;
+using Bridge::DotNetSettings;
+using Bridge::OrderRequest;
+
+namespace {
+
+// Stand-in for BridgeDotNetWorker: one client at a time on a pipe in the
+// temp directory, answering tagged CONNECT and PLACE lines as told.
+class StandInWorker {
+public:
+    enum class Mode { Ok, Reject, Silent, Reverse };
+
+    explicit StandInWorker(std::string path) : m_listen(Bridge::PipeChannel::Listen(path)) {
+        m_thread = std::thread([this] { Run(); });
+    }
+    ~StandInWorker() {
+        m_stop = true;
+        m_thread.join();
+    }
+
+    bool Listening() const { return m_listen.IsOpen(); }
+    void SetMode(Mode m) { m_mode = m; }
+    // Reverse: hold answers until this many PLACEs are in, then answer newest first.
+    void SetBatch(size_t n) { m_batch = n; }
+    void RefuseConnect(bool refuse) { m_refuse = refuse; }
+    void DropClient() { m_drop = true; }
+    int  Connects() const { return m_connects; }
+
+    std::vector<std::string> Received() const {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        return m_received;
+    }
+    std::string Last() const {
+        auto all = Received();
+        return all.empty() ? std::string() : all.back();
+    }
+
+private:
+    void Run() {
+        while (!m_stop) {
+            Bridge::PipeChannel c = m_listen.Accept(20);
+            if (!c.IsOpen()) continue;
+            m_drop = false;
+            m_held.clear();
+            Serve(c);
+        }
+    }
+
+    void Serve(Bridge::PipeChannel& c) {
+        std::string buf;
+        char chunk[4096];
+        while (!m_stop && !m_drop) {
+            int n = c.Receive(chunk, sizeof(chunk), 20);
+            if (n < 0) return;
+            buf.append(chunk, static_cast<size_t>(n));
+            size_t nl;
+            while ((nl = buf.find('\n')) != std::string::npos) {
+                std::string line = buf.substr(0, nl);
+                buf.erase(0, nl + 1);
+                {
+                    std::lock_guard<std::mutex> lk(m_mutex);
+                    m_received.push_back(line);
+                }
+                OnLine(c, line);
+            }
+        }
+    }
+
+    void OnLine(Bridge::PipeChannel& c, const std::string& line) {
+        std::string tag = line.substr(0, line.find(' '));
+        std::string reply;
+        if (line.find(" CONNECT") != std::string::npos) {
+            ++m_connects;
+            reply = tag + (m_refuse ? " ERROR no T4 login" : " OK connected");
+        } else {
+            switch (m_mode.load()) {
+                case Mode::Ok:     reply = tag + " OK order 42"; break;
+                case Mode::Reject: reply = tag + " ERROR insufficient margin"; break;
+                case Mode::Silent: return;
+                case Mode::Reverse:
+                    m_held.push_back(tag);
+                    if (m_held.size() < m_batch) return;
+                    for (auto it = m_held.rbegin(); it != m_held.rend(); ++it) reply += *it + " OK\r\n";
+                    m_held.clear();
+                    c.SendAll(reply.data(), reply.size());
+                    return;
+            }
+        }
+        reply += '\n';
+        c.SendAll(reply.data(), reply.size());
+    }
+
+    Bridge::PipeChannel      m_listen;
+    std::atomic<bool>        m_stop{ false };
+    std::atomic<bool>        m_drop{ false };
+    std::atomic<bool>        m_refuse{ false };
+    std::atomic<Mode>        m_mode{ Mode::Ok };
+    std::atomic<size_t>      m_batch{ 1 };
+    std::atomic<int>         m_connects{ 0 };
+    std::vector<std::string> m_held;
+    mutable std::mutex       m_mutex;
+    std::vector<std::string> m_received;
+    std::thread              m_thread;
+};
+
+template <class Pred>
+bool WaitFor(Pred pred, int ms = 3000) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(ms);
+    while (!pred()) {
+        if (std::chrono::steady_clock::now() > deadline) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return true;
+}
+
+OrderRequest Place(const char* instrument, Bridge::Action side, int qty, Bridge::OrderType type,
+                   double limit = 0.0, double stop = 0.0) {
+    OrderRequest r;
+    r.command     = Bridge::Command::PLACE;
+    r.account     = "SIM1";
+    r.instrument  = instrument;
+    r.action      = side;
+    r.quantity    = qty;
+    r.orderType   = type;
+    r.limitPrice  = limit;
+    r.stopPrice   = stop;
+    r.timeInForce = Bridge::TimeInForce::DAY;
+    return r;
+}
+
+} // namespace
+
+void TestDotNetAdapter() {
+    printf("\n-- TestDotNetAdapter --\n");
+    using namespace Bridge;
+    namespace fs = std::filesystem;
+
+    fs::path dir = fs::temp_directory_path() / "bridge_dotnet_test";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    std::string pipe = (dir / "worker.pipe").string();
+
+    // Pipe names map to where .NET puts them; paths are kept
+    CHECK_TRUE(PipeChannel::PathOf(pipe) == pipe);
+#ifndef _WIN32
+    CHECK_TRUE(PipeChannel::PathOf("BridgeT4Pipe").find("CoreFxPipe_BridgeT4Pipe") != std::string::npos);
+#endif
+
+    DotNetSettings settings;
+    settings.pipeName    = pipe;
+    settings.timeoutMs   = 2000;
+    settings.reconnectMs = 20;
+    OrderRequest limit = Place("ES", Action::BUY, 2, OrderType::LIMIT, 5001.25);
+
+    // No worker: not connected, and Execute says so at once
+    {
+        DotNetAdapter adapter(settings);
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));   // a few reconnect attempts
+        CHECK_FALSE(adapter.IsConnected());
+        CHECK_TRUE(adapter.IsShardSafe());
+        auto t0 = std::chrono::steady_clock::now();
+        bool allRefused = true;
+        for (int i = 0; i < 100; ++i)
+            if (adapter.Execute(limit) != RC_NOT_CONNECTED) allRefused = false;
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - t0).count();
+        CHECK_TRUE(allRefused);
+        CHECK_TRUE(ms < 50);
+    }
+
+    StandInWorker worker(pipe);
+    CHECK_TRUE(worker.Listening());
+    auto adapter = std::make_unique<DotNetAdapter>(settings);
+    CHECK_TRUE(WaitFor([&] { return adapter->IsConnected(); }));
+    CHECK_EQ(worker.Connects(), 1);
+    CHECK_STR_EQ(worker.Received().front(), std::string("#1 CONNECT"));
+
+    // PLACE lines: tagged, with the limit, the stop or 0 as the price
+    {
+        CHECK_EQ(adapter->Execute(limit), RC_SUCCESS);
+        CHECK_STR_EQ(worker.Last(), std::string("#2 PLACE ES BUY 2 5001.25 LIMIT"));
+        CHECK_EQ(adapter->Execute(Place("NQ", Action::SELL, 1, OrderType::STOPMARKET, 0.0, 17950.5)), RC_SUCCESS);
+        CHECK_STR_EQ(worker.Last(), std::string("#3 PLACE NQ SELL 1 17950.5 STOPMARKET"));
+        CHECK_EQ(adapter->Execute(Place("CL", Action::BUY, 3, OrderType::MARKET)), RC_SUCCESS);
+        CHECK_STR_EQ(worker.Last(), std::string("#4 PLACE CL BUY 3 0 MARKET"));
+        CHECK_EQ(adapter->Execute(Place("ES", Action::SELL, 1, OrderType::STOPLIMIT, 4990.0, 4991.0)), RC_SUCCESS);
+        CHECK_STR_EQ(worker.Last(), std::string("#5 PLACE ES SELL 1 4990 STOPLIMIT"));
+        CHECK_EQ((int)adapter->InFlight(), 0);
+    }
+
+    // Refused by the worker; unsupported commands and fields never reach it
+    {
+        worker.SetMode(StandInWorker::Mode::Reject);
+        CHECK_EQ(adapter->Execute(limit), RC_REJECTED);
+        worker.SetMode(StandInWorker::Mode::Ok);
+
+        size_t before = worker.Received().size();
+        OrderRequest cancel = limit;
+        cancel.command = Command::CANCEL;
+        CHECK_EQ(adapter->Execute(cancel), RC_INVALID_CMD);
+        CHECK_EQ(adapter->Execute(Place("ES Z26", Action::BUY, 1, OrderType::MARKET)), RC_INVALID_PARAM);
+        CHECK_EQ(adapter->Execute(Place("ES", Action::UNKNOWN, 1, OrderType::MARKET)), RC_INVALID_PARAM);
+        CHECK_EQ((int)worker.Received().size(), (int)before);
+    }
+
+    // A batch goes out in one write and is answered out of order
+    {
+        worker.SetMode(StandInWorker::Mode::Reverse);
+        worker.SetBatch(4);
+        OrderRequest reqs[5] = { limit, limit, limit, limit, limit };
+        reqs[2].command = Command::FLATTENEVERYTHING;
+        int results[5] = {};
+        adapter->ExecuteBatch(reqs, 5, results);
+        CHECK_EQ(results[0], RC_SUCCESS);
+        CHECK_EQ(results[1], RC_SUCCESS);
+        CHECK_EQ(results[2], RC_INVALID_CMD);
+        CHECK_EQ(results[3], RC_SUCCESS);
+        CHECK_EQ(results[4], RC_SUCCESS);
+    }
+
+    // Callers on several threads are in flight together: the worker answers
+    // none until all eight are in, which lockstep would never get to
+    {
+        worker.SetBatch(8);
+        std::atomic<int> ok{ 0 };
+        std::vector<std::thread> callers;
+        for (int t = 0; t < 8; ++t)
+            callers.emplace_back([&] { if (adapter->Execute(limit) == RC_SUCCESS) ++ok; });
+        for (auto& t : callers) t.join();
+        CHECK_EQ(ok.load(), 8);
+        worker.SetMode(StandInWorker::Mode::Ok);
+    }
+
+    // No answer in time; a late one is dropped. The worker serves one
+    // client at a time, so this adapter has the pipe to itself.
+    adapter.reset();
+    {
+        DotNetSettings quick = settings;
+        quick.timeoutMs = 100;
+        DotNetAdapter fast(quick);
+        CHECK_TRUE(WaitFor([&] { return fast.IsConnected(); }));
+        worker.SetMode(StandInWorker::Mode::Silent);
+        CHECK_EQ(fast.Execute(limit), RC_TIMEOUT);
+        CHECK_EQ((int)fast.InFlight(), 1);
+        worker.SetMode(StandInWorker::Mode::Ok);
+    }
+    adapter = std::make_unique<DotNetAdapter>(settings);
+    CHECK_TRUE(WaitFor([&] { return adapter->IsConnected(); }));
+
+    // The pipe drops: waiting calls fail, new ones fail fast, and the
+    // adapter reconnects in the background
+    {
+        worker.SetMode(StandInWorker::Mode::Silent);
+        int waiting = RC_PENDING;
+        std::thread caller([&] { waiting = adapter->Execute(limit); });
+        CHECK_TRUE(WaitFor([&] { return adapter->InFlight() == 1; }));
+        int connects = worker.Connects();
+        worker.RefuseConnect(true);
+        worker.DropClient();
+        caller.join();
+        CHECK_EQ(waiting, RC_NOT_CONNECTED);
+
+        // Refused CONNECTs keep it disconnected, retrying
+        CHECK_TRUE(WaitFor([&] { return worker.Connects() >= connects + 2; }));
+        CHECK_FALSE(adapter->IsConnected());
+        auto t0 = std::chrono::steady_clock::now();
+        CHECK_EQ(adapter->Execute(limit), RC_NOT_CONNECTED);
+        CHECK_TRUE(std::chrono::steady_clock::now() - t0 < std::chrono::milliseconds(20));
+
+        worker.RefuseConnect(false);
+        worker.SetMode(StandInWorker::Mode::Ok);
+        CHECK_TRUE(WaitFor([&] { return adapter->IsConnected(); }));
+        CHECK_EQ(adapter->Execute(limit), RC_SUCCESS);
+        CHECK_EQ((int)adapter->InFlight(), 0);
+    }
+    adapter.reset();
+
+    // Configuration
+    {
+        BridgeConfig a, b;
+        a.adapterType = b.adapterType = "DOTNET";
+        a.pipeName        = pipe;
+        a.dotnetTimeoutMs = 250;
+        DotNetSettings s = DotNetSettingsOf(a);
+        CHECK_TRUE(s.pipeName == pipe);
+        CHECK_EQ(s.timeoutMs, 250);
+        CHECK_TRUE(AdapterSettingsDiffer(a, b));
+        b.pipeName        = pipe;
+        b.dotnetTimeoutMs = 250;
+        CHECK_FALSE(AdapterSettingsDiffer(a, b));
+        b.fixStorePath = "ignored.store";
+        CHECK_FALSE(AdapterSettingsDiffer(a, b));
+
+        auto viaConfig = CreateAdapter(a);
+        CHECK_TRUE(dynamic_cast<DotNetAdapter*>(viaConfig.get()) != nullptr);
+        CHECK_TRUE(WaitFor([&] { return viaConfig->IsConnected(); }));
+        CHECK_EQ(viaConfig->Execute(limit), RC_SUCCESS);
+        CHECK_TRUE(dynamic_cast<DotNetAdapter*>(CreateAdapter("DOTNET").get()) != nullptr);
+    }
+
+    fs::remove_all(dir);
+}
@@ -0,0 +1,198 @@
+#include "TestFramework.h"
+#include "../../BridgeCore/include/AdapterFactory.h"
+#include "../../BridgeCore/include/BridgeEngine.h"
+#include "../../BridgeCore/include/Config.h"
+#include "../../BridgeCore/include/FaultInjectingAdapter.h"
+#include "../../BridgeCore/include/MockAdapter.h"
+#include "../../BridgeCore/include/Types.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+static Bridge::OrderRequest MakeFaultReq()
+{
+    Bridge::OrderRequest r;
+    r.command     = Bridge::Command::PLACE;
+    r.account     = "FAULT1";
+    r.instrument  = "ES";
+    r.action      = Bridge::Action::BUY;
+    r.quantity    = 1;
+    r.orderType   = Bridge::OrderType::MARKET;
+    r.timeInForce = Bridge::TimeInForce::DAY;
+    return r;
+}
+
+void TestFaultInjection() {
+    printf("\n-- TestFaultInjection --\n");
+    namespace fs = std::filesystem;
+    using Bridge::FaultProfile;
+
+    fs::path dir = fs::temp_directory_path() / "bridge_fault_test";
+    fs::create_directories(dir);
+
+    // Latency specs
+    {
+        FaultProfile p;
+        CHECK_EQ(Bridge::ParseFaultLatency("fixed:250", p), Bridge::RC_SUCCESS);
+        CHECK_TRUE(p.latency == FaultProfile::Latency::Fixed && p.fixedUs == 250.0);
+        CHECK_EQ(Bridge::ParseFaultLatency("Uniform: 100-400", p), Bridge::RC_SUCCESS);
+        CHECK_TRUE(p.latency == FaultProfile::Latency::Uniform && p.minUs == 100.0 && p.maxUs == 400.0);
+        CHECK_EQ(Bridge::ParseFaultLatency("lognormal:300,0.5", p), Bridge::RC_SUCCESS);
+        CHECK_TRUE(p.latency == FaultProfile::Latency::LogNormal && p.sigma == 0.5);
+        CHECK_EQ(Bridge::ParseFaultLatency("none", p), Bridge::RC_SUCCESS);
+        CHECK_TRUE(p.latency == FaultProfile::Latency::None);
+
+        CHECK_EQ(Bridge::ParseFaultLatency("uniform:400-100", p), Bridge::RC_CONFIG_ERR);
+        CHECK_EQ(Bridge::ParseFaultLatency("fixed:", p), Bridge::RC_CONFIG_ERR);
+        CHECK_EQ(Bridge::ParseFaultLatency("gamma:1,2", p), Bridge::RC_CONFIG_ERR);
+        CHECK_EQ(Bridge::ParseFaultLatency("histogram:no/such/file", p), Bridge::RC_CONFIG_ERR);
+    }
+
+    // Samples stay inside their distribution
+    {
+        FaultProfile p;
+        p.seed = 42;
+        Bridge::ParseFaultLatency("uniform:100-400", p);
+        Bridge::FaultInjectingAdapter uni(std::make_shared<Bridge::MockAdapter>(), p);
+        bool inRange = true;
+        for (int i = 0; i < 1000; ++i) {
+            double us = uni.SampleLatencyUs();
+            inRange = inRange && us >= 100.0 && us <= 400.0;
+        }
+        CHECK_TRUE(inRange);
+
+        Bridge::ParseFaultLatency("lognormal:300,0.5", p);
+        Bridge::FaultInjectingAdapter logn(std::make_shared<Bridge::MockAdapter>(), p);
+        std::vector<double> s(4001);
+        for (double& v : s) v = logn.SampleLatencyUs();
+        std::nth_element(s.begin(), s.begin() + 2000, s.end());
+        CHECK_TRUE(s[2000] > 270.0 && s[2000] < 330.0);
+
+        fs::path hist = dir / "latency.hist";
+        {
+            std::ofstream f(hist, std::ios::trunc);
+            f << "# upperUs count\n100 0\n200 10\n1000 0\n";
+        }
+        CHECK_EQ(Bridge::ParseFaultLatency("histogram:" + hist.string(), p), Bridge::RC_SUCCESS);
+        CHECK_EQ((int)p.histogram.size(), 3);
+        Bridge::FaultInjectingAdapter h(std::make_shared<Bridge::MockAdapter>(), p);
+        inRange = true;
+        for (int i = 0; i < 1000; ++i) {
+            double us = h.SampleLatencyUs();
+            inRange = inRange && us >= 100.0 && us <= 200.0;
+        }
+        CHECK_TRUE(inRange);
+    }
+
+    // Rejects, timeouts and disconnect windows
+    {
+        auto mock = std::make_shared<Bridge::MockAdapter>();
+        FaultProfile p;
+        p.rejectRate = 1.0;
+        Bridge::FaultInjectingAdapter rejecting(mock, p);
+        CHECK_EQ(rejecting.Execute(MakeFaultReq()), Bridge::RC_REJECTED);
+        CHECK_EQ((int)mock->WorkingCount(), 0);
+        CHECK_EQ((int)rejecting.Rejects(), 1);
+
+        p = FaultProfile{};
+        p.rejectRate = 0.25;
+        p.seed       = 7;
+        Bridge::FaultInjectingAdapter some(mock, p);
+        int rejected = 0;
+        for (int i = 0; i < 2000; ++i)
+            if (some.Execute(MakeFaultReq()) == Bridge::RC_REJECTED) ++rejected;
+        CHECK_TRUE(rejected > 400 && rejected < 600);
+        mock->Clear();
+
+        p = FaultProfile{};
+        Bridge::ParseFaultLatency("fixed:20000", p);
+        p.timeoutMs = 2;
+        Bridge::FaultInjectingAdapter slow(mock, p);
+        auto t0 = std::chrono::steady_clock::now();
+        CHECK_EQ(slow.Execute(MakeFaultReq()), Bridge::RC_TIMEOUT);
+        auto waited = std::chrono::steady_clock::now() - t0;
+        CHECK_TRUE(waited >= std::chrono::milliseconds(2) && waited < std::chrono::milliseconds(20));
+        CHECK_EQ((int)mock->WorkingCount(), 1);     // the order still got through
+        mock->Clear();
+
+        p = FaultProfile{};
+        p.disconnectEveryMs = 1000;
+        p.disconnectForMs   = 1000;
+        Bridge::FaultInjectingAdapter down(mock, p);
+        CHECK_FALSE(down.IsConnected());
+        CHECK_EQ(down.Execute(MakeFaultReq()), Bridge::RC_NOT_CONNECTED);
+        int results[2] = {};
+        Bridge::OrderRequest reqs[2] = { MakeFaultReq(), MakeFaultReq() };
+        down.ExecuteBatch(reqs, 2, results);
+        CHECK_TRUE(results[0] == Bridge::RC_NOT_CONNECTED && results[1] == Bridge::RC_NOT_CONNECTED);
+        CHECK_EQ((int)mock->WorkingCount(), 0);
+    }
+
+    // Chosen in bridge.json; the engine reports the injected codes
+    {
+        fs::path cfgPath = dir / "bridge.json";
+        {
+            std::ofstream f(cfgPath, std::ios::trunc);
+            f << "{\n  \"adapterType\": \"MOCK\",\n  \"logFilePath\": \"logs/bridge_fault_test.log\",\n"
+                 "  \"faultLatency\": \"uniform:10-50\",\n  \"faultRejectRate\": 1.0,\n"
+                 "  \"faultTimeoutMs\": 5,\n  \"faultSeed\": 3\n}\n";
+        }
+        Bridge::BridgeConfig cfg;
+        CHECK_EQ(Bridge::LoadConfig(cfgPath.string(), cfg), Bridge::RC_SUCCESS);
+        CHECK_STR_EQ(cfg.faultLatency, std::string("uniform:10-50"));
+        CHECK_TRUE(cfg.faultRejectRate == 1.0 && cfg.faultTimeoutMs == 5 && cfg.faultSeed == 3);
+
+        auto adapter = Bridge::CreateAdapter(cfg);
+        auto* faulty = dynamic_cast<Bridge::FaultInjectingAdapter*>(adapter.get());
+        CHECK_TRUE(faulty != nullptr);
+        CHECK_TRUE(faulty && dynamic_cast<Bridge::MockAdapter*>(&faulty->Inner()) != nullptr);
+
+        Bridge::BridgeEngine engine(cfg);
+        CHECK_EQ(engine.Execute(MakeFaultReq()), Bridge::RC_REJECTED);
+
+        Bridge::BridgeConfig plain = cfg;
+        plain.faultLatency.clear();
+        plain.faultRejectRate = 0.0;
+        plain.faultTimeoutMs  = 0;
+        CHECK_TRUE(Bridge::AdapterSettingsDiffer(cfg, plain));
+        CHECK_TRUE(dynamic_cast<Bridge::MockAdapter*>(Bridge::CreateAdapter(plain).get()) != nullptr);
+        engine.ApplyConfig(plain);
+        CHECK_EQ(engine.Execute(MakeFaultReq()), Bridge::RC_SUCCESS);
+    }
+
+    // Backpressure: rejected async pushes must not recycle live tickets
+    {
+        Bridge::BridgeConfig cfg;
+        cfg.adapterType     = "MOCK";
+        cfg.logFilePath     = "logs/bridge_fault_test.log";
+        cfg.asyncWorkers    = 1;
+        cfg.asyncQueueDepth = 2;
+        FaultProfile p;
+        Bridge::ParseFaultLatency("fixed:1000", p);
+        Bridge::BridgeEngine engine(cfg, std::make_shared<Bridge::FaultInjectingAdapter>(
+                                             std::make_shared<Bridge::MockAdapter>(), p));
+        std::vector<int> tickets;
+        int full = 0;
+        for (int i = 0; i < 20000; ++i) {
+            int t = engine.ExecuteAsync(MakeFaultReq());
+            if (t == Bridge::RC_QUEUE_FULL) ++full;
+            else tickets.push_back(t);
+        }
+        CHECK_TRUE(full > 4096);
+        bool allKnown = true;
+        for (int t : tickets) {
+            int rc;
+            while ((rc = engine.PollResult(t)) == Bridge::RC_PENDING)
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            allKnown = allKnown && rc == Bridge::RC_SUCCESS;
+        }
+        CHECK_TRUE(allKnown);
+    }
+
+    std::error_code ec;
+    fs::remove_all(dir, ec);
+}
@@ -0,0 +1,610 @@
+#include "TestFramework.h"
+#include "../../BridgeCore/include/AdapterFactory.h"
+#include "../../BridgeCore/include/Config.h"
+#include "../../BridgeCore/include/FixAdapter.h"
+#include "../../BridgeCore/include/FixMessage.h"
+#include "../../BridgeCore/include/Numeric.h"
+#include "../../BridgeCore/include/Socket.h"
+#include "../../BridgeCore/include/SymbolTable.h"
+#include "../../BridgeCore/include/Types.h"
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using Bridge::FixFields;
+using Bridge::FixWriter;
+namespace FixTag = Bridge::FixTag;
+
+namespace {
+
+// Stand-in for the broker's acceptor: one client at a time on a loopback
+// port, answering logons, test requests and orders as told.
+class FixAcceptor {
+public:
+    enum class Mode { Ack, Fill, Reject, Silent };
+
+    FixAcceptor() : m_listen(Bridge::Socket::Listen("127.0.0.1", 0)) {
+        m_thread = std::thread([this] { Run(); });
+    }
+    ~FixAcceptor() {
+        m_stop = true;
+        m_thread.join();
+    }
+
+    uint16_t Port() const { return m_listen.LocalPort(); }
+    void     SetMode(Mode m) { m_mode = m; }
+    int      Logons() const { return m_logons; }
+    void     DropClient() { m_drop = true; }
+    void     SkipSeq() { std::lock_guard<std::mutex> lk(m_sendMutex); ++m_seq; }
+    // Carry sequence numbers over reconnects unless the logon asks for a reset.
+    void     KeepSeqs() { m_keepSeqs = true; }
+    // Answer the next logon with ResetSeqNumFlag=Y, starting over at 1.
+    void     ResetAtLogon() { m_resetAtLogon = true; }
+    // Leave replace requests unanswered.
+    void     HoldReplaces() { m_holdReplaces = true; }
+
+    // Received messages, in order.
+    std::vector<std::string> Received() const {
+        std::lock_guard<std::mutex> lk(m_recvMutex);
+        return m_received;
+    }
+    size_t CountOf(std::string_view type) const {
+        size_t n = 0;
+        for (const auto& m : Received()) {
+            FixFields f;
+            if (f.Parse(m) && f.MsgType() == type) ++n;
+        }
+        return n;
+    }
+    std::string Last(std::string_view type) const {
+        auto all = Received();
+        for (auto it = all.rbegin(); it != all.rend(); ++it) {
+            FixFields f;
+            if (f.Parse(*it) && f.MsgType() == type) return *it;
+        }
+        return {};
+    }
+
+    // Send one message; 'body' adds the fields after the standard header.
+    void Send(std::string_view type, const std::function<void(FixWriter&)>& body = {}) {
+        std::lock_guard<std::mutex> lk(m_sendMutex);
+        FixWriter w;
+        w.Begin(type);
+        w.Add(FixTag::SenderCompID, std::string_view("SERVER"));
+        w.Add(FixTag::TargetCompID, std::string_view("CLIENT"));
+        w.Add(FixTag::MsgSeqNum, static_cast<int64_t>(m_seq++));
+        w.AddTimestamp(FixTag::SendingTime);
+        if (body) body(w);
+        std::string_view msg = w.Finish();
+        m_client.SendAll(msg.data(), msg.size());
+    }
+
+private:
+    void Run() {
+        while (!m_stop) {
+            Bridge::Socket c = m_listen.Accept(20);
+            if (!c.IsOpen()) continue;
+            {
+                std::lock_guard<std::mutex> lk(m_sendMutex);
+                m_client = std::move(c);
+                if (!m_keepSeqs) m_seq = 1;
+            }
+            m_drop = false;
+            Serve();
+            std::lock_guard<std::mutex> lk(m_sendMutex);
+            m_client.Close();
+        }
+    }
+
+    void Serve() {
+        std::vector<char> buf(64 * 1024);
+        size_t len = 0;
+        while (!m_stop && !m_drop) {
+            int n = m_client.Receive(buf.data() + len, buf.size() - len, 20);
+            if (n < 0) return;
+            len += static_cast<size_t>(n);
+            for (;;) {
+                ptrdiff_t size = Bridge::FixFrame(std::string_view(buf.data(), len));
+                if (size <= 0) break;
+                std::string msg(buf.data(), static_cast<size_t>(size));
+                std::memmove(buf.data(), buf.data() + size, len - static_cast<size_t>(size));
+                len -= static_cast<size_t>(size);
+                {
+                    std::lock_guard<std::mutex> lk(m_recvMutex);
+                    m_received.push_back(msg);
+                }
+                if (!OnMessage(msg)) return;
+            }
+        }
+    }
+
+    bool OnMessage(const std::string& msg) {
+        FixFields f;
+        if (!f.Parse(msg)) return false;
+        std::string type(f.MsgType());
+        std::string id(f.Get(FixTag::ClOrdID));
+        std::string orig(f.Get(FixTag::OrigClOrdID));
+        std::string side(f.Get(FixTag::Side));
+        std::string qty(f.Get(FixTag::OrderQty));
+        auto report = [&](char execType, const std::string& extra = {}) {
+            Send("8", [&](FixWriter& w) {
+                w.Add(FixTag::OrderID, std::string_view(id));
+                w.Add(FixTag::ExecID, std::string_view("E"));
+                w.Add(FixTag::ClOrdID, std::string_view(id));
+                if (!orig.empty()) w.Add(FixTag::OrigClOrdID, std::string_view(orig));
+                w.Add(FixTag::ExecType, execType);
+                w.Add(FixTag::OrdStatus, execType);
+                w.Add(FixTag::Side, std::string_view(side));
+                if (execType == '2') {
+                    w.Add(FixTag::LastShares, std::string_view(qty));
+                    w.Add(FixTag::CumQty, std::string_view(qty));
+                    w.Add(FixTag::LastPx, std::string_view("4900.25"));
+                }
+                if (!extra.empty()) w.Add(FixTag::Text, std::string_view(extra));
+            });
+        };
+        if (type == "A") {
+            ++m_logons;
+            bool forced = m_resetAtLogon.exchange(false);
+            if (forced || f.GetChar(FixTag::ResetSeqNumFlag) == 'Y') {
+                std::lock_guard<std::mutex> lk(m_sendMutex);
+                m_seq = 1;
+            }
+            Send("A", [forced](FixWriter& w) {
+                w.Add(FixTag::EncryptMethod, '0');
+                w.Add(FixTag::HeartBtInt, static_cast<int64_t>(30));
+                if (forced) w.Add(FixTag::ResetSeqNumFlag, 'Y');
+            });
+        } else if (type == "1") {
+            std::string req(f.Get(FixTag::TestReqID));
+            Send("0", [&](FixWriter& w) { w.Add(FixTag::TestReqID, std::string_view(req)); });
+        } else if (type == "2") {
+            int64_t next = 0;
+            {
+                std::lock_guard<std::mutex> lk(m_sendMutex);
+                next = static_cast<int64_t>(m_seq);
+            }
+            Send("4", [&](FixWriter& w) {
+                w.Add(FixTag::GapFillFlag, 'Y');
+                w.Add(FixTag::NewSeqNo, next + 1);
+            });
+        } else if (f.GetChar(FixTag::PossDupFlag) == 'Y') {
+            // A resent order: already answered
+        } else if (type == "D") {
+            switch (m_mode.load()) {
+                case Mode::Ack:    report('0'); break;
+                case Mode::Fill:   report('0'); report('2'); break;
+                case Mode::Reject: report('8', "no"); break;
+                case Mode::Silent: break;
+            }
+        } else if (type == "F") {
+            report('4');
+        } else if (type == "G") {
+            if (!m_holdReplaces) report('5');
+        } else if (type == "5") {
+            Send("5");
+            return false;
+        }
+        return true;
+    }
+
+    Bridge::Socket           m_listen;
+    Bridge::Socket           m_client;
+    std::mutex               m_sendMutex;
+    uint64_t                 m_seq = 1;
+    mutable std::mutex       m_recvMutex;
+    std::vector<std::string> m_received;
+    std::atomic<Mode>        m_mode{ Mode::Ack };
+    std::atomic<int>         m_logons{ 0 };
+    std::atomic<bool>        m_drop{ false };
+    std::atomic<bool>        m_keepSeqs{ false };
+    std::atomic<bool>        m_resetAtLogon{ false };
+    std::atomic<bool>        m_holdReplaces{ false };
+    std::atomic<bool>        m_stop{ false };
+    std::thread              m_thread;
+};
+
+Bridge::FixSettings SettingsFor(uint16_t port, int ackTimeoutMs) {
+    Bridge::FixSettings s;
+    s.port         = port;
+    s.ackTimeoutMs = ackTimeoutMs;
+    s.reconnectMs  = 20;
+    return s;
+}
+
+template <class Pred>
+bool WaitFor(Pred pred, int ms = 3000) {
+    for (int i = 0; i < ms / 5; ++i) {
+        if (pred()) return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return pred();
+}
+
+Bridge::OrderRequest MakeFixReq(Bridge::Command cmd, Bridge::Action side, int qty, double limit = 0.0) {
+    Bridge::OrderRequest r;
+    r.command     = cmd;
+    r.account     = "ACC1";
+    r.instrument  = "ES";
+    r.action      = side;
+    r.quantity    = qty;
+    r.orderType   = limit > 0.0 ? Bridge::OrderType::LIMIT : Bridge::OrderType::MARKET;
+    r.limitPrice  = limit;
+    r.timeInForce = Bridge::TimeInForce::DAY;
+    return r;
+}
+
+std::string FieldOf(const std::string& msg, int tag) {
+    FixFields f;
+    return f.Parse(msg) ? std::string(f.Get(tag)) : std::string();
+}
+
+// Numbers may be zero-padded on the wire; compare values.
+int64_t IntOf(const std::string& msg, int tag) {
+    FixFields f;
+    return f.Parse(msg) ? f.GetInt(tag, -1) : -1;
+}
+
+bool PriceIs(const std::string& msg, int tag, const char* want) {
+    Bridge::FixedPrice got, expected;
+    return Bridge::ParsePrice(FieldOf(msg, tag), got) == std::errc{} &&
+           Bridge::ParsePrice(want, expected) == std::errc{} && Bridge::ComparePrice(got, expected) == 0;
+}
+
+} // namespace
+
+void TestFixAdapter() {
+    printf("\n-- TestFixAdapter --\n");
+    using Bridge::Action;
+    using Bridge::Command;
+
+    // FixWriter output frames, checksums and parses back
+    {
+        FixWriter w;
+        w.Begin("D");
+        w.Add(FixTag::ClOrdID, std::string_view("ABC-1"));
+        w.Add(FixTag::OrderQty, static_cast<int64_t>(5));
+        w.Add(FixTag::Side, '1');
+        w.AddPrice(FixTag::Price, Bridge::FixedPrice{}, 4900.25);
+        std::string msg(w.Finish());
+        CHECK_TRUE(msg.rfind("8=FIX.4.2\x01" "9=", 0) == 0);
+        CHECK_EQ(Bridge::FixFrame(msg), static_cast<ptrdiff_t>(msg.size()));
+        CHECK_EQ(Bridge::FixFrame(msg.substr(0, msg.size() - 1)), 0);
+        CHECK_EQ(Bridge::FixFrame(msg + "8=FIX"), static_cast<ptrdiff_t>(msg.size()));
+
+        std::string bad = msg;
+        bad[bad.find("ABC")] = 'X';   // checksum no longer matches
+        CHECK_EQ(Bridge::FixFrame(bad), -1);
+        CHECK_EQ(Bridge::FixFrame("GARBAGE"), -1);
+
+        FixFields f;
+        CHECK_TRUE(f.Parse(msg));
+        CHECK_TRUE(f.MsgType() == "D");
+        CHECK_TRUE(f.Get(FixTag::ClOrdID) == "ABC-1");
+        CHECK_EQ(f.GetInt(FixTag::OrderQty), 5);
+        CHECK_TRUE(f.GetChar(FixTag::Side) == '1');
+        CHECK_TRUE(f.Get(FixTag::Price) == "4900.25");
+        CHECK_FALSE(f.Has(FixTag::StopPx));
+        CHECK_FALSE(f.Parse("35=D\x01" "11"));
+
+        // Too long for the buffer: refused, not truncated
+        std::string big(FixWriter::kCapacity, 'x');
+        w.Begin("D");
+        w.Add(FixTag::Text, std::string_view(big));
+        CHECK_TRUE(w.Overflow());
+        CHECK_TRUE(w.Finish().empty());
+    }
+
+    // Nothing listening: RC_NOT_CONNECTED, and the destructor does not hang
+    {
+        uint16_t port = 0;
+        {
+            Bridge::Socket probe = Bridge::Socket::Listen("127.0.0.1", 0);
+            port = probe.LocalPort();
+        }
+        Bridge::FixAdapter fix(SettingsFor(port, 0));
+        CHECK_FALSE(fix.IsConnected());
+        CHECK_EQ(fix.Execute(MakeFixReq(Command::PLACE, Action::BUY, 1)), Bridge::RC_NOT_CONNECTED);
+    }
+
+    // Logon, orders and execution reports
+    {
+        FixAcceptor acceptor;
+        CHECK_TRUE(acceptor.Port() != 0);
+        auto fix = std::make_unique<Bridge::FixAdapter>(SettingsFor(acceptor.Port(), 2000));
+        CHECK_TRUE(WaitFor([&] { return fix->IsConnected(); }));
+        std::string logon = acceptor.Last("A");
+        CHECK_STR_EQ(FieldOf(logon, FixTag::ResetSeqNumFlag), std::string("Y"));
+        CHECK_STR_EQ(FieldOf(logon, FixTag::SenderCompID), std::string("CLIENT"));
+        CHECK_EQ(IntOf(logon, FixTag::MsgSeqNum), 1);
+        CHECK_EQ((int)fix->NextOutgoingSeq(), 2);
+        CHECK_EQ((int)fix->NextIncomingSeq(), 2);
+
+        CHECK_EQ(fix->Execute(MakeFixReq(Command::PLACE, Action::BUY, 2, 4900.25)), Bridge::RC_SUCCESS);
+        CHECK_EQ((int)fix->OpenOrderCount(), 1);
+        std::string d = acceptor.Last("D");
+        CHECK_STR_EQ(FieldOf(d, FixTag::Account), std::string("ACC1"));
+        CHECK_STR_EQ(FieldOf(d, FixTag::Symbol), std::string("ES"));
+        CHECK_STR_EQ(FieldOf(d, FixTag::Side), std::string("1"));
+        CHECK_EQ(IntOf(d, FixTag::OrderQty), 2);
+        CHECK_STR_EQ(FieldOf(d, FixTag::OrdType), std::string("2"));
+        CHECK_TRUE(PriceIs(d, FixTag::Price, "4900.25"));
+        CHECK_EQ(IntOf(d, FixTag::MsgSeqNum), 2);
+
+        // CHANGE replaces the open order in place
+        auto change = MakeFixReq(Command::CHANGE, Action::BUY, 3, 4899.5);
+        CHECK_EQ(fix->Execute(change), Bridge::RC_SUCCESS);
+        std::string g = acceptor.Last("G");
+        CHECK_STR_EQ(FieldOf(g, FixTag::OrigClOrdID), FieldOf(d, FixTag::ClOrdID));
+        CHECK_EQ(IntOf(g, FixTag::OrderQty), 3);
+        CHECK_TRUE(PriceIs(g, FixTag::Price, "4899.5"));
+        CHECK_EQ((int)fix->OpenOrderCount(), 1);
+
+        // CANCEL targets the replacement's ClOrdID
+        CHECK_EQ(fix->Execute(MakeFixReq(Command::CANCEL, Action::BUY, 0)), Bridge::RC_SUCCESS);
+        CHECK_STR_EQ(FieldOf(acceptor.Last("F"), FixTag::OrigClOrdID), FieldOf(g, FixTag::ClOrdID));
+        CHECK_EQ((int)fix->OpenOrderCount(), 0);
+
+        // Rejected by the broker
+        acceptor.SetMode(FixAcceptor::Mode::Reject);
+        CHECK_EQ(fix->Execute(MakeFixReq(Command::PLACE, Action::BUY, 1)), Bridge::RC_REJECTED);
+        CHECK_EQ((int)fix->OpenOrderCount(), 0);
+        CHECK_EQ(fix->Execute(MakeFixReq(Command::PLACE, Action::BUY, 0)), Bridge::RC_INVALID_PARAM);
+
+        // Fills move the position; CLOSEPOSITION sends the offsetting market order
+        acceptor.SetMode(FixAcceptor::Mode::Fill);
+        Bridge::SymbolId acc = Bridge::InternSymbol("ACC1");
+        Bridge::SymbolId es  = Bridge::InternSymbol("ES");
+        CHECK_EQ(fix->Execute(MakeFixReq(Command::PLACE, Action::BUY, 3)), Bridge::RC_SUCCESS);
+        CHECK_TRUE(WaitFor([&] { return fix->Position(acc, es) == 3; }));
+        CHECK_EQ(fix->Execute(MakeFixReq(Command::CLOSEPOSITION, Action::BUY, 0)), Bridge::RC_SUCCESS);
+        std::string close = acceptor.Last("D");
+        CHECK_STR_EQ(FieldOf(close, FixTag::Side), std::string("2"));
+        CHECK_EQ(IntOf(close, FixTag::OrderQty), 3);
+        CHECK_STR_EQ(FieldOf(close, FixTag::OrdType), std::string("1"));
+        CHECK_TRUE(WaitFor([&] { return fix->Position(acc, es) == 0; }));
+        CHECK_EQ((int)fix->OpenOrderCount(), 0);
+
+        // A batch goes out in one write and every request gets its answer
+        acceptor.SetMode(FixAcceptor::Mode::Ack);
+        size_t before = acceptor.CountOf("D");
+        Bridge::OrderRequest batch[3] = {
+            MakeFixReq(Command::PLACE, Action::BUY, 1, 4890.0),
+            MakeFixReq(Command::PLACE, Action::SELL, 1, 4910.0),
+            MakeFixReq(Command::PLACE, Action::BUY, 1, 4880.0),
+        };
+        int results[3] = { -99, -99, -99 };
+        fix->ExecuteBatch(batch, 3, results);
+        CHECK_TRUE(results[0] == Bridge::RC_SUCCESS && results[1] == Bridge::RC_SUCCESS &&
+                   results[2] == Bridge::RC_SUCCESS);
+        CHECK_EQ((int)(acceptor.CountOf("D") - before), 3);
+        CHECK_EQ((int)fix->OpenOrderCount(), 3);
+        CHECK_EQ(fix->Execute(MakeFixReq(Command::CANCELALLORDERS, Action::BUY, 0)), Bridge::RC_SUCCESS);
+        CHECK_EQ((int)fix->OpenOrderCount(), 0);
+
+        // A missing account or instrument is refused, never taken as "any"
+        CHECK_EQ(fix->Execute(MakeFixReq(Command::PLACE, Action::BUY, 1, 4890.0)), Bridge::RC_SUCCESS);
+        size_t cancels = acceptor.CountOf("F");
+        auto noAccount = MakeFixReq(Command::CANCELALLORDERS, Action::BUY, 0);
+        noAccount.account.clear();
+        CHECK_EQ(fix->Execute(noAccount), Bridge::RC_INVALID_PARAM);
+        auto noInstrument = MakeFixReq(Command::CANCEL, Action::BUY, 0);
+        noInstrument.instrument.clear();
+        CHECK_EQ(fix->Execute(noInstrument), Bridge::RC_INVALID_PARAM);
+        CHECK_EQ((int)(acceptor.CountOf("F") - cancels), 0);
+        CHECK_EQ((int)fix->OpenOrderCount(), 1);
+        CHECK_EQ(fix->Execute(MakeFixReq(Command::CANCELALLORDERS, Action::BUY, 0)), Bridge::RC_SUCCESS);
+        CHECK_EQ((int)fix->OpenOrderCount(), 0);
+
+        // Another session's fill does not add its names to the symbol table
+        acceptor.Send("8", [](FixWriter& w) {
+            w.Add(FixTag::OrderID, std::string_view("X1"));
+            w.Add(FixTag::ExecID, std::string_view("X1"));
+            w.Add(FixTag::ClOrdID, std::string_view("OTHER-1"));
+            w.Add(FixTag::ExecType, '2');
+            w.Add(FixTag::OrdStatus, '2');
+            w.Add(FixTag::Account, std::string_view("FIX-UNSEEN-ACCOUNT"));
+            w.Add(FixTag::Symbol, std::string_view("FIX-UNSEEN-SYMBOL"));
+            w.Add(FixTag::Side, '1');
+            w.Add(FixTag::LastShares, static_cast<int64_t>(4));
+            w.Add(FixTag::CumQty, static_cast<int64_t>(4));
+            w.Add(FixTag::LastPx, std::string_view("4900"));
+        });
+        acceptor.Send("1", [](FixWriter& w) { w.Add(FixTag::TestReqID, std::string_view("AFTER")); });
+        CHECK_TRUE(WaitFor([&] { return FieldOf(acceptor.Last("0"), FixTag::TestReqID) == "AFTER"; }));
+        CHECK_EQ(Bridge::FindSymbol("FIX-UNSEEN-ACCOUNT"), Bridge::kNoSymbol);
+        CHECK_EQ(Bridge::FindSymbol("FIX-UNSEEN-SYMBOL"), Bridge::kNoSymbol);
+
+        // Session level: TestRequest answered, a sequence gap asks for a resend
+        acceptor.Send("1", [](FixWriter& w) { w.Add(FixTag::TestReqID, std::string_view("PING")); });
+        CHECK_TRUE(WaitFor([&] { return FieldOf(acceptor.Last("0"), FixTag::TestReqID) == "PING"; }));
+        uint64_t expected = fix->NextIncomingSeq();
+        acceptor.SkipSeq();
+        acceptor.Send("0");
+        CHECK_TRUE(WaitFor([&] { return !acceptor.Last("2").empty(); }));
+        CHECK_STR_EQ(FieldOf(acceptor.Last("2"), FixTag::BeginSeqNo), std::to_string(expected));
+        CHECK_TRUE(WaitFor([&] { return fix->NextIncomingSeq() > expected + 1; }));
+        CHECK_TRUE(fix->IsConnected());
+
+        // Dropped connection: reconnects and logs on again with fresh sequence numbers
+        acceptor.DropClient();
+        CHECK_TRUE(WaitFor([&] { return acceptor.Logons() == 2 && fix->IsConnected(); }));
+        CHECK_EQ(fix->Execute(MakeFixReq(Command::PLACE, Action::BUY, 1, 4800.0)), Bridge::RC_SUCCESS);
+        CHECK_EQ(IntOf(acceptor.Last("D"), FixTag::MsgSeqNum), 2);
+
+        // Destruction logs out
+        fix.reset();
+        CHECK_EQ((int)acceptor.CountOf("5"), 1);
+    }
+
+    // An order with a replace still out is cancelled under its last accepted ClOrdID
+    {
+        FixAcceptor acceptor;
+        acceptor.HoldReplaces();
+        Bridge::FixAdapter fix(SettingsFor(acceptor.Port(), 0));
+        CHECK_TRUE(WaitFor([&] { return fix.IsConnected(); }));
+        CHECK_EQ(fix.Execute(MakeFixReq(Command::PLACE, Action::BUY, 2, 4900.25)), Bridge::RC_SUCCESS);
+        CHECK_EQ(fix.Execute(MakeFixReq(Command::CHANGE, Action::BUY, 3, 4899.5)), Bridge::RC_SUCCESS);
+        CHECK_TRUE(WaitFor([&] { return acceptor.CountOf("G") == 1; }));
+        CHECK_EQ((int)fix.OpenOrderCount(), 1);
+
+        CHECK_EQ(fix.Execute(MakeFixReq(Command::FLATTENEVERYTHING, Action::BUY, 0)), Bridge::RC_SUCCESS);
+        CHECK_TRUE(WaitFor([&] { return acceptor.CountOf("F") == 1; }));
+        CHECK_STR_EQ(FieldOf(acceptor.Last("F"), FixTag::OrigClOrdID), FieldOf(acceptor.Last("D"), FixTag::ClOrdID));
+        CHECK_TRUE(WaitFor([&] { return fix.OpenOrderCount() == 0; }));   // canceled, replacement with it
+        CHECK_EQ(fix.Execute(MakeFixReq(Command::CANCELALLORDERS, Action::BUY, 0)), Bridge::RC_SUCCESS);
+        CHECK_EQ((int)acceptor.CountOf("F"), 1);
+    }
+
+    // Session store: resend from the store, resume after a restart
+    {
+        namespace fs = std::filesystem;
+        fs::path store = fs::temp_directory_path() / "bridge_fix_session.store";
+        fs::remove(store);
+        FixAcceptor acceptor;
+        acceptor.KeepSeqs();
+        Bridge::FixSettings settings = SettingsFor(acceptor.Port(), 2000);
+        settings.storePath = store.string();
+
+        auto fix = std::make_unique<Bridge::FixAdapter>(settings);
+        CHECK_TRUE(WaitFor([&] { return fix->IsConnected(); }));
+        CHECK_STR_EQ(FieldOf(acceptor.Last("A"), FixTag::ResetSeqNumFlag), std::string("Y"));   // a new store
+        CHECK_EQ(fix->Execute(MakeFixReq(Command::PLACE, Action::BUY, 1, 4900.0)), Bridge::RC_SUCCESS);
+        CHECK_EQ(fix->Execute(MakeFixReq(Command::PLACE, Action::SELL, 2, 4910.0)), Bridge::RC_SUCCESS);
+        std::string first  = acceptor.Received()[1];
+        std::string second = acceptor.Last("D");
+        acceptor.Send("1", [](FixWriter& w) { w.Add(FixTag::TestReqID, std::string_view("T")); });   // heartbeat 4
+        CHECK_TRUE(WaitFor([&] { return acceptor.CountOf("0") == 1; }));
+        CHECK_EQ(fix->Execute(MakeFixReq(Command::PLACE, Action::BUY, 3, 4890.0)), Bridge::RC_SUCCESS);   // 5
+
+        // Orders come again as possible duplicates; the heartbeat becomes a gap fill
+        size_t before = acceptor.Received().size();
+        acceptor.Send("2", [](FixWriter& w) {
+            w.Add(FixTag::BeginSeqNo, static_cast<int64_t>(2));
+            w.Add(FixTag::EndSeqNo, static_cast<int64_t>(0));
+        });
+        CHECK_TRUE(WaitFor([&] { return acceptor.Received().size() >= before + 4; }));
+        std::vector<std::string> resent = acceptor.Received();
+        resent.erase(resent.begin(), resent.begin() + static_cast<ptrdiff_t>(before));
+        CHECK_EQ((int)resent.size(), 4);
+        if (resent.size() == 4) {
+            CHECK_EQ(IntOf(resent[0], FixTag::MsgSeqNum), 2);
+            CHECK_STR_EQ(FieldOf(resent[0], FixTag::ClOrdID), FieldOf(first, FixTag::ClOrdID));
+            CHECK_STR_EQ(FieldOf(resent[0], FixTag::PossDupFlag), std::string("Y"));
+            CHECK_STR_EQ(FieldOf(resent[0], FixTag::OrigSendingTime), FieldOf(first, FixTag::SendingTime));
+            CHECK_EQ(IntOf(resent[0], FixTag::OrderQty), 1);
+            CHECK_TRUE(PriceIs(resent[0], FixTag::Price, "4900"));
+            CHECK_EQ(IntOf(resent[1], FixTag::MsgSeqNum), 3);
+            CHECK_STR_EQ(FieldOf(resent[1], FixTag::ClOrdID), FieldOf(second, FixTag::ClOrdID));
+            CHECK_STR_EQ(FieldOf(resent[2], FixTag::MsgType), std::string("4"));
+            CHECK_EQ(IntOf(resent[2], FixTag::MsgSeqNum), 4);
+            CHECK_STR_EQ(FieldOf(resent[2], FixTag::GapFillFlag), std::string("Y"));
+            CHECK_EQ(IntOf(resent[2], FixTag::NewSeqNo), 5);
+            CHECK_EQ(IntOf(resent[3], FixTag::MsgSeqNum), 5);
+            CHECK_STR_EQ(FieldOf(resent[3], FixTag::MsgType), std::string("D"));
+        }
+        CHECK_EQ((int)fix->NextOutgoingSeq(), 6);
+        uint64_t inSeq = fix->NextIncomingSeq();
+
+        // A restart picks up both sequences from the store, without a reset
+        fix.reset();   // logout is 6
+        fix = std::make_unique<Bridge::FixAdapter>(settings);
+        CHECK_EQ((int)fix->NextOutgoingSeq(), 7);
+        CHECK_EQ((int)fix->NextIncomingSeq(), (int)inSeq + 1);   // the logout reply
+        CHECK_TRUE(WaitFor([&] { return fix->IsConnected(); }));
+        std::string logon = acceptor.Last("A");
+        CHECK_EQ(IntOf(logon, FixTag::MsgSeqNum), 7);
+        CHECK_FALSE(FieldOf(logon, FixTag::ResetSeqNumFlag) == "Y");
+        CHECK_EQ(fix->Execute(MakeFixReq(Command::PLACE, Action::BUY, 1, 4800.0)), Bridge::RC_SUCCESS);
+        CHECK_EQ(IntOf(acceptor.Last("D"), FixTag::MsgSeqNum), 8);
+
+        // Messages missed while down are asked for at logon
+        uint64_t missed = fix->NextIncomingSeq() + 1;   // after the logout reply
+        fix.reset();
+        acceptor.SkipSeq();
+        acceptor.SkipSeq();
+        fix = std::make_unique<Bridge::FixAdapter>(settings);
+        CHECK_TRUE(WaitFor([&] { return fix->IsConnected(); }));
+        CHECK_TRUE(WaitFor([&] { return IntOf(acceptor.Last("2"), FixTag::BeginSeqNo) == (int64_t)missed; }));
+        CHECK_TRUE(WaitFor([&] { return fix->NextIncomingSeq() > missed + 2; }));
+        CHECK_EQ(fix->Execute(MakeFixReq(Command::PLACE, Action::SELL, 1, 4810.0)), Bridge::RC_SUCCESS);
+
+        // The counterparty resets at logon: both sides start over, and a
+        // resend covers only the new session
+        fix.reset();
+        acceptor.ResetAtLogon();
+        fix = std::make_unique<Bridge::FixAdapter>(settings);
+        CHECK_TRUE(WaitFor([&] { return fix->IsConnected(); }));
+        CHECK_FALSE(FieldOf(acceptor.Last("A"), FixTag::ResetSeqNumFlag) == "Y");   // we did not ask
+        CHECK_EQ((int)fix->NextOutgoingSeq(), 2);
+        CHECK_EQ((int)fix->NextIncomingSeq(), 2);
+        CHECK_EQ(fix->Execute(MakeFixReq(Command::PLACE, Action::BUY, 2, 4790.0)), Bridge::RC_SUCCESS);
+        std::string fresh = acceptor.Last("D");
+        CHECK_EQ(IntOf(fresh, FixTag::MsgSeqNum), 2);
+        before = acceptor.Received().size();
+        acceptor.Send("2", [](FixWriter& w) {
+            w.Add(FixTag::BeginSeqNo, static_cast<int64_t>(2));
+            w.Add(FixTag::EndSeqNo, static_cast<int64_t>(0));
+        });
+        CHECK_TRUE(WaitFor([&] { return acceptor.Received().size() > before; }));
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));   // nothing more follows
+        resent = acceptor.Received();
+        CHECK_EQ((int)(resent.size() - before), 1);
+        if (resent.size() == before + 1) {
+            CHECK_EQ(IntOf(resent.back(), FixTag::MsgSeqNum), 2);
+            CHECK_STR_EQ(FieldOf(resent.back(), FixTag::ClOrdID), FieldOf(fresh, FixTag::ClOrdID));
+            CHECK_STR_EQ(FieldOf(resent.back(), FixTag::PossDupFlag), std::string("Y"));
+        }
+        CHECK_EQ((int)fix->NextOutgoingSeq(), 3);
+        fix.reset();
+        fs::remove(store);
+    }
+
+    // No answer within fixAckTimeoutMs
+    {
+        FixAcceptor acceptor;
+        acceptor.SetMode(FixAcceptor::Mode::Silent);
+        Bridge::FixAdapter fix(SettingsFor(acceptor.Port(), 50));
+        CHECK_TRUE(WaitFor([&] { return fix.IsConnected(); }));
+        CHECK_EQ(fix.Execute(MakeFixReq(Command::PLACE, Action::BUY, 1)), Bridge::RC_TIMEOUT);
+        CHECK_EQ((int)fix.OpenOrderCount(), 1);   // it may still be working at the broker
+    }
+
+    // bridge.json keys and the factory
+    {
+        namespace fs = std::filesystem;
+        fs::path cfgPath = fs::temp_directory_path() / "bridge_fix_test.json";
+        std::ofstream(cfgPath) << "{\n  \"adapterType\": \"FIX\",\n  \"fixHost\": \"10.1.2.3\",\n"
+                                  "  \"fixPort\": 5001,\n  \"fixSenderCompId\": \"ME\",\n"
+                                  "  \"fixTargetCompId\": \"T4\",\n  \"fixHeartbeatSeconds\": 10,\n"
+                                  "  \"fixAckTimeoutMs\": 250,\n  \"fixStorePath\": \"logs/fix.store\"\n}\n";
+        Bridge::BridgeConfig cfg;
+        CHECK_EQ(Bridge::LoadConfig(cfgPath.string(), cfg), Bridge::RC_SUCCESS);
+        fs::remove(cfgPath);
+        Bridge::FixSettings s = Bridge::FixSettingsOf(cfg);
+        CHECK_STR_EQ(s.host, std::string("10.1.2.3"));
+        CHECK_EQ(s.port, 5001);
+        CHECK_STR_EQ(s.senderCompId, std::string("ME"));
+        CHECK_STR_EQ(s.targetCompId, std::string("T4"));
+        CHECK_EQ(s.heartbeatSeconds, 10);
+        CHECK_EQ(s.ackTimeoutMs, 250);
+        CHECK_STR_EQ(s.storePath, std::string("logs/fix.store"));
+
+        Bridge::BridgeConfig other = cfg;
+        CHECK_FALSE(Bridge::AdapterSettingsDiffer(cfg, other));
+        other.fixTargetCompId = "T5";
+        CHECK_TRUE(Bridge::AdapterSettingsDiffer(cfg, other));
+
+        cfg.fixPort = 0;   // never connects; just the type
+        auto adapter = Bridge::CreateAdapter(cfg);
+        CHECK_TRUE(dynamic_cast<Bridge::FixAdapter*>(adapter.get()) != nullptr);
+    }
+}
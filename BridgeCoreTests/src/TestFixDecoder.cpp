@@ -0,0 +1,229 @@
+#include "TestFramework.h"
+#include "../../BridgeCore/include/FixDecoder.h"
+#include "../../BridgeCore/include/FixMessage.h"
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using Bridge::FixDecoder;
+using Bridge::FixFields;
+
+namespace {
+
+// Wrap a body ("35=...|...|", '|' for SOH) in BeginString, BodyLength and
+// a correct CheckSum.
+std::string Frame(std::string body) {
+    for (char& c : body)
+        if (c == '|') c = Bridge::kFixSoh;
+    std::string msg = "8=FIX.4.2\x01" "9=" + std::to_string(body.size()) + "\x01" + body;
+    unsigned sum = 0;
+    for (char c : msg) sum += static_cast<unsigned char>(c);
+    char trailer[8];
+    snprintf(trailer, sizeof(trailer), "10=%03u\x01", sum & 0xFF);
+    return msg + trailer;
+}
+
+// What the acceptor sends: session messages and every kind of execution report.
+std::vector<std::string> Corpus() {
+    const char* const bodies[] = {
+        "35=A|49=SERVER|56=CLIENT|34=1|52=20260314-09:30:00.000|98=0|108=30|",
+        "35=0|49=SERVER|56=CLIENT|34=2|52=20260314-09:30:30.000|",
+        "35=1|49=SERVER|56=CLIENT|34=3|52=20260314-09:30:31.000|112=PING|",
+        "35=8|49=SERVER|56=CLIENT|34=4|52=20260314-09:30:01.123|37=O-1|11=BR093000A-1|17=E-1|"
+        "150=0|39=0|1=ACC1|55=ES|54=1|38=2|151=2|14=0|6=0|",
+        "35=8|49=SERVER|56=CLIENT|34=5|52=20260314-09:30:01.456|37=O-1|11=BR093000A-1|17=E-2|"
+        "150=1|39=1|1=ACC1|55=ES|54=1|38=2|32=1|31=4900.25|151=1|14=1|6=4900.25|",
+        "35=8|49=SERVER|56=CLIENT|34=6|52=20260314-09:30:01.789|37=O-1|11=BR093000A-1|17=E-3|"
+        "150=2|39=2|1=ACC1|55=ES|54=1|38=2|32=1|31=4900.5|151=0|14=2|6=4900.375|",
+        "35=8|49=SERVER|56=CLIENT|34=7|52=20260314-09:30:02.000|37=NONE|11=BR093000A-2|17=E-4|"
+        "150=8|39=8|55=NQ|54=2|151=0|14=0|58=price=0 is not valid|",
+        "35=8|49=SERVER|56=CLIENT|34=8|43=Y|52=20260314-09:30:02.500|37=O-3|11=BR093000A-4|"
+        "41=BR093000A-3|17=E-5|150=5|39=5|55=ES|54=2|151=3|14=0|",
+        "35=9|49=SERVER|56=CLIENT|34=9|52=20260314-09:30:03.000|37=O-3|11=BR093000A-5|"
+        "41=BR093000A-4|39=8|58=too late to cancel|",
+        "35=3|49=SERVER|56=CLIENT|34=10|52=20260314-09:30:04.000|45=12|58=|",
+        "35=j|49=SERVER|56=CLIENT|34=11|52=20260314-09:30:05.000|45=13|58=first|58=second|",
+        "35=4|49=SERVER|56=CLIENT|34=12|43=Y|52=20260314-09:30:06.000|123=Y|36=20|9999=x|5000=big|",
+        "35=5|49=SERVER|56=CLIENT|34=13|52=20260314-09:30:07.000|58=bye|",
+    };
+    std::vector<std::string> out;
+    for (const char* b : bodies) out.push_back(Frame(b));
+    return out;
+}
+
+// Every tag the corpus uses, plus some it does not.
+const int kProbeTags[] = { 1, 6, 7, 11, 14, 17, 31, 32, 34, 35, 36, 37, 38, 39, 41, 43, 44, 45, 49, 52, 54,
+                           55, 56, 58, 98, 108, 112, 123, 150, 151, 255, 256, 5000, 9999, 123456 };
+
+// The decoder agrees with FixFields, the reference field-by-field parser.
+bool SameAsFields(const FixDecoder& d, std::string_view msg) {
+    FixFields f;
+    if (!f.Parse(msg)) return false;
+    for (int tag : kProbeTags)
+        if (d.Get(tag) != f.Get(tag) || d.Has(tag) != f.Has(tag)) return false;
+    return true;
+}
+
+bool InsideOf(std::string_view v, std::string_view buf) {
+    return v.empty() || (v.data() >= buf.data() && v.data() + v.size() <= buf.data() + buf.size());
+}
+
+struct Rng {
+    uint64_t s = 0x2545F4914F6CDD1Dull;
+    uint64_t Next() {
+        s ^= s << 13;
+        s ^= s >> 7;
+        s ^= s << 17;
+        return s;
+    }
+    size_t Below(size_t n) { return n ? static_cast<size_t>(Next() % n) : 0; }
+};
+
+// One random edit of a message body: byte flips, FIX delimiters and digits
+// in odd places, deletions, duplications and truncation.
+void Mutate(std::string& body, Rng& rng) {
+    static const char kBytes[] = { '\x01', '=', '0', '9', '|', '\x80', '\xFF', '\0', 'A' };
+    size_t at = rng.Below(body.size() + 1);
+    switch (rng.Below(6)) {
+        case 0: if (!body.empty()) body[rng.Below(body.size())] = static_cast<char>(rng.Next()); break;
+        case 1: body.insert(at, 1, kBytes[rng.Below(sizeof(kBytes))]); break;
+        case 2: if (at < body.size()) body.erase(at, 1 + rng.Below(4)); break;
+        case 3: body.insert(at, body.substr(rng.Below(body.size()), rng.Below(16))); break;
+        case 4: body.resize(rng.Below(body.size() + 1)); break;
+        default: body.insert(at, std::to_string(rng.Next() % 100000) + "="); break;
+    }
+}
+
+} // namespace
+
+void TestFixDecoder() {
+    printf("\n-- TestFixDecoder --\n");
+    const std::vector<std::string> corpus = Corpus();
+
+    // Vector byte sum matches a plain loop at every length and alignment
+    {
+        Rng rng;
+        std::vector<char> bytes(600);
+        for (char& c : bytes) c = static_cast<char>(rng.Next());
+        bool same = true;
+        for (size_t start = 0; start < 40; ++start) {
+            for (size_t n = 0; n + start <= bytes.size(); n += 1 + n / 8) {
+                unsigned expect = 0;
+                for (size_t i = 0; i < n; ++i) expect += static_cast<unsigned char>(bytes[start + i]);
+                if (Bridge::FixByteSum(bytes.data() + start, n) != expect) same = false;
+            }
+        }
+        CHECK_TRUE(same);
+    }
+
+    // Every corpus message decodes, indexes and agrees with FixFields
+    {
+        FixDecoder d;
+        bool all = true;
+        for (const std::string& m : corpus) {
+            if (d.Decode(m) != static_cast<ptrdiff_t>(m.size()) || !SameAsFields(d, m)) all = false;
+        }
+        CHECK_TRUE(all);
+
+        CHECK_EQ(d.Decode(corpus[4]), (int)corpus[4].size());
+        CHECK_TRUE(d.MsgType() == "8");
+        CHECK_TRUE(d.Get(Bridge::FixTag::ClOrdID) == "BR093000A-1");
+        CHECK_TRUE(d.GetChar(Bridge::FixTag::ExecType) == '1');
+        CHECK_EQ(d.GetInt(Bridge::FixTag::LastShares), 1);
+        CHECK_TRUE(d.Get(Bridge::FixTag::LastPx) == "4900.25");
+        CHECK_TRUE(d.Message().data() == corpus[4].data());   // no copy
+        CHECK_FALSE(d.Has(Bridge::FixTag::Text));
+
+        CHECK_EQ(d.Decode(corpus[6]), (int)corpus[6].size());
+        CHECK_TRUE(d.Get(Bridge::FixTag::Text) == "price=0 is not valid");
+        CHECK_EQ(d.Decode(corpus[9]), (int)corpus[9].size());
+        CHECK_TRUE(d.Has(Bridge::FixTag::Text) && d.Get(Bridge::FixTag::Text).empty());
+        CHECK_EQ(d.Decode(corpus[10]), (int)corpus[10].size());
+        CHECK_TRUE(d.Get(Bridge::FixTag::Text) == "first");
+        CHECK_EQ(d.Decode(corpus[11]), (int)corpus[11].size());
+        CHECK_TRUE(d.Get(9999) == "x" && d.Get(5000) == "big" && !d.Has(123456));
+        CHECK_EQ(d.GetInt(Bridge::FixTag::NewSeqNo), 20);
+
+        CHECK_TRUE(FixDecoder::IsIndexed(Bridge::FixTag::ExecType));
+        CHECK_TRUE(FixDecoder::IsIndexed(Bridge::FixTag::LeavesQty));
+        CHECK_FALSE(FixDecoder::IsIndexed(Bridge::FixTag::NewSeqNo));
+        CHECK_FALSE(FixDecoder::IsIndexed(-1));
+        CHECK_FALSE(FixDecoder::IsIndexed(100000));
+    }
+
+    // A stream of messages decodes in order; every prefix just needs more bytes
+    {
+        std::string stream;
+        for (const std::string& m : corpus) stream += m;
+        FixDecoder d;
+        size_t used = 0, count = 0;
+        size_t before = g_allocCount.load();
+        while (used < stream.size()) {
+            ptrdiff_t n = d.Decode(std::string_view(stream).substr(used));
+            if (n <= 0) break;
+            used += static_cast<size_t>(n);
+            ++count;
+        }
+        CHECK_EQ((int)(g_allocCount.load() - before), 0);
+        CHECK_EQ((int)count, (int)corpus.size());
+        CHECK_EQ((int)used, (int)stream.size());
+
+        bool prefixes = true;
+        for (size_t n = 0; n < corpus[5].size(); ++n)
+            if (d.Decode(std::string_view(corpus[5]).substr(0, n)) != 0) prefixes = false;
+        CHECK_TRUE(prefixes);
+
+        std::string bad = corpus[5];
+        bad[bad.size() - 3] = bad[bad.size() - 3] == '0' ? '1' : '0';   // CheckSum off by one
+        CHECK_EQ(d.Decode(bad), -1);
+        CHECK_TRUE(d.Message().empty() && !d.Has(Bridge::FixTag::MsgType));
+        CHECK_EQ(d.Decode(Frame("35=0|49=SERVER|=oops|")), -1);
+        CHECK_EQ(d.Decode(Frame("35=0|49=SERVER|abc=1|")), -1);
+        CHECK_TRUE(!d.Has(Bridge::FixTag::MsgType) && d.Get(Bridge::FixTag::SenderCompID).empty());
+    }
+
+    // Fuzz: mutated bodies, re-framed so they reach the field walk, and raw
+    // mutations that the framing must reject or survive
+    {
+        Rng rng;
+        FixDecoder d;
+        int decoded = 0, rejected = 0;
+        bool agree = true, inside = true, sane = true;
+        for (int i = 0; i < 20000; ++i) {
+            const std::string& seed = corpus[rng.Below(corpus.size())];
+            std::string m;
+            if (i % 2 == 0) {
+                size_t bodyStart = seed.find('\x01', 10) + 1;
+                std::string body = seed.substr(bodyStart, seed.size() - bodyStart - 7);
+                for (size_t k = 0, edits = 1 + rng.Below(3); k < edits; ++k) Mutate(body, rng);
+                m = Frame(body);
+            } else {
+                m = seed;
+                Mutate(m, rng);
+            }
+            ptrdiff_t n = d.Decode(m);
+            if (n > static_cast<ptrdiff_t>(m.size())) sane = false;
+            if (n < 0) {
+                ++rejected;
+                std::string_view framed = m;
+                ptrdiff_t f = Bridge::FixFrame(framed);
+                FixFields ref;
+                if (f > 0 && ref.Parse(framed.substr(0, static_cast<size_t>(f)))) agree = false;
+                continue;
+            }
+            if (n == 0) continue;
+            ++decoded;
+            std::string_view msg = std::string_view(m).substr(0, static_cast<size_t>(n));
+            FixFields ref;
+            if (ref.Parse(msg) && !SameAsFields(d, msg)) agree = false;
+            for (int tag : kProbeTags)
+                if (!InsideOf(d.Get(tag), msg)) inside = false;
+        }
+        CHECK_TRUE(sane);
+        CHECK_TRUE(agree);
+        CHECK_TRUE(inside);
+        CHECK_TRUE(decoded > 1000);
+        CHECK_TRUE(rejected > 1000);
+    }
+}
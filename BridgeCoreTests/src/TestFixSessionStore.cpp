@@ -0,0 +1,137 @@
+#include "TestFramework.h"
+#include "../../BridgeCore/include/FixSessionStore.h"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+using Bridge::FixSessionStore;
+
+namespace {
+
+// A distinct, recognisable message for each sequence number.
+std::string MessageFor(uint64_t seq, size_t size) {
+    std::string m = "35=D|34=" + std::to_string(seq) + "|";
+    m.resize(size, static_cast<char>('a' + seq % 26));
+    return m;
+}
+
+} // namespace
+
+void TestFixSessionStore() {
+    printf("\n-- TestFixSessionStore --\n");
+    namespace fs = std::filesystem;
+
+    fs::path dir = fs::temp_directory_path() / "bridge_fixstore_test";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    std::string path = (dir / "session.store").string();
+
+    // A new store starts both sequences at 1 and keeps nothing
+    {
+        FixSessionStore s;
+        CHECK_TRUE(s.Open(path, "CLIENT", "SERVER", 4096, 16));
+        CHECK_EQ((int)s.NextOutgoing(), 1);
+        CHECK_EQ((int)s.NextIncoming(), 1);
+        CHECK_TRUE(s.Find(1).empty());
+
+        // Session messages (not stored) between orders leave gaps
+        for (uint64_t seq = 1; seq <= 9; ++seq) {
+            if (seq % 3 != 0) CHECK_TRUE(s.Store(seq, MessageFor(seq, 100)));
+            s.SetNextOutgoing(seq + 1);
+        }
+        s.SetNextIncoming(42);
+        CHECK_TRUE(s.Find(4) == MessageFor(4, 100));
+        CHECK_TRUE(s.Find(3).empty());
+        CHECK_TRUE(s.Find(10).empty());
+        CHECK_FALSE(s.Store(8, MessageFor(8, 100)));   // sequence numbers only rise
+        CHECK_FALSE(s.Store(10, std::string(2048, 'x')));   // more than a quarter of the ring
+    }
+
+    // Reopening resumes the sequences and finds the same messages
+    {
+        auto t0 = std::chrono::steady_clock::now();
+        FixSessionStore s;
+        CHECK_TRUE(s.Open(path, "CLIENT", "SERVER", 4096, 16));
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - t0).count();
+        CHECK_TRUE(ms < 100);
+        CHECK_EQ((int)s.NextOutgoing(), 10);
+        CHECK_EQ((int)s.NextIncoming(), 42);
+        bool same = true;
+        for (uint64_t seq = 1; seq <= 9; ++seq)
+            if (s.Find(seq) != (seq % 3 != 0 ? MessageFor(seq, 100) : std::string())) same = false;
+        CHECK_TRUE(same);
+
+        // Another session's CompIDs, or other sizes, are refused
+        FixSessionStore other;
+        CHECK_FALSE(other.Open(path, "CLIENT", "OTHER", 4096, 16));
+        CHECK_FALSE(other.Open(path, "CLIENT", "SERVER", 8192, 16));
+        CHECK_FALSE(other.Open(path, std::string(64, 'C'), "SERVER"));
+    }
+
+    // Wrapping the ring drops the oldest messages, only as many as needed
+    {
+        FixSessionStore s;
+        CHECK_TRUE(s.Open((dir / "wrap.store").string(), "CLIENT", "SERVER", 1024, 64));
+        bool kept = true, intact = true;
+        for (uint64_t seq = 1; seq <= 200; ++seq) {
+            size_t size = 40 + (seq * 37) % 200;
+            if (!s.Store(seq, MessageFor(seq, size))) kept = false;
+            // Everything from FirstKept on is intact; older ones are gone
+            for (uint64_t old = 1; old <= seq; ++old) {
+                std::string_view m = s.Find(old);
+                if (old >= s.FirstKept() && m != MessageFor(old, 40 + (old * 37) % 200)) intact = false;
+                if (old < s.FirstKept() && !m.empty()) intact = false;
+            }
+        }
+        CHECK_TRUE(kept);
+        CHECK_TRUE(intact);
+        CHECK_TRUE(s.FirstKept() >= 190);   // a 1 KB ring holds a handful
+        CHECK_TRUE(s.Find(200) == MessageFor(200, 40 + (200 * 37) % 200));
+    }
+
+    // The index holds the last indexSlots numbers, whatever the ring holds
+    {
+        FixSessionStore s;
+        CHECK_TRUE(s.Open((dir / "index.store").string(), "CLIENT", "SERVER", 1 << 16, 8));
+        for (uint64_t seq = 1; seq <= 20; ++seq) s.Store(seq, MessageFor(seq, 16));
+        CHECK_EQ((int)s.FirstKept(), 13);
+        CHECK_TRUE(s.Find(12).empty());
+        CHECK_TRUE(s.Find(13) == MessageFor(13, 16));
+        CHECK_TRUE(s.Find(20) == MessageFor(20, 16));
+
+        s.Reset();
+        CHECK_EQ((int)s.NextOutgoing(), 1);
+        CHECK_EQ((int)s.NextIncoming(), 1);
+        CHECK_TRUE(s.Find(20).empty());
+        CHECK_TRUE(s.Store(1, MessageFor(1, 16)));
+        CHECK_TRUE(s.Find(1) == MessageFor(1, 16));
+    }
+
+    // Not a store
+    {
+        std::string junk = (dir / "junk.store").string();
+        std::ofstream(junk) << "this is not a session store";
+        FixSessionStore s;
+        CHECK_FALSE(s.Open(junk, "CLIENT", "SERVER", 4096, 16));
+        CHECK_FALSE(s.IsOpen());
+        CHECK_FALSE(s.Store(1, "35=D|"));
+        CHECK_EQ((int)s.NextOutgoing(), 1);
+    }
+
+    // Storing never allocates
+    {
+        FixSessionStore s;
+        CHECK_TRUE(s.Open((dir / "alloc.store").string(), "CLIENT", "SERVER"));
+        std::string msg = MessageFor(1, 180);
+        size_t before = g_allocCount.load();
+        for (uint64_t seq = 1; seq <= 10000; ++seq) {
+            s.Store(seq, msg);
+            s.SetNextOutgoing(seq + 1);
+        }
+        CHECK_EQ((int)(g_allocCount.load() - before), 0);
+        CHECK_TRUE(s.Find(10000) == msg);
+    }
+
+    fs::remove_all(dir);
+}
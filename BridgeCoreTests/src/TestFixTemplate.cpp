@@ -0,0 +1,148 @@
+#include "TestFramework.h"
+#include "../../BridgeCore/include/FixMessage.h"
+#include "../../BridgeCore/include/FixTemplate.h"
+#include "../../BridgeCore/include/Numeric.h"
+#include <string>
+
+using Bridge::FixFields;
+using Bridge::FixOrderFields;
+namespace FixTag = Bridge::FixTag;
+
+namespace {
+
+FixOrderFields MakeFields(char ordType) {
+    FixOrderFields f;
+    f.clOrdId  = "BR093000A-17";
+    f.account  = "ACC1";
+    f.symbol   = "ESH26";
+    f.side     = '2';
+    f.quantity = 3;
+    f.ordType  = ordType;
+    f.tif      = '1';
+    Bridge::ParsePrice("4200.25", f.price);
+    Bridge::ParsePrice("4199.75", f.stopPx);
+    return f;
+}
+
+bool SamePrice(std::string_view a, std::string_view b) {
+    Bridge::FixedPrice x, y;
+    return Bridge::ParsePrice(a, x) == std::errc{} && Bridge::ParsePrice(b, y) == std::errc{} &&
+           Bridge::ComparePrice(x, y) == 0;
+}
+
+// Same fields with the same values as the FixWriter encoding, whatever the
+// padding and order.
+bool SameAsWriter(std::string_view msg, char msgType, uint64_t seq, const FixOrderFields& f) {
+    Bridge::FixWriter w;
+    std::string ref(Bridge::EncodeOrder(w, msgType, "CLIENT", "SERVER", seq, f));
+    FixFields a, b;
+    if (ref.empty() || !a.Parse(msg) || !b.Parse(ref) || a.Count() != b.Count()) return false;
+    const int text[]   = { FixTag::MsgType, FixTag::SenderCompID, FixTag::TargetCompID, FixTag::ClOrdID,
+                           FixTag::OrigClOrdID, FixTag::Account, FixTag::Symbol, FixTag::Side,
+                           FixTag::HandlInst, FixTag::OrdType, FixTag::TimeInForce };
+    const int number[] = { FixTag::MsgSeqNum, FixTag::OrderQty };
+    const int price[]  = { FixTag::Price, FixTag::StopPx };
+    for (int tag : text)
+        if (a.Has(tag) != b.Has(tag) || a.Get(tag) != b.Get(tag)) return false;
+    for (int tag : number)
+        if (a.Has(tag) != b.Has(tag) || a.GetInt(tag) != b.GetInt(tag)) return false;
+    for (int tag : price)
+        if (a.Has(tag) != b.Has(tag) || (a.Has(tag) && !SamePrice(a.Get(tag), b.Get(tag)))) return false;
+    // Both timestamps come from the same clock read.
+    return a.Get(FixTag::SendingTime).size() == Bridge::kFixTimestampLen &&
+           a.Get(FixTag::SendingTime) == a.Get(FixTag::TransactTime);
+}
+
+} // namespace
+
+void TestFixTemplate() {
+    printf("\n-- TestFixTemplate --\n");
+
+    Bridge::FixOrderTemplates templates("CLIENT", "SERVER");
+    CHECK_TRUE(templates.Valid());
+
+    // Every message type and OrdType frames, checksums and matches the writer
+    {
+        for (char type : { 'D', 'F', 'G' }) {
+            for (char ordType : { '1', '2', '3', '4' }) {
+                FixOrderFields f = MakeFields(ordType);
+                if (type != 'D') f.origClOrdId = "BR093000A-16";
+                std::string_view msg = templates.Render(type, 42, f);
+                CHECK_TRUE(!msg.empty() && Bridge::FixFrame(msg) == static_cast<ptrdiff_t>(msg.size()));
+                CHECK_TRUE(SameAsWriter(msg, type, 42, f));
+                if (type == 'F') break;
+            }
+        }
+        FixFields m;
+        FixOrderFields f = MakeFields('1');
+        CHECK_TRUE(m.Parse(templates.Render('D', 7, f)));
+        CHECK_FALSE(m.Has(FixTag::Price));
+        CHECK_FALSE(m.Has(FixTag::StopPx));
+        CHECK_TRUE(m.Parse(templates.Render('F', 7, f)));
+        CHECK_FALSE(m.Has(FixTag::OrdType));
+        CHECK_TRUE(m.Has(FixTag::OrigClOrdID));
+    }
+
+    // Slots are re-patched: shorter strings and smaller numbers after longer ones
+    {
+        FixOrderFields f = MakeFields('4');
+        f.account  = "A-VERY-LONG-ACCOUNT-NAME";
+        f.quantity = 999999999;
+        Bridge::ParsePrice("-123456.123456789", f.price);
+        std::string_view first = templates.Render('D', 999999999, f);
+        CHECK_TRUE(Bridge::FixFrame(first) == static_cast<ptrdiff_t>(first.size()));
+        CHECK_TRUE(SameAsWriter(first, 'D', 999999999, f));
+
+        FixOrderFields g = MakeFields('4');
+        g.account = "";
+        std::string_view second = templates.Render('D', 1, g);
+        CHECK_TRUE(Bridge::FixFrame(second) == static_cast<ptrdiff_t>(second.size()));
+        CHECK_TRUE(SameAsWriter(second, 'D', 1, g));
+        FixFields m;
+        CHECK_TRUE(m.Parse(second));
+        CHECK_FALSE(m.Has(FixTag::Account));
+    }
+
+    // Values that do not fit a slot are left to the writer
+    {
+        FixOrderFields f = MakeFields('2');
+        CHECK_TRUE(templates.Render('D', 1000000000, f).empty());
+        Bridge::FixWriter w;
+        CHECK_FALSE(Bridge::EncodeOrder(w, 'D', "CLIENT", "SERVER", 1000000000, f).empty());
+
+        f.quantity = 1000000000;
+        CHECK_TRUE(templates.Render('D', 1, f).empty());
+        f.quantity = -1;
+        CHECK_TRUE(templates.Render('D', 1, f).empty());
+
+        f = MakeFields('2');
+        f.price = Bridge::FixedPrice{};   // a limit order needs its price
+        CHECK_TRUE(templates.Render('D', 1, f).empty());
+        CHECK_TRUE(Bridge::EncodeOrder(w, 'D', "CLIENT", "SERVER", 1, f).empty());
+
+        std::string longSymbol(Bridge::FixOrderTemplates::kCapacity, 'S');
+        f = MakeFields('1');
+        f.symbol = longSymbol;
+        CHECK_TRUE(templates.Render('D', 1, f).empty());
+        CHECK_TRUE(templates.Render('X', 1, MakeFields('1')).empty());
+        CHECK_TRUE(templates.Render('D', 1, MakeFields('9')).empty());
+
+        std::string longId(Bridge::FixOrderTemplates::kCapacity, 'C');
+        Bridge::FixOrderTemplates bad(longId, "SERVER");
+        CHECK_FALSE(bad.Valid());
+        CHECK_TRUE(bad.Render('D', 1, MakeFields('1')).empty());
+    }
+
+    // Rendering never allocates
+    {
+        FixOrderFields f = MakeFields('2');
+        size_t total  = 0;
+        size_t before = g_allocCount.load();
+        for (uint64_t seq = 1; seq <= 1000; ++seq) {
+            f.quantity = static_cast<int64_t>(seq);
+            total += templates.Render('D', seq, f).size();
+        }
+        CHECK_EQ((int)(g_allocCount.load() - before), 0);
+        CHECK_TRUE(total > 0);
+    }
+}
@@ -1,10 +1,15 @@
 // TestFramework shared declarations (included by test files, not compiled separately)
 #pragma once
 #include <cstdio>
+#include <cstddef>
+#include <atomic>
 
 extern int g_pass;
 extern int g_fail;
 
+// Number of global operator new calls made so far (counted in main.cpp).
+extern std::atomic<size_t> g_allocCount;
+
 #define CHECK_EQ(a, b) do { \
     if ((a) == (b)) { \
         printf("[PASS] %s == %s\n", #a, #b); \
@@ -0,0 +1,240 @@
+#include "TestFramework.h"
+#include "../../BridgeCore/include/BridgeEngine.h"
+#include "../../BridgeCore/include/Config.h"
+#include "../../BridgeCore/include/MappedFile.h"
+#include "../../BridgeCore/include/MockAdapter.h"
+#include "../../BridgeCore/include/Numeric.h"
+#include "../../BridgeCore/include/RequestJournal.h"
+#include "../../BridgeCore/include/Types.h"
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+static Bridge::OrderRequest MakeJournalReq(int i)
+{
+    Bridge::OrderRequest r;
+    r.command     = Bridge::Command::PLACE;
+    r.account     = "JRNL" + std::to_string(i % 3);
+    r.instrument  = "ESZ26";
+    r.action      = (i % 2) ? Bridge::Action::SELL : Bridge::Action::BUY;
+    r.quantity    = 1 + i;
+    r.orderType   = Bridge::OrderType::LIMIT;
+    r.limitPrice  = 5000.25 + i;
+    r.limitPx     = Bridge::PriceFromDouble(r.limitPrice);
+    r.timeInForce = Bridge::TimeInForce::GTC;
+    r.barKey      = 1000u + static_cast<uint64_t>(i);
+    return r;
+}
+
+void TestJournal() {
+    printf("\n-- TestJournal --\n");
+    namespace fs = std::filesystem;
+
+    fs::path dir = fs::temp_directory_path() / "bridge_journal_test";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+
+    // Round trip: every field comes back, the file is trimmed on Close
+    {
+        std::string path = (dir / "roundtrip.bjr").string();
+        {
+            Bridge::RequestJournal j;
+            CHECK_TRUE(j.Open(path));
+            for (int i = 0; i < 100; ++i)
+                j.Append(MakeJournalReq(i), 1000 + i, 50 + i, i % 5 ? Bridge::RC_SUCCESS : Bridge::RC_INVALID_PARAM,
+                         i % 2 ? Bridge::RequestJournal::kAsync : 0);
+            CHECK_EQ(j.Records(), 100u);
+            CHECK_EQ(j.Dropped(), 0u);
+        }
+        CHECK_TRUE(fs::file_size(path) < 64u * 1024u);
+
+        Bridge::JournalReader r;
+        CHECK_TRUE(r.Open(path));
+        Bridge::JournalEntry e;
+        int  n  = 0;
+        bool ok = true;
+        while (r.Next(e)) {
+            Bridge::OrderRequest want = MakeJournalReq(n);
+            ok = ok && e.req.command == want.command && e.req.account == want.account &&
+                 e.req.instrument == want.instrument && e.req.action == want.action &&
+                 e.req.quantity == want.quantity && e.req.orderType == want.orderType &&
+                 e.req.limitPrice == want.limitPrice && e.req.limitPx.ticks == want.limitPx.ticks &&
+                 e.req.limitPx.scale == want.limitPx.scale && !e.req.stopPx.IsSet() &&
+                 e.req.timeInForce == want.timeInForce && e.req.barKey == want.barKey &&
+                 e.timeNs == 1000 + n && e.durationNs == 50 + n &&
+                 e.rc == (n % 5 ? Bridge::RC_SUCCESS : Bridge::RC_INVALID_PARAM) &&
+                 e.flags == (n % 2 ? Bridge::RequestJournal::kAsync : 0);
+            ++n;
+        }
+        CHECK_EQ(n, 100);
+        CHECK_TRUE(ok);
+
+        r.Rewind();
+        CHECK_TRUE(r.Next(e));
+        CHECK_EQ(e.req.quantity, 1);
+    }
+
+    // Reopening appends after the existing records
+    {
+        std::string path = (dir / "append.bjr").string();
+        {
+            Bridge::RequestJournal j;
+            CHECK_TRUE(j.Open(path));
+            j.Append(MakeJournalReq(0), 1, 1, Bridge::RC_SUCCESS);
+        }
+        {
+            Bridge::RequestJournal j;
+            CHECK_TRUE(j.Open(path));
+            CHECK_EQ(j.Records(), 1u);
+            j.Append(MakeJournalReq(1), 2, 1, Bridge::RC_SUCCESS);
+        }
+        Bridge::JournalReader r;
+        CHECK_TRUE(r.Open(path));
+        Bridge::JournalEntry e;
+        int n = 0;
+        while (r.Next(e)) ++n;
+        CHECK_EQ(n, 2);
+        CHECK_EQ(e.timeNs, 2);
+    }
+
+    // A record whose size was never stored (crash mid-append) ends the journal
+    {
+        std::string path = (dir / "torn.bjr").string();
+        size_t end = 0;
+        {
+            Bridge::RequestJournal j;
+            CHECK_TRUE(j.Open(path));
+            j.Append(MakeJournalReq(0), 1, 1, Bridge::RC_SUCCESS);
+            j.Append(MakeJournalReq(1), 2, 1, Bridge::RC_SUCCESS);
+        }
+        {
+            // Zero the second record's size field, as if the writer died.
+            Bridge::MappedFile f;
+            CHECK_TRUE(f.Open(path, Bridge::MappedFile::Mode::ReadWrite));
+            end = f.Size();
+            Bridge::JournalReader r;
+            CHECK_TRUE(r.Open(path));
+            Bridge::JournalEntry e;
+            CHECK_TRUE(r.Next(e));
+            size_t second = r.Offset();
+            for (size_t i = 0; i < 4; ++i) f.Data()[second + i] = 0;
+        }
+        Bridge::JournalReader r;
+        CHECK_TRUE(r.Open(path));
+        Bridge::JournalEntry e;
+        int n = 0;
+        while (r.Next(e)) ++n;
+        CHECK_EQ(n, 1);
+
+        Bridge::RequestJournal j;
+        CHECK_TRUE(j.Open(path));
+        CHECK_EQ(j.Records(), 1u);
+        j.Append(MakeJournalReq(2), 3, 1, Bridge::RC_SUCCESS);
+        j.Close();
+        CHECK_TRUE(fs::file_size(path) == end);   // overwrote the torn record
+    }
+
+    // Not a journal
+    {
+        std::string path = (dir / "bogus.bjr").string();
+        {
+            Bridge::MappedFile f;
+            CHECK_TRUE(f.Open(path, Bridge::MappedFile::Mode::ReadWrite, 128));
+            for (size_t i = 0; i < 128; ++i) f.Data()[i] = 'x';
+        }
+        Bridge::RequestJournal j;
+        CHECK_FALSE(j.Open(path));
+        Bridge::JournalReader r;
+        CHECK_FALSE(r.Open(path));
+        CHECK_FALSE(r.Open((dir / "missing.bjr").string()));
+    }
+
+    // Appends from several threads all land
+    {
+        std::string path = (dir / "threads.bjr").string();
+        {
+            Bridge::RequestJournal j;
+            CHECK_TRUE(j.Open(path));
+            std::vector<std::thread> threads;
+            for (int t = 0; t < 4; ++t)
+                threads.emplace_back([&j, t] {
+                    for (int i = 0; i < 20000; ++i)
+                        j.Append(MakeJournalReq(i), t, i, Bridge::RC_SUCCESS);
+                });
+            for (std::thread& th : threads) th.join();
+            CHECK_EQ(j.Records(), 80000u);
+        }
+        Bridge::JournalReader r;
+        CHECK_TRUE(r.Open(path));
+        Bridge::JournalEntry e;
+        int n = 0;
+        while (r.Next(e)) ++n;
+        CHECK_EQ(n, 80000);
+    }
+
+    // Engine with journalPath records sync, batch and async requests
+    {
+        std::string path = (dir / "engine.bjr").string();
+        Bridge::BridgeConfig cfg = Bridge::DefaultConfig();
+        cfg.logFilePath = "";
+        cfg.journalPath = path;
+        {
+            Bridge::BridgeEngine engine(cfg, std::make_shared<Bridge::MockAdapter>());
+            Bridge::OrderRequest bad = MakeJournalReq(9);
+            bad.command = Bridge::Command::UNKNOWN;
+            int rcGood = engine.Execute(MakeJournalReq(0));
+            int rcBad  = engine.Execute(bad);
+            CHECK_EQ(rcGood, Bridge::RC_SUCCESS);
+            CHECK_EQ(rcBad, Bridge::RC_INVALID_CMD);
+
+            Bridge::OrderRequest batch[2] = { MakeJournalReq(1), MakeJournalReq(2) };
+            int rc[2] = {};
+            engine.ExecuteBatch(batch, 2, rc);
+
+            int ticket = engine.ExecuteAsync(MakeJournalReq(3));
+            CHECK_TRUE(ticket > 0);
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+            while (engine.PollResult(ticket) == Bridge::RC_PENDING && std::chrono::steady_clock::now() < deadline)
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            CHECK_EQ(engine.PollResult(ticket), Bridge::RC_SUCCESS);
+            CHECK_EQ(engine.JournaledRequests(), 5u);
+
+            // journalPath is fixed at startup
+            Bridge::BridgeConfig next = cfg;
+            next.journalPath = (dir / "other.bjr").string();
+            engine.ApplyConfig(next);
+            CHECK_STR_EQ(engine.Config().journalPath, path);
+        }
+        CHECK_FALSE(fs::exists(dir / "other.bjr"));
+
+        Bridge::JournalReader r;
+        CHECK_TRUE(r.Open(path));
+        std::vector<Bridge::JournalEntry> got;
+        Bridge::JournalEntry e;
+        while (r.Next(e)) got.push_back(e);
+        CHECK_EQ(got.size(), 5u);
+        if (got.size() == 5) {
+            CHECK_EQ(got[0].rc, Bridge::RC_SUCCESS);
+            CHECK_EQ(got[1].rc, Bridge::RC_INVALID_CMD);
+            CHECK_TRUE(got[1].req.command == Bridge::Command::UNKNOWN);
+            CHECK_TRUE(got[2].flags == Bridge::RequestJournal::kBatch && got[3].flags == Bridge::RequestJournal::kBatch);
+            CHECK_TRUE(got[4].flags == Bridge::RequestJournal::kAsync);
+            CHECK_TRUE(got[0].timeNs > 0 && got[0].durationNs >= 0);
+            CHECK_TRUE(got[4].timeNs >= got[0].timeNs);
+        }
+    }
+
+    // No journal by default
+    {
+        Bridge::BridgeConfig cfg = Bridge::DefaultConfig();
+        cfg.logFilePath = "";
+        Bridge::BridgeEngine engine(cfg, std::make_shared<Bridge::MockAdapter>());
+        engine.Execute(MakeJournalReq(0));
+        CHECK_EQ(engine.JournaledRequests(), 0u);
+    }
+
+    fs::remove_all(dir);
+}
@@ -0,0 +1,186 @@
+#include "TestFramework.h"
+#include "../../BridgeCore/include/BridgeEngine.h"
+#include "../../BridgeCore/include/Config.h"
+#include "../../BridgeCore/include/LatencyStats.h"
+#include "../../BridgeCore/include/Types.h"
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr uint8_t kPlace  = static_cast<uint8_t>(Bridge::Command::PLACE);
+constexpr uint8_t kCancel = static_cast<uint8_t>(Bridge::Command::CANCEL);
+
+uint64_t CountOf(Bridge::Stage s, uint8_t command, const char* adapter) {
+    return Bridge::LatencyQuery(s, command, adapter).count;
+}
+
+Bridge::OrderRequest MakeStatsReq(int qty) {
+    Bridge::OrderRequest r;
+    r.command     = Bridge::Command::PLACE;
+    r.account     = "ACC1";
+    r.instrument  = "ES";
+    r.action      = Bridge::Action::BUY;
+    r.quantity    = qty;
+    r.orderType   = Bridge::OrderType::MARKET;
+    r.timeInForce = Bridge::TimeInForce::DAY;
+    return r;
+}
+
+} // namespace
+
+void TestLatencyStats() {
+    printf("\n-- TestLatencyStats --\n");
+    using Bridge::LatencyHistogram;
+    using Bridge::Stage;
+
+    // Buckets are exact below 32 and within 1/32 above
+    {
+        bool exact = true;
+        for (uint64_t v = 0; v < 32; ++v)
+            exact &= LatencyHistogram::BucketOf(v) == v && LatencyHistogram::BucketHigh(v) == v;
+        CHECK_TRUE(exact);
+
+        bool bounded = true;
+        size_t prev = 0;
+        for (uint64_t v = 32; v < (1ull << 30); v += v / 7 + 1) {
+            size_t   b  = LatencyHistogram::BucketOf(v);
+            uint64_t hi = LatencyHistogram::BucketHigh(b);
+            bounded &= b >= prev && hi >= v && hi - v <= v / 32;
+            prev = b;
+        }
+        CHECK_TRUE(bounded);
+        CHECK_EQ(LatencyHistogram::BucketOf(UINT64_MAX), LatencyHistogram::kBuckets - 1);
+    }
+
+    // Percentiles of a uniform 1..10000 sample
+    {
+        LatencyHistogram h;
+        for (uint64_t v = 1; v <= 10000; ++v) h.Record(v);
+        CHECK_EQ(h.Count(), 10000u);
+        CHECK_EQ(h.Max(), 10000u);
+        CHECK_EQ(h.Sum(), 10000u * 10001u / 2);
+        uint64_t p50 = h.Percentile(0.50);
+        uint64_t p99 = h.Percentile(0.99);
+        CHECK_TRUE(p50 >= 5000 && p50 <= 5000 + 5000 / 32);
+        CHECK_TRUE(p99 >= 9900 && p99 <= 9900 + 9900 / 32);
+        CHECK_EQ(h.Percentile(1.0), 10000u);
+
+        LatencyHistogram merged;
+        merged.Merge(h);
+        merged.Merge(h);
+        CHECK_EQ(merged.Count(), 20000u);
+        CHECK_EQ(merged.Percentile(0.50), p50);
+    }
+
+    // Only the outermost scope records; marks outside a scope do nothing
+    {
+        Bridge::LatencySetEnabled(true);
+        uint64_t before = CountOf(Stage::Total, kCancel, "-");
+        Bridge::LatencyScope::Mark(Stage::Convert);
+        {
+            Bridge::LatencyScope outer;
+            Bridge::LatencyScope::SetCommand(Bridge::Command::CANCEL);
+            {
+                Bridge::LatencyScope inner;
+                Bridge::LatencyScope::Mark(Stage::Parse);
+            }
+            Bridge::LatencyScope::Mark(Stage::Validate);
+        }
+        CHECK_EQ(CountOf(Stage::Total, kCancel, "-"), before + 1);
+        CHECK_TRUE(CountOf(Stage::Parse, kCancel, "-") >= 1);
+        CHECK_TRUE(CountOf(Stage::Validate, kCancel, "-") >= 1);
+    }
+
+    // A batch scope keeps its row when the payloads inside are parsed
+    {
+        uint64_t before = CountOf(Stage::Total, Bridge::kLatencyBatch, "-");
+        {
+            Bridge::LatencyScope scope;
+            Bridge::LatencyScope::SetCommand(Bridge::kLatencyBatch);
+            Bridge::LatencyScope::SetCommand(Bridge::Command::PLACE);
+        }
+        CHECK_EQ(CountOf(Stage::Total, Bridge::kLatencyBatch, "-"), before + 1);
+    }
+
+    // Engine requests are charged per stage under their command and adapter
+    {
+        Bridge::BridgeConfig cfg;
+        cfg.adapterType      = "MOCK";
+        cfg.asyncWorkers     = 1;
+        cfg.statsDumpSeconds = 0;
+        Bridge::BridgeEngine engine(cfg);
+        uint64_t total   = CountOf(Stage::Total, kPlace, "MOCK");
+        uint64_t adapter = CountOf(Stage::Adapter, kPlace, "MOCK");
+        uint64_t async   = CountOf(Stage::Adapter, kPlace, "MOCK:async");
+        uint64_t submits = CountOf(Stage::Total, kPlace, "-");
+        const int kRuns = 50;
+        for (int i = 0; i < kRuns; ++i) engine.Execute(MakeStatsReq(1 + i));
+        CHECK_EQ(CountOf(Stage::Total, kPlace, "MOCK"), total + kRuns);
+        CHECK_EQ(CountOf(Stage::Adapter, kPlace, "MOCK"), adapter + kRuns);
+
+        int ticket = engine.ExecuteAsync(MakeStatsReq(7));
+        CHECK_TRUE(ticket > 0);
+        for (int i = 0; i < 5000 && engine.PollResult(ticket) == Bridge::RC_PENDING; ++i)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        CHECK_EQ(CountOf(Stage::Total, kPlace, "-"), submits + 1);
+        // The worker's scope closes just after the result is published.
+        for (int i = 0; i < 1000 && CountOf(Stage::Adapter, kPlace, "MOCK:async") == async; ++i)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        CHECK_EQ(CountOf(Stage::Adapter, kPlace, "MOCK:async"), async + 1);
+
+        Bridge::LatencySummary s = Bridge::LatencyQuery(Stage::Total, kPlace, "MOCK");
+        CHECK_TRUE(s.p50 <= s.p99 && s.p99 <= s.p999 && s.p999 <= s.max);
+        CHECK_TRUE(s.mean <= s.max);
+
+        std::string report = Bridge::LatencyReport();
+        CHECK_TRUE(report.rfind("command", 0) == 0);
+        CHECK_TRUE(report.find("\nPLACE ") != std::string::npos);
+        CHECK_TRUE(report.find("MOCK:async") != std::string::npos);
+    }
+
+    // Switched off, requests record nothing
+    {
+        Bridge::BridgeConfig cfg;
+        cfg.adapterType      = "MOCK";
+        cfg.latencyStats     = false;
+        cfg.statsDumpSeconds = 0;
+        Bridge::BridgeEngine engine(cfg);
+        CHECK_FALSE(Bridge::LatencyEnabled());
+        uint64_t total = CountOf(Stage::Total, kPlace, "MOCK");
+        for (int i = 0; i < 10; ++i) engine.Execute(MakeStatsReq(1));
+        CHECK_EQ(CountOf(Stage::Total, kPlace, "MOCK"), total);
+        Bridge::LatencySetEnabled(true);
+    }
+
+    // GET_STATS buffer contract: full length returned, text cut and terminated
+    {
+        int len = Bridge::LatencyReport(nullptr, 0);
+        CHECK_TRUE(len > 0);
+        std::vector<char> small(16, 'x');
+        CHECK_EQ(Bridge::LatencyReport(small.data(), 16), len);
+        CHECK_EQ(std::string(small.data()).size(), 15u);
+        std::vector<char> full(static_cast<size_t>(len) + 1);
+        CHECK_EQ(Bridge::LatencyReport(full.data(), len + 1), len);
+        CHECK_EQ(std::string(full.data()).size(), static_cast<size_t>(len));
+    }
+
+    // bridge.json keys
+    {
+        namespace fs = std::filesystem;
+        fs::path cfgPath = fs::temp_directory_path() / "bridge_latency_test.json";
+        std::ofstream(cfgPath) << "{\n  \"latencyStats\": false,\n  \"statsDumpSeconds\": 300\n}\n";
+        Bridge::BridgeConfig cfg;
+        CHECK_EQ(Bridge::LoadConfig(cfgPath.string(), cfg), Bridge::RC_SUCCESS);
+        CHECK_FALSE(cfg.latencyStats);
+        CHECK_EQ(cfg.statsDumpSeconds, 300);
+        CHECK_TRUE(Bridge::DefaultConfig().latencyStats);
+        CHECK_EQ(Bridge::DefaultConfig().statsDumpSeconds, 60);
+        fs::remove(cfgPath);
+    }
+}
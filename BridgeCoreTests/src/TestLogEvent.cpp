@@ -0,0 +1,138 @@
+#include "TestFramework.h"
+#include "../../BridgeCore/include/BinaryLog.h"
+#include "../../BridgeCore/include/LogEvent.h"
+#include "../../BridgeCore/include/Logger.h"
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr Bridge::LogFormat kOrder("[REQ-{:04}] PLACE_ORDER account={} quantity={} limitPrice={}");
+constexpr Bridge::LogFormat kRc("Execute returned code={}");
+
+template <typename... A>
+std::string Render(const char* format, const A&... args) {
+    Bridge::LogArgs packed;
+    (packed.Put(args), ...);
+    std::string out;
+    Bridge::FormatLogEvent(out, format, packed.bytes, packed.size);
+    return out;
+}
+
+std::vector<Bridge::BinaryLogLine> ReadBinary(const std::string& path) {
+    std::vector<Bridge::BinaryLogLine> lines;
+    Bridge::BinaryLogReader reader;
+    if (!reader.Open(path)) return lines;
+    Bridge::BinaryLogLine line;
+    while (reader.Next(line)) lines.push_back(line);
+    return lines;
+}
+
+} // namespace
+
+void TestLogEvent() {
+    printf("\n-- TestLogEvent --\n");
+    namespace fs = std::filesystem;
+
+    // Formatting
+    CHECK_TRUE(Render("[REQ-{:04}] rc={}", 7u, -3) == "[REQ-0007] rc=-3");
+    CHECK_TRUE(Render("px={} qty={}", 4500.25, int64_t{ 1 } << 40) == "px=4500.25 qty=1099511627776");
+    CHECK_TRUE(Render("a={} b={}", "ES", std::string("SIM1")) == "a=ES b=SIM1");
+    CHECK_TRUE(Render("{:5}|{:03}", "ab", -4) == "   ab|-04");
+    CHECK_TRUE(Render("null={}", static_cast<const char*>(nullptr)) == "null=<null>");
+    CHECK_TRUE(Render("missing={} {}", 1) == "missing=1 ?");
+    CHECK_TRUE(Render("{not a placeholder} {}", true) == "{not a placeholder} 1");
+    CHECK_TRUE(Render("unterminated {", 1) == "unterminated {");
+
+    // Long strings are cut; arguments that no longer fit print as "?"
+    {
+        std::string big(200, 'x');
+        std::string out = Render("{} {} {} {}", big, big, big, 42);
+        CHECK_TRUE(out.find(std::string(Bridge::kLogMaxStrBytes, 'x') + " ") == 0);
+        CHECK_TRUE(out.size() < 3 * Bridge::kLogMaxStrBytes + 8);
+        CHECK_TRUE(out.substr(out.size() - 2) == " ?");
+    }
+
+    fs::path dir = fs::temp_directory_path() / "bridge_logevent_test";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+
+    // Text mode: the writer thread formats structured lines
+    {
+        Bridge::LogOptions o;
+        o.filePath = (dir / "text.log").string();
+        Bridge::LogInit(o);
+        Bridge::LogEvent(Bridge::LogLevel::INFO, kOrder, 12u, "SIM1", 3, 4500.25);
+        Bridge::LogFlush();
+        std::ifstream f(o.filePath);
+        std::string   line;
+        std::getline(f, line);
+        CHECK_TRUE(line.find("[INFO ] [REQ-0012] PLACE_ORDER account=SIM1 quantity=3 limitPrice=4500.25")
+                   != std::string::npos);
+    }
+
+    // Binary mode: .blog file decoded back to the same text
+    std::string blog = (dir / "bridge.blog").string();
+    {
+        Bridge::LogOptions o;
+        o.filePath = (dir / "bridge.log").string();
+        o.binary   = true;
+        Bridge::LogInit(o);
+        Bridge::LogEvent(Bridge::LogLevel::INFO, kOrder, 1u, "SIM1", 2, 4500.5);
+        Bridge::LogEvent(Bridge::LogLevel::WARNING_, kRc, -5);
+        Bridge::LogError("plain line");
+        Bridge::LogEvent(Bridge::LogLevel::INFO, kOrder, 2u, "SIM2", 1, 4501.0);
+        Bridge::LogFlush();
+
+        CHECK_TRUE(fs::exists(blog));
+        CHECK_TRUE(!fs::exists(o.filePath));
+        std::vector<Bridge::BinaryLogLine> lines = ReadBinary(blog);
+        CHECK_EQ(lines.size(), 4u);
+        if (lines.size() == 4) {
+            CHECK_TRUE(lines[0].text == "[REQ-0001] PLACE_ORDER account=SIM1 quantity=2 limitPrice=4500.5");
+            CHECK_TRUE(lines[0].level == Bridge::LogLevel::INFO);
+            CHECK_TRUE(lines[1].text == "Execute returned code=-5");
+            CHECK_TRUE(lines[1].level == Bridge::LogLevel::WARNING_);
+            CHECK_TRUE(lines[2].text == "plain line");
+            CHECK_TRUE(lines[2].level == Bridge::LogLevel::ERROR_);
+            CHECK_TRUE(lines[3].text == "[REQ-0002] PLACE_ORDER account=SIM2 quantity=1 limitPrice=4501");
+            CHECK_TRUE(lines[3].wallNs >= lines[0].wallNs);
+            int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+            CHECK_TRUE(now - lines[0].wallNs < 60LL * 1000000000 && now >= lines[0].wallNs - 1000000000);
+        }
+    }
+
+    // Reopening appends a fresh dictionary; earlier lines still decode
+    {
+        Bridge::LogOptions o;
+        o.filePath = (dir / "other.log").string();
+        Bridge::LogInit(o);                          // closes bridge.blog
+        o.filePath = (dir / "bridge.log").string();
+        o.binary   = true;
+        Bridge::LogInit(o);
+        Bridge::LogEvent(Bridge::LogLevel::WARNING_, kRc, -9);
+        Bridge::LogEvent(Bridge::LogLevel::INFO, kOrder, 3u, "SIM3", 4, 1.5);
+        Bridge::LogFlush();
+        std::vector<Bridge::BinaryLogLine> lines = ReadBinary(blog);
+        CHECK_EQ(lines.size(), 6u);
+        if (lines.size() == 6) {
+            CHECK_TRUE(lines[0].text == "[REQ-0001] PLACE_ORDER account=SIM1 quantity=2 limitPrice=4500.5");
+            CHECK_TRUE(lines[4].text == "Execute returned code=-9");
+            CHECK_TRUE(lines[5].text == "[REQ-0003] PLACE_ORDER account=SIM3 quantity=4 limitPrice=1.5");
+        }
+    }
+
+    // A text log is not a binary log
+    {
+        Bridge::BinaryLogReader reader;
+        CHECK_TRUE(!reader.Open((dir / "text.log").string()));
+    }
+
+    Bridge::LogInit("", false);
+    fs::remove_all(dir);
+}
@@ -0,0 +1,199 @@
+#include "TestFramework.h"
+#include "../../BridgeCore/include/BinaryLog.h"
+#include "../../BridgeCore/include/Config.h"
+#include "../../BridgeCore/include/LogEvent.h"
+#include "../../BridgeCore/include/LogFile.h"
+#include "../../BridgeCore/include/Logger.h"
+#include "../../BridgeCore/include/MappedFile.h"
+#include "../../BridgeCore/include/Types.h"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr Bridge::LogFormat kLine("[REQ-{:04}] PLACE_ORDER account={} quantity={}");
+
+std::string ReadAll(const std::string& path) {
+    std::ifstream f(path, std::ios::binary);
+    std::ostringstream ss;
+    ss << f.rdbuf();
+    return ss.str();
+}
+
+// Lines of a text segment; false if any is not a whole log line.
+bool TextLines(const std::string& path, size_t& count) {
+    std::string body = ReadAll(path);
+    if (body.find('\0') != std::string::npos) return false;
+    std::istringstream in(body);
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.rfind("[", 0) != 0 || line.find("PLACE_ORDER") == std::string::npos) return false;
+        ++count;
+    }
+    return body.empty() || body.back() == '\n';
+}
+
+} // namespace
+
+void TestLogRotation() {
+    printf("\n-- TestLogRotation --\n");
+    namespace fs = std::filesystem;
+
+    fs::path dir = fs::temp_directory_path() / "bridge_logrotation_test";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+
+    // Preallocation reserves the full length up front
+    {
+        std::string p = (dir / "prealloc.bin").string();
+        CHECK_TRUE(Bridge::MappedFile::Preallocate(p, 1 << 20));
+        CHECK_TRUE(fs::file_size(p) >= (1u << 20));
+    }
+
+    // A mapped segment continues after its content and is cut on close
+    {
+        Bridge::LogFile::Options o;
+        o.path         = (dir / "resume.log").string();
+        o.segmentBytes = 64 * 1024;
+        Bridge::LogFile f;
+        CHECK_TRUE(f.Open(o));
+        CHECK_TRUE(f.Rotating());
+        CHECK_TRUE(fs::exists(dir / "resume.next.log"));
+        CHECK_TRUE(fs::file_size(o.path) >= o.segmentBytes);
+        f.Write("abc\n", 4);
+        CHECK_EQ(f.Used(), 4u);
+        CHECK_TRUE(!f.SizeDue(100));
+        CHECK_TRUE(f.SizeDue(o.segmentBytes));
+        CHECK_TRUE(!f.AgeDue());
+        f.Close();
+        CHECK_TRUE(!fs::exists(dir / "resume.next.log"));
+        CHECK_TRUE(ReadAll(o.path) == "abc\n");
+
+        CHECK_TRUE(f.Open(o));
+        CHECK_EQ(f.Used(), 4u);
+        f.Write("def\n", 4);
+        CHECK_TRUE(f.Rotate());
+        CHECK_EQ(f.Used(), 0u);
+        f.Write("ghi\n", 4);
+        f.Close();
+        std::vector<std::string> archived = Bridge::LogFile::ArchivedSegments(o.path);
+        CHECK_EQ(archived.size(), 1u);
+        if (archived.size() == 1) CHECK_TRUE(ReadAll(archived[0]) == "abc\ndef\n");
+        CHECK_TRUE(ReadAll(o.path) == "ghi\n");
+    }
+
+    // A crash leaves the zero tail: the next open still finds the end
+    {
+        std::string p = (dir / "crash.log").string();
+        {
+            std::ofstream f(p, std::ios::binary);
+            f << "one\n";
+            f << std::string(1000, '\0');
+        }
+        Bridge::LogFile::Options o;
+        o.path         = p;
+        o.segmentBytes = 4096;
+        Bridge::LogFile f;
+        CHECK_TRUE(f.Open(o));
+        CHECK_EQ(f.Used(), 4u);
+        f.Write("two\n", 4);
+        f.Close();
+        CHECK_TRUE(ReadAll(p) == "one\ntwo\n");
+    }
+
+    // Size rotation through the logger: no line is split or lost
+    const int kLines = 2000;
+    {
+        Bridge::LogOptions o;
+        o.filePath     = (dir / "bridge.log").string();
+        o.segmentBytes = 16 * 1024;
+        o.keepSegments = 0;
+        Bridge::LogInit(o);
+        for (int i = 0; i < kLines; ++i)
+            Bridge::LogEvent(Bridge::LogLevel::INFO, kLine, static_cast<unsigned>(i), "SIM1", i % 7);
+        Bridge::LogInit("", false);   // closes and trims the live segment
+
+        std::vector<std::string> archived = Bridge::LogFile::ArchivedSegments(o.filePath);
+        CHECK_TRUE(archived.size() >= 5);
+        size_t lines = 0;
+        bool   whole = TextLines(o.filePath, lines);
+        for (const std::string& a : archived) {
+            whole &= TextLines(a, lines);
+            whole &= fs::file_size(a) <= o.segmentBytes;
+        }
+        CHECK_TRUE(whole);
+        CHECK_EQ(lines, static_cast<size_t>(kLines));
+        CHECK_TRUE(!fs::exists(dir / "bridge.next.log"));
+    }
+
+    // Old segments beyond keepSegments are deleted
+    {
+        Bridge::LogOptions o;
+        o.filePath     = (dir / "bridge.log").string();
+        o.segmentBytes = 16 * 1024;
+        o.keepSegments = 2;
+        Bridge::LogInit(o);
+        for (int i = 0; i < kLines; ++i)
+            Bridge::LogEvent(Bridge::LogLevel::INFO, kLine, static_cast<unsigned>(i), "SIM1", i % 7);
+        Bridge::LogFlush();
+        CHECK_EQ(Bridge::LogFile::ArchivedSegments(o.filePath).size(), 2u);
+        Bridge::LogInit("", false);
+    }
+
+    // Binary segments each decode on their own
+    {
+        Bridge::LogOptions o;
+        o.filePath     = (dir / "bin.log").string();
+        o.binary       = true;
+        o.segmentBytes = 8 * 1024;
+        o.keepSegments = 0;
+        Bridge::LogInit(o);
+        for (int i = 0; i < kLines; ++i) {
+            if (i % 100 == 0) Bridge::LogInfo("plain line " + std::to_string(i));
+            Bridge::LogEvent(Bridge::LogLevel::INFO, kLine, static_cast<unsigned>(i), "SIM2", 1);
+        }
+        Bridge::LogInit("", false);
+
+        std::string live = (dir / "bin.blog").string();
+        std::vector<std::string> segments = Bridge::LogFile::ArchivedSegments(live);
+        CHECK_TRUE(segments.size() >= 5);
+        segments.push_back(live);
+        size_t events = 0, plain = 0;
+        bool   ordered = true;
+        int    expect  = 0;
+        for (const std::string& s : segments) {
+            Bridge::BinaryLogReader reader;
+            if (!reader.Open(s)) { ordered = false; continue; }
+            Bridge::BinaryLogLine line;
+            while (reader.Next(line)) {
+                if (line.text.rfind("plain line ", 0) == 0) { ++plain; continue; }
+                char want[32];
+                std::snprintf(want, sizeof(want), "[REQ-%04d]", expect++);
+                ordered &= line.text.rfind(want, 0) == 0;
+                ++events;
+            }
+        }
+        CHECK_TRUE(ordered);
+        CHECK_EQ(events, static_cast<size_t>(kLines));
+        CHECK_EQ(plain, static_cast<size_t>(kLines / 100));
+    }
+
+    // bridge.json keys
+    {
+        std::string cfgPath = (dir / "bridge.json").string();
+        std::ofstream(cfgPath) << "{\n  \"logMaxSizeMb\": 64,\n  \"logRotateMinutes\": 60,\n"
+                                  "  \"logKeepSegments\": 3\n}\n";
+        Bridge::BridgeConfig cfg;
+        CHECK_EQ(Bridge::LoadConfig(cfgPath, cfg), Bridge::RC_SUCCESS);
+        CHECK_EQ(cfg.logMaxSizeMb, 64);
+        CHECK_EQ(cfg.logRotateMinutes, 60);
+        CHECK_EQ(cfg.logKeepSegments, 3);
+        CHECK_EQ(Bridge::DefaultConfig().logMaxSizeMb, 0);
+        CHECK_EQ(Bridge::DefaultConfig().logKeepSegments, 10);
+    }
+
+    fs::remove_all(dir);
+}
@@ -0,0 +1,162 @@
+#include "TestFramework.h"
+#include "../../BridgeCore/include/Config.h"
+#include "../../BridgeCore/include/Logger.h"
+#include "../../BridgeCore/include/Types.h"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Lines in 'path' containing 'needle'.
+static int CountLines(const std::string& path, const std::string& needle)
+{
+    std::ifstream f(path);
+    std::string   line;
+    int           n = 0;
+    while (std::getline(f, line))
+        if (line.find(needle) != std::string::npos) ++n;
+    return n;
+}
+
+void TestLogger() {
+    printf("\n-- TestLogger --\n");
+    namespace fs = std::filesystem;
+
+    fs::path dir = fs::temp_directory_path() / "bridge_logger_test";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    std::string first  = (dir / "first.log").string();
+    std::string second = (dir / "sub" / "second.log").string();
+
+    // Lines reach the file in order, formatted as before
+    {
+        Bridge::LogOptions o;
+        o.filePath = first;
+        Bridge::LogInit(o);
+        Bridge::LogInfo("logger-test one");
+        Bridge::LogWarning("logger-test two");
+        Bridge::LogError("logger-test three");
+        Bridge::LogFlush();
+
+        std::ifstream f(first);
+        std::vector<std::string> lines;
+        std::string line;
+        while (std::getline(f, line)) lines.push_back(line);
+        CHECK_EQ(lines.size(), 3u);
+        if (lines.size() == 3) {
+            CHECK_TRUE(lines[0].size() > 22 && lines[0][0] == '[' && lines[0][20] == ']');
+            CHECK_TRUE(lines[0].find("[INFO ] logger-test one") != std::string::npos);
+            CHECK_TRUE(lines[1].find("[WARN ] logger-test two") != std::string::npos);
+            CHECK_TRUE(lines[2].find("[ERROR] logger-test three") != std::string::npos);
+        }
+    }
+
+    // An ERROR line is flushed without waiting for the interval
+    {
+        Bridge::LogOptions o;
+        o.filePath        = first;
+        o.flushIntervalMs = 60000;
+        Bridge::LogInit(o);
+        Bridge::LogError("logger-test urgent");
+        bool seen = false;
+        for (int i = 0; i < 500 && !seen; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            seen = CountLines(first, "logger-test urgent") == 1;
+        }
+        CHECK_TRUE(seen);
+    }
+
+    // Reconfiguring writes queued lines to the old file first
+    {
+        Bridge::LogInfo("logger-test before switch");
+        Bridge::LogOptions o;
+        o.filePath = second;
+        Bridge::LogInit(o);
+        Bridge::LogInfo("logger-test after switch");
+        Bridge::LogFlush();
+        CHECK_EQ(CountLines(first,  "logger-test before switch"), 1);
+        CHECK_EQ(CountLines(second, "logger-test before switch"), 0);
+        CHECK_EQ(CountLines(second, "logger-test after switch"), 1);
+    }
+
+    // Blocking policy: nothing is lost, however hard the queue is pushed
+    {
+        Bridge::LogOptions o;
+        o.filePath      = (dir / "block.log").string();
+        o.blockWhenFull = true;
+        Bridge::LogInit(o);
+        uint64_t dropped = Bridge::LogDropped();
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t)
+            threads.emplace_back([t] {
+                for (int i = 0; i < 20000; ++i)
+                    Bridge::LogInfo("logger-test flood " + std::to_string(t) + ":" + std::to_string(i));
+            });
+        for (std::thread& th : threads) th.join();
+        Bridge::LogFlush();
+        CHECK_EQ(CountLines(o.filePath, "logger-test flood"), 80000);
+        CHECK_TRUE(Bridge::LogDropped() == dropped);
+    }
+
+    // Drop policy: every line is either written or counted as dropped
+    {
+        Bridge::LogOptions o;
+        o.filePath = (dir / "drop.log").string();
+        Bridge::LogInit(o);
+        uint64_t dropped = Bridge::LogDropped();
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t)
+            threads.emplace_back([t] {
+                for (int i = 0; i < 20000; ++i)
+                    Bridge::LogInfo("logger-test flood " + std::to_string(t) + ":" + std::to_string(i));
+            });
+        for (std::thread& th : threads) th.join();
+        Bridge::LogFlush();
+        uint64_t lost = Bridge::LogDropped() - dropped;
+        CHECK_EQ(CountLines(o.filePath, "logger-test flood") + static_cast<int>(lost), 80000);
+        CHECK_EQ(CountLines(o.filePath, "line(s) dropped") > 0, lost > 0);
+    }
+
+    // Level gate: lines below the minimum are discarded, and the macros do
+    // not evaluate their message when the level is off
+    {
+        Bridge::LogOptions o;
+        o.filePath = (dir / "level.log").string();
+        o.minLevel = Bridge::LogLevel::WARNING_;
+        Bridge::LogInit(o);
+        CHECK_TRUE(!Bridge::LogEnabled(Bridge::LogLevel::INFO));
+        CHECK_TRUE(Bridge::LogEnabled(Bridge::LogLevel::ERROR_));
+
+        int built = 0;
+        auto message = [&built](const char* text) { ++built; return std::string(text); };
+        BRIDGE_LOG_INFO(message("logger-test info"));
+        BRIDGE_LOG_DEBUG(message("logger-test debug"));
+        BRIDGE_LOG_WARN(message("logger-test warn"));
+        Bridge::LogInfo("logger-test plain info");
+        CHECK_EQ(built, 1);
+
+        Bridge::LogSetLevel(Bridge::LogLevel::DEBUG_);
+        BRIDGE_LOG_DEBUG(message("logger-test debug"));
+        CHECK_EQ(built, BRIDGE_LOG_COMPILE_MIN_LEVEL <= 0 ? 2 : 1);
+        Bridge::LogFlush();
+        CHECK_EQ(CountLines(o.filePath, "logger-test warn"), 1);
+        CHECK_EQ(CountLines(o.filePath, "logger-test info"), 0);
+        CHECK_EQ(CountLines(o.filePath, "logger-test plain info"), 0);
+        CHECK_EQ(CountLines(o.filePath, "logger-test debug"), BRIDGE_LOG_COMPILE_MIN_LEVEL <= 0 ? 1 : 0);
+    }
+
+    // logLevel in bridge.json
+    {
+        std::string cfgPath = (dir / "level.json").string();
+        std::ofstream(cfgPath) << "{\n  \"logLevel\": \"warn\"\n}\n";
+        Bridge::BridgeConfig cfg;
+        CHECK_EQ(Bridge::LoadConfig(cfgPath, cfg), Bridge::RC_SUCCESS);
+        CHECK_TRUE(cfg.logLevel == Bridge::LogLevel::WARNING_);
+        CHECK_TRUE(Bridge::DefaultConfig().logLevel == Bridge::LogLevel::INFO);
+    }
+
+    Bridge::LogInit("", false);
+    fs::remove_all(dir);
+}
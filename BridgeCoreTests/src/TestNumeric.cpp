@@ -0,0 +1,104 @@
+#include "TestFramework.h"
+#include "../../BridgeCore/include/Numeric.h"
+#include "../../BridgeCore/include/Parser.h"
+#include "../../BridgeCore/include/Types.h"
+#include <string>
+#include <system_error>
+#include <limits>
+
+static std::string Fmt(const Bridge::FixedPrice& p) {
+    char buf[32];
+    size_t n = Bridge::FormatPrice(p, buf, sizeof(buf));
+    return std::string(buf, n);
+}
+
+void TestNumeric() {
+    printf("\n-- TestNumeric --\n");
+
+    // ParseInt
+    {
+        int v = 0;
+        CHECK_TRUE(Bridge::ParseInt("42", v) == std::errc{});
+        CHECK_EQ(v, 42);
+        CHECK_TRUE(Bridge::ParseInt("+7", v) == std::errc{});
+        CHECK_EQ(v, 7);
+        CHECK_TRUE(Bridge::ParseInt("-3", v) == std::errc{});
+        CHECK_EQ(v, -3);
+        CHECK_TRUE(Bridge::ParseInt("", v)    == std::errc::invalid_argument);
+        CHECK_TRUE(Bridge::ParseInt("1x", v)  == std::errc::invalid_argument);
+        CHECK_TRUE(Bridge::ParseInt("abc", v) == std::errc::invalid_argument);
+        CHECK_TRUE(Bridge::ParseInt("99999999999", v) == std::errc::result_out_of_range);
+        CHECK_EQ(v, -3); // untouched on failure
+    }
+
+    // ParsePrice keeps the quoted decimals exactly
+    {
+        Bridge::FixedPrice p;
+        CHECK_TRUE(Bridge::ParsePrice("4200.25", p) == std::errc{});
+        CHECK_TRUE(p.ticks == 420025);
+        CHECK_EQ(p.scale, 2);
+        CHECK_STR_EQ(Fmt(p), std::string("4200.25"));
+
+        CHECK_TRUE(Bridge::ParsePrice("0.0001", p) == std::errc{});
+        CHECK_TRUE(p.ticks == 1);
+        CHECK_EQ(p.scale, 4);
+        CHECK_STR_EQ(Fmt(p), std::string("0.0001"));
+
+        CHECK_TRUE(Bridge::ParsePrice("-12.5", p) == std::errc{});
+        CHECK_STR_EQ(Fmt(p), std::string("-12.5"));
+
+        CHECK_TRUE(Bridge::ParsePrice("4.2e3", p) == std::errc{});
+        CHECK_STR_EQ(Fmt(p), std::string("4200"));
+
+        CHECK_TRUE(Bridge::ParsePrice("", p)     == std::errc::invalid_argument);
+        CHECK_TRUE(Bridge::ParsePrice(".", p)    == std::errc::invalid_argument);
+        CHECK_TRUE(Bridge::ParsePrice("12a", p)  == std::errc::invalid_argument);
+    }
+
+    // Double conversion, comparison and rescaling
+    {
+        Bridge::FixedPrice a = Bridge::PriceFromDouble(4900.0);
+        CHECK_TRUE(a.ticks == 4900);
+        CHECK_EQ(a.scale, 0);
+        Bridge::FixedPrice b = Bridge::PriceFromDouble(0.1);
+        CHECK_STR_EQ(Fmt(b), std::string("0.1"));
+        CHECK_TRUE(Bridge::PriceToDouble(b) == 0.1);
+        CHECK_FALSE(Bridge::PriceFromDouble(std::numeric_limits<double>::infinity()).IsSet());
+
+        Bridge::FixedPrice x, y;
+        Bridge::ParsePrice("4200.50", x);
+        Bridge::ParsePrice("4200.5", y);
+        CHECK_EQ(Bridge::ComparePrice(x, y), 0);
+        Bridge::ParsePrice("4200.75", y);
+        CHECK_EQ(Bridge::ComparePrice(x, y), -1);
+        CHECK_EQ(Bridge::ComparePrice(y, x), 1);
+
+        Bridge::FixedPrice r;
+        CHECK_TRUE(Bridge::RescalePrice(x, 4, r) == std::errc{});
+        CHECK_TRUE(r.ticks == 42005000);
+        CHECK_TRUE(Bridge::RescalePrice(x, 1, r) == std::errc{});
+        CHECK_TRUE(r.ticks == 42005);
+        CHECK_TRUE(Bridge::RescalePrice(y, 1, r) == std::errc::invalid_argument);
+    }
+
+    // ParsePayload carries the exact price and rejects malformed numbers
+    {
+        Bridge::OrderRequest req;
+        int rc = Bridge::ParsePayload(
+            "command=PLACE|account=ACC1|instrument=ES|action=BUY|quantity=1|"
+            "orderType=LIMIT|limitPrice=4200.25|timeInForce=DAY", req);
+        CHECK_EQ(rc, Bridge::RC_SUCCESS);
+        CHECK_TRUE(req.limitPx.ticks == 420025);
+        CHECK_TRUE(req.limitPrice == 4200.25);
+
+        rc = Bridge::ParsePayload(
+            "command=PLACE|account=ACC1|instrument=ES|action=BUY|quantity=1|"
+            "orderType=LIMIT|limitPrice=42x0|timeInForce=DAY", req);
+        CHECK_EQ(rc, Bridge::RC_INVALID_PARAM);
+
+        rc = Bridge::ParsePayload(
+            "command=PLACE|account=ACC1|instrument=ES|action=BUY|quantity=1|"
+            "orderType=LIMIT|limitPrice=-1|timeInForce=DAY", req);
+        CHECK_EQ(rc, Bridge::RC_INVALID_PARAM);
+    }
+}
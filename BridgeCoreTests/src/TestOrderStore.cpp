@@ -0,0 +1,92 @@
+#include "TestFramework.h"
+#include "../../BridgeCore/include/OrderStore.h"
+#include "../../BridgeCore/include/Types.h"
+#include <string>
+
+static Bridge::OrderRequest MakeStoreReq(int qty)
+{
+    Bridge::OrderRequest r;
+    r.command     = Bridge::Command::PLACE;
+    r.action      = Bridge::Action::BUY;
+    r.quantity    = qty;
+    r.orderType   = Bridge::OrderType::MARKET;
+    r.timeInForce = Bridge::TimeInForce::DAY;
+    return r;
+}
+
+void TestOrderStore() {
+    printf("\n-- TestOrderStore --\n");
+
+    // Preformatted id counter carries across digit boundaries
+    {
+        Bridge::OrderIdCounter ids("MOCK-");
+        CHECK_TRUE(ids.Next() == "MOCK-1");
+        std::string last;
+        for (int i = 2; i <= 100; ++i) last = std::string(ids.Next());
+        CHECK_STR_EQ(last, std::string("MOCK-100"));
+        for (int i = 101; i <= 1000; ++i) last = std::string(ids.Next());
+        CHECK_STR_EQ(last, std::string("MOCK-1000"));
+        ids.Reset();
+        CHECK_TRUE(ids.Next() == "MOCK-1");
+    }
+
+    const Bridge::SymbolId A1 = 1, A2 = 2, ES = 10, NQ = 11;
+
+    // Cancels touch only their key / account
+    {
+        Bridge::OrderStore store;
+        CHECK_TRUE(store.Add(MakeStoreReq(1), A1, ES) == "MOCK-1");
+        store.Add(MakeStoreReq(2), A1, NQ);
+        store.Add(MakeStoreReq(3), A1, ES);
+        store.Add(MakeStoreReq(4), A2, ES);
+        CHECK_EQ((int)store.WorkingCount(), 4);
+        CHECK_EQ((int)store.WorkingCount(A1, ES), 2);
+
+        CHECK_EQ((int)store.CancelWorking(A1, ES), 2);
+        CHECK_EQ((int)store.WorkingCount(A1, ES), 0);
+        CHECK_EQ((int)store.WorkingCount(A1, NQ), 1);
+        CHECK_EQ((int)store.WorkingCount(A2, ES), 1);
+        CHECK_EQ((int)store.CancelWorking(A1, ES), 0);
+
+        CHECK_EQ((int)store.CancelAccount(A1), 1);
+        CHECK_EQ((int)store.WorkingCount(), 1);
+        CHECK_EQ((int)store.ArchivedCount(), 3);
+
+        auto all = store.Snapshot();
+        CHECK_EQ((int)all.size(), 4);
+        CHECK_TRUE(all[0].orderId == "MOCK-1" && !all[0].working);
+        CHECK_TRUE(all[1].quantity == 2 && !all[1].working);
+        CHECK_TRUE(all[3].orderId == "MOCK-4" && all[3].working);
+
+        CHECK_EQ((int)store.CancelAll(), 1);
+        CHECK_EQ((int)store.WorkingCount(), 0);
+    }
+
+    // Unlinking from the middle of a key list keeps the rest reachable
+    {
+        Bridge::OrderStore store;
+        for (int i = 1; i <= 5; ++i) store.Add(MakeStoreReq(i), A1, i % 2 ? ES : NQ);
+        CHECK_EQ((int)store.CancelWorking(A1, NQ), 2);      // orders 2 and 4
+        CHECK_EQ((int)store.WorkingCount(A1, ES), 3);
+        CHECK_EQ((int)store.CancelAccount(A1), 3);
+        CHECK_EQ((int)store.WorkingCount(), 0);
+    }
+
+    // Retired slots are reused: the working table tracks open orders only
+    {
+        Bridge::OrderStore store;
+        for (int i = 0; i < 1000; ++i) {
+            store.Add(MakeStoreReq(1), A1, ES);
+            store.CancelWorking(A1, ES);
+        }
+        CHECK_EQ((int)store.SlotCount(), 1);
+        CHECK_EQ((int)store.ArchivedCount(), 1000);
+        store.Add(MakeStoreReq(7), A2, NQ);
+        auto all = store.Snapshot();
+        CHECK_TRUE(all.back().orderId == "MOCK-1001" && all.back().working);
+
+        store.Clear();
+        CHECK_EQ((int)store.Snapshot().size(), 0);
+        CHECK_TRUE(store.Add(MakeStoreReq(1), A1, ES) == "MOCK-1");
+    }
+}
@@ -63,6 +63,46 @@ void TestParser() {
         CHECK_EQ(req.quantity, 5);
     }
 
+    // ParsePayload makes no heap allocations once account/instrument fit in
+    // the strings' small-buffer storage.
+    {
+        Bridge::OrderRequest req;
+        std::string payload =
+            "command=PLACE|account=ACC1|instrument=ESH26|action=SELL|"
+            "quantity=3|orderType=STOPLIMIT|limitPrice=4200.25|stopPrice=4199.75|timeInForce=GTC";
+        int rc = Bridge::ParsePayload(payload, req);
+        CHECK_EQ(rc, Bridge::RC_SUCCESS);
+
+        size_t before = g_allocCount.load();
+        for (int i = 0; i < 100; ++i)
+            rc = Bridge::ParsePayload(payload, req);
+        size_t allocs = g_allocCount.load() - before;
+        CHECK_EQ(rc, Bridge::RC_SUCCESS);
+        CHECK_EQ((int)allocs, 0);
+        CHECK_TRUE(req.instrument == "ESH26");
+        CHECK_EQ((int)req.orderType, (int)Bridge::OrderType::STOPLIMIT);
+    }
+
+    // Keys are case-insensitive and surrounding whitespace is ignored
+    {
+        Bridge::OrderRequest req;
+        int rc = Bridge::ParsePayload(
+            " COMMAND = cancel | Account=ACC2 |INSTRUMENT= NQ |", req);
+        CHECK_EQ(rc, Bridge::RC_SUCCESS);
+        CHECK_EQ((int)req.command, (int)Bridge::Command::CANCEL);
+        CHECK_TRUE(req.account == "ACC2");
+        CHECK_TRUE(req.instrument == "NQ");
+    }
+
+    // Malformed number
+    {
+        Bridge::OrderRequest req;
+        int rc = Bridge::ParsePayload(
+            "command=PLACE|account=ACC1|instrument=ES|action=BUY|"
+            "quantity=abc|orderType=MARKET|timeInForce=DAY", req);
+        CHECK_EQ(rc, Bridge::RC_INVALID_PARAM);
+    }
+
     // BuildRequest (narrow) - valid
     {
         Bridge::OrderRequest req;
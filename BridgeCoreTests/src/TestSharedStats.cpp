@@ -0,0 +1,208 @@
+#include "TestFramework.h"
+#include "../../BridgeCore/include/BridgeEngine.h"
+#include "../../BridgeCore/include/Config.h"
+#include "../../BridgeCore/include/SharedStats.h"
+#include "../../BridgeCore/include/Types.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr size_t kPlace  = static_cast<size_t>(Bridge::Command::PLACE);
+constexpr size_t kCancel = static_cast<size_t>(Bridge::Command::CANCEL);
+constexpr int    kOk     = Bridge::StatsResultSlot(Bridge::RC_SUCCESS);
+constexpr int    kReject = Bridge::StatsResultSlot(Bridge::RC_REJECTED);
+
+// Segment names are machine-wide; keep runs from tripping over each other.
+std::string UniqueName(const char* prefix) {
+    return prefix + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count() % 1000000000);
+}
+
+uint64_t Requests(size_t command, int slot) {
+    auto s = std::make_unique<Bridge::StatsSnapshot>();
+    Bridge::CollectStats(*s);
+    return s->requests[command][slot];
+}
+
+Bridge::OrderRequest MakeSharedReq(int qty) {
+    Bridge::OrderRequest r;
+    r.command     = Bridge::Command::PLACE;
+    r.account     = "ACC1";
+    r.instrument  = "ES";
+    r.action      = Bridge::Action::BUY;
+    r.quantity    = qty;
+    r.orderType   = Bridge::OrderType::MARKET;
+    r.timeInForce = Bridge::TimeInForce::DAY;
+    return r;
+}
+
+} // namespace
+
+void TestSharedStats() {
+    printf("\n-- TestSharedStats --\n");
+
+    // Result slots and names
+    {
+        CHECK_TRUE(std::string(Bridge::StatsResultName(kOk)) == "OK");
+        CHECK_TRUE(std::string(Bridge::StatsResultName(kReject)) == "REJECTED");
+        CHECK_EQ(Bridge::StatsResultSlot(12345), Bridge::kStatsResults - 1);
+        CHECK_TRUE(std::string(Bridge::StatsResultName(Bridge::StatsResultSlot(-999))) == "OTHER");
+        CHECK_TRUE(std::string(Bridge::StatsCommandName(kPlace)) == "PLACE");
+    }
+
+    // Per-thread counters add up across threads, including exited ones
+    {
+        uint64_t placed   = Requests(kPlace, kOk);
+        uint64_t rejected = Requests(kCancel, kReject);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([] {
+                for (int i = 0; i < 1000; ++i) Bridge::CountRequest(Bridge::Command::PLACE, Bridge::RC_SUCCESS);
+                for (int i = 0; i < 10; ++i) Bridge::CountRequest(Bridge::Command::CANCEL, Bridge::RC_REJECTED);
+            });
+        }
+        for (auto& t : threads) t.join();
+        CHECK_EQ(Requests(kPlace, kOk), placed + 4000);
+        CHECK_EQ(Requests(kCancel, kReject), rejected + 40);
+    }
+
+    // Percentile of bucket counts, in ticks
+    {
+        using Bridge::LatencyHistogram;
+        std::vector<uint64_t> buckets(LatencyHistogram::kBuckets, 0);
+        CHECK_EQ(Bridge::StatsPercentile(buckets.data(), 0.5), 0u);
+        buckets[LatencyHistogram::BucketOf(100)]  = 99;
+        buckets[LatencyHistogram::BucketOf(5000)] = 1;
+        CHECK_EQ(Bridge::StatsPercentile(buckets.data(), 0.50), LatencyHistogram::BucketHigh(LatencyHistogram::BucketOf(100)));
+        CHECK_EQ(Bridge::StatsPercentile(buckets.data(), 0.999), LatencyHistogram::BucketHigh(LatencyHistogram::BucketOf(5000)));
+    }
+
+    // Publish / read round trip; one publisher per name
+    {
+        std::string name = UniqueName("BridgeStatsTest");
+        Bridge::SharedStatsSegment reader;
+        CHECK_FALSE(reader.Open(name));
+
+        Bridge::SharedStatsSegment pub;
+        CHECK_TRUE(pub.Create(name));
+        Bridge::SharedStatsSegment second;
+        CHECK_FALSE(second.Create(name));
+
+        CHECK_TRUE(reader.Open(name));
+        CHECK_TRUE(reader.PublisherPid() != 0);
+        CHECK_TRUE(reader.StartedUnixMs() != 0);
+        auto in  = std::make_unique<Bridge::StatsSnapshot>();
+        auto out = std::make_unique<Bridge::StatsSnapshot>();
+        CHECK_TRUE(reader.Read(*out));
+        CHECK_EQ(out->publishedNs, 0u);
+
+        in->publishedNs = 42;
+        std::strcpy(in->adapter, "SIM");
+        in->connected                = 1;
+        in->asyncQueued              = 7;
+        in->requests[kPlace][kOk]    = 1234;
+        in->latencyBuckets[3][17]    = 99;
+        in->ticksPerNs               = 2.5;
+        pub.Publish(*in);
+        CHECK_TRUE(reader.Read(*out));
+        CHECK_TRUE(std::memcmp(in.get(), out.get(), sizeof(Bridge::StatsSnapshot)) == 0);
+
+        // The reader cannot publish
+        in->publishedNs = 43;
+        reader.Publish(*in);
+        CHECK_TRUE(reader.Read(*out));
+        CHECK_EQ(out->publishedNs, 42u);
+
+        pub.Close();
+        CHECK_EQ(reader.PublisherPid(), 0u);
+        CHECK_TRUE(second.Create(name));   // the name is free again
+        second.Close();
+    }
+
+    // Readers never see a snapshot that is half written
+    {
+        std::string name = UniqueName("BridgeStatsSeq");
+        Bridge::SharedStatsSegment pub, reader;
+        CHECK_TRUE(pub.Create(name));
+        CHECK_TRUE(reader.Open(name));
+        std::atomic<bool> done{ false };
+        std::thread writer([&] {
+            auto s = std::make_unique<Bridge::StatsSnapshot>();
+            for (uint64_t i = 1; i <= 20000; ++i) {
+                s->publishedNs = i;
+                s->dedupHits   = i;
+                s->latencyMax[Bridge::kStatsStages - 1] = i;
+                pub.Publish(*s);
+            }
+            done.store(true);
+        });
+        auto s = std::make_unique<Bridge::StatsSnapshot>();
+        int reads = 0, torn = 0;
+        while (!done.load()) {
+            if (!reader.Read(*s)) continue;
+            ++reads;
+            if (s->dedupHits != s->publishedNs || s->latencyMax[Bridge::kStatsStages - 1] != s->publishedNs) ++torn;
+        }
+        writer.join();
+        CHECK_TRUE(reads > 0);
+        CHECK_EQ(torn, 0);
+        CHECK_TRUE(reader.Read(*s));
+        CHECK_EQ(s->publishedNs, 20000u);
+    }
+
+    // The engine publishes its counters; BridgeTop's view of it
+    {
+        Bridge::BridgeConfig cfg;
+        cfg.adapterType       = "MOCK";
+        cfg.statsDumpSeconds  = 0;
+        cfg.statsPublishMs    = 0;   // publish only when asked
+        cfg.statsSharedMemory = UniqueName("BridgeStatsEngine");
+        Bridge::SharedStatsSegment reader;
+        auto s = std::make_unique<Bridge::StatsSnapshot>();
+        {
+            Bridge::BridgeEngine engine(cfg);
+            CHECK_TRUE(reader.Open(cfg.statsSharedMemory));
+            CHECK_TRUE(reader.Read(*s));
+            CHECK_TRUE(s->publishedNs != 0);   // published once at startup
+            CHECK_TRUE(std::string(s->adapter) == "MOCK");
+            CHECK_EQ(s->connected, 1u);
+            uint64_t placed = s->requests[kPlace][kOk];
+            uint64_t total  = s->latencyCount[static_cast<size_t>(Bridge::Stage::Total)];
+
+            for (int i = 0; i < 20; ++i) engine.Execute(MakeSharedReq(1 + i));
+            engine.PublishStats();
+            CHECK_TRUE(reader.Read(*s));
+            CHECK_EQ(s->requests[kPlace][kOk], placed + 20);
+            CHECK_TRUE(s->latencyCount[static_cast<size_t>(Bridge::Stage::Total)] >= total + 20);
+            CHECK_TRUE(s->ticksPerNs > 0);
+
+            // Another engine cannot take the name while this one has it
+            Bridge::BridgeEngine other(cfg);
+            CHECK_TRUE(reader.Read(*s));
+            CHECK_EQ(s->requests[kPlace][kOk], placed + 20);
+        }
+        CHECK_EQ(reader.PublisherPid(), 0u);
+    }
+
+    // bridge.json keys
+    {
+        namespace fs = std::filesystem;
+        fs::path cfgPath = fs::temp_directory_path() / "bridge_sharedstats_test.json";
+        std::ofstream(cfgPath) << "{\n  \"statsSharedMemory\": \"BridgeStats\",\n  \"statsPublishMs\": 250\n}\n";
+        Bridge::BridgeConfig cfg;
+        CHECK_EQ(Bridge::LoadConfig(cfgPath.string(), cfg), Bridge::RC_SUCCESS);
+        CHECK_STR_EQ(cfg.statsSharedMemory, std::string("BridgeStats"));
+        CHECK_EQ(cfg.statsPublishMs, 250);
+        CHECK_TRUE(Bridge::DefaultConfig().statsSharedMemory.empty());   // opt-in
+        CHECK_EQ(Bridge::DefaultConfig().statsPublishMs, 1000);
+        fs::remove(cfgPath);
+    }
+}
@@ -0,0 +1,228 @@
+#include "TestFramework.h"
+#include "../../BridgeCore/include/SimExchangeAdapter.h"
+#include "../../BridgeCore/include/MarketDataFeed.h"
+#include "../../BridgeCore/include/PriceLevelBook.h"
+#include "../../BridgeCore/include/SymbolTable.h"
+#include "../../BridgeCore/include/Types.h"
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+using Bridge::ExecutionReport;
+
+static Bridge::PriceTicks Px(double v) { return std::llround(v * 1e6); }
+
+static Bridge::OrderRequest MakeSimReq(Bridge::Command cmd, Bridge::Action action, int qty,
+                                       Bridge::OrderType ot = Bridge::OrderType::MARKET,
+                                       double limit = 0.0, double stop = 0.0)
+{
+    Bridge::OrderRequest r;
+    r.command     = cmd;
+    r.account     = "SIMACC";
+    r.instrument  = "SIMES";
+    r.action      = action;
+    r.quantity    = qty;
+    r.orderType   = ot;
+    r.limitPrice  = limit;
+    r.stopPrice   = stop;
+    r.timeInForce = Bridge::TimeInForce::DAY;
+    return r;
+}
+
+static Bridge::MarketEvent Quote(double bid, int bidSize, double ask, int askSize) {
+    Bridge::MarketEvent ev;
+    ev.instrument = Bridge::InternSymbol("SIMES");
+    ev.kind       = Bridge::MarketEvent::Kind::Quote;
+    ev.price      = Px(bid);
+    ev.size       = bidSize;
+    ev.ask        = Px(ask);
+    ev.askSize    = askSize;
+    return ev;
+}
+
+static Bridge::MarketEvent Trade(double px, int size) {
+    Bridge::MarketEvent ev;
+    ev.instrument = Bridge::InternSymbol("SIMES");
+    ev.kind       = Bridge::MarketEvent::Kind::Trade;
+    ev.price      = Px(px);
+    ev.size       = size;
+    return ev;
+}
+
+void TestSimExchange() {
+    printf("\n-- TestSimExchange --\n");
+    using Bridge::BookSide;
+    using Bridge::PriceLevelBook;
+
+    // Price-time priority in the flat book
+    {
+        PriceLevelBook book;
+        book.Add(BookSide::Bid, Px(100), 5, 1);
+        book.Add(BookSide::Bid, Px(101), 3, 2);
+        PriceLevelBook::Handle h3 = book.Add(BookSide::Bid, Px(100), 2, 3);
+        book.Add(BookSide::Ask, Px(102), 4, 4);
+        Bridge::PriceTicks best = 0;
+        CHECK_TRUE(book.Best(BookSide::Bid, best) && best == Px(101));
+        CHECK_EQ(book.QtyAt(BookSide::Bid, Px(100)), 7);
+
+        std::vector<uint64_t> tags;
+        int filled = book.Match(BookSide::Bid, Px(100), 6,
+            [&](uint64_t tag, int, Bridge::PriceTicks, int) { tags.push_back(tag); });
+        CHECK_EQ(filled, 6);
+        CHECK_TRUE(tags.size() == 2 && tags[0] == 2 && tags[1] == 1);
+        CHECK_EQ((int)book.LevelCount(BookSide::Bid), 1);
+        CHECK_EQ(book.QtyAt(BookSide::Bid, Px(100)), 4);
+
+        CHECK_EQ(book.Cancel(h3), 2);
+        CHECK_EQ(book.Cancel(h3), 0);
+        CHECK_EQ((int)book.OrderCount(), 2);
+        CHECK_EQ(book.Match(BookSide::Ask, Px(101.5), 10, [](uint64_t, int, Bridge::PriceTicks, int) {}), 0);
+    }
+
+    // Feed parsing
+    {
+        Bridge::MarketDataFeed feed;
+        int rc = feed.Parse("# recorded session\n"
+                            "1000,Q,SIMES,5001.00,40,5001.25,35\r\n"
+                            "\n"
+                            "1150,T,SIMES,5001.25,3\n");
+        CHECK_EQ(rc, Bridge::RC_SUCCESS);
+        CHECK_EQ((int)feed.Size(), 2);
+        const Bridge::MarketEvent& q = feed.Events()[0];
+        CHECK_TRUE(q.kind == Bridge::MarketEvent::Kind::Quote && q.price == Px(5001.0) && q.askSize == 35);
+        CHECK_TRUE(feed.Events()[1].timeUs == 1150 && feed.Events()[1].size == 3);
+        CHECK_TRUE(feed.Events()[1].instrument == Bridge::InternSymbol("SIMES"));
+
+        CHECK_EQ(feed.Parse("2000,T,SIMES,5001.25,1\n2001,X,SIMES,1,1\n"), Bridge::RC_INVALID_PARAM);
+        CHECK_EQ((int)feed.ErrorLine(), 2);
+        CHECK_EQ((int)feed.Size(), 3);
+        CHECK_EQ(feed.Load("no/such/feed.csv"), Bridge::RC_CONFIG_ERR);
+    }
+
+    Bridge::SymbolId acc = Bridge::InternSymbol("SIMACC");
+    Bridge::SymbolId es  = Bridge::InternSymbol("SIMES");
+
+    // Market order takes the quote, then fills from later prints
+    {
+        Bridge::SimExchangeAdapter sim;
+        std::vector<ExecutionReport> reports;
+        sim.SetExecutionSink([&](const ExecutionReport& r) { reports.push_back(r); });
+
+        sim.OnMarketEvent(Quote(100.00, 10, 100.25, 5));
+        CHECK_EQ(sim.Execute(MakeSimReq(Bridge::Command::PLACE, Bridge::Action::BUY, 8)), Bridge::RC_SUCCESS);
+        CHECK_EQ((int)reports.size(), 2);
+        CHECK_TRUE(reports[0].type == ExecutionReport::Type::New && reports[0].orderId == "SIM-1");
+        CHECK_TRUE(reports[1].type == ExecutionReport::Type::PartialFill && reports[1].lastQty == 5);
+        CHECK_TRUE(reports[1].lastPx.ticks == 10025 && reports[1].lastPx.scale == 2);
+        CHECK_EQ(reports[1].leavesQty, 3);
+        CHECK_EQ((int)sim.Position(acc, es), 5);
+
+        sim.OnMarketEvent(Trade(100.25, 2));
+        sim.OnMarketEvent(Trade(100.50, 10));
+        CHECK_TRUE(reports.back().type == ExecutionReport::Type::Fill);
+        CHECK_EQ(reports.back().lastQty, 1);
+        CHECK_EQ(reports.back().cumQty, 8);
+        CHECK_EQ((int)sim.Position(acc, es), 8);
+        CHECK_EQ((int)sim.WorkingCount(), 0);
+        CHECK_EQ((int)sim.FillCount(), 3);
+    }
+
+    // Resting limit: partial fill on a print at its price, then cancel
+    {
+        Bridge::SimExchangeAdapter sim;
+        std::vector<ExecutionReport> reports;
+        sim.SetExecutionSink([&](const ExecutionReport& r) { reports.push_back(r); });
+
+        sim.OnMarketEvent(Quote(100.00, 10, 100.25, 5));
+        sim.Execute(MakeSimReq(Bridge::Command::PLACE, Bridge::Action::SELL, 3, Bridge::OrderType::LIMIT, 101.0));
+        sim.OnMarketEvent(Trade(100.75, 4));
+        CHECK_EQ((int)reports.size(), 1);
+        sim.OnMarketEvent(Trade(101.00, 1));
+        CHECK_TRUE(reports.back().type == ExecutionReport::Type::PartialFill && reports.back().leavesQty == 2);
+        CHECK_EQ((int)sim.Position(acc, es), -1);
+
+        sim.Execute(MakeSimReq(Bridge::Command::CANCEL, Bridge::Action::SELL, 0));
+        CHECK_TRUE(reports.back().type == ExecutionReport::Type::Canceled && reports.back().leavesQty == 0);
+        CHECK_EQ((int)sim.WorkingCount(), 0);
+        sim.OnMarketEvent(Trade(102.00, 10));
+        CHECK_EQ((int)sim.Position(acc, es), -1);
+    }
+
+    // A print fills its size once, not once per side of the book
+    {
+        Bridge::SimExchangeAdapter sim;
+        sim.OnMarketEvent(Quote(99.00, 10, 101.00, 10));
+        sim.Execute(MakeSimReq(Bridge::Command::PLACE, Bridge::Action::BUY, 3, Bridge::OrderType::LIMIT, 100.0));
+        sim.Execute(MakeSimReq(Bridge::Command::PLACE, Bridge::Action::SELL, 3, Bridge::OrderType::LIMIT, 100.0));
+        CHECK_EQ((int)sim.WorkingCount(), 2);
+        sim.OnMarketEvent(Trade(100.00, 4));
+        CHECK_EQ((int)sim.Position(acc, es), 2);   // bought 3, sold the 1 left
+        CHECK_EQ((int)sim.WorkingCount(), 1);
+    }
+
+    // Stop triggers on a print through it; CLOSEPOSITION offsets the fill
+    {
+        Bridge::SimExchangeAdapter sim;
+        sim.OnMarketEvent(Quote(100.00, 10, 100.25, 5));
+        sim.Execute(MakeSimReq(Bridge::Command::PLACE, Bridge::Action::SELL, 2,
+                               Bridge::OrderType::STOPMARKET, 0.0, 99.0));
+        sim.OnMarketEvent(Trade(99.50, 5));
+        CHECK_EQ((int)sim.Position(acc, es), 0);
+        sim.OnMarketEvent(Quote(98.75, 1, 99.00, 5));
+        sim.OnMarketEvent(Trade(99.00, 5));
+        CHECK_EQ((int)sim.Position(acc, es), -2);       // 1 from the bid, 1 from the print
+        CHECK_EQ((int)sim.WorkingCount(), 0);
+
+        sim.Execute(MakeSimReq(Bridge::Command::CLOSEPOSITION, Bridge::Action::BUY, 0));
+        CHECK_EQ((int)sim.Position(acc, es), 0);        // bought 2 of the 5 offered
+
+        sim.Execute(MakeSimReq(Bridge::Command::PLACE, Bridge::Action::BUY, 1));
+        CHECK_EQ((int)sim.Position(acc, es), 1);
+        sim.Execute(MakeSimReq(Bridge::Command::REVERSEPOSITION, Bridge::Action::BUY, 1));
+        CHECK_EQ((int)sim.WorkingCount(), 1);           // bid already taken: waits
+        sim.OnMarketEvent(Quote(98.75, 5, 99.00, 5));
+        CHECK_EQ((int)sim.Position(acc, es), -1);
+    }
+
+    // simFeedPath: the file is replayed in the background at its recorded pace
+    {
+        std::filesystem::path feed = std::filesystem::temp_directory_path() / "bridge_sim_feed_test.csv";
+        {
+            std::ofstream f(feed);
+            f << "# timeUs,Q,instrument,bid,bidSize,ask,askSize\n"
+              << "1000000,Q,SIMES,99.75,10,100.25,10\n"
+              << "1050000,T,SIMES,100.00,5\n";
+        }
+        Bridge::BridgeConfig cfg;
+        cfg.simFeedPath = feed.string();
+        Bridge::SimExchangeAdapter sim(Bridge::SimSettingsOf(cfg));
+        CHECK_EQ(sim.Execute(MakeSimReq(Bridge::Command::PLACE, Bridge::Action::BUY, 3,
+                                        Bridge::OrderType::LIMIT, 100.00)), Bridge::RC_SUCCESS);
+        const Bridge::SymbolId acc = Bridge::InternSymbol("SIMACC");
+        const Bridge::SymbolId es  = Bridge::InternSymbol("SIMES");
+        for (int i = 0; i < 300 && sim.Position(acc, es) == 0; ++i)
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        CHECK_EQ((int)sim.Position(acc, es), 3);
+        CHECK_EQ((int)sim.WorkingCount(), 0);
+        std::filesystem::remove(feed);
+
+        // A missing file leaves the adapter working, without market data
+        Bridge::SimSettings missing;
+        missing.feedPath = (std::filesystem::temp_directory_path() / "bridge_sim_no_such_feed.csv").string();
+        Bridge::SimExchangeAdapter none(missing);
+        CHECK_EQ(none.Execute(MakeSimReq(Bridge::Command::PLACE, Bridge::Action::BUY, 1,
+                                         Bridge::OrderType::LIMIT, 100.00)), Bridge::RC_SUCCESS);
+        CHECK_EQ((int)none.WorkingCount(), 1);
+    }
+
+    // Bad requests are rejected without side effects
+    {
+        Bridge::SimExchangeAdapter sim;
+        CHECK_EQ(sim.Execute(MakeSimReq(Bridge::Command::PLACE, Bridge::Action::BUY, 0)), Bridge::RC_INVALID_PARAM);
+        CHECK_EQ(sim.Execute(MakeSimReq(Bridge::Command::UNKNOWN, Bridge::Action::BUY, 1)), Bridge::RC_INVALID_CMD);
+        CHECK_EQ((int)sim.WorkingCount(), 0);
+    }
+}
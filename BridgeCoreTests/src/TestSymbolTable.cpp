@@ -0,0 +1,151 @@
+#include "TestFramework.h"
+#include "../../BridgeCore/include/BridgeEngine.h"
+#include "../../BridgeCore/include/Config.h"
+#include "../../BridgeCore/include/DedupCache.h"
+#include "../../BridgeCore/include/MockAdapter.h"
+#include "../../BridgeCore/include/SymbolTable.h"
+#include "../../BridgeCore/include/Parser.h"
+#include "../../BridgeCore/include/Types.h"
+#include <string>
+#include <thread>
+#include <vector>
+
+void TestSymbolTable() {
+    printf("\n-- TestSymbolTable --\n");
+
+    // Interning is idempotent and case-sensitive
+    {
+        Bridge::SymbolId a = Bridge::InternSymbol("SYMTEST-ACC");
+        Bridge::SymbolId b = Bridge::InternSymbol(std::string("SYMTEST-ACC"));
+        Bridge::SymbolId c = Bridge::InternSymbol("symtest-acc");
+        CHECK_TRUE(a != Bridge::kNoSymbol);
+        CHECK_EQ(a, b);
+        CHECK_TRUE(a != c);
+        CHECK_TRUE(Bridge::SymbolName(a) == "SYMTEST-ACC");
+        CHECK_EQ(Bridge::FindSymbol("SYMTEST-ACC"), a);
+    }
+
+    // Empty strings and unknown ids
+    {
+        CHECK_EQ(Bridge::InternSymbol(""), Bridge::kNoSymbol);
+        CHECK_EQ(Bridge::FindSymbol("SYMTEST-NEVER-INTERNED"), Bridge::kNoSymbol);
+        CHECK_TRUE(Bridge::SymbolName(Bridge::kNoSymbol).empty());
+        CHECK_TRUE(Bridge::SymbolName(0xFFFFFFFFu).empty());
+    }
+
+    // Repeat lookups do not allocate
+    {
+        Bridge::InternSymbol("SYMTEST-A-LONGER-INSTRUMENT-NAME");
+        size_t before = g_allocCount.load();
+        Bridge::SymbolId id = Bridge::kNoSymbol;
+        for (int i = 0; i < 1000; ++i)
+            id = Bridge::InternSymbol("SYMTEST-A-LONGER-INSTRUMENT-NAME");
+        CHECK_EQ((int)(g_allocCount.load() - before), 0);
+        CHECK_TRUE(id != Bridge::kNoSymbol);
+    }
+
+    // Concurrent interning of the same names agrees on the ids
+    {
+        const int kThreads = 4;
+        const int kNames   = 64;
+        std::vector<std::vector<Bridge::SymbolId>> seen(kThreads);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < kThreads; ++t) {
+            threads.emplace_back([t, &seen]() {
+                for (int n = 0; n < kNames; ++n)
+                    seen[t].push_back(Bridge::InternSymbol("SYMTEST-MT-" + std::to_string(n)));
+            });
+        }
+        for (auto& th : threads) th.join();
+        bool same = true;
+        for (int t = 1; t < kThreads; ++t)
+            same = same && (seen[t] == seen[0]);
+        CHECK_TRUE(same);
+        CHECK_TRUE(Bridge::SymbolName(seen[0][7]) == "SYMTEST-MT-7");
+    }
+
+    // Rejected requests do not use up slots, so new names still resolve after
+    // more bad ones than the table holds
+    {
+        bool unresolved = true;
+        for (int i = 0; i < 5000; ++i) {
+            std::string n = std::to_string(i);
+            Bridge::OrderRequest r1, r2, r3;
+            Bridge::ParsePayload("command=PLACE|account=SYMBAD-A" + n + "|instrument=SYMBAD-I" + n +
+                                 "|action=BUY|quantity=x|orderType=MARKET", r1);
+            Bridge::ParsePayload("command=PLACE|account=SYMBAD-B" + n + "|instrument=ES|action=BUY|quantity=0|"
+                                 "orderType=MARKET|timeInForce=DAY", r2);
+            Bridge::BuildRequest("NOSUCHCOMMAND", ("SYMBAD-C" + n).c_str(), ("SYMBAD-D" + n).c_str(), "BUY", 1,
+                                 "MARKET", 0.0, 0.0, "DAY", r3);
+            unresolved = unresolved && r2.accountId == Bridge::kNoSymbol && r3.accountId == Bridge::kNoSymbol;
+        }
+        CHECK_TRUE(unresolved);
+        CHECK_EQ(Bridge::FindSymbol("SYMBAD-A0"), Bridge::kNoSymbol);
+        CHECK_EQ(Bridge::FindSymbol("SYMBAD-B4999"), Bridge::kNoSymbol);
+        CHECK_EQ(Bridge::FindSymbol("SYMBAD-C7"), Bridge::kNoSymbol);
+        Bridge::OrderRequest ok;
+        int rc = Bridge::ParsePayload("command=PLACE|account=SYMTEST-NEW-ACC|instrument=ES|action=BUY|quantity=1|"
+                                      "orderType=MARKET|timeInForce=DAY", ok);
+        CHECK_EQ(rc, Bridge::RC_SUCCESS);
+        CHECK_TRUE(ok.accountId != Bridge::kNoSymbol);
+        CHECK_TRUE(Bridge::SymbolsResolved(ok));
+    }
+
+    // Parsed requests carry resolved ids
+    {
+        Bridge::OrderRequest req;
+        int rc = Bridge::ParsePayload("command=CANCEL|account=SYMTEST-ACC|instrument=ESH26", req);
+        CHECK_EQ(rc, Bridge::RC_SUCCESS);
+        CHECK_EQ(req.accountId, Bridge::FindSymbol("SYMTEST-ACC"));
+        CHECK_TRUE(Bridge::SymbolName(req.instrumentId) == "ESH26");
+    }
+}
+
+// Runs last: the table is process-wide and stays full.
+void TestSymbolTableFull() {
+    printf("\n-- TestSymbolTableFull --\n");
+
+    Bridge::SymbolId known = Bridge::InternSymbol("SYMTEST-ACC");
+    int added = 0;
+    while (Bridge::InternSymbol("SYMFULL-" + std::to_string(added)) != Bridge::kNoSymbol) ++added;
+    CHECK_TRUE(added > 0 && added < 4096);
+    CHECK_EQ(Bridge::InternSymbol("SYMTEST-ACC"), known);   // existing names still resolve
+    CHECK_EQ(Bridge::FindSymbol("SYMFULL-" + std::to_string(added)), Bridge::kNoSymbol);
+
+    Bridge::OrderRequest a;
+    int rc = Bridge::ParsePayload("command=PLACE|account=FULL-ACC-A|instrument=ES|action=BUY|quantity=1|"
+                                  "orderType=MARKET|timeInForce=DAY", a);
+    CHECK_EQ(rc, Bridge::RC_SUCCESS);
+    CHECK_EQ(a.accountId, Bridge::kNoSymbol);
+    CHECK_FALSE(Bridge::SymbolsResolved(a));
+    Bridge::OrderRequest b = a;
+    b.account = "FULL-ACC-B";
+
+    // Accounts without an id do not dedup against each other
+    CHECK_TRUE(Bridge::DedupCache::KeyOf(a) != Bridge::DedupCache::KeyOf(b));
+
+    // Adapters and the engine refuse them instead of merging them
+    {
+        Bridge::MockAdapter mock;
+        CHECK_EQ(mock.Execute(a), Bridge::RC_INVALID_PARAM);
+        Bridge::OrderRequest cancelAll = a;
+        cancelAll.command = Bridge::Command::CANCELALLORDERS;
+        CHECK_EQ(mock.Execute(cancelAll), Bridge::RC_INVALID_PARAM);
+    }
+    {
+        Bridge::BridgeConfig cfg;
+        cfg.adapterType    = "MOCK";
+        cfg.executionLanes = 4;
+        Bridge::BridgeEngine engine(cfg);
+        CHECK_EQ(engine.Execute(a), Bridge::RC_INVALID_PARAM);
+        CHECK_EQ(engine.ExecuteAsync(b), Bridge::RC_INVALID_PARAM);
+        Bridge::OrderRequest named = a;
+        named.account   = "SYMTEST-ACC";
+        named.accountId = Bridge::kNoSymbol;
+        Bridge::OrderRequest batch[2] = { a, named };
+        int results[2] = {};
+        engine.ExecuteBatch(batch, 2, results);
+        CHECK_EQ(results[0], Bridge::RC_INVALID_PARAM);
+        CHECK_EQ(results[1], Bridge::RC_SUCCESS);
+    }
+}
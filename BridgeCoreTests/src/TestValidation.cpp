@@ -38,6 +38,14 @@ void TestValidation() {
     CHECK_EQ((int)Bridge::ParseTimeInForce("day"), (int)Bridge::TimeInForce::DAY);
     CHECK_EQ((int)Bridge::ParseTimeInForce("???"), (int)Bridge::TimeInForce::UNKNOWN);
 
+    // Keyword table: tokens only match within their own kind
+    CHECK_EQ((int)Bridge::ParseCommand("BUY"),         (int)Bridge::Command::UNKNOWN);
+    CHECK_EQ((int)Bridge::ParseAction("PLACE"),        (int)Bridge::Action::UNKNOWN);
+    CHECK_EQ((int)Bridge::ParseOrderType("account"),   (int)Bridge::OrderType::UNKNOWN);
+    CHECK_EQ((int)Bridge::ParseCommand("PLACEX"),      (int)Bridge::Command::UNKNOWN);
+    CHECK_EQ((int)Bridge::ParseCommand("P@ACE"),       (int)Bridge::Command::UNKNOWN);
+    CHECK_EQ((int)Bridge::ParseCommand("ReversePosition"), (int)Bridge::Command::REVERSEPOSITION);
+
     // ValidateRequest - valid PLACE
     {
         Bridge::OrderRequest req;
@@ -0,0 +1,80 @@
+#include "TestFramework.h"
+#include "../../BridgeCore/include/WideText.h"
+#include "../../BridgeCore/include/Parser.h"
+#include "../../BridgeCore/include/Types.h"
+#include <string>
+
+static std::string Narrow(const wchar_t* w) {
+    char buf[256];
+    size_t n = Bridge::NarrowWide(w, buf, sizeof(buf));
+    return std::string(buf, n);
+}
+
+void TestWideText() {
+    printf("\n-- TestWideText (%s) --\n", Bridge::NarrowWideIsa());
+
+    // ASCII of every length around the vector widths
+    {
+        const wchar_t* src = L"command=PLACE|account=ACC1|instrument=ESH26|action=BUY";
+        std::string expected = "command=PLACE|account=ACC1|instrument=ESH26|action=BUY";
+        bool allMatch = true;
+        for (size_t len = 0; len <= expected.size(); ++len) {
+            std::wstring w(src, len);
+            allMatch = allMatch && (Narrow(w.c_str()) == expected.substr(0, len));
+        }
+        CHECK_TRUE(allMatch);
+    }
+
+    // Null and empty input
+    {
+        char buf[8] = { 'x' };
+        CHECK_EQ((int)Bridge::NarrowWide(nullptr, buf, sizeof(buf)), 0);
+        CHECK_EQ(buf[0], '\0');
+        CHECK_STR_EQ(Narrow(L""), std::string(""));
+    }
+
+    // Non-ASCII switches to UTF-8, including after a vector-width ASCII run
+    {
+        CHECK_STR_EQ(Narrow(L"caf\u00e9"), std::string("caf\xC3\xA9"));
+        CHECK_STR_EQ(Narrow(L"ACCOUNT-0123456789-\u20ac"),
+                     std::string("ACCOUNT-0123456789-\xE2\x82\xAC"));
+        CHECK_STR_EQ(Narrow(L"\U0001F600x"), std::string("\xF0\x9F\x98\x80x"));
+    }
+
+    // Too-small buffer reports the size needed
+    {
+        char small[4];
+        CHECK_EQ((int)Bridge::NarrowWide(L"ESH26", small, sizeof(small)), 5);
+        CHECK_EQ((int)Bridge::NarrowWide(L"\u00e9\u00e9", small, sizeof(small)), 4);
+        char exact[5];
+        CHECK_EQ((int)Bridge::NarrowWide(L"\u00e9\u00e9", exact, sizeof(exact)), 4);
+        CHECK_TRUE(std::string(exact) == "\xC3\xA9\xC3\xA9");
+    }
+
+    // NarrowArg spills to the heap only when needed
+    {
+        std::wstring longW(300, L'A');
+        Bridge::NarrowArg<16> big(longW.c_str());
+        CHECK_EQ((int)big.view().size(), 300);
+
+        size_t before = g_allocCount.load();
+        Bridge::NarrowArg<16> small(L"ESH26");
+        CHECK_EQ((int)(g_allocCount.load() - before), 0);
+        CHECK_TRUE(small.view() == "ESH26");
+    }
+
+    // Wide BuildRequest
+    {
+        Bridge::OrderRequest req;
+        int rc = Bridge::BuildRequest(L"place", L"ACC1", L"ESH26", L"Sell", 2,
+                                      L"LIMIT", 4200.25, 0.0, L"gtc", req);
+        CHECK_EQ(rc, Bridge::RC_SUCCESS);
+        CHECK_EQ((int)req.action, (int)Bridge::Action::SELL);
+        CHECK_TRUE(req.instrument == "ESH26");
+        CHECK_TRUE(req.limitPx.ticks == 420025);
+
+        rc = Bridge::BuildRequest(L"PLACE", nullptr, L"ES", L"BUY", 1,
+                                  L"MARKET", 0.0, 0.0, L"DAY", req);
+        CHECK_EQ(rc, Bridge::RC_INVALID_PARAM);
+    }
+}
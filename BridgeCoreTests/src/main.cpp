@@ -1,13 +1,48 @@
 #include "TestFramework.h"
+#include <cstdlib>
+#include <new>
 
 // Definitions of shared test counters
 int g_pass = 0;
 int g_fail = 0;
+std::atomic<size_t> g_allocCount{ 0 };
+
+// Replace the global allocator so tests can assert on heap traffic.
+void* operator new(size_t size) {
+    g_allocCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
 
 // Forward declarations for test functions
 void TestValidation();
 void TestParser();
 void TestMockAdapter();
+void TestNumeric();
+void TestSymbolTable();
+void TestWideText();
+void TestBatch();
+void TestAsync();
+void TestDedup();
+void TestLanes();
+void TestConfigReload();
+void TestOrderStore();
+void TestSimExchange();
+void TestFaultInjection();
+void TestJournal();
+void TestLogger();
+void TestLogEvent();
+void TestLogRotation();
+void TestLatencyStats();
+void TestSharedStats();
+void TestFixAdapter();
+void TestFixTemplate();
+void TestFixDecoder();
+void TestFixSessionStore();
+void TestDotNetAdapter();
+void TestSymbolTableFull();
 
 int main() {
     printf("=== BridgeCoreTests ===\n\n");
@@ -15,6 +50,29 @@ int main() {
     TestValidation();
     TestParser();
     TestMockAdapter();
+    TestNumeric();
+    TestSymbolTable();
+    TestWideText();
+    TestBatch();
+    TestAsync();
+    TestDedup();
+    TestLanes();
+    TestConfigReload();
+    TestOrderStore();
+    TestSimExchange();
+    TestFaultInjection();
+    TestJournal();
+    TestLogger();
+    TestLogEvent();
+    TestLogRotation();
+    TestLatencyStats();
+    TestSharedStats();
+    TestFixAdapter();
+    TestFixTemplate();
+    TestFixDecoder();
+    TestFixSessionStore();
+    TestDotNetAdapter();
+    TestSymbolTableFull();   // last: fills the process-wide symbol table
 
     printf("\n=== Results: %d passed, %d failed ===\n", g_pass, g_fail);
     return (g_fail == 0) ? 0 : 1;
@@ -38,4 +38,28 @@ BRIDGE_API int __stdcall PLACE_ORDER_CMD_W(const wchar_t* payload);
 // Single pipe-delimited ANSI payload
 BRIDGE_API int __stdcall PLACE_ORDER_CMD_A(const char* payload);
 
+// Newline-separated pipe-delimited Unicode payloads. Writes one return code
+// per payload to results[0..capacity) and returns the number of payloads.
+BRIDGE_API int __stdcall PLACE_ORDER_BATCH_W(const wchar_t* payloads, int* results, int capacity);
+
+// Newline-separated pipe-delimited ANSI payloads
+BRIDGE_API int __stdcall PLACE_ORDER_BATCH_A(const char* payloads, int* results, int capacity);
+
+// Async pipe-delimited payloads: validate, queue and return a ticket (> 0)
+// without waiting for the adapter, or a negative return code.
+BRIDGE_API int __stdcall PLACE_ORDER_ASYNC_CMD_W(const wchar_t* payload);
+BRIDGE_API int __stdcall PLACE_ORDER_ASYNC_CMD_A(const char* payload);
+
+// Result for an async ticket: 1 (pending) or the final return code.
+BRIDGE_API int __stdcall POLL_RESULT(int ticket);
+
+// Per-stage latency report (count, p50/p99/p99.9/max in ns per command,
+// adapter and stage) as text in buffer[0..capacity), NUL-terminated and cut
+// to fit. Returns the full length; pass capacity 0 to size the buffer.
+BRIDGE_API int __stdcall GET_STATS(char* buffer, int capacity);
+
+// Stop the engine's threads, release the adapter and flush the log before
+// the DLL is unloaded. Call once, last; returns 0.
+BRIDGE_API int __stdcall BRIDGE_SHUTDOWN();
+
 } // extern "C"
@@ -1,29 +1,14 @@
 #define BRIDGEDLL_EXPORTS
 #include "../BridgeDLL.h"
 #include "../../BridgeCore/include/BridgeEngine.h"
+#include "../../BridgeCore/include/LatencyStats.h"
 #include "../../BridgeCore/include/Parser.h"
+#include "../../BridgeCore/include/SharedStats.h"
 #include "../../BridgeCore/include/Logger.h"
 #include "../../BridgeCore/include/Types.h"
+#include "../../BridgeCore/include/WideText.h"
 #include <string>
 
-#ifdef _WIN32
-#define WIN32_LEAN_AND_MEAN
-#include <windows.h>
-#endif
-
-namespace {
-
-static std::string WideToUtf8(const wchar_t* w) {
-    if (!w) return {};
-    int len = WideCharToMultiByte(CP_UTF8, 0, w, -1, nullptr, 0, nullptr, nullptr);
-    if (len <= 0) return {};
-    std::string s(static_cast<size_t>(len - 1), '\0');
-    WideCharToMultiByte(CP_UTF8, 0, w, -1, s.data(), len, nullptr, nullptr);
-    return s;
-}
-
-} // anonymous namespace
-
 extern "C" {
 
 BRIDGE_API int __stdcall PLACE_ORDER_W(
@@ -38,15 +23,19 @@ BRIDGE_API int __stdcall PLACE_ORDER_W(
     const wchar_t* timeInForce)
 {
     try {
+        BRIDGE_LATENCY_SCOPE();
         Bridge::OrderRequest req;
         int rc = Bridge::BuildRequest(command, account, instrument, action,
                                       quantity, orderType, limitPrice, stopPrice,
                                       timeInForce, req);
-        if (rc != Bridge::RC_SUCCESS) return rc;
-        return Bridge::GetEngine().Execute(req);
+        BRIDGE_LATENCY_MARK(Validate);
+        if (rc != Bridge::RC_SUCCESS) { Bridge::CountRequest(req.command, rc); return rc; }
+        Bridge::BridgeEngine& engine = Bridge::GetEngine();
+        BRIDGE_LATENCY_MARK(GetEngine);
+        return engine.Execute(req);
     }
     catch (...) {
-        Bridge::LogError("Unhandled exception in PLACE_ORDER_W");
+        BRIDGE_LOG_ERROR("Unhandled exception in PLACE_ORDER_W");
         return Bridge::RC_INTERNAL_ERR;
     }
 }
@@ -63,15 +52,19 @@ BRIDGE_API int __stdcall PLACE_ORDER_A(
     const char* timeInForce)
 {
     try {
+        BRIDGE_LATENCY_SCOPE();
         Bridge::OrderRequest req;
         int rc = Bridge::BuildRequest(command, account, instrument, action,
                                       quantity, orderType, limitPrice, stopPrice,
                                       timeInForce, req);
-        if (rc != Bridge::RC_SUCCESS) return rc;
-        return Bridge::GetEngine().Execute(req);
+        BRIDGE_LATENCY_MARK(Validate);
+        if (rc != Bridge::RC_SUCCESS) { Bridge::CountRequest(req.command, rc); return rc; }
+        Bridge::BridgeEngine& engine = Bridge::GetEngine();
+        BRIDGE_LATENCY_MARK(GetEngine);
+        return engine.Execute(req);
     }
     catch (...) {
-        Bridge::LogError("Unhandled exception in PLACE_ORDER_A");
+        BRIDGE_LOG_ERROR("Unhandled exception in PLACE_ORDER_A");
         return Bridge::RC_INTERNAL_ERR;
     }
 }
@@ -79,14 +72,19 @@ BRIDGE_API int __stdcall PLACE_ORDER_A(
 BRIDGE_API int __stdcall PLACE_ORDER_CMD_W(const wchar_t* payload)
 {
     try {
-        std::string narrow = WideToUtf8(payload);
+        BRIDGE_LATENCY_SCOPE();
+        Bridge::NarrowArg<1024> narrow(payload);
+        BRIDGE_LATENCY_MARK(Convert);
         Bridge::OrderRequest req;
-        int rc = Bridge::ParsePayload(narrow, req);
-        if (rc != Bridge::RC_SUCCESS) return rc;
-        return Bridge::GetEngine().Execute(req);
+        int rc = Bridge::ParsePayload(narrow.view(), req);
+        BRIDGE_LATENCY_MARK(Validate);
+        if (rc != Bridge::RC_SUCCESS) { Bridge::CountRequest(req.command, rc); return rc; }
+        Bridge::BridgeEngine& engine = Bridge::GetEngine();
+        BRIDGE_LATENCY_MARK(GetEngine);
+        return engine.Execute(req);
     }
     catch (...) {
-        Bridge::LogError("Unhandled exception in PLACE_ORDER_CMD_W");
+        BRIDGE_LOG_ERROR("Unhandled exception in PLACE_ORDER_CMD_W");
         return Bridge::RC_INTERNAL_ERR;
     }
 }
@@ -94,15 +92,107 @@ BRIDGE_API int __stdcall PLACE_ORDER_CMD_W(const wchar_t* payload)
 BRIDGE_API int __stdcall PLACE_ORDER_CMD_A(const char* payload)
 {
     try {
+        BRIDGE_LATENCY_SCOPE();
         Bridge::OrderRequest req;
         int rc = Bridge::ParsePayload(payload ? payload : "", req);
-        if (rc != Bridge::RC_SUCCESS) return rc;
-        return Bridge::GetEngine().Execute(req);
+        BRIDGE_LATENCY_MARK(Validate);
+        if (rc != Bridge::RC_SUCCESS) { Bridge::CountRequest(req.command, rc); return rc; }
+        Bridge::BridgeEngine& engine = Bridge::GetEngine();
+        BRIDGE_LATENCY_MARK(GetEngine);
+        return engine.Execute(req);
+    }
+    catch (...) {
+        BRIDGE_LOG_ERROR("Unhandled exception in PLACE_ORDER_CMD_A");
+        return Bridge::RC_INTERNAL_ERR;
+    }
+}
+
+BRIDGE_API int __stdcall PLACE_ORDER_BATCH_W(const wchar_t* payloads, int* results, int capacity)
+{
+    try {
+        BRIDGE_LATENCY_SCOPE();
+        BRIDGE_LATENCY_COMMAND(Bridge::kLatencyBatch);
+        if (!payloads) return Bridge::RC_INVALID_PARAM;
+        Bridge::NarrowArg<4096> narrow(payloads);
+        BRIDGE_LATENCY_MARK(Convert);
+        Bridge::BridgeEngine& engine = Bridge::GetEngine();
+        BRIDGE_LATENCY_MARK(GetEngine);
+        return engine.ExecuteBatch(narrow.view(), results, capacity);
     }
     catch (...) {
-        Bridge::LogError("Unhandled exception in PLACE_ORDER_CMD_A");
+        BRIDGE_LOG_ERROR("Unhandled exception in PLACE_ORDER_BATCH_W");
         return Bridge::RC_INTERNAL_ERR;
     }
 }
 
+BRIDGE_API int __stdcall PLACE_ORDER_BATCH_A(const char* payloads, int* results, int capacity)
+{
+    try {
+        BRIDGE_LATENCY_SCOPE();
+        BRIDGE_LATENCY_COMMAND(Bridge::kLatencyBatch);
+        if (!payloads) return Bridge::RC_INVALID_PARAM;
+        Bridge::BridgeEngine& engine = Bridge::GetEngine();
+        BRIDGE_LATENCY_MARK(GetEngine);
+        return engine.ExecuteBatch(payloads, results, capacity);
+    }
+    catch (...) {
+        BRIDGE_LOG_ERROR("Unhandled exception in PLACE_ORDER_BATCH_A");
+        return Bridge::RC_INTERNAL_ERR;
+    }
+}
+
+BRIDGE_API int __stdcall PLACE_ORDER_ASYNC_CMD_W(const wchar_t* payload)
+{
+    try {
+        BRIDGE_LATENCY_SCOPE();
+        Bridge::NarrowArg<1024> narrow(payload);
+        BRIDGE_LATENCY_MARK(Convert);
+        Bridge::OrderRequest req;
+        int rc = Bridge::ParsePayload(narrow.view(), req);
+        BRIDGE_LATENCY_MARK(Validate);
+        if (rc != Bridge::RC_SUCCESS) { Bridge::CountRequest(req.command, rc); return rc; }
+        Bridge::BridgeEngine& engine = Bridge::GetEngine();
+        BRIDGE_LATENCY_MARK(GetEngine);
+        return engine.ExecuteAsync(req);
+    }
+    catch (...) {
+        BRIDGE_LOG_ERROR("Unhandled exception in PLACE_ORDER_ASYNC_CMD_W");
+        return Bridge::RC_INTERNAL_ERR;
+    }
+}
+
+BRIDGE_API int __stdcall PLACE_ORDER_ASYNC_CMD_A(const char* payload)
+{
+    try {
+        BRIDGE_LATENCY_SCOPE();
+        Bridge::OrderRequest req;
+        int rc = Bridge::ParsePayload(payload ? payload : "", req);
+        BRIDGE_LATENCY_MARK(Validate);
+        if (rc != Bridge::RC_SUCCESS) { Bridge::CountRequest(req.command, rc); return rc; }
+        Bridge::BridgeEngine& engine = Bridge::GetEngine();
+        BRIDGE_LATENCY_MARK(GetEngine);
+        return engine.ExecuteAsync(req);
+    }
+    catch (...) {
+        BRIDGE_LOG_ERROR("Unhandled exception in PLACE_ORDER_ASYNC_CMD_A");
+        return Bridge::RC_INTERNAL_ERR;
+    }
+}
+
+BRIDGE_API int __stdcall POLL_RESULT(int ticket)
+{
+    return Bridge::GetEngine().PollResult(ticket);
+}
+
+BRIDGE_API int __stdcall GET_STATS(char* buffer, int capacity)
+{
+    return Bridge::LatencyReport(buffer, capacity);
+}
+
+BRIDGE_API int __stdcall BRIDGE_SHUTDOWN()
+{
+    Bridge::ShutdownEngine();
+    return Bridge::RC_SUCCESS;
+}
+
 } // extern "C"
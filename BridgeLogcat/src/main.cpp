@@ -0,0 +1,86 @@
+// BridgeLogcat: decode a binary log (logFormat "BINARY", see BinaryLog.h)
+// into the same text lines the text logger writes.
+//
+// Usage: BridgeLogcat <log.blog> [options]
+//   --level <LEVEL>   only lines at or above DEBUG, INFO, WARN or ERROR
+//   --micros          print timestamps with microseconds
+#include "../../BridgeCore/include/BinaryLog.h"
+#include "../../BridgeCore/include/Logger.h"
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <string>
+
+using namespace Bridge;
+
+struct Options {
+    std::string path;
+    LogLevel    minLevel = LogLevel::DEBUG_;
+    bool        micros   = false;
+};
+
+static void Usage() {
+    std::fprintf(stderr, "usage: BridgeLogcat <log.blog> [--level DEBUG|INFO|WARN|ERROR] [--micros]\n");
+}
+
+static bool ParseLevel(const std::string& s, LogLevel& out) {
+    if      (s == "DEBUG") out = LogLevel::DEBUG_;
+    else if (s == "INFO")  out = LogLevel::INFO;
+    else if (s == "WARN")  out = LogLevel::WARNING_;
+    else if (s == "ERROR") out = LogLevel::ERROR_;
+    else return false;
+    return true;
+}
+
+static bool ParseArgs(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if (a == "--level" && i + 1 < argc) {
+            if (!ParseLevel(argv[++i], opt.minLevel)) return false;
+        }
+        else if (a == "--micros") opt.micros = true;
+        else if (!a.empty() && a[0] != '-' && opt.path.empty()) opt.path = a;
+        else return false;
+    }
+    return !opt.path.empty();
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!ParseArgs(argc, argv, opt)) {
+        Usage();
+        return 1;
+    }
+
+    BinaryLogReader reader;
+    if (!reader.Open(opt.path)) {
+        std::fprintf(stderr, "cannot open binary log %s\n", opt.path.c_str());
+        return 1;
+    }
+
+    BinaryLogLine line;
+    int64_t       stampSec = INT64_MIN;
+    char          stamp[32] = {};
+    while (reader.Next(line)) {
+        if (line.level < opt.minLevel) continue;
+        int64_t sec = line.wallNs / 1000000000;
+        if (sec != stampSec) {
+            std::time_t t = static_cast<std::time_t>(sec);
+            struct tm tm_info;
+#ifdef _WIN32
+            localtime_s(&tm_info, &t);
+#else
+            localtime_r(&t, &tm_info);
+#endif
+            std::strftime(stamp, sizeof(stamp), "%Y-%m-%d %H:%M:%S", &tm_info);
+            stampSec = sec;
+        }
+        if (opt.micros)
+            std::printf("[%s.%06lld] [%s] %s\n", stamp,
+                        static_cast<long long>(line.wallNs % 1000000000 / 1000),
+                        LogLevelName(line.level), line.text.c_str());
+        else
+            std::printf("[%s] [%s] %s\n", stamp, LogLevelName(line.level), line.text.c_str());
+    }
+    return 0;
+}
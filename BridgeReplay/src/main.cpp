@@ -0,0 +1,230 @@
+// BridgeReplay: push a request journal (see RequestJournal.h) back through an
+// adapter and report throughput, latency percentiles and how the return
+// codes compare with the ones recorded.
+//
+// Usage: BridgeReplay <journal> [options]
+//   --config <path>     bridge.json to build the adapter from (default: MOCK)
+//   --adapter <TYPE>    override adapterType ("MOCK", "SIM", ...)
+//   --pace max|recorded replay as fast as possible (default) or with the
+//                       recorded gaps between requests
+//   --speed <x>         with --pace recorded, play back x times faster
+//   --via-payload       render each request as a pipe payload and parse it
+//                       again, so parser changes are measured too
+//   --repeat <n>        replay the journal n times (default 1)
+//   --strict            exit with 2 if any return code differs
+#include "../../BridgeCore/include/AdapterFactory.h"
+#include "../../BridgeCore/include/Config.h"
+#include "../../BridgeCore/include/Keywords.h"
+#include "../../BridgeCore/include/Numeric.h"
+#include "../../BridgeCore/include/Parser.h"
+#include "../../BridgeCore/include/RequestJournal.h"
+#include "../../BridgeCore/include/Types.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace Bridge;
+
+struct Options {
+    std::string journal;
+    std::string configPath;
+    std::string adapter;
+    bool        recordedPace = false;
+    double      speed        = 1.0;
+    bool        viaPayload   = false;
+    int         repeat       = 1;
+    bool        strict       = false;
+};
+
+static void Usage() {
+    std::fprintf(stderr,
+        "usage: BridgeReplay <journal> [--config path] [--adapter TYPE] [--pace max|recorded]\n"
+        "                    [--speed x] [--via-payload] [--repeat n] [--strict]\n");
+}
+
+static bool ParseArgs(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        bool        hasValue = (i + 1 < argc);
+        if (a == "--config" && hasValue)       opt.configPath = argv[++i];
+        else if (a == "--adapter" && hasValue) opt.adapter = argv[++i];
+        else if (a == "--pace" && hasValue) {
+            std::string p = argv[++i];
+            if (p != "max" && p != "recorded") return false;
+            opt.recordedPace = (p == "recorded");
+        }
+        else if (a == "--speed" && hasValue) {
+            if (ParseDouble(argv[++i], opt.speed) != std::errc{} || opt.speed <= 0.0) return false;
+        }
+        else if (a == "--repeat" && hasValue) {
+            if (ParseInt(argv[++i], opt.repeat) != std::errc{} || opt.repeat < 1) return false;
+        }
+        else if (a == "--via-payload") opt.viaPayload = true;
+        else if (a == "--strict")      opt.strict = true;
+        else if (!a.empty() && a[0] != '-' && opt.journal.empty()) opt.journal = a;
+        else return false;
+    }
+    return !opt.journal.empty();
+}
+
+static std::string_view Spelling(KeywordKind kind, uint8_t value) noexcept {
+    for (const Keyword& k : Keywords::kAll)
+        if (k.kind == kind && k.value == value) return k.text;
+    return {};
+}
+
+static void AppendField(std::string& out, std::string_view key, std::string_view value) {
+    if (value.empty()) return;
+    if (!out.empty()) out += '|';
+    out.append(key).append("=").append(value);
+}
+
+static void AppendPrice(std::string& out, std::string_view key, const FixedPrice& px, double value) {
+    char   buf[48];
+    size_t n = FormatPrice(px, buf, sizeof(buf));
+    if (n == 0) n = static_cast<size_t>(std::snprintf(buf, sizeof(buf), "%.10g", value));
+    AppendField(out, key, std::string_view(buf, n));
+}
+
+// The payload TradeStation would have sent for 'r'. BARKEY is only kept as
+// a hash, so it is restored after parsing instead.
+static std::string RenderPayload(const OrderRequest& r) {
+    std::string p;
+    AppendField(p, "command",     Spelling(KeywordKind::Command, static_cast<uint8_t>(r.command)));
+    AppendField(p, "account",     r.account);
+    AppendField(p, "instrument",  r.instrument);
+    AppendField(p, "action",      Spelling(KeywordKind::Action, static_cast<uint8_t>(r.action)));
+    AppendField(p, "quantity",    std::to_string(r.quantity));
+    AppendField(p, "orderType",   Spelling(KeywordKind::OrderType, static_cast<uint8_t>(r.orderType)));
+    AppendPrice(p, "limitPrice",  r.limitPx, r.limitPrice);
+    AppendPrice(p, "stopPrice",   r.stopPx, r.stopPrice);
+    AppendField(p, "timeInForce", Spelling(KeywordKind::TimeInForce, static_cast<uint8_t>(r.timeInForce)));
+    return p;
+}
+
+static double Percentile(const std::vector<int64_t>& sorted, double q) {
+    if (sorted.empty()) return 0.0;
+    size_t i = static_cast<size_t>(q * static_cast<double>(sorted.size() - 1) + 0.5);
+    return static_cast<double>(sorted[i]) / 1000.0;
+}
+
+static void PrintLatency(const char* label, std::vector<int64_t>& ns) {
+    std::sort(ns.begin(), ns.end());
+    std::printf("  %-10s %10.2f %10.2f %10.2f %10.2f %10.2f\n", label,
+                Percentile(ns, 0.50), Percentile(ns, 0.90), Percentile(ns, 0.99),
+                Percentile(ns, 0.999), ns.empty() ? 0.0 : static_cast<double>(ns.back()) / 1000.0);
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!ParseArgs(argc, argv, opt)) {
+        Usage();
+        return 1;
+    }
+
+    JournalReader reader;
+    if (!reader.Open(opt.journal)) {
+        std::fprintf(stderr, "cannot open journal %s\n", opt.journal.c_str());
+        return 1;
+    }
+    std::vector<JournalEntry> entries;
+    JournalEntry              e;
+    while (reader.Next(e)) entries.push_back(e);
+    if (entries.empty()) {
+        std::fprintf(stderr, "journal %s has no records\n", opt.journal.c_str());
+        return 1;
+    }
+
+    BridgeConfig cfg = DefaultConfig();
+    if (!opt.configPath.empty() && LoadConfig(opt.configPath, cfg) != RC_SUCCESS) {
+        std::fprintf(stderr, "cannot load config %s\n", opt.configPath.c_str());
+        return 1;
+    }
+    if (!opt.adapter.empty()) cfg.adapterType = opt.adapter;
+    std::transform(cfg.adapterType.begin(), cfg.adapterType.end(), cfg.adapterType.begin(),
+        [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+    std::shared_ptr<IBrokerAdapter> adapter = CreateAdapter(cfg);
+
+    // Render up front so only parsing is timed.
+    std::vector<std::string> payloads;
+    if (opt.viaPayload) {
+        payloads.reserve(entries.size());
+        for (const JournalEntry& j : entries) payloads.push_back(RenderPayload(j.req));
+    }
+
+    const size_t         total = entries.size() * static_cast<size_t>(opt.repeat);
+    std::vector<int64_t> latency;
+    latency.reserve(total);
+    std::map<std::pair<int, int>, uint64_t> differ;   // (recorded, replayed) -> count
+    uint64_t     matched = 0;
+    OrderRequest parsed;
+
+    using Clock = std::chrono::steady_clock;
+    // Records are in completion order, so async requests can be slightly
+    // out of timestamp order; those are simply sent without waiting.
+    const int64_t firstNs = entries.front().timeNs;
+    int64_t       lastNs  = firstNs;
+    for (const JournalEntry& j : entries) lastNs = std::max(lastNs, j.timeNs);
+    const int64_t spanNs  = lastNs - firstNs;
+    Clock::time_point start = Clock::now();
+    for (int pass = 0; pass < opt.repeat; ++pass) {
+        Clock::time_point passStart = Clock::now();
+        for (size_t i = 0; i < entries.size(); ++i) {
+            const JournalEntry& j = entries[i];
+            if (opt.recordedPace) {
+                auto offset = std::chrono::nanoseconds(
+                    static_cast<int64_t>(static_cast<double>(j.timeNs - firstNs) / opt.speed));
+                std::this_thread::sleep_until(passStart + offset);
+            }
+            Clock::time_point t0 = Clock::now();
+            int rc;
+            if (opt.viaPayload) {
+                parsed = OrderRequest{};
+                rc = ParsePayload(payloads[i], parsed);
+                if (rc == RC_SUCCESS) {
+                    parsed.barKey = j.req.barKey;
+                    rc = adapter->Execute(parsed);
+                }
+            } else {
+                rc = adapter->Execute(j.req);
+            }
+            latency.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t0).count());
+            if (rc == j.rc) ++matched;
+            else            ++differ[{ j.rc, rc }];
+        }
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::vector<int64_t> recorded;
+    recorded.reserve(entries.size());
+    for (const JournalEntry& j : entries) recorded.push_back(j.durationNs);
+
+    std::printf("journal    %s: %zu record(s) spanning %.3f s\n", opt.journal.c_str(), entries.size(),
+                static_cast<double>(spanNs) / 1e9);
+    std::printf("adapter    %s, pace %s", cfg.adapterType.c_str(), opt.recordedPace ? "recorded" : "max");
+    if (opt.recordedPace) std::printf(" x%.2f", opt.speed);
+    std::printf(", %s\n", opt.viaPayload ? "via payload parser" : "direct");
+    std::printf("replayed   %zu request(s) in %.3f s = %.0f req/s\n", total, seconds,
+                seconds > 0.0 ? static_cast<double>(total) / seconds : 0.0);
+    std::printf("latency us %10s %10s %10s %10s %10s\n", "p50", "p90", "p99", "p99.9", "max");
+    PrintLatency("replay", latency);
+    PrintLatency("recorded", recorded);
+    std::printf("return codes: %llu match", static_cast<unsigned long long>(matched));
+    uint64_t differing = total - matched;
+    std::printf(", %llu differ\n", static_cast<unsigned long long>(differing));
+    for (const auto& [codes, count] : differ)
+        std::printf("  recorded %d -> replayed %d: %llu\n", codes.first, codes.second,
+                    static_cast<unsigned long long>(count));
+
+    return (opt.strict && differing > 0) ? 2 : 0;
+}
@@ -9,11 +9,16 @@
 #include "BridgeTS.h"
 
 #include "BridgeEngine.h"
+#include "LatencyStats.h"
 #include "Parser.h"
+#include "SharedStats.h"
 #include "Logger.h"
+#include "LogEvent.h"
 #include "Types.h"
+#include "WideText.h"
 
 #include <string>
+#include <string_view>
 #include <atomic>
 
 // ---------------------------------------------------------------------------
@@ -24,56 +29,169 @@ namespace {
 static std::atomic<unsigned int> g_reqCounter{ 0 }; 
 
 // SEH wrapper — must be in its own function with NO C++ objects that need
-// unwinding (std::string etc.) to avoid MSVC error C2712.
-static int SEH_WideCharToMultiByte(UINT cp, DWORD flags, const wchar_t* w,
-                                    int cchW, char* buf, int cbBuf)
+// unwinding (std::string etc.) to avoid MSVC error C2712. NarrowWide reads
+// the caller's string directly, so a bad pointer from EasyLanguage is caught
+// here rather than crashing TradeStation.
+static size_t SEH_NarrowWide(const wchar_t* w, char* buf, size_t cap, bool* faulted)
 {
     __try {
-        return WideCharToMultiByte(cp, flags, w, cchW, buf, cbBuf, nullptr, nullptr);
+        return Bridge::NarrowWide(w, buf, cap);
     }
     __except (EXCEPTION_EXECUTE_HANDLER) {
+        *faulted = true;
         return 0;
     }
 }
 
-static std::string WideToUtf8(const wchar_t* w)
+// Narrow a wide payload into 'stackBuf' (ASCII fast path), spilling to
+// 'heap' only when it does not fit. Returns an empty view on a bad pointer.
+template <size_t N>
+static std::string_view NarrowPayload(const wchar_t* w, char (&stackBuf)[N], std::string& heap)
 {
-    if (!w) return {};
-    int len = SEH_WideCharToMultiByte(CP_UTF8, 0, w, -1, nullptr, 0);
-    if (len <= 0) return {};
-    std::string s(static_cast<size_t>(len - 1), '\0');
-    SEH_WideCharToMultiByte(CP_UTF8, 0, w, -1, s.data(), len);
-    return s;
+    bool faulted = false;
+    size_t len = SEH_NarrowWide(w, stackBuf, N, &faulted);
+    if (faulted) return {};
+    if (len < N) return std::string_view(stackBuf, len);
+
+    heap.resize(len + 1);
+    len = SEH_NarrowWide(w, heap.data(), heap.size(), &faulted);
+    if (faulted || len >= heap.size()) return {};
+    heap.resize(len);
+    return heap;
 }
 
-// Format a request tag such as "[REQ-0001]"
-static std::string ReqTag(unsigned int id)
+// Log lines, tagged with the request id as "[REQ-0001]". Arguments are
+// packed on the calling thread and formatted by the log writer.
+constexpr Bridge::LogFormat kLogSehAsync    ("[REQ-{:04}] SEH exception in DispatchAsync");
+constexpr Bridge::LogFormat kLogAsyncReject ("[REQ-{:04}] ExecuteAsync rejected rc={}");
+constexpr Bridge::LogFormat kLogAsyncQueued ("[REQ-{:04}] queued as ticket {}");
+constexpr Bridge::LogFormat kLogSehIn       ("[REQ-{:04}] SEH exception in {}");
+constexpr Bridge::LogFormat kLogBatchReject ("[REQ-{:04}] {} rejected batch rc={} capacity={}");
+constexpr Bridge::LogFormat kLogBatchDone   ("[REQ-{:04}] {} submitted {} payload(s)");
+constexpr Bridge::LogFormat kLogSehRequest  ("[REQ-{:04}] SEH exception in DispatchRequest");
+constexpr Bridge::LogFormat kLogExecuted    ("[REQ-{:04}] Execute returned rc={}");
+constexpr Bridge::LogFormat kLogNullCommand ("[REQ-{:04}] PLACE_ORDER called with null command");
+constexpr Bridge::LogFormat kLogPlaceOrder  ("[REQ-{:04}] PLACE_ORDER called command={} account={} instrument={}"
+                                             " action={} quantity={} orderType={} limitPrice={} stopPrice={} tif={}");
+constexpr Bridge::LogFormat kLogInvalid     ("[REQ-{:04}] Validation failed rc={}");
+constexpr Bridge::LogFormat kLogValid       ("[REQ-{:04}] Validation: OK");
+constexpr Bridge::LogFormat kLogFnInvalid   ("[REQ-{:04}] {} validation failed rc={}");
+constexpr Bridge::LogFormat kLogFnValid     ("[REQ-{:04}] {} Validation: OK");
+constexpr Bridge::LogFormat kLogFnUnparsed  ("[REQ-{:04}] {} parse/validation failed rc={}");
+constexpr Bridge::LogFormat kLogFnNull      ("[REQ-{:04}] {} called with null payloads");
+
+// SEH-guarded engine execute — no C++ objects in this function. *faulted
+// tells a structured exception apart from an RC_INTERNAL_ERR the engine
+// returned (and logged) itself.
+static int SEH_Execute(Bridge::BridgeEngine& engine, const Bridge::OrderRequest& req, bool* faulted)
 {
-    char buf[32];
-    snprintf(buf, sizeof(buf), "[REQ-%04u]", id);
-    return buf;
+    __try {
+        return engine.Execute(req);
+    }
+    __except (EXCEPTION_EXECUTE_HANDLER) {
+        *faulted = true;
+        return Bridge::RC_INTERNAL_ERR;
+    }
 }
 
-// SEH-guarded engine execute — no C++ objects in this function.
-static int SEH_Execute(Bridge::BridgeEngine& engine, const Bridge::OrderRequest& req)
+// SEH-guarded batch execute. Also guards the writes into the caller's
+// results buffer.
+static int SEH_ExecuteBatch(Bridge::BridgeEngine& engine, std::string_view payloads,
+                            int* results, int capacity, bool* faulted)
 {
     __try {
-        return engine.Execute(req);
+        return engine.ExecuteBatch(payloads, results, capacity);
+    }
+    __except (EXCEPTION_EXECUTE_HANDLER) {
+        *faulted = true;
+        return Bridge::RC_INTERNAL_ERR;
+    }
+}
+
+// SEH-guarded async submit — no C++ objects in this function.
+static int SEH_ExecuteAsync(Bridge::BridgeEngine& engine, const Bridge::OrderRequest& req, bool* faulted)
+{
+    __try {
+        return engine.ExecuteAsync(req);
     }
     __except (EXCEPTION_EXECUTE_HANDLER) {
+        *faulted = true;
         return Bridge::RC_INTERNAL_ERR;
     }
 }
 
+// SEH-guarded stats report — also guards the writes into the caller's buffer.
+static int SEH_LatencyReport(char* buffer, int capacity)
+{
+    __try {
+        return Bridge::LatencyReport(buffer, capacity);
+    }
+    __except (EXCEPTION_EXECUTE_HANDLER) {
+        return Bridge::RC_INTERNAL_ERR;
+    }
+}
+
+// SEH-guarded ticket poll. Not logged, like POLL_RESULT itself.
+static int SEH_PollResult(const Bridge::BridgeEngine& engine, int ticket)
+{
+    __try {
+        return engine.PollResult(ticket);
+    }
+    __except (EXCEPTION_EXECUTE_HANDLER) {
+        return Bridge::RC_INTERNAL_ERR;
+    }
+}
+
+// Async dispatch — returns the ticket, or a negative code.
+static int DispatchAsync(const Bridge::OrderRequest& req, unsigned int id)
+{
+    Bridge::BridgeEngine& engine = Bridge::GetEngine();
+    BRIDGE_LATENCY_MARK(GetEngine);
+    bool faulted = false;
+    int ticket = SEH_ExecuteAsync(engine, req, &faulted);
+    if (faulted) {
+        BRIDGE_EVENT_ERROR(kLogSehAsync, id);
+    } else if (ticket < 0) {
+        BRIDGE_EVENT_WARN(kLogAsyncReject, id, ticket);
+    } else {
+        BRIDGE_EVENT_DEBUG(kLogAsyncQueued, id, ticket);
+    }
+    BRIDGE_LATENCY_MARK(Log);
+    return ticket;
+}
+
+// Batch dispatch — one log line for the whole batch.
+static int DispatchBatch(std::string_view payloads, int* results, int capacity,
+                         unsigned int id, const char* fn)
+{
+    Bridge::BridgeEngine& engine = Bridge::GetEngine();
+    BRIDGE_LATENCY_MARK(GetEngine);
+    bool faulted = false;
+    int n = SEH_ExecuteBatch(engine, payloads, results, capacity, &faulted);
+    if (faulted) {
+        BRIDGE_EVENT_ERROR(kLogSehIn, id, fn);
+    } else if (n < 0) {
+        BRIDGE_EVENT_WARN(kLogBatchReject, id, fn, n, capacity);
+    } else {
+        BRIDGE_EVENT_INFO(kLogBatchDone, id, fn, n);
+    }
+    BRIDGE_LATENCY_MARK(Log);
+    return n;
+}
+
 // Core dispatch — all public entry points converge here after building req.
-static int DispatchRequest(const Bridge::OrderRequest& req, const std::string& tag)
+static int DispatchRequest(const Bridge::OrderRequest& req, unsigned int id)
 {
-    int rc = SEH_Execute(Bridge::GetEngine(), req);
-    if (rc == Bridge::RC_INTERNAL_ERR) {
-        Bridge::LogError(tag + " SEH exception in DispatchRequest");
+    Bridge::BridgeEngine& engine = Bridge::GetEngine();
+    BRIDGE_LATENCY_MARK(GetEngine);
+    bool faulted = false;
+    int rc = SEH_Execute(engine, req, &faulted);
+    if (faulted) {
+        BRIDGE_EVENT_ERROR(kLogSehRequest, id);
     } else {
-        Bridge::LogDebug(tag + " Execute returned rc=" + std::to_string(rc));
+        BRIDGE_EVENT_DEBUG(kLogExecuted, id, rc);
     }
+    BRIDGE_LATENCY_MARK(Log);
     return rc;
 }
 
@@ -111,36 +229,32 @@ BRIDGETS_API int __stdcall PLACE_ORDER(
     double      stopPrice,
     const char* timeInForce)
 {
+    BRIDGE_LATENCY_SCOPE();
     unsigned int id = ++g_reqCounter;
-    std::string tag = ReqTag(id);
 
     // Guard against null command — return RC_INVALID_PARAM per spec.
     if (!command) {
-        Bridge::LogWarning(tag + " PLACE_ORDER called with null command");
+        BRIDGE_EVENT_WARN(kLogNullCommand, id);
         return Bridge::RC_INVALID_PARAM;
     }
 
-    Bridge::LogInfo(tag + " PLACE_ORDER called"
-        " command=" + std::string(command ? command : "<null>") +
-        " account=" + std::string(account ? account : "<null>") +
-        " instrument=" + std::string(instrument ? instrument : "<null>") +
-        " action=" + std::string(action ? action : "<null>") +
-        " quantity=" + std::to_string(quantity) +
-        " orderType=" + std::string(orderType ? orderType : "<null>") +
-        " limitPrice=" + std::to_string(limitPrice) +
-        " stopPrice=" + std::to_string(stopPrice) +
-        " tif=" + std::string(timeInForce ? timeInForce : "<null>"));
+    BRIDGE_EVENT_INFO(kLogPlaceOrder, id, command, account, instrument,
+                      action, quantity, orderType, limitPrice, stopPrice, timeInForce);
+    BRIDGE_LATENCY_MARK(Log);
 
     Bridge::OrderRequest req;
     int rc = Bridge::BuildRequest(command, account, instrument, action,
                                   quantity, orderType, limitPrice, stopPrice,
                                   timeInForce, req);
+    BRIDGE_LATENCY_MARK(Validate);
     if (rc != Bridge::RC_SUCCESS) {
-        Bridge::LogWarning(tag + " Validation failed rc=" + std::to_string(rc));
+        Bridge::CountRequest(req.command, rc);
+        BRIDGE_EVENT_WARN(kLogInvalid, id, rc);
         return rc;
     }
-    Bridge::LogInfo(tag + " Validation: OK");
-    return DispatchRequest(req, tag);
+    BRIDGE_EVENT_INFO(kLogValid, id);
+    BRIDGE_LATENCY_MARK(Log);
+    return DispatchRequest(req, id);
 }
 
 // Unicode variant.
@@ -155,19 +269,22 @@ BRIDGETS_API int __stdcall PLACE_ORDER_W(
     double         stopPrice,
     const wchar_t* timeInForce)
 {
+    BRIDGE_LATENCY_SCOPE();
     unsigned int id = ++g_reqCounter;
-    std::string tag = ReqTag(id);
 
     Bridge::OrderRequest req;
     int rc = Bridge::BuildRequest(command, account, instrument, action,
                                   quantity, orderType, limitPrice, stopPrice,
                                   timeInForce, req);
+    BRIDGE_LATENCY_MARK(Validate);
     if (rc != Bridge::RC_SUCCESS) {
-        Bridge::LogWarning(tag + " PLACE_ORDER_W validation failed rc=" + std::to_string(rc));
+        Bridge::CountRequest(req.command, rc);
+        BRIDGE_EVENT_WARN(kLogFnInvalid, id, "PLACE_ORDER_W", rc);
         return rc;
     }
-    Bridge::LogInfo(tag + " PLACE_ORDER_W Validation: OK");
-    return DispatchRequest(req, tag);
+    BRIDGE_EVENT_INFO(kLogFnValid, id, "PLACE_ORDER_W");
+    BRIDGE_LATENCY_MARK(Log);
+    return DispatchRequest(req, id);
 }
 
 // ANSI named alias — identical to PLACE_ORDER.
@@ -189,34 +306,132 @@ BRIDGETS_API int __stdcall PLACE_ORDER_A(
 // Pipe-delimited Unicode payload.
 BRIDGETS_API int __stdcall PLACE_ORDER_CMD_W(const wchar_t* payload)
 {
+    BRIDGE_LATENCY_SCOPE();
     unsigned int id = ++g_reqCounter;
-    std::string tag = ReqTag(id);
 
-    std::string narrow = WideToUtf8(payload);
+    char stackBuf[1024];
+    std::string heap;
+    std::string_view narrow = NarrowPayload(payload, stackBuf, heap);
+    BRIDGE_LATENCY_MARK(Convert);
     Bridge::OrderRequest req;
     int rc = Bridge::ParsePayload(narrow, req);
+    BRIDGE_LATENCY_MARK(Validate);
     if (rc != Bridge::RC_SUCCESS) {
-        Bridge::LogWarning(tag + " PLACE_ORDER_CMD_W parse/validation failed rc=" + std::to_string(rc));
+        Bridge::CountRequest(req.command, rc);
+        BRIDGE_EVENT_WARN(kLogFnUnparsed, id, "PLACE_ORDER_CMD_W", rc);
         return rc;
     }
-    Bridge::LogInfo(tag + " PLACE_ORDER_CMD_W Validation: OK");
-    return DispatchRequest(req, tag);
+    BRIDGE_EVENT_INFO(kLogFnValid, id, "PLACE_ORDER_CMD_W");
+    BRIDGE_LATENCY_MARK(Log);
+    return DispatchRequest(req, id);
 }
 
 // Pipe-delimited ANSI payload.
 BRIDGETS_API int __stdcall PLACE_ORDER_CMD_A(const char* payload)
 {
+    BRIDGE_LATENCY_SCOPE();
     unsigned int id = ++g_reqCounter;
-    std::string tag = ReqTag(id);
 
     Bridge::OrderRequest req;
     int rc = Bridge::ParsePayload(payload ? payload : "", req);
+    BRIDGE_LATENCY_MARK(Validate);
     if (rc != Bridge::RC_SUCCESS) {
-        Bridge::LogWarning(tag + " PLACE_ORDER_CMD_A parse/validation failed rc=" + std::to_string(rc));
+        Bridge::CountRequest(req.command, rc);
+        BRIDGE_EVENT_WARN(kLogFnUnparsed, id, "PLACE_ORDER_CMD_A", rc);
         return rc;
     }
-    Bridge::LogInfo(tag + " PLACE_ORDER_CMD_A Validation: OK");
-    return DispatchRequest(req, tag);
+    BRIDGE_EVENT_INFO(kLogFnValid, id, "PLACE_ORDER_CMD_A");
+    BRIDGE_LATENCY_MARK(Log);
+    return DispatchRequest(req, id);
+}
+
+// Newline-separated Unicode payloads.
+BRIDGETS_API int __stdcall PLACE_ORDER_BATCH_W(const wchar_t* payloads, int* results, int capacity)
+{
+    BRIDGE_LATENCY_SCOPE();
+    BRIDGE_LATENCY_COMMAND(Bridge::kLatencyBatch);
+    unsigned int id = ++g_reqCounter;
+
+    if (!payloads) {
+        BRIDGE_EVENT_WARN(kLogFnNull, id, "PLACE_ORDER_BATCH_W");
+        return Bridge::RC_INVALID_PARAM;
+    }
+    char stackBuf[4096];
+    std::string heap;
+    std::string_view narrow = NarrowPayload(payloads, stackBuf, heap);
+    BRIDGE_LATENCY_MARK(Convert);
+    return DispatchBatch(narrow, results, capacity, id, "PLACE_ORDER_BATCH_W");
+}
+
+// Newline-separated ANSI payloads.
+BRIDGETS_API int __stdcall PLACE_ORDER_BATCH_A(const char* payloads, int* results, int capacity)
+{
+    BRIDGE_LATENCY_SCOPE();
+    BRIDGE_LATENCY_COMMAND(Bridge::kLatencyBatch);
+    unsigned int id = ++g_reqCounter;
+
+    if (!payloads) {
+        BRIDGE_EVENT_WARN(kLogFnNull, id, "PLACE_ORDER_BATCH_A");
+        return Bridge::RC_INVALID_PARAM;
+    }
+    return DispatchBatch(payloads, results, capacity, id, "PLACE_ORDER_BATCH_A");
+}
+
+// Async pipe-delimited Unicode payload.
+BRIDGETS_API int __stdcall PLACE_ORDER_ASYNC_CMD_W(const wchar_t* payload)
+{
+    BRIDGE_LATENCY_SCOPE();
+    unsigned int id = ++g_reqCounter;
+
+    char stackBuf[1024];
+    std::string heap;
+    std::string_view narrow = NarrowPayload(payload, stackBuf, heap);
+    BRIDGE_LATENCY_MARK(Convert);
+    Bridge::OrderRequest req;
+    int rc = Bridge::ParsePayload(narrow, req);
+    BRIDGE_LATENCY_MARK(Validate);
+    if (rc != Bridge::RC_SUCCESS) {
+        Bridge::CountRequest(req.command, rc);
+        BRIDGE_EVENT_WARN(kLogFnUnparsed, id, "PLACE_ORDER_ASYNC_CMD_W", rc);
+        return rc;
+    }
+    return DispatchAsync(req, id);
+}
+
+// Async pipe-delimited ANSI payload.
+BRIDGETS_API int __stdcall PLACE_ORDER_ASYNC_CMD_A(const char* payload)
+{
+    BRIDGE_LATENCY_SCOPE();
+    unsigned int id = ++g_reqCounter;
+
+    Bridge::OrderRequest req;
+    int rc = Bridge::ParsePayload(payload ? payload : "", req);
+    BRIDGE_LATENCY_MARK(Validate);
+    if (rc != Bridge::RC_SUCCESS) {
+        Bridge::CountRequest(req.command, rc);
+        BRIDGE_EVENT_WARN(kLogFnUnparsed, id, "PLACE_ORDER_ASYNC_CMD_A", rc);
+        return rc;
+    }
+    return DispatchAsync(req, id);
+}
+
+// Async ticket result. Lock-free and not logged: strategies poll it every bar.
+BRIDGETS_API int __stdcall POLL_RESULT(int ticket)
+{
+    return SEH_PollResult(Bridge::GetEngine(), ticket);
+}
+
+// Latency report text; see LatencyStats.h. Not timed itself.
+BRIDGETS_API int __stdcall GET_STATS(char* buffer, int capacity)
+{
+    return SEH_LatencyReport(buffer, capacity);
+}
+
+// Explicit teardown; see BridgeTS.h.
+BRIDGETS_API int __stdcall BRIDGE_SHUTDOWN()
+{
+    Bridge::ShutdownEngine();
+    return Bridge::RC_SUCCESS;
 }
 
-} // extern "C"
\ No newline at end of file
+} // extern "C"
@@ -52,4 +52,35 @@ BRIDGETS_API int __stdcall PLACE_ORDER_CMD_W(const wchar_t* payload);
 // Single pipe-delimited ANSI payload.
 BRIDGETS_API int __stdcall PLACE_ORDER_CMD_A(const char* payload);
 
+// Newline-separated pipe-delimited Unicode payloads. Writes one return code
+// per payload to results[0..capacity) and returns the number of payloads.
+BRIDGETS_API int __stdcall PLACE_ORDER_BATCH_W(const wchar_t* payloads, int* results, int capacity);
+
+// Newline-separated pipe-delimited ANSI payloads.
+// Called via:  DefineDLLFunc: "BridgeTS.dll", INT, "PLACE_ORDER_BATCH_A",
+//              LPSTR, LPINT, INT;
+BRIDGETS_API int __stdcall PLACE_ORDER_BATCH_A(const char* payloads, int* results, int capacity);
+
+// Async pipe-delimited payloads: validate, queue and return a ticket (> 0)
+// without waiting for the adapter, or a negative return code.
+// Called via:  DefineDLLFunc: "BridgeTS.dll", INT, "PLACE_ORDER_ASYNC_CMD_A", LPSTR;
+BRIDGETS_API int __stdcall PLACE_ORDER_ASYNC_CMD_W(const wchar_t* payload);
+BRIDGETS_API int __stdcall PLACE_ORDER_ASYNC_CMD_A(const char* payload);
+
+// Result for an async ticket: 1 (pending) or the final return code.
+// Called via:  DefineDLLFunc: "BridgeTS.dll", INT, "POLL_RESULT", INT;
+BRIDGETS_API int __stdcall POLL_RESULT(int ticket);
+
+// Per-stage latency report (count, p50/p99/p99.9/max in ns per command,
+// adapter and stage) copied into buffer, NUL-terminated and cut to fit.
+// Returns the full length; call with capacity 0 to size the buffer.
+// Called via:  DefineDLLFunc: "BridgeTS.dll", INT, "GET_STATS", LPSTR, INT;
+BRIDGETS_API int __stdcall GET_STATS(char* buffer, int capacity);
+
+// Stop the engine's threads, release the adapter and flush the log, so the
+// DLL can be unloaded without joining threads under the loader lock. Call
+// once, last; later calls return -3 (not connected). Returns 0.
+// Called via:  DefineDLLFunc: "BridgeTS.dll", INT, "BRIDGE_SHUTDOWN";
+BRIDGETS_API int __stdcall BRIDGE_SHUTDOWN();
+
 } // extern "C"
@@ -0,0 +1,194 @@
+// BridgeTop: live view of a running bridge, read from the shared-memory
+// stats segment it publishes (statsSharedMemory, see SharedStats.h). The
+// segment is mapped read-only; the bridge never waits for this tool.
+//
+// Usage: BridgeTop [name] [options]
+//   name              segment name (default "BridgeStats")
+//   --interval <ms>   refresh period (default 1000)
+//   --once            print the totals since startup once and exit
+#include "../../BridgeCore/include/SharedStats.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#endif
+
+using namespace Bridge;
+
+struct Options {
+    std::string name       = "BridgeStats";
+    int         intervalMs = 1000;
+    bool        once       = false;
+};
+
+static void Usage() {
+    std::fprintf(stderr, "usage: BridgeTop [name] [--interval ms] [--once]\n");
+}
+
+static bool ParseArgs(int argc, char** argv, Options& opt) {
+    bool named = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if (a == "--interval" && i + 1 < argc) {
+            opt.intervalMs = std::atoi(argv[++i]);
+            if (opt.intervalMs <= 0) return false;
+        }
+        else if (a == "--once") opt.once = true;
+        else if (!a.empty() && a[0] != '-' && !named) { opt.name = a; named = true; }
+        else return false;
+    }
+    return true;
+}
+
+static void EnableAnsi() {
+#ifdef _WIN32
+    HANDLE out  = GetStdHandle(STD_OUTPUT_HANDLE);
+    DWORD  mode = 0;
+    if (out != INVALID_HANDLE_VALUE && GetConsoleMode(out, &mode))
+        SetConsoleMode(out, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+#endif
+}
+
+static int64_t UnixMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+static double Micros(uint64_t ticks, double ticksPerNs) {
+    return static_cast<double>(ticks) / (ticksPerNs > 0 ? ticksPerNs : 1.0) / 1000.0;
+}
+
+// 'prev' is the snapshot the rates and percentiles are taken from; with
+// none, they cover everything since the bridge started.
+static void Print(const Options& opt, const SharedStatsSegment& seg,
+                  const StatsSnapshot& cur, const StatsSnapshot* prev) {
+    double secs = 0;
+    if (prev) secs = static_cast<double>(cur.publishedNs - prev->publishedNs) / 1e9;
+    auto rate = [&](uint64_t now, uint64_t before) {
+        return secs > 0 ? static_cast<double>(now - before) / secs : 0.0;
+    };
+
+    int64_t up = (UnixMs() - static_cast<int64_t>(seg.StartedUnixMs())) / 1000;
+    if (up < 0) up = 0;
+    std::printf("%s  pid %llu  up %lld:%02lld:%02lld  adapter %s (%s)\n", opt.name.c_str(),
+                static_cast<unsigned long long>(seg.PublisherPid()),
+                static_cast<long long>(up / 3600), static_cast<long long>(up / 60 % 60),
+                static_cast<long long>(up % 60), cur.adapter,
+                cur.connected ? "connected" : "NOT CONNECTED");
+    std::printf("async %llu/%llu in %llu lane(s)  log queued %llu dropped %llu  "
+                "dedup hits %llu misses %llu  journaled %llu\n\n",
+                static_cast<unsigned long long>(cur.asyncQueued),
+                static_cast<unsigned long long>(cur.asyncCapacity),
+                static_cast<unsigned long long>(cur.lanes),
+                static_cast<unsigned long long>(cur.logQueued),
+                static_cast<unsigned long long>(cur.logDropped),
+                static_cast<unsigned long long>(cur.dedupHits),
+                static_cast<unsigned long long>(cur.dedupMisses),
+                static_cast<unsigned long long>(cur.journaled));
+
+    std::printf("%-12s %12s %10s  results\n", "command", "total", prev ? "/s" : "");
+    for (size_t c = 0; c < kStatsCommands; ++c) {
+        uint64_t total = 0, before = 0;
+        for (int r = 0; r < kStatsResults; ++r) {
+            total += cur.requests[c][r];
+            if (prev) before += prev->requests[c][r];
+        }
+        if (total == 0) continue;
+        std::printf("%-12s %12llu ", StatsCommandName(c), static_cast<unsigned long long>(total));
+        if (prev) std::printf("%10.1f ", rate(total, before));
+        else      std::printf("%10s ", "");
+        for (int r = 0; r < kStatsResults; ++r)
+            if (cur.requests[c][r])
+                std::printf(" %s %llu", StatsResultName(r),
+                            static_cast<unsigned long long>(cur.requests[c][r]));
+        std::printf("\n");
+    }
+
+    std::printf("\n%-12s %12s %10s %10s %10s %10s %10s  (us; %s)\n",
+                "stage", "count", prev ? "/s" : "", "p50", "p99", "p99.9", "max",
+                prev ? "percentiles over the last interval, max since startup" : "since startup");
+    uint64_t delta[LatencyHistogram::kBuckets];
+    for (size_t s = 0; s < kStatsStages; ++s) {
+        if (cur.latencyCount[s] == 0) continue;
+        uint64_t samples = cur.latencyCount[s];
+        for (size_t b = 0; b < LatencyHistogram::kBuckets; ++b)
+            delta[b] = cur.latencyBuckets[s][b] - (prev ? prev->latencyBuckets[s][b] : 0);
+        if (prev) samples -= prev->latencyCount[s];
+        std::printf("%-12s %12llu ", StageName(static_cast<Stage>(s)),
+                    static_cast<unsigned long long>(cur.latencyCount[s]));
+        if (prev) std::printf("%10.1f ", rate(cur.latencyCount[s], prev->latencyCount[s]));
+        else      std::printf("%10s ", "");
+        if (samples == 0) {
+            std::printf("%10s %10s %10s ", "-", "-", "-");
+        } else {
+            std::printf("%10.2f %10.2f %10.2f ",
+                        Micros(StatsPercentile(delta, 0.50), cur.ticksPerNs),
+                        Micros(StatsPercentile(delta, 0.99), cur.ticksPerNs),
+                        Micros(StatsPercentile(delta, 0.999), cur.ticksPerNs));
+        }
+        std::printf("%10.2f\n", Micros(cur.latencyMax[s], cur.ticksPerNs));
+    }
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!ParseArgs(argc, argv, opt)) {
+        Usage();
+        return 1;
+    }
+
+    SharedStatsSegment seg;
+    auto cur  = std::make_unique<StatsSnapshot>();
+    auto prev = std::make_unique<StatsSnapshot>();
+    bool havePrev = false;
+    uint64_t pid  = 0;
+    const auto interval = std::chrono::milliseconds(opt.intervalMs);
+
+    if (opt.once) {
+        if (!seg.Open(opt.name) || seg.PublisherPid() == 0) {
+            std::fprintf(stderr, "no bridge is publishing stats as \"%s\"\n", opt.name.c_str());
+            return 1;
+        }
+        if (!seg.Read(*cur) || cur->publishedNs == 0) {
+            std::fprintf(stderr, "cannot read a snapshot from \"%s\"\n", opt.name.c_str());
+            return 1;
+        }
+        Print(opt, seg, *cur, nullptr);
+        return 0;
+    }
+
+    EnableAnsi();
+    for (;; std::this_thread::sleep_for(interval)) {
+        // (Re)attach whenever the publisher has gone, e.g. across a restart.
+        if (!seg.IsOpen() || seg.PublisherPid() == 0) {
+            if (!seg.Open(opt.name) || seg.PublisherPid() == 0) {
+                seg.Close();
+                havePrev = false;
+                std::printf("\x1b[H\x1b[2JBridgeTop: waiting for a bridge publishing \"%s\"...\n",
+                            opt.name.c_str());
+                std::fflush(stdout);
+                continue;
+            }
+        }
+        if (!seg.Read(*cur) || cur->publishedNs == 0) continue;
+        // A new publisher restarts its counters; start the rates over.
+        if (seg.PublisherPid() != pid) {
+            pid      = seg.PublisherPid();
+            havePrev = false;
+        }
+        if (havePrev && cur->publishedNs == prev->publishedNs) continue;   // nothing new yet
+
+        std::printf("\x1b[H\x1b[2J");
+        Print(opt, seg, *cur, havePrev ? prev.get() : nullptr);
+        std::fflush(stdout);
+        std::swap(cur, prev);
+        havePrev = true;
+    }
+}
@@ -1,5 +1,6 @@
 using System.IO.Pipes;
 using System.Text;
+using System.Threading.Channels;
 
 namespace BridgeDotNetWorker;
 
@@ -11,6 +12,10 @@ namespace BridgeDotNetWorker;
 ///   <item><term>PLACE symbol side qty price [type]</term><description>Places an order. Returns "OK ..." or "ERROR ..."</description></item>
 ///   <item><term>EXIT</term><description>Shuts down the server.</description></item>
 /// </list>
+/// A command may be prefixed with a correlation tag, <c>#&lt;id&gt; PLACE ...</c>, and its reply carries the
+/// same tag (<c>#&lt;id&gt; OK ...</c>). A client can keep many requests in flight: lines are read ahead, but
+/// every command of a connection is executed and answered in arrival order, one at a time, so the
+/// connector is never called concurrently.
 /// </summary>
 public sealed class PipeServer : IDisposable
 {
@@ -61,21 +66,54 @@ public sealed class PipeServer : IDisposable
 
     private async Task HandleClientAsync(NamedPipeServerStream pipe, CancellationToken token)
     {
-        using var reader = new StreamReader(pipe, Encoding.UTF8, leaveOpen: true);
-        using var writer = new StreamWriter(pipe, Encoding.UTF8, leaveOpen: true) { AutoFlush = true };
+        using var reader = new StreamReader(pipe, new UTF8Encoding(false), leaveOpen: true);
+        using var writer = new StreamWriter(pipe, new UTF8Encoding(false), leaveOpen: true) { AutoFlush = true, NewLine = "\n" };
 
-        while (!token.IsCancellationRequested && pipe.IsConnected)
-        {
-            string? line = await reader.ReadLineAsync(token);
-            if (line is null) break;  // client disconnected
+        // Lines are read ahead while one executor runs them in arrival order, so requests stay
+        // pipelined on the wire but reach the connector one at a time.
+        var queue = Channel.CreateUnbounded<(string? Tag, string Command)>(
+            new UnboundedChannelOptions { SingleReader = true, SingleWriter = true });
+        Task executor = Task.Run(() => ExecuteAsync(queue.Reader, writer, token), token);
 
-            string response = ProcessCommand(line.Trim());
-            await writer.WriteLineAsync(response.AsMemory(), token);
+        try
+        {
+            while (!token.IsCancellationRequested && pipe.IsConnected && !executor.IsCompleted)
+            {
+                string? line = await reader.ReadLineAsync(token);
+                if (line is null) break;  // client disconnected
+
+                string command = line.Trim();
+                string? tag    = null;
+                if (command.StartsWith('#'))
+                {
+                    int space = command.IndexOf(' ');
+                    tag     = space < 0 ? command : command[..space];
+                    command = space < 0 ? string.Empty : command[(space + 1)..].Trim();
+                }
+
+                await queue.Writer.WriteAsync((tag, command), token);
+                if (command.Equals("EXIT", StringComparison.OrdinalIgnoreCase)) break;
+            }
+        }
+        finally
+        {
+            queue.Writer.TryComplete();
+            try { await executor; } catch (Exception) { }
+        }
+    }
 
-            if (line.Trim().Equals("EXIT", StringComparison.OrdinalIgnoreCase))
+    private async Task ExecuteAsync(ChannelReader<(string? Tag, string Command)> queue, StreamWriter writer,
+                                    CancellationToken token)
+    {
+        await foreach (var (tag, command) in queue.ReadAllAsync(token))
+        {
+            bool   exit     = command.Equals("EXIT", StringComparison.OrdinalIgnoreCase);
+            string response = exit ? "OK bye" : ProcessCommand(command);
+            await writer.WriteLineAsync((tag is null ? response : $"{tag} {response}").AsMemory(), token);
+            if (exit)
             {
                 _cts.Cancel();
-                break;
+                return;
             }
         }
     }
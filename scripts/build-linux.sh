@@ -0,0 +1,43 @@
+#!/usr/bin/env bash
+# Build the portable parts of the bridge on Linux: BridgeCore (static lib),
+# BridgeCoreTests, BridgeBench, BridgeReplay, BridgeLogcat and BridgeTop. The
+# DLL projects are Windows-only.
+#
+# Usage: scripts/build-linux.sh [Release|Debug]
+# Env:   CXX (default g++), ARCH_FLAGS (default -march=native)
+set -euo pipefail
+
+config="${1:-Release}"
+cxx="${CXX:-g++}"
+arch="${ARCH_FLAGS--march=native}"
+
+repo="$(cd "$(dirname "${BASH_SOURCE[0]}")/.." && pwd)"
+out="$repo/build-linux/$config"
+mkdir -p "$out/obj"
+
+flags="-std=c++20 -Wall -Wextra -pthread -I$repo/BridgeCore/include $arch"
+if [ "$config" = "Release" ]; then
+  flags="$flags -O2 -DNDEBUG"
+else
+  flags="$flags -O0 -g -D_DEBUG"
+fi
+
+echo "== Build script starting =="
+echo "Configuration: $config"
+echo "Compiler: $cxx"
+
+objs=()
+for src in "$repo"/BridgeCore/src/*.cpp; do
+  obj="$out/obj/$(basename "${src%.cpp}").o"
+  $cxx $flags -c "$src" -o "$obj"
+  objs+=("$obj")
+done
+ar rcs "$out/libBridgeCore.a" "${objs[@]}"
+
+$cxx $flags "$repo"/BridgeCoreTests/src/*.cpp "$out/libBridgeCore.a" -o "$out/BridgeCoreTests"
+$cxx $flags "$repo"/BridgeBench/src/*.cpp     "$out/libBridgeCore.a" -o "$out/BridgeBench"
+$cxx $flags "$repo"/BridgeReplay/src/*.cpp    "$out/libBridgeCore.a" -o "$out/BridgeReplay"
+$cxx $flags "$repo"/BridgeLogcat/src/*.cpp    "$out/libBridgeCore.a" -o "$out/BridgeLogcat"
+$cxx $flags "$repo"/BridgeTop/src/*.cpp       "$out/libBridgeCore.a" -o "$out/BridgeTop"
+
+echo "== Build script done: $out =="